@@ -0,0 +1,204 @@
+/****************************************************************************************
+	elementalarenabench.c
+
+	An ElementArena against glibc malloc, replaying recorded size traces.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Each trace is recorded up front, then replayed against both allocators.
+	A step frees whatever block its slot holds and allocates a new one.
+
+	- "phases": a random one of 8192 slots in each step. Sizes are
+	  log-uniform over a range that rises by a factor of four in each of
+	  four phases, from 16-256 bytes up to 1-16 kilobytes.
+	- "growing": alternates between a random one of 256 buffers, which grows
+	  by an eighth each time from 1 kilobyte to 256 kilobytes and then
+	  starts over, and a random one of 8192 small blocks of 16 to 255 bytes.
+	  A grown buffer rarely fits the hole its old self left, and small
+	  blocks settle into those holes. That is the pattern that fragments a
+	  heap.
+
+	Each replay runs in a child process of its own. Prints millions of
+	operations per second. It also prints the peak footprint over the most
+	bytes live at once. For the arena the footprint is its high-water mark;
+	for malloc it is the heap as mallinfo2() reports it.
+
+	************************************************************************************/
+
+#include <malloc.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "elementalarena.h"
+#include "elementalbench.h"
+
+#define	kSmall		8192
+#define	kBuffers	256
+#define	kSlots		(kSmall + kBuffers)
+#define	kPhases		4
+#define	kArenaSize	((size_t) 1024 * 1024 * 1024)
+
+typedef	struct	TraceStep	TraceStep;
+
+struct	TraceStep	{
+	uint32_t	slot;
+	uint32_t	size;
+};
+
+static	void	*gBlocks[ kSlots ];
+static	size_t	gSizes[ kSlots ];
+
+//	Returns the most bytes live at once.
+	static
+	size_t
+RecordTrace(
+	TraceStep	*trace,
+	size_t		count,
+	bool		growing )
+{
+	uint64_t	random = 13;
+	size_t		live = 0;
+	size_t		peak = 0;
+	size_t		index;
+
+	memset( gSizes, 0, sizeof( gSizes ) );
+	for( index = 0; index < count; index++ ) {
+		size_t	slot;
+		size_t	size;
+
+		if( !growing ) {
+			size_t	phase = index * kPhases / count;
+			double	low = log( 16.0 * pow( 4.0, (double) phase ) );
+			double	draw = (double) (BenchRandom( &random ) >> 11) * 0x1.0p-53;
+
+			slot = (size_t) (BenchRandom( &random ) % kSmall);
+			size = (size_t) exp( low + draw * log( 16.0 ) );
+		} else if( index % 2 ) {
+			slot = kSmall + (size_t) (BenchRandom( &random ) % kBuffers);
+			size = gSizes[ slot ] ? gSizes[ slot ] + gSizes[ slot ] / 8 + 16 : 1024;
+			if( size > 256 * 1024 )
+				size = 1024;
+		} else {
+			slot = (size_t) (BenchRandom( &random ) % kSmall);
+			size = 16 + (size_t) (BenchRandom( &random ) % 240);
+		}
+		trace[ index ].slot = (uint32_t) slot;
+		trace[ index ].size = (uint32_t) size;
+		live += size - gSizes[ slot ];
+		gSizes[ slot ] = size;
+		if( live > peak )
+			peak = live;
+	}
+	return( peak );
+}
+
+	static
+	size_t
+MallocFootprint( void )
+{
+	struct mallinfo2	info = mallinfo2();
+
+	return( info.arena + info.hblkhd );
+}
+
+//	Replays trace against one allocator, printing a line of results.
+	static
+	void
+ReplayTrace(
+	const TraceStep	*trace,
+	size_t			count,
+	size_t			peakLive,
+	char			*memory,
+	bool			growing,
+	bool			arena_ )
+{
+	ElementArena	arena;
+	size_t			base = MallocFootprint();
+	size_t			footprint = 0;
+	size_t			failures = 0;
+	double			start;
+	size_t			index;
+
+	NewElementArena( &arena, memory, kArenaSize );
+	memset( gBlocks, 0, sizeof( gBlocks ) );
+
+	start = BenchNow();
+	for( index = 0; index < count; index++ ) {
+		size_t	slot = trace[ index ].slot;
+		size_t	size = trace[ index ].size;
+
+		if( arena_ ) {
+			FreeArenaBlock( gBlocks[ slot ], &arena );
+			AllocateArenaBlock( &gBlocks[ slot ], &arena, size );
+			if( !gBlocks[ slot ] )
+				failures++;
+			else if( (size_t) ((char*) gBlocks[ slot ] + size - memory) > footprint )
+				footprint = (size_t) ((char*) gBlocks[ slot ] + size - memory);
+		} else {
+			free( gBlocks[ slot ] );
+			gBlocks[ slot ] = malloc( size );
+			if( index % 1024 == 0 && MallocFootprint() > base + footprint )
+				footprint = MallocFootprint() - base;
+		}
+	}
+	printf( "%-8s %-8s %10.1f %12.2f %16.2f\n", growing ? "growing" : "phases",
+		arena_ ? "arena" : "malloc", (double) peakLive / 1e6,
+		(double) (count * 2) / (BenchNow() - start) / 1e6, (double) footprint / (double) peakLive );
+	if( failures )
+		printf( "%zu arena allocations failed\n", failures );
+
+	for( index = 0; index < kSlots; index++ ) {
+		if( arena_ )
+			FreeArenaBlock( gBlocks[ index ], &arena );
+		else
+			free( gBlocks[ index ] );
+	}
+	DeleteElementArena( &arena );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t		count = (size_t) (4000000 * BenchScale( argc, argv )) + kPhases;
+	TraceStep	*trace = (TraceStep*) malloc( count * sizeof( TraceStep ) );
+	char		*memory = (char*) malloc( kArenaSize );
+	int			growing;
+
+	printf( "%-8s %-8s %10s %12s %16s\n", "trace", "", "live MB", "M ops/s", "footprint/live" );
+	for( growing = 0; growing < 2; growing++ ) {
+		size_t	peakLive = RecordTrace( trace, count, growing );
+		int		arena_;
+
+		//	Each replay runs in a child of its own, so malloc starts with a
+		//	fresh heap.
+		for( arena_ = 0; arena_ < 2; arena_++ ) {
+			pid_t	child;
+			int		status;
+
+			fflush( stdout );
+			child = fork();
+			if( child < 0 ) {
+				perror( "fork" );
+				return( 1 );
+			}
+			if( child == 0 ) {
+				ReplayTrace( trace, count, peakLive, memory, growing, arena_ );
+				fflush( stdout );
+				_exit( 0 );
+			}
+			if( waitpid( child, &status, 0 ) != child || !WIFEXITED( status ) || WEXITSTATUS( status ) ) {
+				fprintf( stderr, "replay failed\n" );
+				return( 1 );
+			}
+		}
+	}
+	free( memory );
+	free( trace );
+	return( 0 );
+}
@@ -0,0 +1,165 @@
+/****************************************************************************************
+	elementalbench.h
+
+	What the benchmarks share: a clock, percentiles and hardware counters.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Every benchmark takes an optional scale as its first argument, multiplying
+	its default amount of work, and prints one line per measurement. The test
+	suite runs each at a small scale so they keep building and running; for
+	real numbers, run them by hand on a quiet machine from a Release build.
+
+	Hardware counters come from perf_event_open(2) and read as -1 where the
+	kernel or a container does not allow them.
+
+	************************************************************************************/
+
+#ifndef		_elementalbench_
+#define		_elementalbench_
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//	Monotonic seconds.
+	static inline
+	double
+BenchNow( void )
+{
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return( (double) now.tv_sec + (double) now.tv_nsec * 1e-9 );
+}
+
+//	Monotonic nanoseconds, for per-operation latencies.
+	static inline
+	uint64_t
+BenchNanoseconds( void )
+{
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return( (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec );
+}
+
+//	argv[1] as a positive number, else 1.
+	static inline
+	double
+BenchScale(
+	int		argc,
+	char	**argv )
+{
+	double	scale = argc > 1 ? atof( argv[ 1 ] ) : 1.0;
+
+	return( scale > 0 ? scale : 1.0 );
+}
+
+//	xorshift64*: a fast, reproducible stream for generating workloads.
+	static inline
+	uint64_t
+BenchRandom(
+	uint64_t	*state )
+{
+	uint64_t	x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return( x * UINT64_C( 0x2545F4914F6CDD1D ) );
+}
+
+	static inline
+	int
+BenchCompareU64(
+	const void	*a,
+	const void	*b )
+{
+	uint64_t	x = *(const uint64_t*) a;
+	uint64_t	y = *(const uint64_t*) b;
+
+	return( (x > y) - (x < y) );
+}
+
+//	Sorts samples in place and returns the given percentile, 0 to 100.
+	static inline
+	uint64_t
+BenchPercentile(
+	uint64_t	*samples,
+	size_t		count,
+	double		percentile )
+{
+	size_t	index;
+
+	if( count == 0 )
+		return( 0 );
+	qsort( samples, count, sizeof( uint64_t ), BenchCompareU64 );
+	index = (size_t) (percentile / 100.0 * (double) (count - 1) + 0.5);
+	return( samples[ index < count ? index : count - 1 ] );
+}
+
+//	Opens a counter of this thread, PERF_COUNT_HW_BRANCH_MISSES say, stopped
+//	and zeroed. Returns -1 if counters are unavailable.
+	static inline
+	int
+OpenBenchCounter(
+	uint32_t	type,
+	uint64_t	config )
+{
+	struct perf_event_attr	attr;
+
+	memset( &attr, 0, sizeof( attr ) );
+	attr.size = sizeof( attr );
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return( (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+}
+
+	static inline
+	void
+StartBenchCounter(
+	int	counter )
+{
+	if( counter >= 0 ) {
+		ioctl( counter, PERF_EVENT_IOC_RESET, 0 );
+		ioctl( counter, PERF_EVENT_IOC_ENABLE, 0 );
+	}
+}
+
+//	Stops counter and returns its count, or -1.
+	static inline
+	long long
+StopBenchCounter(
+	int	counter )
+{
+	long long	count = -1;
+
+	if( counter < 0 )
+		return( -1 );
+	ioctl( counter, PERF_EVENT_IOC_DISABLE, 0 );
+	if( read( counter, &count, sizeof( count ) ) != (ssize_t) sizeof( count ) )
+		count = -1;
+	return( count );
+}
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	//	_elementalbench_
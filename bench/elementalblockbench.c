@@ -0,0 +1,155 @@
+/****************************************************************************************
+	elementalblockbench.c
+
+	BlockElementList against the classic intrusive ElementList.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A million 64-byte objects, linked in a shuffled order as after days of
+	uptime, are walked end to end: first touching only the links, then also
+	reading a key from each object. Then both lists serve ends-heavy
+	workloads, a FIFO (put last, grab first) and a LIFO (put first, grab
+	first), at a steady depth. Prints nanoseconds per element or operation.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elementalblock.h"
+
+#define	kDepth		1024
+
+typedef	struct	Object	Object;
+
+struct	Object	{
+	Element		element;
+	long		key;
+	char		payload[ 64 - sizeof( Element ) - sizeof( long ) ];
+};
+
+	static
+	void
+Shuffle(
+	Object		**order,
+	size_t		count,
+	uint64_t	*state )
+{
+	size_t	index;
+
+	for( index = count - 1; index > 0; index-- ) {
+		size_t	other = (size_t) (BenchRandom( state ) % (index + 1));
+		Object	*swap = order[ index ];
+
+		order[ index ] = order[ other ];
+		order[ other ] = swap;
+	}
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t				count = (size_t) (1000000 * BenchScale( argc, argv ));
+	size_t				operations = count * 4;
+	Object				*objects = (Object*) calloc( count, sizeof( Object ) );
+	Object				**order = (Object**) malloc( count * sizeof( Object* ) );
+	uint64_t			state = 0x9e3779b97f4a7c15ull;
+	ElementList			list;
+	BlockElementList	blocks;
+	BlockElementCursor	cursor;
+	volatile long		sink = 0;
+	double				start, linked[ 4 ], blocked[ 4 ];
+	size_t				index;
+	void				*element;
+	long				sum;
+
+	for( index = 0; index < count; index++ ) {
+		objects[ index ].key = (long) index;
+		order[ index ] = &objects[ index ];
+	}
+	Shuffle( order, count, &state );
+	NewElementList( &list );
+	NewBlockElementList( &blocks );
+	for( index = 0; index < count; index++ ) {
+		PutLastElement( order[ index ], &list );
+		PutLastBlockElement( order[ index ], &blocks );
+	}
+
+	//	Walks: links only, then links and keys.
+	start = BenchNow();
+	sum = 0;
+	for( FirstElement( &element, &list ); element; NextElement( element, &element ) )
+		sum++;
+	linked[ 0 ] = BenchNow() - start;
+	sink += sum;
+	start = BenchNow();
+	sum = 0;
+	for( FirstBlockElement( &element, &blocks, &cursor ); element; NextBlockElement( &element, &cursor ) )
+		sum++;
+	blocked[ 0 ] = BenchNow() - start;
+	sink += sum;
+
+	start = BenchNow();
+	sum = 0;
+	for( FirstElement( &element, &list ); element; NextElement( element, &element ) )
+		sum += ((Object*) element)->key;
+	linked[ 1 ] = BenchNow() - start;
+	sink += sum;
+	start = BenchNow();
+	sum = 0;
+	for( FirstBlockElement( &element, &blocks, &cursor ); element; NextBlockElement( &element, &cursor ) )
+		sum += ((Object*) element)->key;
+	blocked[ 1 ] = BenchNow() - start;
+	sink += sum;
+
+	while( GrabFirstElement( &element, &list ), element )
+		;
+	while( GrabFirstBlockElement( &element, &blocks ), element )
+		;
+
+	//	Ends: a FIFO, then a LIFO, each kDepth deep.
+	for( index = 0; index < kDepth; index++ ) {
+		PutLastElement( &objects[ index ], &list );
+		PutLastBlockElement( &objects[ index ], &blocks );
+	}
+	start = BenchNow();
+	for( index = 0; index < operations; index++ ) {
+		GrabFirstElement( &element, &list );
+		PutLastElement( element, &list );
+	}
+	linked[ 2 ] = BenchNow() - start;
+	start = BenchNow();
+	for( index = 0; index < operations; index++ ) {
+		GrabFirstBlockElement( &element, &blocks );
+		PutLastBlockElement( element, &blocks );
+	}
+	blocked[ 2 ] = BenchNow() - start;
+
+	start = BenchNow();
+	for( index = 0; index < operations; index++ ) {
+		GrabFirstElement( &element, &list );
+		PutFirstElement( element, &list );
+	}
+	linked[ 3 ] = BenchNow() - start;
+	start = BenchNow();
+	for( index = 0; index < operations; index++ ) {
+		GrabFirstBlockElement( &element, &blocks );
+		PutFirstBlockElement( element, &blocks );
+	}
+	blocked[ 3 ] = BenchNow() - start;
+
+	printf( "%-16s %14s %14s\n", "workload", "list ns", "block ns" );
+	printf( "%-16s %14.2f %14.2f\n", "walk links", linked[ 0 ] * 1e9 / (double) count, blocked[ 0 ] * 1e9 / (double) count );
+	printf( "%-16s %14.2f %14.2f\n", "walk and read", linked[ 1 ] * 1e9 / (double) count, blocked[ 1 ] * 1e9 / (double) count );
+	printf( "%-16s %14.2f %14.2f\n", "fifo put+grab", linked[ 2 ] * 1e9 / (double) operations, blocked[ 2 ] * 1e9 / (double) operations );
+	printf( "%-16s %14.2f %14.2f\n", "lifo put+grab", linked[ 3 ] * 1e9 / (double) operations, blocked[ 3 ] * 1e9 / (double) operations );
+
+	DeleteBlockElementList( &blocks );
+	DeleteElementList( &list );
+	free( order );
+	free( objects );
+	return( 0 );
+}
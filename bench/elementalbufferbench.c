@@ -0,0 +1,144 @@
+/****************************************************************************************
+	elementalbufferbench.c
+
+	Gathered writes from a BufferChain against copying into one send buffer.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Responses of many small pieces go down a socketpair whose far end a
+	second thread drains. Each is sent either as a BufferChain, a header
+	prepended to its pieces and flushed with writev(), the descriptors going
+	back to a BufferPool; or by copying the header and pieces into one
+	contiguous buffer and write()ing that, as our outbound path did. Prints
+	megabytes per second for pieces of 64 bytes, 512 bytes and 4 kilobytes,
+	about 64 kilobytes per response.
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "elementalbench.h"
+#include "elementalbuffer.h"
+
+#define	kResponseBytes	65536
+#define	kHeader			"HTTP/1.1 200 OK\r\nContent-Length: 65536\r\n\r\n"
+
+	static
+	void*
+Drain(
+	void	*refCon )
+{
+	int		fd = *(int*) refCon;
+	char	bytes[ 65536 ];
+
+	while( read( fd, bytes, sizeof( bytes ) ) > 0 )
+		;
+	return( NULL );
+}
+
+	static
+	bool
+WriteAll(
+	int			fd,
+	const char	*bytes,
+	size_t		length )
+{
+	while( length ) {
+		ssize_t	wrote = write( fd, bytes, length );
+
+		if( wrote < 0 )
+			return( false );
+		bytes += wrote;
+		length -= (size_t) wrote;
+	}
+	return( true );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const size_t	pieceSizes[] = { 64, 512, 4096 };
+	size_t			responses = (size_t) (16384 * BenchScale( argc, argv )) + 1;
+	char			*pieces = (char*) malloc( kResponseBytes );
+	char			*contiguous = (char*) malloc( kResponseBytes + sizeof( kHeader ) );
+	size_t			which;
+
+	memset( pieces, 'x', kResponseBytes );
+	printf( "%-8s %8s %14s %14s\n", "piece", "pieces", "chain MB/s", "copy MB/s" );
+	for( which = 0; which < sizeof( pieceSizes ) / sizeof( pieceSizes[ 0 ] ); which++ ) {
+		size_t		pieceSize = pieceSizes[ which ];
+		size_t		pieceCount = kResponseBytes / pieceSize;
+		double		seconds[ 2 ];
+		int			copy;
+
+		for( copy = 0; copy < 2; copy++ ) {
+			BufferChain	chain;
+			BufferPool	pool;
+			pthread_t	drainer;
+			int			sockets[ 2 ];
+			double		start;
+			size_t		response;
+
+			if( socketpair( AF_UNIX, SOCK_STREAM, 0, sockets ) != 0
+					|| pthread_create( &drainer, NULL, Drain, &sockets[ 1 ] ) != 0 ) {
+				perror( "socketpair" );
+				return( 1 );
+			}
+			NewBufferChain( &chain );
+			NewBufferPool( &pool, NULL, NULL );
+
+			start = BenchNow();
+			for( response = 0; response < responses; response++ ) {
+				size_t	piece;
+
+				if( copy ) {
+					size_t	length = sizeof( kHeader ) - 1;
+
+					memcpy( contiguous, kHeader, length );
+					for( piece = 0; piece < pieceCount; piece++ ) {
+						memcpy( contiguous + length, pieces + piece * pieceSize, pieceSize );
+						length += pieceSize;
+					}
+					if( !WriteAll( sockets[ 0 ], contiguous, length ) ) {
+						perror( "write" );
+						return( 1 );
+					}
+				} else {
+					ElementBuffer	*buffer;
+
+					for( piece = 0; piece < pieceCount; piece++ ) {
+						GrabPoolBuffer( &buffer, &pool );
+						AppendChainBuffer( buffer, &chain, pieces + piece * pieceSize, pieceSize );
+					}
+					GrabPoolBuffer( &buffer, &pool );
+					PrependChainBuffer( buffer, &chain, kHeader, sizeof( kHeader ) - 1 );
+					while( CountChainBytes( &chain ) )
+						if( !FlushBufferChain( &chain, sockets[ 0 ], &pool ) ) {
+							perror( "writev" );
+							return( 1 );
+						}
+				}
+			}
+			seconds[ copy ] = BenchNow() - start;
+
+			close( sockets[ 0 ] );
+			pthread_join( drainer, NULL );
+			close( sockets[ 1 ] );
+			DeleteBufferChain( &chain );
+			DeleteBufferPool( &pool );
+		}
+		printf( "%-8zu %8zu %14.0f %14.0f\n", pieceSize, pieceCount,
+			(double) (responses * kResponseBytes) / seconds[ 0 ] / 1e6,
+			(double) (responses * kResponseBytes) / seconds[ 1 ] / 1e6 );
+	}
+	free( pieces );
+	free( contiguous );
+	return( 0 );
+}
@@ -0,0 +1,219 @@
+/****************************************************************************************
+	elementalchannelbench.c
+
+	Pipeline throughput and handoff latency of an ElementChannel against an
+	ElementList guarded by a mutex and condition variables.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Producers stamp each item as they put it and consumers note how long it
+	took to come out, through a bounded queue of 256. For 1, 2 and 4
+	producer/consumer pairs, prints items per second and the p50 and p99
+	handoff latency, for the channel (grabbing one at a time, then up to 32)
+	and for the condvar queue, which signals once per item.
+
+	************************************************************************************/
+
+#include <pthread.h>
+
+#include "elementalbench.h"
+#include "elementalchannel.h"
+
+#define	kCapacity	256
+#define	kMostPairs	4
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	Element		element;
+	uint64_t	stamp;
+};
+
+typedef	struct	{
+	ElementList		list;
+	size_t			count;
+	bool			closed;
+	pthread_mutex_t	lock;
+	pthread_cond_t	notEmpty;
+	pthread_cond_t	notFull;
+} CondQueue;
+
+typedef	struct	{
+	Item		*items;
+	uint64_t	*latencies;
+	size_t		count;
+	size_t		taken;
+} Worker;
+
+static	ElementChannel	gChannel;
+static	CondQueue		gQueue;
+static	int				gMode;		//	0 channel, 1 channel in batches, 2 condvar queue.
+
+	static
+	void*
+Producer(
+	void	*refCon )
+{
+	Worker	*worker = (Worker*) refCon;
+	size_t	index;
+
+	for( index = 0; index < worker->count; index++ ) {
+		Item	*item = &worker->items[ index ];
+
+		item->stamp = BenchNanoseconds();
+		if( gMode < 2 )
+			PutChannelElement( item, &gChannel, NULL );
+		else {
+			pthread_mutex_lock( &gQueue.lock );
+			while( gQueue.count >= kCapacity )
+				pthread_cond_wait( &gQueue.notFull, &gQueue.lock );
+			PutLastElement( item, &gQueue.list );
+			gQueue.count++;
+			pthread_cond_signal( &gQueue.notEmpty );
+			pthread_mutex_unlock( &gQueue.lock );
+		}
+	}
+	return( NULL );
+}
+
+	static
+	void*
+Consumer(
+	void	*refCon )
+{
+	Worker		*worker = (Worker*) refCon;
+	ElementList	batch;
+	Item		*item;
+
+	NewElementList( &batch );
+	for( ;; ) {
+		if( gMode == 0 ) {
+			if( !GrabChannelElement( (void**) &item, &gChannel, NULL ) )
+				break;
+			PutLastElement( item, &batch );
+		} else if( gMode == 1 ) {
+			if( GrabChannelElements( &batch, 32, &gChannel, NULL ) == 0 )
+				break;
+		} else {
+			pthread_mutex_lock( &gQueue.lock );
+			while( gQueue.count == 0 && !gQueue.closed )
+				pthread_cond_wait( &gQueue.notEmpty, &gQueue.lock );
+			GrabFirstElement( (void**) &item, &gQueue.list );
+			if( item ) {
+				gQueue.count--;
+				pthread_cond_signal( &gQueue.notFull );
+			}
+			pthread_mutex_unlock( &gQueue.lock );
+			if( item == NULL )
+				break;
+			PutLastElement( item, &batch );
+		}
+		while( GrabFirstElement( (void**) &item, &batch ), item ) {
+			uint64_t	now = BenchNanoseconds();
+
+			if( worker->taken < worker->count )
+				worker->latencies[ worker->taken ] = now - item->stamp;
+			worker->taken++;
+		}
+	}
+	return( NULL );
+}
+
+	static
+	void
+Measure(
+	int		pairs,
+	int		mode,
+	size_t	perProducer )
+{
+	pthread_t	producers[ kMostPairs ];
+	pthread_t	consumers[ kMostPairs ];
+	Worker		producing[ kMostPairs ];
+	Worker		consuming[ kMostPairs ];
+	size_t		total = (size_t) pairs * perProducer;
+	uint64_t	*latencies = (uint64_t*) malloc( total * sizeof( uint64_t ) );
+	size_t		samples = 0;
+	double		start;
+	double		seconds;
+	int			index;
+
+	gMode = mode;
+	if( mode < 2 )
+		NewElementChannel( &gChannel, kCapacity );
+	else {
+		NewElementList( &gQueue.list );
+		gQueue.count = 0;
+		gQueue.closed = false;
+		pthread_mutex_init( &gQueue.lock, NULL );
+		pthread_cond_init( &gQueue.notEmpty, NULL );
+		pthread_cond_init( &gQueue.notFull, NULL );
+	}
+	for( index = 0; index < pairs; index++ ) {
+		producing[ index ].items = (Item*) calloc( perProducer, sizeof( Item ) );
+		producing[ index ].count = perProducer;
+		//	A consumer may take more than its share; it keeps the first perProducer.
+		consuming[ index ].latencies = (uint64_t*) malloc( perProducer * sizeof( uint64_t ) );
+		consuming[ index ].count = perProducer;
+		consuming[ index ].taken = 0;
+	}
+
+	start = BenchNow();
+	for( index = 0; index < pairs; index++ )
+		pthread_create( &consumers[ index ], NULL, Consumer, &consuming[ index ] );
+	for( index = 0; index < pairs; index++ )
+		pthread_create( &producers[ index ], NULL, Producer, &producing[ index ] );
+	for( index = 0; index < pairs; index++ )
+		pthread_join( producers[ index ], NULL );
+	if( mode < 2 )
+		CloseElementChannel( &gChannel );
+	else {
+		pthread_mutex_lock( &gQueue.lock );
+		gQueue.closed = true;
+		pthread_cond_broadcast( &gQueue.notEmpty );
+		pthread_mutex_unlock( &gQueue.lock );
+	}
+	for( index = 0; index < pairs; index++ )
+		pthread_join( consumers[ index ], NULL );
+	seconds = BenchNow() - start;
+
+	for( index = 0; index < pairs; index++ ) {
+		size_t	kept = consuming[ index ].taken < perProducer ? consuming[ index ].taken : perProducer;
+
+		memcpy( latencies + samples, consuming[ index ].latencies, kept * sizeof( uint64_t ) );
+		samples += kept;
+		free( consuming[ index ].latencies );
+		free( producing[ index ].items );
+	}
+	printf( "%-6d %-14s %14.0f %12llu %12llu\n", pairs,
+		mode == 0 ? "channel" : mode == 1 ? "channel/32" : "condvar",
+		(double) total / seconds,
+		(unsigned long long) BenchPercentile( latencies, samples, 50 ),
+		(unsigned long long) BenchPercentile( latencies, samples, 99 ) );
+
+	if( mode < 2 )
+		DeleteElementChannel( &gChannel );
+	else {
+		pthread_cond_destroy( &gQueue.notFull );
+		pthread_cond_destroy( &gQueue.notEmpty );
+		pthread_mutex_destroy( &gQueue.lock );
+		DeleteElementList( &gQueue.list );
+	}
+	free( latencies );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t	perProducer = (size_t) (1000000 * BenchScale( argc, argv ));
+	int		pairs;
+	int		mode;
+
+	printf( "%-6s %-14s %14s %12s %12s\n", "pairs", "queue", "items/s", "p50 ns", "p99 ns" );
+	for( pairs = 1; pairs <= kMostPairs; pairs *= 2 )
+		for( mode = 0; mode < 3; mode++ )
+			Measure( pairs, mode, perProducer );
+	return( 0 );
+}
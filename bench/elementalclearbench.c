@@ -0,0 +1,102 @@
+/****************************************************************************************
+	elementalclearbench.c
+
+	Request-scoped lists, emptied at the end of every request.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Each request puts its entries, drawn from a pool, on a list that lives
+	as long as the worker, looks a few up, and ends by emptying the list:
+	either with a GrabFirstElement() loop, as we used to, or with one
+	ClearElementList(). Requests of a hundred, ten thousand and a hundred
+	thousand entries. Prints nanoseconds per request spent emptying the
+	list, and per entry for the whole request. Built twice, against the
+	plain library and against one with elementalGenerations, whose clear is
+	constant-time but whose puts stamp every entry.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elemental.h"
+
+#define	kPasses		20
+
+typedef	struct	Entry	Entry;
+
+struct	Entry	{
+	Element		element;
+	uint64_t	key;
+};
+
+	static
+	double
+Request(
+	ElementList	*list,
+	Entry		*pool,
+	size_t		count,
+	bool		grab,
+	uint64_t	*state,
+	uint64_t	*sum )
+{
+	size_t	index;
+	double	start;
+
+	for( index = 0; index < count; index++ )
+		PutLastElement( &pool[ index ], list );
+	for( index = 0; index < 16; index++ )
+		*sum += pool[ BenchRandom( state ) % count ].key;
+
+	start = BenchNow();
+	if( grab ) {
+		void	*element;
+
+		for( GrabFirstElement( &element, list ); element; GrabFirstElement( &element, list ) )
+			;
+	} else
+		ClearElementList( list );
+	return( BenchNow() - start );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const size_t	sizes[] = { 100, 10000, 100000 };
+	double			scale = BenchScale( argc, argv );
+	Entry			*pool = (Entry*) calloc( sizes[ 2 ], sizeof( Entry ) );
+	uint64_t		state = 3;
+	uint64_t		sum = 0;
+	size_t			which;
+
+	for( which = 0; which < sizes[ 2 ]; which++ )
+		pool[ which ].key = which;
+
+	printf( "%s\n", elementalGenerations ? "with elementalGenerations" : "without elementalGenerations" );
+	printf( "%-8s %-6s %16s %16s\n", "entries", "empty", "empty ns/req", "total ns/entry" );
+	for( which = 0; which < sizeof( sizes ) / sizeof( sizes[ 0 ] ); which++ ) {
+		size_t	requests = (size_t) ((double) (kPasses * sizes[ 2 ] / sizes[ which ]) * scale) + 1;
+		int		grab;
+
+		for( grab = 1; grab >= 0; grab-- ) {
+			ElementList	list;
+			double		emptying = 0;
+			double		start;
+			size_t		request;
+
+			NewElementList( &list );
+			start = BenchNow();
+			for( request = 0; request < requests; request++ )
+				emptying += Request( &list, pool, sizes[ which ], grab, &state, &sum );
+			printf( "%-8zu %-6s %16.0f %16.2f\n", sizes[ which ], grab ? "grab" : "clear",
+				emptying * 1e9 / (double) requests,
+				(BenchNow() - start) * 1e9 / (double) (requests * sizes[ which ]) );
+			DeleteElementList( &list );
+		}
+	}
+	free( pool );
+	return( sum == 0 );
+}
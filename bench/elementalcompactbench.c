@@ -0,0 +1,99 @@
+/****************************************************************************************
+	elementalcompactbench.c
+
+	Iteration before and after CompactElementList().
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A million 64-byte objects are scattered one per 256 bytes of a large
+	pool and linked in shuffled order, as after days of heap churn. The list
+	is walked, reading each object's key; compacted into an arena; and walked
+	again. Prints ElementListLocality() and nanoseconds per element for each
+	walk, and what the compaction itself cost per element.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elemental.h"
+
+#define	kSpread		256
+
+typedef	struct	Object	Object;
+
+struct	Object	{
+	Element		element;
+	long		key;
+	char		payload[ 64 - sizeof( Element ) - sizeof( long ) ];
+};
+
+	static
+	double
+Walk(
+	ElementList	*list,
+	long		*sum )
+{
+	double	start = BenchNow();
+	Object	*object;
+
+	*sum = 0;
+	for( FirstElementType( &object, list, Object, element ); object; NextElementType( object, (void**) &object, Object, element ) )
+		*sum += object->key;
+	return( BenchNow() - start );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t		count = (size_t) (1000000 * BenchScale( argc, argv ));
+	char		*pool = (char*) calloc( count, kSpread );
+	Object		*arena = (Object*) calloc( count, sizeof( Object ) );
+	size_t		*order = (size_t*) malloc( count * sizeof( size_t ) );
+	uint64_t	state = 0x9e3779b97f4a7c15ull;
+	ElementList	list;
+	size_t		index, before, after;
+	double		scattered, compacting, compacted;
+	long		sum1, sum2;
+
+	for( index = 0; index < count; index++ )
+		order[ index ] = index;
+	for( index = count - 1; index > 0; index-- ) {
+		size_t	other = (size_t) (BenchRandom( &state ) % (index + 1));
+		size_t	swap = order[ index ];
+
+		order[ index ] = order[ other ];
+		order[ other ] = swap;
+	}
+	NewElementList( &list );
+	for( index = 0; index < count; index++ ) {
+		Object	*object = (Object*) (pool + order[ index ] * kSpread);
+
+		object->key = (long) index;
+		PutLastElement( object, &list );
+	}
+
+	before = ElementListLocality( &list );
+	scattered = Walk( &list, &sum1 );
+	compacting = BenchNow();
+	CompactElementListType( &list, arena, count * sizeof( Object ), NULL, NULL, Object, element );
+	compacting = BenchNow() - compacting;
+	after = ElementListLocality( &list );
+	compacted = Walk( &list, &sum2 );
+	if( sum1 != sum2 )
+		return( 1 );
+
+	printf( "%-10s %14s %14s\n", "list", "locality", "walk ns/elem" );
+	printf( "%-10s %14zu %14.2f\n", "scattered", before, scattered * 1e9 / (double) count );
+	printf( "%-10s %14zu %14.2f\n", "compacted", after, compacted * 1e9 / (double) count );
+	printf( "compaction: %.2f ns/elem\n", compacting * 1e9 / (double) count );
+
+	DeleteElementList( &list );
+	free( order );
+	free( arena );
+	free( pool );
+	return( 0 );
+}
@@ -0,0 +1,295 @@
+/****************************************************************************************
+	elementalcorobench.cpp
+
+	Coroutine channel and mutex against std::mutex and std::condition_variable.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Producers hand elements to consumers through a queue of 64, and workers
+	take turns incrementing a counter under a mutex. Each is run as
+	coroutines on an ElementLoop (one thread), as coroutines on an
+	ElementThreadLoop run by 4 threads, and as 4 plain threads with a
+	std::mutex/condvar queue or a std::mutex. Prints operations per second and
+	heap allocations per operation, which is 0 for the coroutines once they
+	are running.
+
+	************************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "elementalbench.h"
+#include "elementalcoro.hpp"
+
+#define	kCapacity	64
+#define	kPairs		2
+#define	kWorkers	4
+
+struct	Item	{
+	Element	element;
+	long	value;
+};
+
+struct	CondQueue	{
+	std::mutex				lock;
+	std::condition_variable	notEmpty;
+	std::condition_variable	notFull;
+	ElementList				list;
+	size_t					count;
+	bool					closed;
+};
+
+static	std::atomic<long>	gAllocations( 0 );
+static	std::atomic<long>	gGot( 0 );
+static	std::atomic<int>	gDone( 0 );
+static	long				gShared;
+
+	void*
+operator new(
+	size_t	size )
+{
+	void	*block = malloc( size ? size : 1 );
+
+	if( !block )
+		throw std::bad_alloc();
+	gAllocations.fetch_add( 1, std::memory_order_relaxed );
+	return( block );
+}
+
+//	Out of line, or GCC sees free() of what new returned and warns.
+	__attribute__(( noinline ))
+	void
+operator delete(
+	void	*block ) noexcept
+{
+	free( block );
+}
+
+	void
+operator delete(
+	void	*block,
+	size_t	size ) noexcept
+{
+	(void) size;
+	operator delete( block );
+}
+
+	static
+	ElementTask
+Producer(
+	AsyncElementChannel	&channel,
+	Item				*items,
+	long				count )
+{
+	for( long index = 0; index < count; index++ )
+		co_await channel.Put( &items[ index ] );
+}
+
+	static
+	ElementTask
+Consumer(
+	AsyncElementChannel	&channel,
+	long				total,
+	ElementThreadLoop	*loop )
+{
+	void	*item;
+
+	while( (item = co_await channel.Grab()) != NULL ) {
+		if( gGot.fetch_add( 1, std::memory_order_relaxed ) + 1 == total ) {
+			channel.Close();
+			if( loop )
+				loop->Stop();
+		}
+	}
+}
+
+	static
+	ElementTask
+Locker(
+	AsyncElementMutex	&mutex,
+	long				count,
+	ElementThreadLoop	*loop )
+{
+	for( long index = 0; index < count; index++ ) {
+		co_await mutex.Lock();
+		gShared++;
+		mutex.Unlock();
+	}
+	if( ++gDone == kWorkers && loop )
+		loop->Stop();
+}
+
+	static
+	void
+Report(
+	const char	*test,
+	const char	*how,
+	long		operations,
+	double		seconds,
+	long		allocations )
+{
+	printf( "%-8s %-14s %14.0f %12.3f\n", test, how, (double) operations / seconds,
+		(double) allocations / (double) operations );
+}
+
+	static
+	void
+RunThreads(
+	ElementThreadLoop	&loop )
+{
+	std::vector<std::thread>	threads;
+
+	for( int index = 0; index < kWorkers; index++ )
+		threads.emplace_back( [&loop]{ loop.Run(); } );
+	for( std::thread &thread : threads )
+		thread.join();
+}
+
+	static
+	void
+MeasureChannel(
+	long	perProducer )
+{
+	std::vector<Item>	items( (size_t) (kPairs * perProducer) );
+	long				total = kPairs * perProducer;
+
+	for( int threaded = 0; threaded < 2; threaded++ ) {
+		ElementLoop			loop;
+		ElementThreadLoop	threadLoop;
+		ElementExecutor		&executor = threaded ? (ElementExecutor&) threadLoop : (ElementExecutor&) loop;
+		AsyncElementChannel	channel( kCapacity );
+		long				allocations;
+		double				start;
+
+		gGot = 0;
+		for( int index = 0; index < kPairs; index++ ) {
+			SpawnElementTask( Consumer( channel, total, threaded ? &threadLoop : NULL ), executor );
+			SpawnElementTask( Producer( channel, &items[ (size_t) (index * perProducer) ], perProducer ), executor );
+		}
+		allocations = gAllocations;
+		start = BenchNow();
+		if( threaded )
+			RunThreads( threadLoop );
+		else
+			loop.Run();
+		Report( "channel", threaded ? "thread loop" : "loop", total, BenchNow() - start,
+			gAllocations - allocations );
+	}
+
+	//	The same handoff between plain threads.
+	{
+		CondQueue					queue;
+		std::vector<std::thread>	threads;
+		long						allocations = gAllocations;
+		double						start = BenchNow();
+
+		NewElementList( &queue.list );
+		queue.count = 0;
+		queue.closed = false;
+		for( int index = 0; index < kPairs; index++ ) {
+			threads.emplace_back( [&queue]{
+				std::unique_lock<std::mutex>	guard( queue.lock );
+				void							*item;
+
+				for(;;) {
+					queue.notEmpty.wait( guard, [&queue]{ return( queue.count || queue.closed ); } );
+					GrabFirstElement( &item, &queue.list );
+					if( !item )
+						break;
+					queue.count--;
+					queue.notFull.notify_one();
+				}
+			} );
+			threads.emplace_back( [&queue, &items, index, perProducer]{
+				for( long at = 0; at < perProducer; at++ ) {
+					std::unique_lock<std::mutex>	guard( queue.lock );
+
+					queue.notFull.wait( guard, [&queue]{ return( queue.count < kCapacity ); } );
+					PutLastElement( &items[ (size_t) (index * perProducer + at) ], &queue.list );
+					queue.count++;
+					queue.notEmpty.notify_one();
+				}
+			} );
+		}
+		for( int index = 1; index < 2 * kPairs; index += 2 )
+			threads[ (size_t) index ].join();
+		{
+			std::lock_guard<std::mutex>	guard( queue.lock );
+
+			queue.closed = true;
+		}
+		queue.notEmpty.notify_all();
+		for( int index = 0; index < 2 * kPairs; index += 2 )
+			threads[ (size_t) index ].join();
+		Report( "channel", "condvar", total, BenchNow() - start, gAllocations - allocations );
+	}
+}
+
+	static
+	void
+MeasureMutex(
+	long	perWorker )
+{
+	long	total = kWorkers * perWorker;
+
+	for( int threaded = 0; threaded < 2; threaded++ ) {
+		ElementLoop			loop;
+		ElementThreadLoop	threadLoop;
+		ElementExecutor		&executor = threaded ? (ElementExecutor&) threadLoop : (ElementExecutor&) loop;
+		AsyncElementMutex	mutex;
+		long				allocations;
+		double				start;
+
+		gDone = 0;
+		gShared = 0;
+		for( int index = 0; index < kWorkers; index++ )
+			SpawnElementTask( Locker( mutex, perWorker, threaded ? &threadLoop : NULL ), executor );
+		allocations = gAllocations;
+		start = BenchNow();
+		if( threaded )
+			RunThreads( threadLoop );
+		else
+			loop.Run();
+		Report( "mutex", threaded ? "thread loop" : "loop", total, BenchNow() - start,
+			gAllocations - allocations );
+	}
+
+	{
+		std::mutex					mutex;
+		std::vector<std::thread>	threads;
+		long						allocations = gAllocations;
+		double						start = BenchNow();
+
+		gShared = 0;
+		for( int index = 0; index < kWorkers; index++ )
+			threads.emplace_back( [&mutex, perWorker]{
+				for( long at = 0; at < perWorker; at++ ) {
+					std::lock_guard<std::mutex>	guard( mutex );
+
+					gShared++;
+				}
+			} );
+		for( std::thread &thread : threads )
+			thread.join();
+		Report( "mutex", "std::mutex", total, BenchNow() - start, gAllocations - allocations );
+	}
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	double	scale = BenchScale( argc, argv );
+
+	printf( "%-8s %-14s %14s %12s\n", "test", "how", "ops/s", "allocs/op" );
+	MeasureChannel( (long) (1000000 * scale) );
+	MeasureMutex( (long) (1000000 * scale) );
+	return( 0 );
+}
@@ -0,0 +1,169 @@
+/****************************************************************************************
+	elementalhashbench.cpp
+
+	ElementHashTable against std::unordered_map, including latency while growing.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Indexes 4M objects by a 64-bit key, starting from an empty table so both
+	grow all the way. Inserts are timed one by one, so the percentiles show
+	the cost of growing: std::unordered_map rehashes everything at once, the
+	ElementHashTable migrates a few buckets per operation. Then times lookups
+	of random present keys and erases of every key, and prints operations per
+	second. The std::unordered_map maps key to object pointer, as an index
+	kept beside an ElementList would.
+
+	************************************************************************************/
+
+#include <unordered_map>
+#include <vector>
+
+#include "elementalbench.h"
+#include "elementalhash.h"
+
+struct	Object	{
+	Element		chain;
+	uint64_t	key;
+};
+
+	static
+	size_t
+HashKey(
+	uint64_t	key )
+{
+	key ^= key >> 33;
+	key *= UINT64_C( 0xff51afd7ed558ccd );
+	key ^= key >> 33;
+	return( (size_t) key );
+}
+
+	static
+	size_t
+HashObject(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	return( HashKey( ((Object*) element)->key ) );
+}
+
+	static
+	bool
+MatchObject(
+	void		*element,
+	const void	*key,
+	void		*refCon )
+{
+	(void) refCon;
+	return( ((Object*) element)->key == *(const uint64_t*) key );
+}
+
+struct	KeyHash	{
+	size_t	operator()( uint64_t key ) const { return( HashKey( key ) ); }
+};
+
+	static
+	void
+Report(
+	const char				*how,
+	std::vector<uint64_t>	&inserts,
+	double					insertSeconds,
+	double					findSeconds,
+	double					eraseSeconds )
+{
+	double		count = (double) inserts.size();
+	uint64_t	p99 = BenchPercentile( inserts.data(), inserts.size(), 99 );
+	uint64_t	p9999 = BenchPercentile( inserts.data(), inserts.size(), 99.99 );
+
+	//	Sorted now, so the worst insert is last.
+	printf( "%-14s %12.0f %10llu %10llu %10llu %12.0f %12.0f\n", how, count / insertSeconds,
+		(unsigned long long) p99, (unsigned long long) p9999, (unsigned long long) inserts.back(),
+		count / findSeconds, count / eraseSeconds );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t					count = (size_t) (4000000 * BenchScale( argc, argv ));
+	std::vector<Object>		objects( count );
+	std::vector<uint64_t>	order( count );
+	std::vector<uint64_t>	inserts( count );
+	uint64_t				random = 1;
+	uint64_t				sum = 0;
+	double					insertSeconds;
+	double					findSeconds;
+	double					eraseSeconds;
+	double					start;
+
+	for( size_t index = 0; index < count; index++ ) {
+		objects[ index ].key = BenchRandom( &random );
+		order[ index ] = BenchRandom( &random ) % count;
+	}
+
+	printf( "%-14s %12s %10s %10s %10s %12s %12s\n", "table", "inserts/s", "p99 ns",
+		"p99.99 ns", "max ns", "finds/s", "erases/s" );
+
+	{
+		ElementHashTable	table;
+
+		NewElementHashTableType( &table, 1, Object, chain, HashObject, MatchObject, NULL );
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ ) {
+			uint64_t	before = BenchNanoseconds();
+
+			PutHashElement( &objects[ index ], &table );
+			inserts[ index ] = BenchNanoseconds() - before;
+		}
+		insertSeconds = BenchNow() - start;
+
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ ) {
+			Object		*object;
+			uint64_t	key = objects[ order[ index ] ].key;
+
+			FindHashElementType( &object, &table, HashKey( key ), &key );
+			sum += (uintptr_t) object;
+		}
+		findSeconds = BenchNow() - start;
+
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ )
+			RemoveHashElement( &objects[ index ], &table );
+		eraseSeconds = BenchNow() - start;
+		DeleteElementHashTable( &table );
+		Report( "ElementHash", inserts, insertSeconds, findSeconds, eraseSeconds );
+	}
+
+	{
+		std::unordered_map<uint64_t, Object*, KeyHash>	map;
+
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ ) {
+			uint64_t	before = BenchNanoseconds();
+
+			map.emplace( objects[ index ].key, &objects[ index ] );
+			inserts[ index ] = BenchNanoseconds() - before;
+		}
+		insertSeconds = BenchNow() - start;
+
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ ) {
+			auto	found = map.find( objects[ order[ index ] ].key );
+
+			sum += (uintptr_t) found->second;
+		}
+		findSeconds = BenchNow() - start;
+
+		start = BenchNow();
+		for( size_t index = 0; index < count; index++ )
+			map.erase( objects[ index ].key );
+		eraseSeconds = BenchNow() - start;
+		Report( "unordered_map", inserts, insertSeconds, findSeconds, eraseSeconds );
+	}
+
+	//	Keeps the finds from being optimized away.
+	return( sum == 1 );
+}
@@ -0,0 +1,184 @@
+/****************************************************************************************
+	elementalheapbench.cpp
+
+	Dijkstra with an ElementHeap against std::priority_queue with lazy deletion.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Shortest paths from one vertex of a random directed graph of 1M vertices
+	with out-degree 4 and then 16, edge weights 1 to 1000. The ElementHeap
+	holds each vertex once, through a hook in the vertex, and decreases its
+	key in place. The std::priority_queue can't, so every improvement pushes
+	another (distance, vertex) pair and pops of outdated pairs are skipped.
+	Prints the time per run, the decreases (or extra pushes) it made, and
+	the most entries the queue held.
+
+	************************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "elementalbench.h"
+#include "elementalheap.h"
+
+struct	Vertex	{
+	HeapElement	hook;
+	uint64_t	distance;
+	bool		done;
+};
+
+struct	Graph	{
+	std::vector<uint32_t>	starts;		//	Of each vertex's edges, and one past the last.
+	std::vector<uint32_t>	targets;
+	std::vector<uint32_t>	weights;
+};
+
+	static
+	bool
+VertexBefore(
+	void	*a,
+	void	*b,
+	void	*refCon )
+{
+	(void) refCon;
+	return( ((Vertex*) a)->distance < ((Vertex*) b)->distance );
+}
+
+	static
+	uint64_t
+RunElementHeap(
+	const Graph				&graph,
+	std::vector<Vertex>		&vertices,
+	size_t					*decreases,
+	size_t					*peak )
+{
+	ElementHeap	heap;
+	Vertex		*vertex;
+	uint64_t	sum = 0;
+
+	for( Vertex &each : vertices ) {
+		each.hook = HeapElement();
+		each.distance = UINT64_MAX;
+		each.done = false;
+	}
+	*decreases = *peak = 0;
+	NewElementHeap( &heap, VertexBefore, NULL );
+	vertices[ 0 ].distance = 0;
+	PutHeapElement( &vertices[ 0 ], &heap );
+
+	for( GrabFirstHeapElement( (void**) &vertex, &heap ); vertex; GrabFirstHeapElement( (void**) &vertex, &heap ) ) {
+		size_t	index = (size_t) (vertex - vertices.data());
+
+		vertex->done = true;
+		sum += vertex->distance;
+		for( uint32_t edge = graph.starts[ index ]; edge < graph.starts[ index + 1 ]; edge++ ) {
+			Vertex		*target = &vertices[ graph.targets[ edge ] ];
+			uint64_t	distance = vertex->distance + graph.weights[ edge ];
+
+			if( target->done || distance >= target->distance )
+				continue;
+			if( target->distance == UINT64_MAX ) {
+				target->distance = distance;
+				PutHeapElement( target, &heap );
+				if( CountHeapElements( &heap ) > *peak )
+					*peak = CountHeapElements( &heap );
+			} else {
+				target->distance = distance;
+				DecreaseHeapElement( target, &heap );
+				(*decreases)++;
+			}
+		}
+	}
+	DeleteElementHeap( &heap );
+	return( sum );
+}
+
+	static
+	uint64_t
+RunPriorityQueue(
+	const Graph				&graph,
+	std::vector<uint64_t>	&distances,
+	size_t					*pushes,
+	size_t					*peak )
+{
+	typedef	std::pair<uint64_t, uint32_t>	Entry;
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>	queue;
+	uint64_t	sum = 0;
+
+	std::fill( distances.begin(), distances.end(), UINT64_MAX );
+	*pushes = *peak = 0;
+	distances[ 0 ] = 0;
+	queue.push( Entry( 0, 0 ) );
+
+	while( !queue.empty() ) {
+		Entry	entry = queue.top();
+
+		queue.pop();
+		//	Lazy deletion: a later, smaller push superseded this entry.
+		if( entry.first != distances[ entry.second ] )
+			continue;
+		sum += entry.first;
+		for( uint32_t edge = graph.starts[ entry.second ]; edge < graph.starts[ entry.second + 1 ]; edge++ ) {
+			uint32_t	target = graph.targets[ edge ];
+			uint64_t	distance = entry.first + graph.weights[ edge ];
+
+			if( distance >= distances[ target ] )
+				continue;
+			if( distances[ target ] != UINT64_MAX )
+				(*pushes)++;
+			distances[ target ] = distance;
+			queue.push( Entry( distance, target ) );
+			if( queue.size() > *peak )
+				*peak = queue.size();
+		}
+	}
+	return( sum );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t		count = (size_t) (1000000 * BenchScale( argc, argv ));
+	uint64_t	random = 1;
+
+	printf( "%-7s %-15s %10s %12s %10s\n", "degree", "queue", "ms", "decreases", "peak" );
+	for( size_t degree : { 4, 16 } ) {
+		Graph					graph;
+		std::vector<Vertex>		vertices( count );
+		std::vector<uint64_t>	distances( count );
+		size_t					decreases;
+		size_t					peak;
+		uint64_t				heapSum;
+		uint64_t				queueSum;
+		double					start;
+
+		for( size_t index = 0; index < count; index++ ) {
+			graph.starts.push_back( (uint32_t) graph.targets.size() );
+			for( size_t edge = 0; edge < degree; edge++ ) {
+				graph.targets.push_back( (uint32_t) (BenchRandom( &random ) % count) );
+				graph.weights.push_back( (uint32_t) (1 + BenchRandom( &random ) % 1000) );
+			}
+		}
+		graph.starts.push_back( (uint32_t) graph.targets.size() );
+
+		start = BenchNow();
+		heapSum = RunElementHeap( graph, vertices, &decreases, &peak );
+		printf( "%-7zu %-15s %10.1f %12zu %10zu\n", degree, "ElementHeap", (BenchNow() - start) * 1e3, decreases, peak );
+
+		start = BenchNow();
+		queueSum = RunPriorityQueue( graph, distances, &decreases, &peak );
+		printf( "%-7zu %-15s %10.1f %12zu %10zu\n", degree, "priority_queue", (BenchNow() - start) * 1e3, decreases, peak );
+
+		if( heapSum != queueSum ) {
+			fprintf( stderr, "distances differ\n" );
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
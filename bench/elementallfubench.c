@@ -0,0 +1,166 @@
+/****************************************************************************************
+	elementallfubench.c
+
+	Hit ratio and throughput of an ElementLFU cache against an LRU one, on
+	skewed traces.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Requests draw from 1M keys with Zipf skew 0.8, 1.0 and 1.2, and then from
+	a trace whose popular keys move halfway through, where plain LFU clings
+	to the old favourites. Each cache holds 1% of the keys and is indexed by
+	an array, so the cost is the policy's own. Prints hit ratio and requests
+	per second for LRU (an ElementList, most recent first), LFU, and LFU aged
+	every 100k touches.
+
+	************************************************************************************/
+
+#include <math.h>
+
+#include "elementalbench.h"
+#include "elementallfu.h"
+
+#define	kKeys		1000000
+#define	kCapacity	(kKeys / 100)
+
+typedef	struct	Entry	Entry;
+
+struct	Entry	{
+	Element	element;
+	bool	cached;
+};
+
+static	Entry	gEntries[ kKeys ];
+static	double	gCDF[ kKeys ];
+
+	static
+	void
+MakeZipf(
+	double	skew )
+{
+	double	sum = 0;
+	size_t	index;
+
+	for( index = 0; index < kKeys; index++ )
+		gCDF[ index ] = sum += 1.0 / pow( (double) (index + 1), skew );
+	for( index = 0; index < kKeys; index++ )
+		gCDF[ index ] /= sum;
+}
+
+	static
+	void
+MakeTrace(
+	uint32_t	*trace,
+	size_t		count,
+	bool		shifting )
+{
+	uint64_t	random = 7;
+	size_t		index;
+
+	for( index = 0; index < count; index++ ) {
+		double	draw = (double) (BenchRandom( &random ) >> 11) * 0x1.0p-53;
+		size_t	low = 0;
+		size_t	high = kKeys - 1;
+
+		while( low < high ) {
+			size_t	middle = (low + high) / 2;
+
+			if( gCDF[ middle ] < draw )
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		//	Halfway through a shifting trace, a different set of keys is popular.
+		if( shifting && index >= count / 2 )
+			low = (low + kKeys / 2) % kKeys;
+		//	Spread the ranks over the key space.
+		trace[ index ] = (uint32_t) ((low * 2654435761u) % kKeys);
+	}
+}
+
+	static
+	void
+Run(
+	const char		*name,
+	const uint32_t	*trace,
+	size_t			count,
+	int				policy )
+{
+	ElementLFU	lfu;
+	ElementList	lru;
+	size_t		cached = 0;
+	size_t		hits = 0;
+	double		start;
+	size_t		index;
+	Entry		*entry;
+
+	memset( gEntries, 0, sizeof( gEntries ) );
+	NewElementList( &lru );
+	NewElementLFUType( &lfu, Entry, element, policy == 2 ? 100000 : 0 );
+
+	start = BenchNow();
+	for( index = 0; index < count; index++ ) {
+		entry = &gEntries[ trace[ index ] ];
+		if( entry->cached ) {
+			hits++;
+			if( policy == 0 ) {
+				RemoveElement( entry, &lru );
+				PutFirstElement( entry, &lru );
+			} else
+				TouchLFUElement( entry, &lfu );
+			continue;
+		}
+		if( cached == kCapacity ) {
+			Entry	*victim;
+
+			if( policy == 0 )
+				GrabLastElement( (void**) &victim, &lru );
+			else
+				EvictLFUElementType( &victim, &lfu );
+			victim->cached = false;
+		} else
+			cached++;
+		entry->cached = true;
+		if( policy == 0 )
+			PutFirstElement( entry, &lru );
+		else
+			PutLFUElement( entry, &lfu );
+	}
+
+	printf( "%-10s %-8s %8.4f %14.0f\n", name, policy == 0 ? "lru" : policy == 1 ? "lfu" : "lfu+age",
+		(double) hits / (double) count, (double) count / (BenchNow() - start) );
+
+	while( GrabFirstElement( (void**) &entry, &lru ), entry )
+		;
+	while( EvictLFUElementType( &entry, &lfu ), entry )
+		;
+	DeleteElementLFU( &lfu );
+	DeleteElementList( &lru );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const double	skews[] = { 0.8, 1.0, 1.2 };
+	size_t			count = (size_t) (10000000 * BenchScale( argc, argv ));
+	uint32_t		*trace = (uint32_t*) malloc( count * sizeof( uint32_t ) );
+	char			name[ 32 ];
+	size_t			which;
+	int				policy;
+
+	printf( "%-10s %-8s %8s %14s\n", "trace", "policy", "hits", "requests/s" );
+	for( which = 0; which < 4; which++ ) {
+		double	skew = which < 3 ? skews[ which ] : 1.0;
+
+		MakeZipf( skew );
+		MakeTrace( trace, count, which == 3 );
+		snprintf( name, sizeof( name ), which < 3 ? "zipf %.1f" : "shifting", skew );
+		for( policy = 0; policy < 3; policy++ )
+			Run( name, trace, count, policy );
+	}
+	free( trace );
+	return( 0 );
+}
@@ -0,0 +1,160 @@
+/****************************************************************************************
+	elementalparkbench.c
+
+	A one-word lock on the parking lot against pthread_mutex_t.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The lock is the header's example, whose unlock hands ownership straight
+	to the thread parked longest: fair, but every contended handoff is a
+	context switch. A barging variant releases the word and lets the woken
+	thread race for it, as pthread_mutex_t does. 1, 2, 4 and 8 threads take
+	each lock in turn around a short critical section. Prints millions of
+	acquisitions per second.
+
+	************************************************************************************/
+
+#include <pthread.h>
+
+#include "elementalbench.h"
+#include "elementalpark.h"
+
+#define	kThreadsMax	8
+
+typedef	struct	Run	Run;
+
+struct	Run	{
+	int				kind;		//	0 handoff, 1 barging, 2 pthread_mutex_t.
+	size_t			locks;
+	unsigned		word;		//	Bit 0 locked, bit 1 someone parked.
+	pthread_mutex_t	mutex;
+	uint64_t		counter;
+};
+
+	static
+	bool
+StillContended(
+	const void	*address,
+	void		*refCon )
+{
+	(void) refCon;
+	return( __atomic_load_n( (unsigned*) address, __ATOMIC_RELAXED ) == 3 );
+}
+
+	static
+	intptr_t
+HandOver(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon )
+{
+	(void) refCon;
+	__atomic_store_n( (unsigned*) address, unparked ? (moreParked ? 3u : 1u) : 0u, __ATOMIC_RELEASE );
+	return( unparked );
+}
+
+	static
+	intptr_t
+Release(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon )
+{
+	(void) unparked;
+	(void) refCon;
+	__atomic_store_n( (unsigned*) address, moreParked ? 2u : 0u, __ATOMIC_RELEASE );
+	return( 0 );
+}
+
+	static
+	void
+LockWord(
+	unsigned	*word )
+{
+	for( ;; ) {
+		unsigned	seen = __atomic_load_n( word, __ATOMIC_RELAXED );
+		intptr_t	token = 0;
+
+		if( !(seen & 1) ) {
+			if( __atomic_compare_exchange_n( word, &seen, seen | 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+				return;
+			continue;
+		}
+		if( !(seen & 2) && !__atomic_compare_exchange_n( word, &seen, 3, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			continue;
+		if( ParkAddress( word, StillContended, NULL, NULL, &token ) && token == 1 )
+			return;
+	}
+}
+
+	static
+	void
+UnlockWord(
+	unsigned	*word,
+	bool		handoff )
+{
+	unsigned	locked = 1;
+
+	if( !__atomic_compare_exchange_n( word, &locked, 0, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
+		UnparkOneAddress( word, handoff ? HandOver : Release, NULL );
+}
+
+	static
+	void*
+Lock(
+	void	*refCon )
+{
+	Run		*run = (Run*) refCon;
+	size_t	index;
+
+	for( index = 0; index < run->locks; index++ ) {
+		if( run->kind == 2 ) {
+			pthread_mutex_lock( &run->mutex );
+			run->counter++;
+			pthread_mutex_unlock( &run->mutex );
+		} else {
+			LockWord( &run->word );
+			run->counter++;
+			UnlockWord( &run->word, run->kind == 0 );
+		}
+	}
+	return( NULL );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const char	*names[] = { "handoff", "barging", "pthread" };
+	size_t		locks = (size_t) (2000000 * BenchScale( argc, argv )) + 1;
+	size_t		threadCount;
+
+	printf( "%-8s %12s %12s %12s\n", "threads", "handoff M/s", "barging M/s", "pthread M/s" );
+	for( threadCount = 1; threadCount <= kThreadsMax; threadCount *= 2 ) {
+		double	rates[ 3 ];
+		int		kind;
+
+		for( kind = 0; kind < 3; kind++ ) {
+			Run			run = { kind, locks / threadCount, 0, PTHREAD_MUTEX_INITIALIZER, 0 };
+			pthread_t	threads[ kThreadsMax ];
+			double		start = BenchNow();
+			size_t		index;
+
+			for( index = 0; index < threadCount; index++ )
+				pthread_create( &threads[ index ], NULL, Lock, &run );
+			for( index = 0; index < threadCount; index++ )
+				pthread_join( threads[ index ], NULL );
+			if( run.counter != run.locks * threadCount ) {
+				fprintf( stderr, "%s lost updates\n", names[ kind ] );
+				return( 1 );
+			}
+			rates[ kind ] = (double) run.counter / (BenchNow() - start) / 1e6;
+		}
+		printf( "%-8zu %12.2f %12.2f %12.2f\n", threadCount, rates[ 0 ], rates[ 1 ], rates[ 2 ] );
+	}
+	return( 0 );
+}
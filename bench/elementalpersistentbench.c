@@ -0,0 +1,153 @@
+/****************************************************************************************
+	elementalpersistentbench.c
+
+	PersistentElementList throughput by fsync batch, and recovery time.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A work queue of 16-byte items, about 1000 deep, takes alternating puts at
+	the tail and grabs from the head with a sync every 1, 16, 256 and 4096
+	operations. Prints operations and syncs per second.
+
+	Then builds a 10M-element list (scaled), closes it, and times reopening
+	it. Next a child updates a tenth of the elements, syncs them, and dies
+	without closing, and the reopening that replays its log is timed too.
+	The files go in the working directory, so its disk is the one measured.
+
+	************************************************************************************/
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "elementalbench.h"
+#include "elementalpersistent.h"
+
+#define	kPath	"elementalpersistentbench.dat"
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	uint64_t	key;
+	uint64_t	value;
+};
+
+	static
+	void
+RemoveFiles( void )
+{
+	unlink( kPath );
+	unlink( kPath ".log" );
+}
+
+	static
+	void
+MeasureBatch(
+	size_t	batch,
+	size_t	count )
+{
+	PersistentElementList	list;
+	PersistentOffset		element;
+	Item					item = { 0, 0 };
+	double					start;
+	double					seconds;
+	size_t					index;
+
+	RemoveFiles();
+	if( !OpenPersistentElementList( &list, kPath, sizeof( Item ), 2048, batch ) )
+		abort();
+	for( index = 0; index < 1000; index++, item.key++ )
+		PutLastPersistentElement( &element, &item, &list );
+	SyncPersistentElementList( &list );
+
+	start = BenchNow();
+	for( index = 0; index < count; index++ ) {
+		if( index & 1 )
+			GrabFirstPersistentElement( &item, &list );
+		else {
+			item.key++;
+			PutLastPersistentElement( &element, &item, &list );
+		}
+	}
+	SyncPersistentElementList( &list );
+	seconds = BenchNow() - start;
+
+	printf( "%8zu %14.0f %12.0f\n", batch, (double) count / seconds, (double) count / batch / seconds );
+	ClosePersistentElementList( &list );
+}
+
+	static
+	void
+MeasureRecovery(
+	size_t	count )
+{
+	PersistentElementList	list;
+	PersistentOffset		element;
+	Item					item = { 0, 0 };
+	struct stat				status;
+	double					start;
+	double					clean;
+	double					replayed;
+	pid_t					child;
+	int						result;
+	size_t					index;
+
+	RemoveFiles();
+	if( !OpenPersistentElementList( &list, kPath, sizeof( Item ), count, 4096 ) )
+		abort();
+	for( index = 0; index < count; index++, item.key++ )
+		PutLastPersistentElement( &element, &item, &list );
+	ClosePersistentElementList( &list );
+
+	start = BenchNow();
+	if( !OpenPersistentElementList( &list, kPath, sizeof( Item ), count, 4096 ) )
+		abort();
+	clean = BenchNow() - start;
+	ClosePersistentElementList( &list );
+
+	//	Leave a log tail behind, as a crash would.
+	child = fork();
+	if( child == 0 ) {
+		if( !OpenPersistentElementList( &list, kPath, sizeof( Item ), count, 4096 ) )
+			_exit( 1 );
+		for( FirstPersistentElement( &element, &list ), index = 0; element; NextPersistentElement( element, &element, &list ), index++ )
+			if( index % 10 == 0 ) {
+				item.key = index;
+				item.value = 1;
+				UpdatePersistentElement( element, &item, &list );
+			}
+		SyncPersistentElementList( &list );
+		_exit( 0 );
+	}
+	if( waitpid( child, &result, 0 ) != child || !WIFEXITED( result ) || WEXITSTATUS( result ) != 0 )
+		abort();
+	stat( kPath ".log", &status );
+
+	start = BenchNow();
+	if( !OpenPersistentElementList( &list, kPath, sizeof( Item ), count, 4096 ) )
+		abort();
+	replayed = BenchNow() - start;
+	if( CountPersistentElements( &list ) != count )
+		abort();
+	ClosePersistentElementList( &list );
+
+	printf( "%zu elements: open %.3f ms, open replaying %.1f MB of log %.3f ms\n", count,
+		clean * 1e3, (double) status.st_size / (1024 * 1024), replayed * 1e3 );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	double	scale = BenchScale( argc, argv );
+	size_t	batches[] = { 1, 16, 256, 4096 };
+	size_t	which;
+
+	printf( "%8s %14s %12s\n", "batch", "ops/s", "syncs/s" );
+	for( which = 0; which < sizeof( batches ) / sizeof( batches[ 0 ] ); which++ )
+		MeasureBatch( batches[ which ], (size_t) (200000 * scale) );
+	MeasureRecovery( (size_t) (10000000 * scale) );
+	RemoveFiles();
+	return( 0 );
+}
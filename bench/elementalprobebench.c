@@ -0,0 +1,77 @@
+/****************************************************************************************
+	elementalprobebench.c
+
+	What the USDT probes cost with no tracer attached.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Times every probed operation, a put of each kind and a grab of each kind,
+	over a list of 1024 elements, and prints nanoseconds per operation and
+	branch misses per operation (-1 where counters are unavailable). The
+	build runs it twice where <sys/sdt.h> exists: as elementalprobebench,
+	against a library without probes, and as elementalprobebench-probed,
+	against one with them. The difference between the two runs is what the
+	semaphore checks cost.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elemental.h"
+
+#ifndef	BenchProbed
+	#define	BenchProbed	0
+#endif
+
+#define	kElements	1024
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t		rounds = (size_t) (20000 * BenchScale( argc, argv ));
+	Element		*elements = (Element*) calloc( kElements, sizeof( Element ) );
+	int			counter = OpenBenchCounter( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+	ElementList	list;
+	size_t		operations = 0;
+	size_t		round;
+	double		start, seconds;
+	long long	misses;
+
+	NewElementList( &list );
+	StartBenchCounter( counter );
+	start = BenchNow();
+	for( round = 0; round < rounds; round++ ) {
+		void	*element;
+		int		index;
+
+		//	Each put kind, a quarter of the elements apiece...
+		for( index = 0; index < kElements; index += 4 ) {
+			PutFirstElement( &elements[ index ], &list );
+			PutLastElement( &elements[ index + 1 ], &list );
+			PutBeforeElement( &elements[ index + 2 ], &elements[ index + 1 ], &list );
+			PutAfterElement( &elements[ index + 3 ], &elements[ index ], &list );
+		}
+
+		//	...and each grab kind.
+		for( index = 0; index < kElements; index += 4 ) {
+			GrabFirstElement( &element, &list );
+			GrabNextElement( list.first, &element, &list );
+			GrabLastElement( &element, &list );
+			RemoveElement( list.last, &list );
+		}
+		operations += 2 * kElements;
+	}
+	seconds = BenchNow() - start;
+	misses = StopBenchCounter( counter );
+
+	printf( "%-8s %12s %20s\n", "probes", "ns/op", "branch misses/op" );
+	printf( "%-8s %12.2f %20.4f\n", BenchProbed ? "on" : "off", seconds * 1e9 / (double) operations,
+		misses < 0 ? -1.0 : (double) misses / (double) operations );
+	DeleteElementList( &list );
+	free( elements );
+	return( 0 );
+}
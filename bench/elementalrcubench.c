@@ -0,0 +1,191 @@
+/****************************************************************************************
+	elementalrcubench.c
+
+	Read scaling of an RCU list against a reader/writer-locked one.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Readers repeatedly walk a 64-entry routing-table-sized list while one
+	writer replaces an entry every millisecond. For each reader count from 1
+	up to twice the cores (at most 64), prints full traversals per second
+	with FirstElementRCU()/NextElementRCU() inside an epoch, and with
+	NextElement() under pthread_rwlock_rdlock().
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elementalrcu.h"
+
+#define	kEntries	64
+
+typedef	struct	Route	Route;
+
+struct	Route	{
+	Element		element;
+	unsigned	key;
+};
+
+static	ElementList			gList;
+static	ElementEpoch		gEpoch;
+static	pthread_rwlock_t	gLock = PTHREAD_RWLOCK_INITIALIZER;
+static	pthread_mutex_t		gWriterLock = PTHREAD_MUTEX_INITIALIZER;
+static	int					gUseRCU;
+static	int					gStop;
+
+typedef	struct	{
+	ElementReader	reader;
+	unsigned long	walks;
+	unsigned		sum;
+} ReaderState;
+
+	static
+	void*
+Reader(
+	void	*refCon )
+{
+	ReaderState	*state = (ReaderState*) refCon;
+	Route		*route;
+
+	while( !__atomic_load_n( &gStop, __ATOMIC_RELAXED ) ) {
+		if( gUseRCU ) {
+			EnterElementEpoch( &state->reader );
+			for( FirstElementRCU( (void**) &route, &gList ); route; NextElementRCU( route, (void**) &route ) )
+				state->sum += route->key;
+			ExitElementEpoch( &state->reader );
+		} else {
+			pthread_rwlock_rdlock( &gLock );
+			for( FirstElement( (void**) &route, &gList ); route; NextElement( route, (void**) &route ) )
+				state->sum += route->key;
+			pthread_rwlock_unlock( &gLock );
+		}
+		state->walks++;
+	}
+	return( NULL );
+}
+
+	static
+	void*
+Writer(
+	void	*refCon )
+{
+	struct timespec	pause = { 0, 1000000 };
+	unsigned		key = kEntries;
+	Route			*route;
+
+	(void) refCon;
+	while( !__atomic_load_n( &gStop, __ATOMIC_RELAXED ) ) {
+		nanosleep( &pause, NULL );
+		route = (Route*) calloc( 1, sizeof( Route ) );
+		route->key = key++;
+		if( gUseRCU ) {
+			pthread_mutex_lock( &gWriterLock );
+			PutLastElementRCU( route, &gList );
+			RemoveElementRCU( gList.first, &gList, &gEpoch );
+			pthread_mutex_unlock( &gWriterLock );
+		} else {
+			Route	*old;
+
+			pthread_rwlock_wrlock( &gLock );
+			PutLastElement( route, &gList );
+			GrabFirstElement( (void**) &old, &gList );
+			pthread_rwlock_unlock( &gLock );
+			free( old );
+		}
+	}
+	return( NULL );
+}
+
+	static
+	void
+FreeRoute(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	free( element );
+}
+
+	static
+	double
+Measure(
+	int		readers,
+	int		useRCU,
+	double	seconds )
+{
+	pthread_t	threads[ 64 ];
+	pthread_t	writer;
+	ReaderState	*states = (ReaderState*) calloc( (size_t) readers, sizeof( ReaderState ) );
+	struct timespec	pause;
+	unsigned long	walks = 0;
+	Route		*route;
+	int			index;
+
+	NewElementList( &gList );
+	NewElementEpoch( &gEpoch, FreeRoute, NULL, 0 );
+	for( index = 0; index < kEntries; index++ ) {
+		route = (Route*) calloc( 1, sizeof( Route ) );
+		route->key = (unsigned) index;
+		if( useRCU )
+			PutLastElementRCU( route, &gList );
+		else
+			PutLastElement( route, &gList );
+	}
+	gUseRCU = useRCU;
+	gStop = 0;
+
+	//	Readers register under the writer lock, as writer-side calls must.
+	for( index = 0; index < readers; index++ ) {
+		pthread_mutex_lock( &gWriterLock );
+		RegisterElementReader( &states[ index ].reader, &gEpoch );
+		pthread_mutex_unlock( &gWriterLock );
+		pthread_create( &threads[ index ], NULL, Reader, &states[ index ] );
+	}
+	pthread_create( &writer, NULL, Writer, NULL );
+
+	pause.tv_sec = (time_t) seconds;
+	pause.tv_nsec = (long) ((seconds - (double) pause.tv_sec) * 1e9);
+	nanosleep( &pause, NULL );
+	__atomic_store_n( &gStop, 1, __ATOMIC_RELAXED );
+
+	pthread_join( writer, NULL );
+	for( index = 0; index < readers; index++ ) {
+		pthread_join( threads[ index ], NULL );
+		walks += states[ index ].walks;
+		UnregisterElementReader( &states[ index ].reader );
+	}
+
+	if( useRCU ) {
+		while( gList.first )
+			RemoveElementRCU( gList.first, &gList, &gEpoch );
+	} else {
+		while( GrabFirstElement( (void**) &route, &gList ), route )
+			free( route );
+	}
+	DeleteElementEpoch( &gEpoch );
+	free( states );
+	return( (double) walks / seconds );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	double	seconds = 0.5 * BenchScale( argc, argv );
+	long	cores = sysconf( _SC_NPROCESSORS_ONLN );
+	int		most = (int) (cores * 2 < 64 ? cores * 2 : 64);
+	int		readers;
+
+	printf( "%-8s %16s %16s\n", "readers", "rcu walks/s", "rwlock walks/s" );
+	for( readers = 1; readers <= most; readers *= 2 ) {
+		double	rcu = Measure( readers, 1, seconds );
+		double	rwlock = Measure( readers, 0, seconds );
+
+		printf( "%-8d %16.0f %16.0f\n", readers, rcu, rwlock );
+	}
+	return( 0 );
+}
@@ -0,0 +1,245 @@
+/****************************************************************************************
+	elementalreactorbench.c
+
+	Loopback echo through an ElementReactor against a naive epoll loop.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A client thread keeps 64 TCP connections to 127.0.0.1 busy. Each round it
+	sends every connection 4 pipelined 64-byte requests, each a write() of
+	its own, and then reads all the echoes back. The server either runs an
+	ElementReactor, reading each ready connection dry and flushing its
+	replies in one write at the end of the pass, or a naive loop that calls
+	a callback per epoll event which reads once and writes straight back.
+	Prints requests per second, and round-trip latency percentiles from a
+	request's send until its echo has been read.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include "elementalbench.h"
+#include "elementalreactor.h"
+
+#define	kConnections	64
+#define	kDepth			4
+#define	kRequest		64
+#define	kBuffer			(kDepth * kRequest * 4)
+
+typedef	struct	Echo	Echo;
+
+struct	Echo	{
+	ElementConnection	connection;
+	char				out[ kBuffer ];
+	size_t				outLength;
+	size_t				outOffset;
+};
+
+static	ElementReactor	gReactor;
+static	Echo			gEchoes[ kConnections ];
+static	int				gListener;
+static	int				gOpen;
+static	int				gNaive;
+
+	static
+	void
+EchoProc(
+	ElementConnection	*connection,
+	unsigned			events,
+	void				*refCon )
+{
+	Echo	*echo = (Echo*) connection;
+	ssize_t	count = 1;
+
+	(void) refCon;
+	if( events & (elementalReadable | elementalHangup) ) {
+		while( echo->outLength < kBuffer
+				&& (count = read( connection->fd, echo->out + echo->outLength, kBuffer - echo->outLength )) > 0 )
+			echo->outLength += (size_t) count;
+		if( count == 0 || (count < 0 && errno != EAGAIN) ) {
+			RemoveReactorConnection( connection, &gReactor );
+			close( connection->fd );
+			if( --gOpen == 0 )
+				StopElementReactor( &gReactor );
+			return;
+		}
+		if( echo->outLength > echo->outOffset )
+			PendReactorWrite( connection, &gReactor );
+	}
+	if( events & elementalWritable ) {
+		while( echo->outOffset < echo->outLength ) {
+			count = write( connection->fd, echo->out + echo->outOffset, echo->outLength - echo->outOffset );
+			if( count < 0 ) {
+				PendReactorWrite( connection, &gReactor );
+				return;
+			}
+			echo->outOffset += (size_t) count;
+		}
+		echo->outOffset = echo->outLength = 0;
+	}
+}
+
+//	The naive loop's callback: one read, one write, per event.
+	static
+	bool
+NaiveEcho(
+	int	fd )
+{
+	char	buffer[ kBuffer ];
+	ssize_t	count = read( fd, buffer, sizeof( buffer ) );
+	ssize_t	written = 0;
+
+	if( count == 0 || (count < 0 && errno != EAGAIN) )
+		return( false );
+	while( written < count ) {
+		ssize_t	more = write( fd, buffer + written, (size_t) (count - written) );
+
+		if( more > 0 )
+			written += more;
+	}
+	return( true );
+}
+
+	static
+	void*
+Server(
+	void	*refCon )
+{
+	int		index;
+
+	(void) refCon;
+	gOpen = kConnections;
+	for( index = 0; index < kConnections; index++ ) {
+		int	fd = accept( gListener, NULL, NULL );
+		int	on = 1;
+
+		setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof( on ) );
+		fcntl( fd, F_SETFL, O_NONBLOCK );
+		gEchoes[ index ].outLength = gEchoes[ index ].outOffset = 0;
+		if( gNaive ) {
+			struct epoll_event	event;
+
+			event.events = EPOLLIN;
+			event.data.fd = fd;
+			epoll_ctl( gReactor.epollFD, EPOLL_CTL_ADD, fd, &event );
+		} else
+			AddReactorConnection( &gEchoes[ index ].connection, &gReactor, fd, EchoProc, NULL );
+	}
+
+	if( !gNaive ) {
+		RunElementReactor( &gReactor );
+		return( NULL );
+	}
+	while( gOpen ) {
+		int	count = epoll_wait( gReactor.epollFD, gReactor.events, elementalReactorBatch, -1 );
+
+		for( index = 0; index < count; index++ ) {
+			int	fd = gReactor.events[ index ].data.fd;
+
+			if( !NaiveEcho( fd ) ) {
+				epoll_ctl( gReactor.epollFD, EPOLL_CTL_DEL, fd, NULL );
+				close( fd );
+				gOpen--;
+			}
+		}
+	}
+	return( NULL );
+}
+
+	static
+	void
+Measure(
+	bool	naive,
+	size_t	rounds )
+{
+	struct sockaddr_in	address;
+	socklen_t			length = sizeof( address );
+	pthread_t			server;
+	int					clients[ kConnections ];
+	uint64_t			*latencies = (uint64_t*) malloc( rounds * kConnections * kDepth * sizeof( uint64_t ) );
+	size_t				samples = 0;
+	char				request[ kRequest ];
+	char				reply[ kDepth * kRequest ];
+	double				start;
+	size_t				round;
+	int					index;
+	int					on = 1;
+
+	memset( request, 'x', sizeof( request ) );
+	NewElementReactor( &gReactor, 0 );
+	gNaive = naive;
+
+	gListener = socket( AF_INET, SOCK_STREAM, 0 );
+	memset( &address, 0, sizeof( address ) );
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	bind( gListener, (struct sockaddr*) &address, sizeof( address ) );
+	listen( gListener, kConnections );
+	getsockname( gListener, (struct sockaddr*) &address, &length );
+	pthread_create( &server, NULL, Server, NULL );
+	for( index = 0; index < kConnections; index++ ) {
+		clients[ index ] = socket( AF_INET, SOCK_STREAM, 0 );
+		setsockopt( clients[ index ], IPPROTO_TCP, TCP_NODELAY, &on, sizeof( on ) );
+		connect( clients[ index ], (struct sockaddr*) &address, sizeof( address ) );
+	}
+
+	start = BenchNow();
+	for( round = 0; round < rounds; round++ ) {
+		uint64_t	sentAt[ kConnections ][ kDepth ];
+		int			depth;
+
+		for( index = 0; index < kConnections; index++ )
+			for( depth = 0; depth < kDepth; depth++ ) {
+				sentAt[ index ][ depth ] = BenchNanoseconds();
+				if( write( clients[ index ], request, sizeof( request ) ) != (ssize_t) sizeof( request ) )
+					abort();
+			}
+		for( index = 0; index < kConnections; index++ ) {
+			size_t	got = 0;
+
+			while( got < sizeof( reply ) ) {
+				ssize_t	count = read( clients[ index ], reply + got, sizeof( reply ) - got );
+				uint64_t	now = BenchNanoseconds();
+
+				if( count <= 0 )
+					abort();
+				//	Every request completed by this read is answered now.
+				for( depth = (int) (got / kRequest); depth < (int) ((got + (size_t) count) / kRequest); depth++ )
+					latencies[ samples++ ] = now - sentAt[ index ][ depth ];
+				got += (size_t) count;
+			}
+		}
+	}
+
+	printf( "%-8s %14.0f %10llu %10llu %10llu\n", naive ? "naive" : "reactor",
+		(double) samples / (BenchNow() - start),
+		(unsigned long long) BenchPercentile( latencies, samples, 50 ),
+		(unsigned long long) BenchPercentile( latencies, samples, 99 ),
+		(unsigned long long) BenchPercentile( latencies, samples, 99.9 ) );
+
+	for( index = 0; index < kConnections; index++ )
+		close( clients[ index ] );
+	pthread_join( server, NULL );
+	close( gListener );
+	DeleteElementReactor( &gReactor );
+	free( latencies );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t	rounds = (size_t) (20000 * BenchScale( argc, argv ));
+
+	printf( "%-8s %14s %10s %10s %10s\n", "server", "requests/s", "p50 ns", "p99 ns", "p99.9 ns" );
+	Measure( false, rounds );
+	Measure( true, rounds );
+	return( 0 );
+}
@@ -0,0 +1,134 @@
+/****************************************************************************************
+	elementalregistrybench.cpp
+
+	Startup cost of a large registry: static constructors, a linker-section
+	registry, and a list linked at compile time.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	10000 handlers are listed three ways. Each of the first set has its own
+	static object whose constructor puts it last, as our plugins did; the
+	second set is filed with RegisterElement() and stitched on first use;
+	the third is one constinit table, linked by the compiler. Prints the
+	microseconds each spent before main and on first use, and how long a
+	walk of each list takes, checking each holds every handler; then
+	what a later GetHandlersRegistry() costs.
+
+	************************************************************************************/
+
+#include <cstddef>
+
+#include "elemental.h"
+#include "elementalbench.h"
+
+#define	kHandlers	10000
+
+struct	Handler	{
+	Element	element;
+	int		id;
+};
+
+//	Expand M( N ) for N from 10000 through 19999.
+#define	Repeat10( M, P )	M( P##0 ) M( P##1 ) M( P##2 ) M( P##3 ) M( P##4 )	\
+							M( P##5 ) M( P##6 ) M( P##7 ) M( P##8 ) M( P##9 )
+#define	Repeat100( M, P )	Repeat10( M, P##0 ) Repeat10( M, P##1 ) Repeat10( M, P##2 )	\
+							Repeat10( M, P##3 ) Repeat10( M, P##4 ) Repeat10( M, P##5 )	\
+							Repeat10( M, P##6 ) Repeat10( M, P##7 ) Repeat10( M, P##8 )	\
+							Repeat10( M, P##9 )
+#define	Repeat1000( M, P )	Repeat100( M, P##0 ) Repeat100( M, P##1 ) Repeat100( M, P##2 )	\
+							Repeat100( M, P##3 ) Repeat100( M, P##4 ) Repeat100( M, P##5 )	\
+							Repeat100( M, P##6 ) Repeat100( M, P##7 ) Repeat100( M, P##8 )	\
+							Repeat100( M, P##9 )
+#define	Repeat10000( M )	Repeat1000( M, 10 ) Repeat1000( M, 11 ) Repeat1000( M, 12 )	\
+							Repeat1000( M, 13 ) Repeat1000( M, 14 ) Repeat1000( M, 15 )	\
+							Repeat1000( M, 16 ) Repeat1000( M, 17 ) Repeat1000( M, 18 )	\
+							Repeat1000( M, 19 )
+#define	HandlerIndex( N )	((N) - 10000)
+
+static	uint64_t	gStart;
+
+//	Before any constructor at the default priority.
+	__attribute__(( constructor( 101 ) ))
+	static
+	void
+StartClock( void )
+{
+	gStart = BenchNanoseconds();
+}
+
+//	Put last by static constructors.
+static	ElementList	gConstructed;
+static	Handler		gConstructedHandlers[ kHandlers ];
+
+struct	Registrar	{
+	explicit Registrar( int index ) {
+		gConstructedHandlers[ index ].id = index;
+		PutLastElement( &gConstructedHandlers[ index ], &gConstructed );
+	}
+};
+
+#define	Construct( N )	static Registrar elementalConcat( gRegistrar, N )( HandlerIndex( N ) );
+Repeat10000( Construct )
+
+//	Filed in a linker section.
+DefineElementRegistry( Handlers );
+DeclareElementRegistry( Handlers );
+
+#define	Register( N )	RegisterElement( Handlers, &gRegisteredHandlers[ HandlerIndex( N ) ].element );
+#define	RegisteredHandler( N )	{ Element(), HandlerIndex( N ) },
+static	constinit	Handler	gRegisteredHandlers[ kHandlers ] = { Repeat10000( RegisteredHandler ) };
+Repeat10000( Register )
+
+//	Linked at compile time.
+extern	ElementList	gTable;
+#define	TableHandler( N )	\
+	{ ElementInitializer( HandlerIndex( N ) + 1 < kHandlers ? &gTableHandlers[ HandlerIndex( N ) + 1 ].element : NULL,	\
+		HandlerIndex( N ) > 0 ? &gTableHandlers[ HandlerIndex( N ) - 1 ].element : NULL, &gTable ),	\
+		HandlerIndex( N ) },
+static	constinit	Handler	gTableHandlers[ kHandlers ] = { Repeat10000( TableHandler ) };
+constinit	ElementList		gTable = ElementListInitializer( &gTableHandlers[ 0 ].element,
+								&gTableHandlers[ kHandlers - 1 ].element );
+
+//	Microseconds to walk list, checking it holds every handler. A registry
+//	is in link order, which needn't be the order of registration.
+	static
+	double
+WalkHandlers(
+	ElementList	*list )
+{
+	uint64_t	start = BenchNanoseconds();
+	void		*element;
+	long		sum = 0;
+	int			count = 0;
+
+	for( FirstElement( &element, list ); element; NextElement( element, &element ) ) {
+		sum += ((Handler*) element)->id;
+		count++;
+	}
+	if( count != kHandlers || sum != (long) kHandlers * (kHandlers - 1) / 2 ) {
+		fprintf( stderr, "%d handlers, not %d\n", count, kHandlers );
+		exit( 1 );
+	}
+	return( (double) (BenchNanoseconds() - start) / 1e3 );
+}
+
+	int
+main( void )
+{
+	uint64_t	constructed = BenchNanoseconds() - gStart;
+	uint64_t	start = BenchNanoseconds();
+	ElementList	*registry = GetHandlersRegistry();
+	uint64_t	stitched = BenchNanoseconds() - start;
+
+	start = BenchNanoseconds();
+	registry = GetHandlersRegistry();
+	start = BenchNanoseconds() - start;
+
+	printf( "%-14s %14s %14s %14s\n", "", "pre-main us", "first use us", "walk us" );
+	printf( "%-14s %14.1f %14.1f %14.1f\n", "constructors", (double) constructed / 1e3, 0.0, WalkHandlers( &gConstructed ) );
+	printf( "%-14s %14.1f %14.1f %14.1f\n", "registry", 0.0, (double) stitched / 1e3, WalkHandlers( registry ) );
+	printf( "%-14s %14.1f %14.1f %14.1f\n", "compile time", 0.0, 0.0, WalkHandlers( &gTable ) );
+	printf( "later GetHandlersRegistry() %llu ns\n", (unsigned long long) start );
+	return( 0 );
+}
@@ -0,0 +1,156 @@
+/****************************************************************************************
+	elementalreplay.c
+
+	Replays recorded traces against each list variant.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Usage: elementalreplay TRACE...
+
+	Each TRACE is a file written by StartElementTrace() from a build with
+	elementalTrace. Every trace is replayed through ElementTraceCoreProc()
+	against this build's ElementLists, and through a proc that performs the
+	same steps on ElementRings. Prints operations per second, nanoseconds
+	per operation and hardware cache misses per operation, or "-" where the
+	kernel doesn't allow counting them.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "elementalring.h"
+#include "elementaltrace.h"
+
+typedef	struct	RingStandIn	RingStandIn;
+typedef	struct	Variant		Variant;
+
+//	Rings don't keep their elements' list field, so the stand-in does.
+struct	RingStandIn	{
+	Element		element;
+	ElementRing	*ring;
+};
+
+struct	Variant	{
+	const char			*name;
+	ElementTraceProc	proc;
+	size_t				listSize;
+	size_t				elementSize;
+};
+
+	static
+	void
+RingTraceProc(
+	int		op,
+	void	*list,
+	void	*element,
+	void	*anchor,
+	void	*refCon )
+{
+	ElementRing	*ring = (ElementRing*) list;
+	RingStandIn	*standIn = (RingStandIn*) element;
+	RingStandIn	*anchor_ = (RingStandIn*) anchor;
+	void		*grabbed;
+
+	(void) refCon;
+
+	if( op == elementTraceNewList ) {
+		NewElementRing( ring );
+		return;
+	}
+	if( op == elementTraceClear ) {
+		while( !IsRingEmpty( ring ) ) {
+			GrabFirstRingElement( &grabbed, ring );
+			((RingStandIn*) grabbed)->ring = NULL;
+		}
+		return;
+	}
+
+	//	The same leniency as ElementTraceCoreProc() toward a mid-run trace.
+	if( op <= elementTracePutAfter ) {
+		if( standIn->ring )
+			RemoveRingElement( standIn );
+		if( anchor_ && anchor_->ring != ring )
+			anchor_ = NULL;
+		standIn->ring = ring;
+	} else if( standIn->ring != ring )
+		return;
+	else
+		standIn->ring = NULL;
+
+	switch( op ) {
+		case elementTracePutFirst:
+			PutFirstRingElement( standIn, ring );
+			break;
+		case elementTracePutLast:
+			PutLastRingElement( standIn, ring );
+			break;
+		case elementTracePutBefore:
+			PutBeforeRingElement( standIn, anchor_, ring );
+			break;
+		case elementTracePutAfter:
+			PutAfterRingElement( standIn, anchor_, ring );
+			break;
+		case elementTraceSweep:
+			RemoveRingElement( standIn );
+			if( anchor ) {
+				PutLastRingElement( standIn, (ElementRing*) anchor );
+				standIn->ring = (ElementRing*) anchor;
+			}
+			break;
+		default:
+			RemoveRingElement( standIn );
+			break;
+	}
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const Variant	variants[] = {
+		{ "list", ElementTraceCoreProc, sizeof( ElementList ), sizeof( Element ) },
+		{ "ring", RingTraceProc, sizeof( ElementRing ), sizeof( RingStandIn ) } };
+	int				arg;
+	size_t			which;
+
+	if( argc < 2 ) {
+		fprintf( stderr, "usage: %s TRACE...\n", argv[ 0 ] );
+		return( 2 );
+	}
+
+	printf( "%-24s %-6s %10s %8s %12s %8s %12s\n", "trace", "list", "elements", "lists", "ops/s", "ns/op", "misses/op" );
+	for( arg = 1; arg < argc; arg++ )
+		for( which = 0; which < sizeof( variants ) / sizeof( variants[ 0 ] ); which++ ) {
+			const Variant		*variant = &variants[ which ];
+			ElementTraceStats	stats;
+			double				operations;
+			char				misses[ 16 ];
+			int					fd = open( argv[ arg ], O_RDONLY );
+
+			if( fd < 0 || !ReplayElementTrace( fd, variant->proc, variant->listSize, variant->elementSize, NULL, &stats ) ) {
+				fprintf( stderr, "%s: %s\n", argv[ arg ], strerror( errno ) );
+				return( 1 );
+			}
+			close( fd );
+
+			//	An empty trace reports zeros.
+			operations = (double) stats.operations;
+			if( stats.operations == 0 )
+				stats.nanoseconds = 0;
+			if( stats.cacheMisses == UINT64_MAX )
+				strcpy( misses, "-" );
+			else
+				snprintf( misses, sizeof( misses ), "%.3f", operations ? (double) stats.cacheMisses / operations : 0 );
+			printf( "%-24s %-6s %10zu %8zu %12.0f %8.1f %12s\n", argv[ arg ], variant->name,
+				stats.elements, stats.lists,
+				stats.nanoseconds ? operations * 1e9 / (double) stats.nanoseconds : 0,
+				operations ? (double) stats.nanoseconds / operations : 0, misses );
+		}
+	return( 0 );
+}
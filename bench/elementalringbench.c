@@ -0,0 +1,173 @@
+/****************************************************************************************
+	elementalringbench.c
+
+	Branch misses and throughput of ElementRing against ElementList.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A trace of mixed puts (first, last, before, after) and removals is
+	generated once over a pool of nodes, keeping about half of them linked,
+	then replayed against an ElementList and against an ElementRing. Both
+	replays share the same dispatch, so the difference in branch misses per
+	operation is the putters' and removers' own. Prints operations per second
+	and branch misses per operation (-1 where counters are unavailable).
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elementalring.h"
+
+#define	kNodes		4096
+
+typedef	enum	{
+	opPutFirst,
+	opPutLast,
+	opPutBefore,
+	opPutAfter,
+	opRemove
+} Op;
+
+typedef	struct	{
+	unsigned char	op;
+	unsigned		node;
+	unsigned		anchor;
+} Step;
+
+typedef	struct	{
+	Element	element;
+	long	payload;
+} Node;
+
+static	Node	gNodes[ kNodes ];
+
+	static
+	Step*
+MakeTrace(
+	size_t	count )
+{
+	Step		*trace = (Step*) malloc( count * sizeof( Step ) );
+	unsigned	*linked = (unsigned*) malloc( kNodes * sizeof( unsigned ) );
+	unsigned	*unlinked = (unsigned*) malloc( kNodes * sizeof( unsigned ) );
+	unsigned	linkedCount = 0;
+	unsigned	unlinkedCount = kNodes;
+	uint64_t	state = 0x9e3779b97f4a7c15ull;
+	size_t		index;
+
+	for( index = 0; index < kNodes; index++ )
+		unlinked[ index ] = (unsigned) index;
+	for( index = 0; index < count; index++ ) {
+		uint64_t	random = BenchRandom( &state );
+		int			put = linkedCount == 0 || (unlinkedCount > 0 && (random & 1));
+		Step		*step = &trace[ index ];
+		unsigned	slot;
+
+		random >>= 1;
+		if( put ) {
+			slot = (unsigned) (random % unlinkedCount);
+			step->node = unlinked[ slot ];
+			step->op = linkedCount ? (unsigned char) ((random >> 20) % 4) : opPutFirst;
+			step->anchor = linkedCount ? linked[ (random >> 24) % linkedCount ] : 0;
+			unlinked[ slot ] = unlinked[ --unlinkedCount ];
+			linked[ linkedCount++ ] = step->node;
+		} else {
+			slot = (unsigned) (random % linkedCount);
+			step->node = linked[ slot ];
+			step->op = opRemove;
+			linked[ slot ] = linked[ --linkedCount ];
+			unlinked[ unlinkedCount++ ] = step->node;
+		}
+	}
+	free( linked );
+	free( unlinked );
+	return( trace );
+}
+
+	static
+	void
+ReplayList(
+	const Step	*trace,
+	size_t		count )
+{
+	ElementList	list;
+	size_t		index;
+
+	NewElementList( &list );
+	for( index = 0; index < count; index++ ) {
+		Element	*node = &gNodes[ trace[ index ].node ].element;
+		Element	*anchor = &gNodes[ trace[ index ].anchor ].element;
+
+		switch( trace[ index ].op ) {
+			case opPutFirst:	PutFirstElement( node, &list );					break;
+			case opPutLast:		PutLastElement( node, &list );					break;
+			case opPutBefore:	PutBeforeElement( node, anchor, &list );		break;
+			case opPutAfter:	PutAfterElement( node, anchor, &list );			break;
+			case opRemove:		RemoveElement( node, &list );					break;
+		}
+	}
+	while( list.first )
+		RemoveElement( list.first, &list );
+	DeleteElementList( &list );
+}
+
+	static
+	void
+ReplayRing(
+	const Step	*trace,
+	size_t		count )
+{
+	ElementRing	ring;
+	size_t		index;
+	void		*element;
+
+	NewElementRing( &ring );
+	for( index = 0; index < count; index++ ) {
+		Element	*node = &gNodes[ trace[ index ].node ].element;
+		Element	*anchor = &gNodes[ trace[ index ].anchor ].element;
+
+		switch( trace[ index ].op ) {
+			case opPutFirst:	PutFirstRingElement( node, &ring );				break;
+			case opPutLast:		PutLastRingElement( node, &ring );				break;
+			case opPutBefore:	PutBeforeRingElement( node, anchor, &ring );	break;
+			case opPutAfter:	PutAfterRingElement( node, anchor, &ring );		break;
+			case opRemove:		RemoveRingElement( node );						break;
+		}
+	}
+	while( GrabFirstRingElement( &element, &ring ), element )
+		;
+	DeleteElementRing( &ring );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t		count = (size_t) (20000000 * BenchScale( argc, argv ));
+	Step		*trace = MakeTrace( count );
+	int			counter = OpenBenchCounter( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+	int			round;
+
+	printf( "%-6s %16s %20s\n", "layout", "ops/s", "branch misses/op" );
+	for( round = 0; round < 2; round++ ) {
+		double		start;
+		double		seconds;
+		long long	misses;
+		int			ring = round;
+
+		StartBenchCounter( counter );
+		start = BenchNow();
+		if( ring )
+			ReplayRing( trace, count );
+		else
+			ReplayList( trace, count );
+		seconds = BenchNow() - start;
+		misses = StopBenchCounter( counter );
+		printf( "%-6s %16.0f %20.3f\n", ring ? "ring" : "list", (double) count / seconds,
+			misses < 0 ? -1.0 : (double) misses / (double) count );
+	}
+	free( trace );
+	return( 0 );
+}
@@ -0,0 +1,126 @@
+/****************************************************************************************
+	elementalsearchbench.c
+
+	FindElementByKey()'s reordering policies on Zipf-skewed lookups.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	1000 keys sit in a list in an order unrelated to their popularity, and
+	are looked up with Zipf skew 0.8, 1.0 and 1.2. Prints, for each policy,
+	the average number of elements compared per lookup and millions of
+	lookups per second. Built with elementalSearchCounts, the count policy
+	keeps hit counts (and Element grows by a word); without, it transposes.
+
+	************************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "elemental.h"
+#include "elementalbench.h"
+
+#define	kKeys	1000
+
+typedef	struct	Entry	Entry;
+
+struct	Entry	{
+	Element	element;
+	int		key;
+};
+
+static	Entry	gEntries[ kKeys ];
+static	double	gCDF[ kKeys ];
+static	size_t	gCompares;
+
+	static
+	int
+CompareKey(
+	void		*element,
+	const void	*key )
+{
+	gCompares++;
+	return( ((Entry*) element)->key != *(const int*) key );
+}
+
+	static
+	void
+MakeTrace(
+	int		*trace,
+	size_t	count,
+	double	skew )
+{
+	uint64_t	random = 11;
+	double		sum = 0;
+	size_t		index;
+
+	for( index = 0; index < kKeys; index++ )
+		gCDF[ index ] = sum += 1.0 / pow( (double) (index + 1), skew );
+	for( index = 0; index < count; index++ ) {
+		double	draw = (double) (BenchRandom( &random ) >> 11) * 0x1.0p-53 * sum;
+		size_t	low = 0;
+		size_t	high = kKeys - 1;
+
+		while( low < high ) {
+			size_t	middle = (low + high) / 2;
+
+			if( gCDF[ middle ] < draw )
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		//	Spread the ranks over the list.
+		trace[ index ] = (int) ((low * 7919) % kKeys);
+	}
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const double	skews[] = { 0.8, 1.0, 1.2 };
+	const char		*names[] = { "static", "front", "transpose", "count" };
+	size_t			lookups = (size_t) (2000000 * BenchScale( argc, argv )) + 1;
+	int				*trace = (int*) malloc( lookups * sizeof( int ) );
+	size_t			which;
+
+	printf( "sizeof( Element ) %zu\n", sizeof( Element ) );
+	printf( "%-6s %-10s %12s %12s\n", "skew", "policy", "compares", "M/s" );
+	for( which = 0; which < sizeof( skews ) / sizeof( skews[ 0 ] ); which++ ) {
+		int	policy;
+
+		MakeTrace( trace, lookups, skews[ which ] );
+		for( policy = elementSearchStatic; policy <= elementSearchCount; policy++ ) {
+			ElementList	list;
+			double		start;
+			size_t		index;
+
+			NewElementList( &list );
+			for( index = 0; index < kKeys; index++ ) {
+				gEntries[ index ].key = (int) index;
+				PutLastElement( &gEntries[ index ], &list );
+			}
+
+			gCompares = 0;
+			start = BenchNow();
+			for( index = 0; index < lookups; index++ ) {
+				void	*found;
+
+				FindElementByKey( &found, &list, &trace[ index ], CompareKey, policy );
+				if( !found ) {
+					fprintf( stderr, "key %d lost\n", trace[ index ] );
+					return( 1 );
+				}
+			}
+			printf( "%-6.1f %-10s %12.1f %12.2f\n", skews[ which ], names[ policy ],
+				(double) gCompares / (double) lookups, (double) lookups / (BenchNow() - start) / 1e6 );
+
+			for( index = 0; index < kKeys; index++ )
+				RemoveElement( &gEntries[ index ], &list );
+			DeleteElementList( &list );
+		}
+	}
+	free( trace );
+	return( 0 );
+}
@@ -0,0 +1,144 @@
+/****************************************************************************************
+	elementalshardedbench.c
+
+	Free-list throughput of ShardedElementList against one locked ElementList.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Each thread allocates and frees objects from a shared free list: pops a
+	few, then pushes them back, as an allocator's fast path does. For 1 to 64
+	threads, prints pops and pushes per second with a ShardedElementList of
+	one shard per thread, and with a single ElementList behind a
+	pthread_mutex_t.
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elementalsharded.h"
+
+#define	kMostThreads	64
+#define	kPerThread		256
+#define	kHeld			8
+
+typedef	struct	Object	Object;
+
+struct	Object	{
+	Element	element;
+	char	payload[ 40 ];
+};
+
+typedef	struct	{
+	int				sharded;
+	unsigned long	operations;
+} Worker;
+
+static	ShardedElementList	gSharded;
+static	ElementShard		gShards[ kMostThreads ];
+static	ElementList			gList;
+static	pthread_mutex_t		gLock = PTHREAD_MUTEX_INITIALIZER;
+static	int					gStop;
+
+	static
+	void*
+Work(
+	void	*refCon )
+{
+	Worker		*worker = (Worker*) refCon;
+	unsigned	shard = AcquireElementShard( &gSharded );
+	Object		*held[ kHeld ];
+	int			count;
+
+	while( !__atomic_load_n( &gStop, __ATOMIC_RELAXED ) ) {
+		for( count = 0; count < kHeld; count++ ) {
+			if( worker->sharded )
+				PopShardElement( (void**) &held[ count ], &gSharded, shard );
+			else {
+				pthread_mutex_lock( &gLock );
+				GrabFirstElement( (void**) &held[ count ], &gList );
+				pthread_mutex_unlock( &gLock );
+			}
+			if( held[ count ] == NULL )
+				break;
+			held[ count ]->payload[ 0 ]++;
+		}
+		while( count ) {
+			Object	*object = held[ --count ];
+
+			if( worker->sharded )
+				PushShardElement( object, &gSharded, shard );
+			else {
+				pthread_mutex_lock( &gLock );
+				PutFirstElement( object, &gList );
+				pthread_mutex_unlock( &gLock );
+			}
+			worker->operations += 2;
+		}
+	}
+	return( NULL );
+}
+
+	static
+	double
+Measure(
+	int		threads,
+	int		sharded,
+	double	seconds )
+{
+	pthread_t		ids[ kMostThreads ];
+	Worker			workers[ kMostThreads ];
+	Object			*objects = (Object*) calloc( (size_t) threads * kPerThread, sizeof( Object ) );
+	struct timespec	pause;
+	unsigned long	operations = 0;
+	int				index;
+
+	NewShardedElementList( &gSharded, gShards, (unsigned) threads, 32 );
+	NewElementList( &gList );
+	for( index = 0; index < threads * kPerThread; index++ ) {
+		if( sharded )
+			PushShardElement( &objects[ index ], &gSharded, (unsigned) (index / kPerThread) );
+		else
+			PutFirstElement( &objects[ index ], &gList );
+	}
+	gStop = 0;
+	for( index = 0; index < threads; index++ ) {
+		workers[ index ].sharded = sharded;
+		workers[ index ].operations = 0;
+		pthread_create( &ids[ index ], NULL, Work, &workers[ index ] );
+	}
+
+	pause.tv_sec = (time_t) seconds;
+	pause.tv_nsec = (long) ((seconds - (double) pause.tv_sec) * 1e9);
+	nanosleep( &pause, NULL );
+	__atomic_store_n( &gStop, 1, __ATOMIC_RELAXED );
+	for( index = 0; index < threads; index++ ) {
+		pthread_join( ids[ index ], NULL );
+		operations += workers[ index ].operations;
+	}
+
+	DeleteShardedElementList( &gSharded );
+	DeleteElementList( &gList );
+	free( objects );
+	return( (double) operations / seconds );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	double	seconds = 0.5 * BenchScale( argc, argv );
+	int		threads;
+
+	printf( "%-8s %18s %18s\n", "threads", "sharded ops/s", "locked ops/s" );
+	for( threads = 1; threads <= kMostThreads; threads *= 2 ) {
+		double	sharded = Measure( threads, 1, seconds );
+		double	locked = Measure( threads, 0, seconds );
+
+		printf( "%-8d %18.0f %18.0f\n", threads, sharded, locked );
+	}
+	return( 0 );
+}
@@ -0,0 +1,179 @@
+/****************************************************************************************
+	elementalspillbench.c
+
+	A SpillQueue against an unbounded ElementList through 10x bursts.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A work queue of 512-byte items runs in cycles: a steady stretch where
+	each item put is matched by one grabbed, a burst of ten times the budget
+	put with nothing grabbed, and a drain back to where it started. The
+	SpillQueue holds at most 10000 items in memory, spilling the rest to the
+	current directory; the ElementList holds all of them. Prints items per
+	second through each, and the most item memory each had at once.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "elementalbench.h"
+#include "elementalspill.h"
+
+#define	kBudget		10000
+#define	kBatch		256
+#define	kBurst		(kBudget * 10)
+#define	kItemSize	512
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	Element		element;
+	uint64_t	sequence;
+	char		payload[ kItemSize - sizeof( Element ) - sizeof( uint64_t ) ];
+};
+
+static	size_t	gLive;
+static	size_t	gPeak;
+
+	static
+	Item*
+NewItem(
+	uint64_t	sequence )
+{
+	Item	*item = (Item*) malloc( sizeof( Item ) );
+
+	memset( item, 0, sizeof( Item ) );
+	item->sequence = sequence;
+	if( ++gLive > gPeak )
+		gPeak = gLive;
+	return( item );
+}
+
+	static
+	void
+FreeItem(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	free( element );
+	gLive--;
+}
+
+	static
+	size_t
+EncodeItem(
+	void	*element,
+	void	*buffer,
+	size_t	capacity,
+	void	*refCon )
+{
+	Item	*item = (Item*) element;
+	size_t	length = sizeof( Item ) - sizeof( Element );
+
+	(void) refCon;
+	if( length <= capacity )
+		memcpy( buffer, &item->sequence, length );
+	return( length );
+}
+
+	static
+	void*
+DecodeItem(
+	const void	*buffer,
+	size_t		length,
+	void		*refCon )
+{
+	Item	*item = NewItem( 0 );
+
+	(void) refCon;
+	memcpy( &item->sequence, buffer, length );
+	return( item );
+}
+
+//	Puts or grabs one item, checking the order.
+	static
+	void
+Step(
+	bool		spilling,
+	bool		putting,
+	void		*queue,
+	uint64_t	*put,
+	uint64_t	*grabbed )
+{
+	Item	*item;
+
+	if( putting ) {
+		item = NewItem( (*put)++ );
+		if( spilling ) {
+			if( !PutSpillElement( item, (SpillQueue*) queue ) ) {
+				perror( "PutSpillElement" );
+				exit( 1 );
+			}
+		} else
+			PutLastElement( item, (ElementList*) queue );
+		return;
+	}
+	if( spilling ) {
+		if( !GrabSpillElement( (void**) &item, (SpillQueue*) queue ) ) {
+			perror( "GrabSpillElement" );
+			exit( 1 );
+		}
+	} else
+		GrabFirstElement( (void**) &item, (ElementList*) queue );
+	if( !item || item->sequence != (*grabbed)++ ) {
+		fprintf( stderr, "out of order\n" );
+		exit( 1 );
+	}
+	FreeItem( item, NULL );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t	cycles = (size_t) (8 * BenchScale( argc, argv )) + 1;
+	int		spilling;
+
+	printf( "%-10s %14s %14s\n", "queue", "M items/s", "peak MB" );
+	for( spilling = 0; spilling < 2; spilling++ ) {
+		SpillQueue	spill;
+		ElementList	list;
+		void		*queue = spilling ? (void*) &spill : (void*) &list;
+		uint64_t	put = 0;
+		uint64_t	grabbed = 0;
+		double		start;
+		size_t		cycle;
+		size_t		index;
+
+		NewSpillQueue( &spill, ".", kBudget, kBatch, EncodeItem, DecodeItem, FreeItem, NULL );
+		NewElementList( &list );
+		gLive = gPeak = 0;
+
+		//	Start half a budget deep.
+		for( index = 0; index < kBudget / 2; index++ )
+			Step( spilling, true, queue, &put, &grabbed );
+
+		start = BenchNow();
+		for( cycle = 0; cycle < cycles; cycle++ ) {
+			for( index = 0; index < kBurst; index++ )
+				Step( spilling, index % 2 == 0, queue, &put, &grabbed );
+			for( index = 0; index < kBurst; index++ )
+				Step( spilling, true, queue, &put, &grabbed );
+			while( put - grabbed > kBudget / 2 )
+				Step( spilling, false, queue, &put, &grabbed );
+		}
+		printf( "%-10s %14.2f %14.1f\n", spilling ? "spill" : "list",
+			(double) (put + grabbed) / (BenchNow() - start) / 1e6,
+			(double) (gPeak * sizeof( Item )) / 1e6 );
+
+		while( put > grabbed )
+			Step( spilling, false, queue, &put, &grabbed );
+		DeleteSpillQueue( &spill );
+		DeleteElementList( &list );
+	}
+	return( 0 );
+}
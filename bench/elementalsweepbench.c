@@ -0,0 +1,113 @@
+/****************************************************************************************
+	elementalsweepbench.c
+
+	Garbage-collection passes at high removal ratios.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A list of a million objects, a given fraction of them garbage, is cleaned
+	three ways: a walk calling GrabNextElement() on each piece of garbage, as
+	our collector used to; one RemoveElementsIf() pass onto a sink; and
+	MarkElementDead() on each as it is found dead, then one
+	SweepElementList(). Prints nanoseconds per object in the list, for
+	removal ratios from a half to 99 in 100.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elemental.h"
+
+typedef	struct	Object	Object;
+
+struct	Object	{
+	Element	element;
+	bool	garbage;
+};
+
+	static
+	bool
+IsGarbage(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	return( ((Object*) element)->garbage );
+}
+
+	static
+	void
+Fill(
+	ElementList	*list,
+	Object		*objects,
+	size_t		count,
+	double		ratio,
+	uint64_t	*state )
+{
+	size_t	index;
+
+	NewElementList( list );
+	for( index = 0; index < count; index++ ) {
+		objects[ index ].garbage = (double) (BenchRandom( state ) >> 11) * 0x1p-53 < ratio;
+		PutLastElement( &objects[ index ], list );
+	}
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	const double	ratios[] = { 0.5, 0.9, 0.99 };
+	size_t			count = (size_t) (1000000 * BenchScale( argc, argv ));
+	Object			*objects = (Object*) calloc( count, sizeof( Object ) );
+	uint64_t		state = 0x9e3779b97f4a7c15ull;
+	size_t			index;
+
+	printf( "%-8s %18s %18s %18s\n", "removed", "grab-next ns/obj", "remove-if ns/obj", "mark+sweep ns/obj" );
+	for( index = 0; index < sizeof( ratios ) / sizeof( ratios[ 0 ] ); index++ ) {
+		ElementList	list, sink;
+		Object		*object;
+		double		start, grabNext, removeIf, markSweep;
+
+		//	The collector of old: every piece of garbage a full RemoveElement.
+		Fill( &list, objects, count, ratios[ index ], &state );
+		NewElementList( &sink );
+		start = BenchNow();
+		FirstElement( (void**) &object, &list );
+		while( object ) {
+			if( object->garbage ) {
+				Object	*next;
+
+				GrabNextElement( object, (void**) &next, &list );
+				PutLastElement( object, &sink );
+				object = next;
+			} else
+				NextElement( object, (void**) &object );
+		}
+		grabNext = BenchNow() - start;
+
+		Fill( &list, objects, count, ratios[ index ], &state );
+		NewElementList( &sink );
+		start = BenchNow();
+		RemoveElementsIf( &list, IsGarbage, NULL, &sink );
+		removeIf = BenchNow() - start;
+
+		//	Marking happens as objects die, spread out; the sweep is batched.
+		Fill( &list, objects, count, ratios[ index ], &state );
+		NewElementList( &sink );
+		start = BenchNow();
+		for( object = objects; object < objects + count; object++ )
+			if( object->garbage )
+				MarkElementDead( object );
+		SweepElementList( &list, &sink );
+		markSweep = BenchNow() - start;
+
+		printf( "%-8.2f %18.2f %18.2f %18.2f\n", ratios[ index ],
+			grabNext * 1e9 / (double) count, removeIf * 1e9 / (double) count, markSweep * 1e9 / (double) count );
+	}
+	free( objects );
+	return( 0 );
+}
@@ -0,0 +1,111 @@
+/****************************************************************************************
+	elementaltypedbench.c
+
+	DeclareElementList()'s typed functions against the *Type macros.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The same work through each interface, on an element whose Element is not
+	at offset 0: putting 1024 elements at alternating ends, walking them, and
+	grabbing them back. Prints nanoseconds per operation for each.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elementalbench.h"
+#include "elemental.h"
+
+#define	kElements	1024
+
+typedef	struct	Task	Task;
+
+struct	Task	{
+	long	key;
+	Element	element;
+};
+
+DeclareElementList( Task, Task, element );
+
+	static
+	long
+ThroughTypeMacros(
+	Task		*tasks,
+	ElementList	*list )
+{
+	Task	*task;
+	long	sum = 0;
+	int		index;
+
+	for( index = 0; index < kElements; index += 2 ) {
+		PutFirstElementType( &tasks[ index ], list, Task, element );
+		PutLastElementType( &tasks[ index + 1 ], list, Task, element );
+	}
+	for( FirstElementType( &task, list, Task, element ); task; NextElementType( task, (void**) &task, Task, element ) )
+		sum += task->key;
+	while( GrabFirstElementType( (void**) &task, list, Task, element ), task )
+		sum -= task->key;
+	return( sum );
+}
+
+	static
+	long
+ThroughTypedList(
+	Task		*tasks,
+	TaskList	*list )
+{
+	Task	*task;
+	long	sum = 0;
+	int		index;
+
+	for( index = 0; index < kElements; index += 2 ) {
+		PutFirstTask( &tasks[ index ], list );
+		PutLastTask( &tasks[ index + 1 ], list );
+	}
+	for( FirstTask( &task, list ); task; NextTask( task, &task ) )
+		sum += task->key;
+	while( GrabFirstTask( &task, list ), task )
+		sum -= task->key;
+	return( sum );
+}
+
+	int
+main(
+	int		argc,
+	char	**argv )
+{
+	size_t			rounds = (size_t) (20000 * BenchScale( argc, argv ));
+	Task			*tasks = (Task*) calloc( kElements, sizeof( Task ) );
+	ElementList		list;
+	TaskList		typed;
+	volatile long	sink = 0;
+	double			start, macros, functions;
+	size_t			round;
+	int				index;
+
+	for( index = 0; index < kElements; index++ )
+		tasks[ index ].key = index;
+	NewElementList( &list );
+	NewTaskList( &typed );
+
+	start = BenchNow();
+	for( round = 0; round < rounds; round++ )
+		sink += ThroughTypeMacros( tasks, &list );
+	macros = BenchNow() - start;
+
+	start = BenchNow();
+	for( round = 0; round < rounds; round++ )
+		sink += ThroughTypedList( tasks, &typed );
+	functions = BenchNow() - start;
+
+	//	A put, a step and a grab per element per round.
+	printf( "%-14s %10s\n", "interface", "ns/op" );
+	printf( "%-14s %10.2f\n", "Type macros", macros * 1e9 / (double) (rounds * kElements * 3) );
+	printf( "%-14s %10.2f\n", "typed list", functions * 1e9 / (double) (rounds * kElements * 3) );
+
+	DeleteTaskList( &typed );
+	DeleteElementList( &list );
+	free( tasks );
+	return( 0 );
+}
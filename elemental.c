@@ -4,14 +4,32 @@
 	Copyright (c) 1999-2016 Jonathan 'Wolf' Rentzsch: http://rentzsch.com
 	Some rights reserved: http://opensource.org/licenses/mit
 
-	Note that while FindElement() is the only linear-time function here, when
-	assertion checking is turned on, many of the so-called constant-time functions
-	implictly call FindElement() (some more than once).
+	Note that while FindElement() and the sweepers are the only linear-time
+	functions here, when assertion checking is turned on, many of the so-called
+	constant-time functions implictly call FindElement() (some more than once).
+
+	Elements marked dead, and cursor markers, are skipped by the accessors, so
+	those cost one step per hidden element they pass over; SweepElementList()
+	restores constant time. Both kinds are tagged in the two low bits of the
+	Element's list field, which pointer alignment leaves free, so neither costs
+	any space.
+
+	When built with elementalProbes defined to 1 (off by default; it needs
+	<sys/sdt.h>), every put and every unlink fires a semaphore-guarded USDT
+	probe, so tracers such as elemental.bt can attach to a production binary.
+	With no tracer attached, each probe costs a load and one well-predicted
+	branch; elementalprobebench measures it.
+
+	When built with elementalTrace, the same sites can also write a binary
+	trace for ReplayElementTrace() (see elementaltrace.h). Off by default.
 
 	************************************************************************************/
 
 #include <assert.h>
+#include <errno.h>
+#include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "elemental.h"
 
@@ -26,7 +44,7 @@
     #define assertTrue( CONDITION )           assert(CONDITION)
     #define assertIf( CONDITION, ASSERTION )  if((CONDITION)){assert((ASSERTION));}
     #define assertPtr(PTR)                    assert((PTR) && (((intptr_t)(PTR))%4)==0)
-    #define assertPtrIfNotNil(PTR)            if((PTR)){(((intptr_t)(PTR))%4)==0;}
+    #define assertPtrIfNotNil(PTR)            if((PTR)){assert((((intptr_t)(PTR))%4)==0);}
 
     void assertElement( void *element );
     #define assertElementIfNotNil( ELEMENT )  if((ELEMENT))assertElement((ELEMENT))
@@ -42,6 +60,89 @@
 	#define	assertList( LIST )
 #endif
 
+#ifndef	elementalProbes
+	#define	elementalProbes	0
+#endif
+#if	elementalProbes
+	#define	_SDT_HAS_SEMAPHORES	1
+	#include <sys/sdt.h>
+
+	//	Tracers bump these to enable their probe; see elemental.bt.
+	__extension__ unsigned short elemental_put_semaphore __attribute__(( unused )) __attribute__(( section( ".probes" ) ));
+	__extension__ unsigned short elemental_remove_semaphore __attribute__(( unused )) __attribute__(( section( ".probes" ) ));
+
+	//	elemental:put( list, element, op ) and elemental:remove( list, element, op ).
+	#define	elementalProbe( NAME, LIST, ELEMENT, OP )	\
+		do {	\
+			if( __builtin_expect( *(volatile unsigned short*) &elemental_##NAME##_semaphore, 0 ) )	\
+				STAP_PROBE3( elemental, NAME, (LIST), (ELEMENT), (OP) );	\
+		} while( 0 )
+#else
+	#define	elementalProbe( NAME, LIST, ELEMENT, OP )
+#endif
+
+//	The op argument of elemental:put.
+enum	{ putFirstOp, putLastOp, putBeforeOp, putAfterOp };
+
+//	The op argument of elemental:remove.
+enum	{ removeOp, grabFirstOp, grabLastOp, grabNextOp, grabPrevOp, sweepOp };
+
+//	Built with elementalTrace, StartElementTrace() has every put and unlink
+//	append an ElementTraceRecord. Ops match the probes' so traces and tracers
+//	agree. Idle, each site costs one well-predicted branch, like a probe.
+//
+//	Records go into whichever buffer is filling, under a spinlock held only
+//	to copy one in. The thread that fills a buffer swaps in a spare, takes a
+//	ticket and writes the full one after dropping the spinlock; tickets make
+//	the writes land in the order the buffers filled. With every buffer
+//	waiting to be written, recording threads sleep until one comes back.
+#ifndef	elementalTrace
+	#define	elementalTrace	0
+#endif
+#if	elementalTrace
+	#include <pthread.h>
+	#include <time.h>
+	#include <unistd.h>
+
+	//	Records per buffer, and buffers.
+	#ifndef	elementalTraceBatch
+		#define	elementalTraceBatch	1024
+	#endif
+	#ifndef	elementalTraceBuffers
+		#define	elementalTraceBuffers	4
+	#endif
+
+	static	struct	{
+		int					fd;				//	-1 when not tracing.
+		int					lock;			//	Guards the fields up to writeLock.
+		bool				failed;
+		uint64_t			key;
+		ElementTraceRecord	*filling;		//	NULL while every buffer awaits writing.
+		size_t				count;
+		ElementTraceRecord	*spares[ elementalTraceBuffers ];
+		size_t				spareCount;
+		uint64_t			tickets;		//	Handed out in the order buffers fill.
+		pthread_mutex_t		writeLock;		//	Guards written.
+		pthread_cond_t		wrote;			//	Broadcast as each ticket is done.
+		uint64_t			written;		//	Tickets done.
+		ElementTraceRecord	buffers[ elementalTraceBuffers ][ elementalTraceBatch ];
+	}	gElementTrace = {
+		.fd = -1,
+		.writeLock = PTHREAD_MUTEX_INITIALIZER,
+		.wrote = PTHREAD_COND_INITIALIZER };
+
+	#define	lockElementTrace()		while( __atomic_exchange_n( &gElementTrace.lock, 1, __ATOMIC_ACQUIRE ) )
+	#define	unlockElementTrace()	__atomic_store_n( &gElementTrace.lock, 0, __ATOMIC_RELEASE )
+
+	#define	elementalTraced( OP, LIST, ELEMENT, ANCHOR )	\
+		do {	\
+			if( __builtin_expect( __atomic_load_n( &gElementTrace.fd, __ATOMIC_RELAXED ) >= 0, 0 ) )	\
+				TraceElement( (OP), (LIST), (ELEMENT), (ANCHOR) );	\
+		} while( 0 )
+#else
+	#define	elementalTraced( OP, LIST, ELEMENT, ANCHOR )
+#endif
+
 	void*
 AddOffset(
 	void	*element,
@@ -52,6 +153,121 @@ SubtractOffset(
 	void	*element,
 	size_t	offset );
 
+//	Tags kept in the low bits of an Element's list field. Only an element in a
+//	list is ever tagged, so list == NULL still means in none.
+#define	elementDeadFlag		0x1
+#define	elementMarkerFlag	0x2		//	An ElementCursor's.
+#define	elementHiddenFlags	(elementDeadFlag | elementMarkerFlag)
+
+#define	elementFlags( ELEMENT )	((unsigned) ((uintptr_t) (ELEMENT)->list & elementHiddenFlags))
+#define	elementList( ELEMENT )	((ElementList*) ((uintptr_t) (ELEMENT)->list & ~(uintptr_t) elementHiddenFlags))
+#define	tagElementList( LIST, FLAGS )	((ElementList*) ((uintptr_t) (LIST) | (FLAGS)))
+
+#if	elementalSearchCounts
+	//	FindElementByKey() hits saturate here.
+	#define	elementHitsMax		UINT_MAX
+	#define	clearElementHits( ELEMENT )	((ELEMENT)->hits = 0)
+#else
+	#define	clearElementHits( ELEMENT )	((void) 0)
+#endif
+
+#if	elementalGenerations
+	//	Whether element's list has been cleared since element was put in it.
+	//	A DEBUG build's DeleteElementList() poisons the list's generation, so
+	//	that asking an element about its deleted list asserts.
+	#define	elementDeletedGeneration	UINT64_MAX
+	#if	elementalAssertions
+		#define	isElementStale( ELEMENT )	\
+				((ELEMENT)->list	\
+				&& (assert( elementList( ELEMENT )->generation != elementDeletedGeneration ),	\
+					(ELEMENT)->generation != elementList( ELEMENT )->generation))
+	#else
+		#define	isElementStale( ELEMENT )	\
+				((ELEMENT)->list && (ELEMENT)->generation != elementList( ELEMENT )->generation)
+	#endif
+	#define	stampElement( ELEMENT, LIST )	((ELEMENT)->generation = (LIST)->generation)
+#else
+	#define	isElementStale( ELEMENT )	false
+	#define	stampElement( ELEMENT, LIST )	((void) 0)
+#endif
+
+//	A dead element is still linked into its list until swept, and FindElement()
+//	skips it, so only this catches one being put again.
+#define	assertNotDead( ELEMENT )	\
+		assertTrue( !(elementFlags( ELEMENT ) & elementDeadFlag) || isElementStale( ELEMENT ) )
+
+	static
+	Element*
+SkipHiddenForward(
+	Element	*element );
+
+	static
+	Element*
+SkipHiddenBackward(
+	Element	*element );
+
+	static
+	void
+RemoveElementAs(
+	void			*element,
+	ElementList		*list,
+	int				op );
+
+	static
+	void
+MoveElementBefore(
+	Element		*element,
+	Element		*before,
+	ElementList	*list );
+
+	static
+	void
+LinkMarker(
+	Element		*marker,
+	Element		*after,
+	ElementList	*list );
+
+	static
+	void
+UnlinkMarker(
+	Element	*marker );
+
+#if	elementalTrace
+	static
+	void
+TraceElement(
+	int			op,
+	const void	*list,
+	const void	*element,
+	const void	*anchor );
+
+	static
+	uint64_t
+TraceID(
+	const void	*address );
+
+	static
+	void
+WaitElementTraceBuffer( void );
+
+	static
+	void
+WaitElementTraceTurn(
+	uint64_t	ticket );
+
+	static
+	void
+EndElementTraceTurn( void );
+
+	static
+	void
+WriteElementTrace(
+	int					fd,
+	ElementTraceRecord	*records,
+	size_t				count,
+	uint64_t			ticket );
+#endif
+
 
 
 /****************************************************************************************
@@ -68,6 +284,12 @@ NewElementList(
 {
 	assertPtr( list );
 	list->first = list->last = NULL;
+#if	elementalGenerations
+	//	Left alone, so that elements cleared from this list stay stale. Only a
+	//	deleted list's starts over: nothing may still refer to that one.
+	if( list->generation == elementDeletedGeneration )
+		list->generation = 0;
+#endif
 
 }
 
@@ -76,7 +298,46 @@ NewElementList(
 DeleteElementList(
 	ElementList	*list )
 {
-	;
+#if	elementalGenerations && elementalAssertions
+	assertPtr( list );
+	list->generation = elementDeletedGeneration;
+#else
+	(void) list;
+#endif
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Visits the elements unless built with elementalGenerations.
+
+	************************************************************************************/
+
+	void
+ClearElementList(
+	ElementList	*list )
+{
+	assertList( list );
+	elementalTraced( elementTraceClear, list, NULL, NULL );
+
+#if	elementalGenerations
+	list->generation++;
+#else
+	{
+		Element	*element = list->first;
+
+		//	Markers too: their cursors then find themselves in no list.
+		while( element ) {
+			Element	*next = element->next;
+
+			element->next = element->prev = NULL;
+			element->list = NULL;
+			element = next;
+		}
+	}
+#endif
+	list->first = list->last = NULL;
 }
 
 /****************************************************************************************
@@ -91,6 +352,11 @@ DeleteElementList(
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
 	wolf		Wed, May 31, 2000	Updated to support the new list field in Element.
+	agent		Sun, Oct 18, 2026	Clears flags, so callers need not initialize them.
+	agent		Sun, Oct 18, 2026	Fires the elemental:put probe.
+	agent		Mon, Oct 19, 2026	Records the put when tracing.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Asserts element is not marked dead.
 
 	************************************************************************************/
 
@@ -104,17 +370,23 @@ PutFirstElement(
 	assertElement( element );
 	assertList( list );
 	assertTrue( !FindElement( element, list ) );
+	assertNotDead( element_ );
+	elementalProbe( put, list, element, putFirstOp );
+	elementalTraced( elementTracePutFirst, list, element, NULL );
 
+	clearElementHits( element_ );
 	if( list->first ) {
 		element_->prev = NULL;
 		element_->next = list->first;
 		element_->list = list;
+		stampElement( element_, list );
 		list->first->prev = element_;
 		list->first = element_;
 	} else {
 		list->first = list->last = element_;
 		element_->prev = element_->next = NULL;
 		element_->list = list;
+		stampElement( element_, list );
 	}
 
 	assertTrue( list->first == element );
@@ -124,6 +396,11 @@ PutFirstElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Clears flags, so callers need not initialize them.
+	agent		Sun, Oct 18, 2026	Fires the elemental:put probe.
+	agent		Mon, Oct 19, 2026	Records the put when tracing.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Asserts element is not marked dead.
 
 	************************************************************************************/
 
@@ -137,17 +414,23 @@ PutLastElement(
 	assertElement( element );
 	assertList( list );
 	assertTrue( !FindElement( element, list ) );
+	assertNotDead( element_ );
+	elementalProbe( put, list, element, putLastOp );
+	elementalTraced( elementTracePutLast, list, element, NULL );
 
+	clearElementHits( element_ );
 	if( list->first ) {
 		element_->prev = list->last;
 		element_->next = NULL;
 		element_->list = list;
+		stampElement( element_, list );
 		list->last->next = element_;
 		list->last = element_;
 	} else {
 		list->first = list->last = element_;
 		element_->prev = element_->next = NULL;
 		element_->list = list;
+		stampElement( element_, list );
 	}
 
 	assertTrue( list->last == element );
@@ -158,6 +441,12 @@ PutLastElement(
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
 	wolf		Wed, May 31, 2000	Updated to support the new list field in Element.
+	agent		Sun, Oct 18, 2026	Clears flags, so callers need not initialize them.
+	agent		Sun, Oct 18, 2026	Fires the elemental:put probe.
+	agent		Mon, Oct 19, 2026	Puts at the near end, not the far one, when before is first.
+	agent		Mon, Oct 19, 2026	Records the put when tracing.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Asserts element is not marked dead.
 
 	************************************************************************************/
 
@@ -175,22 +464,32 @@ PutBeforeElement(
 	assertTrue( element != before );
 	assertList( list );
 	assertTrue( !FindElement( element, list ) );
+	assertNotDead( element_ );
 	assertIf( before, FindElement( before, list ) );
 
+	clearElementHits( element_ );
 	if( list->first ) {
-		if( before_ == NULL || list->first == before_ )
+		if( before_ == NULL )
 			PutLastElement( element_, list );
+		else if( list->first == before_ )
+			PutFirstElement( element_, list );
 		else {
+			elementalProbe( put, list, element, putBeforeOp );
+			elementalTraced( elementTracePutBefore, list, element, before );
 			element_->prev = before_->prev;
 			element_->next = before_;
 			element_->list = list;
+			stampElement( element_, list );
 			before_->prev->next = element_;
 			before_->prev = element_;
 		}
 	} else {
+		elementalProbe( put, list, element, putBeforeOp );
+		elementalTraced( elementTracePutBefore, list, element, before );
 		list->first = list->last = element_;
 		element_->prev = element_->next = NULL;
 		element_->list = list;
+		stampElement( element_, list );
 	}
 
 	assertIf( before, before_->prev == element && element_->next == before );
@@ -201,6 +500,12 @@ PutBeforeElement(
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
 	wolf		Wed, May 31, 2000	Updated to support the new list field in Element.
+	agent		Sun, Oct 18, 2026	Clears flags, so callers need not initialize them.
+	agent		Sun, Oct 18, 2026	Fires the elemental:put probe.
+	agent		Mon, Oct 19, 2026	Puts at the near end, not the far one, when after is last.
+	agent		Mon, Oct 19, 2026	Records the put when tracing.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Asserts element is not marked dead.
 
 	************************************************************************************/
 
@@ -218,27 +523,134 @@ PutAfterElement(
 	assertTrue( element != after );
 	assertList( list );
 	assertTrue( !FindElement( element, list ) );
+	assertNotDead( element_ );
 	assertIf( after, FindElement( after, list ) );
 
+	clearElementHits( element_ );
 	if( list->first ) {
-		if( after_ == NULL || list->last == after_ )
+		if( after_ == NULL )
 			PutFirstElement( element_, list );
+		else if( list->last == after_ )
+			PutLastElement( element_, list );
 		else {
+			elementalProbe( put, list, element, putAfterOp );
+			elementalTraced( elementTracePutAfter, list, element, after );
 			element_->prev = after_;
 			element_->next = after_->next;
 			element_->list = list;
+			stampElement( element_, list );
 			after_->next->prev = element_;
 			after_->next = element_;
 		}
 	} else {
+		elementalProbe( put, list, element, putAfterOp );
+		elementalTraced( elementTracePutAfter, list, element, after );
 		list->first = list->last = element_;
 		element_->prev = element_->next = NULL;
 		element_->list = list;
+		stampElement( element_, list );
 	}
 
 	assertIf( after, after_->next == element && element_->prev == after );
 }
 
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+SpliceElements(
+	void			*first,
+	void			*last,
+	ElementList		*from,
+	ElementList		*to,
+	bool			toFront )
+{
+	Element	*first_ = (Element*) first;
+	Element	*last_ = (Element*) last;
+	Element	*gap = first_->prev;	//	Where markers in the run go.
+	Element	*put = NULL;			//	The last of the run put so far.
+	Element	*element;
+	Element	*before;
+	Element	*after;
+
+	assertElement( first );
+	assertElement( last );
+	assertList( from );
+	assertList( to );
+	assertTrue( from != to );
+	assertTrue( elementList( first_ ) == from && !isElementStale( first_ ) );
+	assertTrue( elementList( last_ ) == from && !isElementStale( last_ ) );
+	assertTrue( !(elementFlags( first_ ) & elementMarkerFlag) && !(elementFlags( last_ ) & elementMarkerFlag) );
+
+	//	Retag the run, moving its markers out in front of it as it goes.
+	for( element = first_; ; element = after ) {
+		assertTrue( element != NULL );
+		after = element->next;
+		if( elementFlags( element ) & elementMarkerFlag ) {
+			UnlinkMarker( element );
+			LinkMarker( element, gap, from );
+			gap = element;
+			continue;
+		}
+
+		elementalProbe( remove, from, element, removeOp );
+		elementalTraced( elementTraceRemove + removeOp, from, element, NULL );
+		if( !toFront ) {
+			elementalProbe( put, to, element, putLastOp );
+			elementalTraced( elementTracePutLast, to, element, NULL );
+		} else if( put ) {
+			elementalProbe( put, to, element, putAfterOp );
+			elementalTraced( elementTracePutAfter, to, element, put );
+		} else {
+			elementalProbe( put, to, element, putFirstOp );
+			elementalTraced( elementTracePutFirst, to, element, NULL );
+		}
+		element->list = tagElementList( to, elementFlags( element ) & elementDeadFlag );
+		stampElement( element, to );
+		clearElementHits( element );
+		put = element;
+		if( element == last_ )
+			break;
+	}
+
+	//	Cut [first, last] from from...
+	before = first_->prev;
+	after = last_->next;
+	if( before )
+		before->next = after;
+	else
+		from->first = after;
+	if( after )
+		after->prev = before;
+	else
+		from->last = before;
+
+	//	...and splice it into to.
+	if( toFront ) {
+		first_->prev = NULL;
+		last_->next = to->first;
+		if( to->first )
+			to->first->prev = last_;
+		else
+			to->last = last_;
+		to->first = first_;
+	} else {
+		first_->prev = to->last;
+		last_->next = NULL;
+		if( to->last )
+			to->last->next = first_;
+		else
+			to->first = first_;
+		to->last = last_;
+	}
+
+	assertTrue( toFront ? to->first == first : to->last == last );
+}
+
 /****************************************************************************************
 *
 *	Accessors
@@ -251,6 +663,8 @@ PutAfterElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Skips elements marked dead.
+	agent		Mon, Oct 19, 2026	Also skips cursor markers.
 
 	************************************************************************************/
 
@@ -262,13 +676,15 @@ FirstElement(
 	assertPtr( element );
 	assertList( list );
 
-	*element = list->first;
+	*element = SkipHiddenForward( list->first );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Skips elements marked dead.
+	agent		Mon, Oct 19, 2026	Also skips cursor markers.
 
 	************************************************************************************/
 
@@ -280,13 +696,15 @@ LastElement(
 	assertPtr( element );
 	assertList( list );
 
-	*element = list->last;
+	*element = SkipHiddenBackward( list->last );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Skips elements marked dead.
+	agent		Mon, Oct 19, 2026	Also skips cursor markers.
 
 	************************************************************************************/
 
@@ -300,13 +718,15 @@ NextElement(
 	assertElement( element );
 	assertPtr( nextElement );
 
-	*nextElement = element_->next;
+	*nextElement = SkipHiddenForward( element_->next );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Skips elements marked dead.
+	agent		Mon, Oct 19, 2026	Also skips cursor markers.
 
 	************************************************************************************/
 
@@ -320,7 +740,7 @@ PrevElement(
 	assertElement( element );
 	assertPtr( prevElement );
 
-	*prevElement= element_->prev;
+	*prevElement = SkipHiddenBackward( element_->prev );
 }
 
 /****************************************************************************************
@@ -353,6 +773,8 @@ FindElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Wed, May 31, 2000	Created.
+	agent		Mon, Oct 19, 2026	Returns NULL for elements in no list, or cleared from one.
+	agent		Mon, Oct 19, 2026	Masks off the tags in the list field.
 
 	************************************************************************************/
 
@@ -363,15 +785,20 @@ GetElementList(
 	Element	*element_ = (Element*) element;
 
 	assertElement( element );
-	assertTrue( FindElement( element, element_->list ) );
 
-	return( element_->list );
+	if( isElementStale( element_ ) )
+		return( NULL );
+	assertIf( element_->list && !elementFlags( element_ ), FindElement( element, elementList( element_ ) ) );
+
+	return( elementList( element_ ) );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Wed, May 31, 2000	Created.
+	agent		Sun, Oct 18, 2026	Skips elements marked dead.
+	agent		Mon, Oct 19, 2026	Also skips cursor markers.
 
 	************************************************************************************/
 
@@ -381,7 +808,33 @@ IsListEmpty(
 {
 	assertList( list );
 
-	return( list->first == NULL );
+	return( SkipHiddenForward( list->first ) == NULL );
+}
+
+/****************************************************************************************
+*
+*	Searching
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Searching)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FindElementByKey(
+	void				**element,
+	ElementList			*list,
+	const void			*key,
+	ElementCompareProc	compareProc,
+	int					policy )
+{
+	FindElementByKeyOff( element, list, key, compareProc, policy, 0 );
 }
 
 /****************************************************************************************
@@ -397,6 +850,8 @@ IsListEmpty(
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
 	wolf		Wed, May 31, 2000	Updated to support the new list field in Element.
+	agent		Sun, Oct 18, 2026	Accounts for elements marked dead.
+	agent		Sun, Oct 18, 2026	Now just calls RemoveElementAs().
 
 	************************************************************************************/
 
@@ -405,29 +860,14 @@ RemoveElement(
 	void			*element,
 	ElementList		*list )
 {
-	Element	*element_ = (Element*) element;
-
-	assertElement( element );
-	assertList( list );
-
-	if( list->first == element_ )
-		list->first = element_->next;
-	if( list->last == element_ )
-		list->last = element_->prev;
-	if( element_->prev )
-		element_->prev->next = element_->next;
-	if( element_->next )
-		element_->next->prev = element_->prev;
-	element_->prev = element_->next = NULL;
-	element_->list = NULL;
-
-	assertTrue( !FindElement( element, list ) );
+	RemoveElementAs( element, list, removeOp );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Fires the elemental:remove probe.
 
 	************************************************************************************/
 
@@ -441,7 +881,7 @@ GrabFirstElement(
 
 	FirstElement( element, list );
 	if( *element )
-		RemoveElement( *element, list );
+		RemoveElementAs( *element, list, grabFirstOp );
 
 	assertIf( *element, !FindElement( *element, list ) );
 }
@@ -450,6 +890,7 @@ GrabFirstElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Fires the elemental:remove probe.
 
 	************************************************************************************/
 
@@ -463,7 +904,7 @@ GrabLastElement(
 
 	LastElement( element, list );
 	if( *element )
-		RemoveElement( *element, list );
+		RemoveElementAs( *element, list, grabLastOp );
 
 	assertIf( *element, !FindElement( *element, list ) );
 }
@@ -472,6 +913,7 @@ GrabLastElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Fires the elemental:remove probe.
 
 	************************************************************************************/
 
@@ -486,7 +928,7 @@ GrabNextElement(
 	assertList( list );
 
 	NextElement( element, nextElement );
-	RemoveElement( element, list );
+	RemoveElementAs( element, list, grabNextOp );
 
 	assertTrue( !FindElement( element, list ) );
 	assertIf( *nextElement, FindElement( *nextElement, list ) );
@@ -496,6 +938,7 @@ GrabNextElement(
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
 	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Fires the elemental:remove probe.
 
 	************************************************************************************/
 
@@ -510,7 +953,7 @@ GrabPrevElement(
 	assertList( list );
 
 	PrevElement( element, prevElement );
-	RemoveElement( element, list );
+	RemoveElementAs( element, list, grabPrevOp );
 
 	assertTrue( !FindElement( element, list ) );
 	assertIf( *prevElement, FindElement( *prevElement, list ) );
@@ -518,279 +961,1153 @@ GrabPrevElement(
 
 /****************************************************************************************
 *
-*	Offset Putters
+*	Sweepers
 *
 ****************************************************************************************/
 #pragma mark	-
-#pragma mark	(Offset Putters)
+#pragma mark	(Sweepers)
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
 
 	************************************************************************************/
 
-	void
-PutFirstElementOff(
-	void			*element,
-	ElementList		*list,
-	size_t			offset )
+	size_t
+RemoveElementsIf(
+	ElementList			*list,
+	ElementPredicate	predicate,
+	void				*refCon,
+	ElementList			*sink )
 {
-	PutFirstElement( AddOffset( element, offset ), list );
+	return( RemoveElementsIfOff( list, predicate, refCon, sink, 0 ) );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Disregards elements cleared from their list.
+	agent		Mon, Oct 19, 2026	Tags the list field rather than counting in the list.
 
 	************************************************************************************/
 
 	void
-PutLastElementOff(
-	void			*element,
-	ElementList		*list,
-	size_t			offset )
+MarkElementDead(
+	void	*element )
 {
-	PutLastElement( AddOffset( element, offset ), list );
+	Element	*element_ = (Element*) element;
+
+	assertElement( element );
+	assertTrue( !(elementFlags( element_ ) & elementMarkerFlag) );
+
+	if( element_->list && !isElementStale( element_ ) )
+		element_->list = tagElementList( element_->list, elementDeadFlag );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Disregards elements cleared from their list.
+	agent		Mon, Oct 19, 2026	Reads the tag in the list field.
 
 	************************************************************************************/
 
-	void
-PutBeforeElementOff(
-	void			*element,
-	void			*before,
-	ElementList		*list,
-	size_t			offset )
+	bool
+IsElementDead(
+	void	*element )
 {
-	PutBeforeElement( AddOffset( element, offset ), AddOffset( before, offset ), list );
+	assertElement( element );
+
+	return( (elementFlags( (Element*) element ) & elementDeadFlag) != 0 && !isElementStale( (Element*) element ) );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Always sweeps: lists no longer count their dead.
 
 	************************************************************************************/
 
-	void
-PutAfterElementOff(
-	void			*element,
-	void			*after,
-	ElementList		*list,
-	size_t			offset )
+	size_t
+SweepElementList(
+	ElementList	*list,
+	ElementList	*sink )
 {
-	PutAfterElement( AddOffset( element, offset ), AddOffset( after, offset ), list );
-}
-
+	assertList( list );
 
+	return( RemoveElementsIfOff( list, NULL, NULL, sink, 0 ) );
+}
 
 /****************************************************************************************
 *
-*	Offset Accessors
+*	Cursors
 *
 ****************************************************************************************/
 #pragma mark	-
-#pragma mark	(Offset Accessors)
+#pragma mark	(Cursors)
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-FirstElementOff(
-	void			**element,
-	ElementList		*list,
-	size_t			offset )
+OpenElementCursor(
+	ElementCursor	*cursor,
+	ElementList		*list )
 {
-	FirstElement( element, list );
-	*element = SubtractOffset( *element, offset );
+	assertPtr( cursor );
+	assertList( list );
+
+	LinkMarker( &cursor->marker, NULL, list );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-LastElementOff(
-	void			**element,
-	ElementList		*list,
-	size_t			offset )
+CloseElementCursor(
+	ElementCursor	*cursor )
 {
-	LastElement( element, list );
-	*element = SubtractOffset( *element, offset );
+	assertPtr( cursor );
+
+	UnlinkMarker( &cursor->marker );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-NextElementOff(
-	void		*element,
-	void		**nextElement,
-	size_t		offset )
+RewindElementCursor(
+	ElementCursor	*cursor )
 {
-	NextElement( AddOffset( element, offset ), nextElement );
-	*nextElement = SubtractOffset( *nextElement, offset );
+	Element		*marker = &cursor->marker;
+	ElementList	*list = elementList( marker );
+
+	assertPtr( cursor );
+
+	if( !list || isElementStale( marker ) )
+		return;
+	UnlinkMarker( marker );
+	LinkMarker( marker, NULL, list );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-PrevElementOff(
-	void		*element,
-	void		**prevElement,
-	size_t		offset )
+NextCursorElement(
+	void			**element,
+	ElementCursor	*cursor )
 {
-	PrevElement( AddOffset( element, offset ), prevElement );
-	*prevElement = SubtractOffset( *prevElement, offset );
-}
+	Element		*marker = &cursor->marker;
+	ElementList	*list = elementList( marker );
+	Element		*element_;
 
-/****************************************************************************************
-	Commenter	Date				Comment
-	---------	-----------------	-----------------------------------------------------
-	wolf		Fri, Apr 16, 1999	Created.
+	assertPtr( element );
+	assertPtr( cursor );
 
-	************************************************************************************/
+	if( !list || isElementStale( marker ) ) {
+		*element = NULL;
+		return;
+	}
 
-	bool
-FindElementOff(
-	void			*element,
-	ElementList		*list,
-	size_t			offset )
-{
-	return( FindElement( AddOffset( element, offset ), list ) );
+	element_ = SkipHiddenForward( marker->next );
+	if( element_ ) {
+		UnlinkMarker( marker );
+		LinkMarker( marker, element_, list );
+	}
+	*element = element_;
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Wed, May 31, 2000	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
-	ElementList*
-GetElementListOff(
-	void	*element,
-	size_t	offset )
+	size_t
+AdvanceElementCursor(
+	ElementCursor	*cursor,
+	size_t			count )
 {
-	return( GetElementList( AddOffset( element, offset ) ) );
+	Element		*marker = &cursor->marker;
+	ElementList	*list = elementList( marker );
+	Element		*element_ = marker;
+	Element		*passed = NULL;
+	size_t		advanced = 0;
+
+	assertPtr( cursor );
+
+	if( !list || isElementStale( marker ) )
+		return( 0 );
+
+	while( advanced < count && (element_ = SkipHiddenForward( element_->next )) ) {
+		passed = element_;
+		advanced++;
+	}
+	if( passed ) {
+		UnlinkMarker( marker );
+		LinkMarker( marker, passed, list );
+	}
+	return( advanced );
 }
 
 /****************************************************************************************
 *
-*	Offset Grabbers
+*	Compaction
 *
 ****************************************************************************************/
 #pragma mark	-
-#pragma mark	(Offset Grabbers)
+#pragma mark	(Compaction)
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
 
 	************************************************************************************/
 
-	void
-RemoveElementOff(
-	void			*element,
-	ElementList		*list,
-	size_t			offset )
+	size_t
+CompactElementList(
+	ElementList			*list,
+	void				*arena,
+	size_t				arenaSize,
+	size_t				elementSize,
+	ElementRelocateProc	relocateProc,
+	void				*refCon )
 {
-	RemoveElement( AddOffset( element, offset ), list );
+	return( CompactElementListOff( list, arena, arenaSize, elementSize, relocateProc, refCon, 0 ) );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
 
 	************************************************************************************/
 
-	void
-GrabFirstElementOff(
-	void			**element,
-	ElementList		*list,
-	size_t			offset )
+	size_t
+ElementListLocality(
+	ElementList	*list )
 {
-	GrabFirstElement( element, list );
-	*element = SubtractOffset( *element, offset );
-}
+	Element	*element_;
+	size_t	distance = 0;
+	size_t	pairs = 0;
 
-/****************************************************************************************
-	Commenter	Date				Comment
-	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	assertList( list );
 
-	************************************************************************************/
+	//	Physical neighbours, dead or not: they're what the cache sees.
+	for( element_ = list->first; element_ && element_->next; element_ = element_->next ) {
+		char	*here = (char*) element_;
+		char	*there = (char*) element_->next;
 
-	void
+		distance += here < there ? (size_t) (there - here) : (size_t) (here - there);
+		pairs++;
+	}
+	return( pairs ? distance / pairs : 0 );
+}
+
+/****************************************************************************************
+*
+*	Relocation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Relocation)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RelocateElement(
+	void	*oldElement,
+	void	*newElement )
+{
+	Element		*element_ = (Element*) newElement;
+	ElementList	*list = elementList( element_ );
+
+	assertElement( newElement );
+
+	if( list == NULL || isElementStale( element_ ) || oldElement == newElement )
+		return;
+	elementalTraced( elementTraceRelocate, list, oldElement, newElement );
+
+	//	Only the first element has no prev, and only the last no next.
+	if( element_->prev )
+		element_->prev->next = element_;
+	else
+		list->first = element_;
+	if( element_->next )
+		element_->next->prev = element_;
+	else
+		list->last = element_;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RelocateElementArena(
+	void	*oldArena,
+	void	*newArena,
+	size_t	arenaSize,
+	size_t	elementSize )
+{
+	RelocateElementArenaOff( oldArena, newArena, arenaSize, elementSize, 0 );
+}
+
+/****************************************************************************************
+*
+*	Registries
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Registries)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+StitchElementRegistry(
+	ElementList		*list,
+	unsigned		*state,
+	void *const		*start,
+	void *const		*stop )
+{
+	unsigned	unstitched = 0;
+
+	assertList( list );
+	assertPtr( state );
+	assertTrue( start <= stop );
+
+	//	0 unstitched, 1 being stitched, 2 stitched.
+	if( __atomic_compare_exchange_n( state, &unstitched, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE ) ) {
+		for( ; start < stop; start++ )
+			PutLastElement( *start, list );
+		__atomic_store_n( state, 2, __ATOMIC_RELEASE );
+	} else {
+		while( __atomic_load_n( state, __ATOMIC_ACQUIRE ) != 2 )
+			;
+	}
+}
+
+/****************************************************************************************
+*
+*	Tracing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Tracing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Waits out the previous trace's writes, and deals out its buffers.
+
+	************************************************************************************/
+
+	bool
+StartElementTrace(
+	int	fd )
+{
+#if	elementalTrace
+	uint64_t	ticket;
+	bool		busy;
+	int			stack;
+
+	assertTrue( fd >= 0 );
+
+	lockElementTrace();
+	if( gElementTrace.fd >= 0 ) {
+		unlockElementTrace();
+		errno = EBUSY;
+		return( false );
+	}
+	ticket = gElementTrace.tickets++;
+	unlockElementTrace();
+
+	//	Once the previous trace's buffers are all written, they are free.
+	WaitElementTraceTurn( ticket );
+	lockElementTrace();
+	busy = gElementTrace.fd >= 0;
+	if( !busy ) {
+		size_t	index;
+
+		gElementTrace.key = (uint64_t) time( NULL ) ^ ((uint64_t) getpid() << 32) ^ (uint64_t) (uintptr_t) &stack;
+		gElementTrace.failed = false;
+		gElementTrace.filling = gElementTrace.buffers[ 0 ];
+		gElementTrace.count = 0;
+		for( index = 1; index < elementalTraceBuffers; index++ )
+			gElementTrace.spares[ index - 1 ] = gElementTrace.buffers[ index ];
+		gElementTrace.spareCount = elementalTraceBuffers - 1;
+		__atomic_store_n( &gElementTrace.fd, fd, __ATOMIC_RELAXED );
+	}
+	unlockElementTrace();
+	EndElementTraceTurn();
+
+	if( busy ) {
+		errno = EBUSY;
+		return( false );
+	}
+	return( true );
+#else
+	(void) fd;
+	errno = ENOTSUP;
+	return( false );
+#endif
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Writes the last buffer outside the spinlock, after all the others.
+	agent		Mon, Oct 19, 2026	Fails with EINVAL when no trace is running.
+
+	************************************************************************************/
+
+	bool
+StopElementTrace( void )
+{
+#if	elementalTrace
+	ElementTraceRecord	*records;
+	size_t				count;
+	uint64_t			ticket;
+	bool				succeeded;
+	int					fd;
+
+	lockElementTrace();
+	fd = gElementTrace.fd;
+	//	A failed write stops the trace too, but that is reported below.
+	if( fd < 0 && !gElementTrace.failed ) {
+		unlockElementTrace();
+		errno = EINVAL;
+		return( false );
+	}
+	records = gElementTrace.filling;
+	count = fd >= 0 ? gElementTrace.count : 0;
+	gElementTrace.filling = NULL;
+	ticket = gElementTrace.tickets++;
+	__atomic_store_n( &gElementTrace.fd, -1, __ATOMIC_RELAXED );
+	unlockElementTrace();
+
+	//	Returns once every buffer filled before this one is written too.
+	WriteElementTrace( fd, records, count, ticket );
+
+	lockElementTrace();
+	succeeded = !gElementTrace.failed;
+	gElementTrace.failed = false;
+	unlockElementTrace();
+
+	return( succeeded );
+#else
+	errno = ENOTSUP;
+	return( false );
+#endif
+}
+
+/****************************************************************************************
+*
+*	Offset Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+PutFirstElementOff(
+	void			*element,
+	ElementList		*list,
+	size_t			offset )
+{
+	PutFirstElement( AddOffset( element, offset ), list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+PutLastElementOff(
+	void			*element,
+	ElementList		*list,
+	size_t			offset )
+{
+	PutLastElement( AddOffset( element, offset ), list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+PutBeforeElementOff(
+	void			*element,
+	void			*before,
+	ElementList		*list,
+	size_t			offset )
+{
+	PutBeforeElement( AddOffset( element, offset ), AddOffset( before, offset ), list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+PutAfterElementOff(
+	void			*element,
+	void			*after,
+	ElementList		*list,
+	size_t			offset )
+{
+	PutAfterElement( AddOffset( element, offset ), AddOffset( after, offset ), list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+SpliceElementsOff(
+	void			*first,
+	void			*last,
+	ElementList		*from,
+	ElementList		*to,
+	bool			toFront,
+	size_t			offset )
+{
+	SpliceElements( AddOffset( first, offset ), AddOffset( last, offset ), from, to, toFront );
+}
+
+
+
+/****************************************************************************************
+*
+*	Offset Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+FirstElementOff(
+	void			**element,
+	ElementList		*list,
+	size_t			offset )
+{
+	FirstElement( element, list );
+	*element = SubtractOffset( *element, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+LastElementOff(
+	void			**element,
+	ElementList		*list,
+	size_t			offset )
+{
+	LastElement( element, list );
+	*element = SubtractOffset( *element, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+NextElementOff(
+	void		*element,
+	void		**nextElement,
+	size_t		offset )
+{
+	NextElement( AddOffset( element, offset ), nextElement );
+	*nextElement = SubtractOffset( *nextElement, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+PrevElementOff(
+	void		*element,
+	void		**prevElement,
+	size_t		offset )
+{
+	PrevElement( AddOffset( element, offset ), prevElement );
+	*prevElement = SubtractOffset( *prevElement, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Fri, Apr 16, 1999	Created.
+
+	************************************************************************************/
+
+	bool
+FindElementOff(
+	void			*element,
+	ElementList		*list,
+	size_t			offset )
+{
+	return( FindElement( AddOffset( element, offset ), list ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Wed, May 31, 2000	Created.
+
+	************************************************************************************/
+
+	ElementList*
+GetElementListOff(
+	void	*element,
+	size_t	offset )
+{
+	return( GetElementList( AddOffset( element, offset ) ) );
+}
+
+/****************************************************************************************
+*
+*	Offset Searching
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Searching)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	elementSearchCount transposes without elementalSearchCounts.
+
+	************************************************************************************/
+
+	void
+FindElementByKeyOff(
+	void				**element,
+	ElementList			*list,
+	const void			*key,
+	ElementCompareProc	compareProc,
+	int					policy,
+	size_t				offset )
+{
+	Element	*element_;
+#if	elementalSearchCounts
+	Element	*prev;
+#endif
+	Element	*before = NULL;
+
+	assertPtr( element );
+	assertList( list );
+	assertPtr( compareProc );
+
+	FirstElement( (void**) &element_, list );
+	while( element_ && compareProc( SubtractOffset( element_, offset ), key ) != 0 )
+		NextElement( element_, (void**) &element_ );
+
+	if( element_ ) {
+		switch( policy ) {
+			case elementSearchMoveToFront:
+				FirstElement( (void**) &before, list );
+				break;
+			case elementSearchTranspose:
+#if	!elementalSearchCounts
+			case elementSearchCount:	//	No counts to order by; the nearest thing.
+#endif
+				PrevElement( element_, (void**) &before );
+				break;
+#if	elementalSearchCounts
+			case elementSearchCount:
+				if( element_->hits < elementHitsMax )
+					element_->hits++;
+				for( PrevElement( element_, (void**) &prev ); prev && prev->hits < element_->hits;
+					 PrevElement( prev, (void**) &prev ) )
+					before = prev;
+				break;
+#endif
+		}
+		if( before && before != element_ )
+			MoveElementBefore( element_, before, list );
+	}
+
+	*element = SubtractOffset( element_, offset );
+}
+
+/****************************************************************************************
+*
+*	Offset Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+RemoveElementOff(
+	void			*element,
+	ElementList		*list,
+	size_t			offset )
+{
+	RemoveElement( AddOffset( element, offset ), list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstElementOff(
+	void			**element,
+	ElementList		*list,
+	size_t			offset )
+{
+	GrabFirstElement( element, list );
+	*element = SubtractOffset( *element, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
 GrabLastElementOff(
 	void			**element,
-	ElementList		*list,
+	ElementList		*list,
+	size_t			offset )
+{
+	GrabLastElement( element, list );
+	*element = SubtractOffset( *element, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+GrabNextElementOff(
+	void			*element,
+	void			**nextElement,
+	ElementList		*list,
+	size_t			offset )
+{
+	GrabNextElement( AddOffset( element, offset ), nextElement, list );
+	*nextElement = SubtractOffset( *nextElement, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+
+	************************************************************************************/
+
+	void
+GrabPrevElementOff(
+	void			*element,
+	void			**prevElement,
+	ElementList		*list,
+	size_t			offset )
+{
+	GrabPrevElement( AddOffset( element, offset ), prevElement, list );
+	*prevElement = SubtractOffset( *prevElement, offset );
+}
+
+/****************************************************************************************
+*
+*	Offset Sweepers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Sweepers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Records each sweep when tracing.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Never passes cursor markers to predicate.
+	agent		Mon, Oct 19, 2026	Reads the dead and marker tags in the list field.
+
+	************************************************************************************/
+
+	size_t
+RemoveElementsIfOff(
+	ElementList			*list,
+	ElementPredicate	predicate,
+	void				*refCon,
+	ElementList			*sink,
+	size_t				offset )
+{
+	Element	*element_ = list->first;
+	Element	*survivor = NULL;	//	Last element kept so far.
+	size_t	removed = 0;
+
+	assertList( list );
+	assertTrue( list != sink );
+	assertIf( sink, sink->first == NULL || sink->last->next == NULL );
+
+	while( element_ ) {
+		Element	*next = element_->next;
+
+		if( (elementFlags( element_ ) & elementDeadFlag)
+				|| (predicate && !(elementFlags( element_ ) & elementMarkerFlag)
+					&& predicate( SubtractOffset( element_, offset ), refCon )) ) {
+			//	Append straight onto sink; survivors get relinked below.
+			elementalProbe( remove, list, element_, sweepOp );
+			elementalTraced( elementTraceSweep, list, element_, sink );
+			clearElementHits( element_ );
+			element_->next = NULL;
+			if( sink ) {
+				element_->prev = sink->last;
+				element_->list = sink;
+				stampElement( element_, sink );
+				if( sink->last )
+					sink->last->next = element_;
+				else
+					sink->first = element_;
+				sink->last = element_;
+			} else {
+				element_->prev = NULL;
+				element_->list = NULL;
+			}
+			removed++;
+		} else {
+			//	Only the first survivor after a removed run needs relinking.
+			if( element_->prev != survivor ) {
+				element_->prev = survivor;
+				if( survivor )
+					survivor->next = element_;
+				else
+					list->first = element_;
+			}
+			survivor = element_;
+		}
+		element_ = next;
+	}
+
+	if( list->last != survivor ) {
+		if( survivor )
+			survivor->next = NULL;
+		else
+			list->first = NULL;
+		list->last = survivor;
+	}
+
+	assertList( list );
+	return( removed );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+MarkElementDeadOff(
+	void	*element,
+	size_t	offset )
+{
+	MarkElementDead( AddOffset( element, offset ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+IsElementDeadOff(
+	void	*element,
+	size_t	offset )
+{
+	return( IsElementDead( AddOffset( element, offset ) ) );
+}
+
+/****************************************************************************************
+*
+*	Offset Cursors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Cursors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextCursorElementOff(
+	void			**element,
+	ElementCursor	*cursor,
 	size_t			offset )
 {
-	GrabLastElement( element, list );
+	NextCursorElement( element, cursor );
 	*element = SubtractOffset( *element, offset );
 }
 
+/****************************************************************************************
+*
+*	Offset Compaction
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Compaction)
+
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Records each move when tracing.
+	agent		Mon, Oct 19, 2026	Leaves cursor markers in place.
+	agent		Mon, Oct 19, 2026	Reads the marker tag in the list field.
+
+	************************************************************************************/
+
+	size_t
+CompactElementListOff(
+	ElementList			*list,
+	void				*arena,
+	size_t				arenaSize,
+	size_t				elementSize,
+	ElementRelocateProc	relocateProc,
+	void				*refCon,
+	size_t				offset )
+{
+	char	*slot = (char*) arena;
+	Element	*element_ = list->first;
+	Element	*prevCopy = NULL;
+	size_t	moved = 0;
+
+	assertList( list );
+	assertPtr( arena );
+	assertTrue( offset + sizeof( Element ) <= elementSize );
+
+	while( element_ && (moved + 1) * elementSize <= arenaSize ) {
+		Element	*next = element_->next;
+		char	*original;
+		Element	*copy;
+
+		//	Cursor markers aren't list structures; they stay put, linked in sequence.
+		if( elementFlags( element_ ) & elementMarkerFlag ) {
+			element_->prev = prevCopy;
+			if( prevCopy )
+				prevCopy->next = element_;
+			else
+				list->first = element_;
+			prevCopy = element_;
+			element_ = next;
+			continue;
+		}
+
+		original = (char*) SubtractOffset( element_, offset );
+		copy = (Element*) AddOffset( slot, offset );
+
+		//	The copy's next still points at the original successor, which is
+		//	either copied next time around or becomes the boundary below.
+		memcpy( slot, original, elementSize );
+		elementalTraced( elementTraceRelocate, list, element_, copy );
+		copy->prev = prevCopy;
+		if( prevCopy )
+			prevCopy->next = copy;
+		else
+			list->first = copy;
+
+		if( relocateProc )
+			relocateProc( original, slot, refCon );
+
+		prevCopy = copy;
+		slot += elementSize;
+		moved++;
+		element_ = next;
+	}
+
+	if( prevCopy ) {
+		prevCopy->next = element_;
+		if( element_ )
+			element_->prev = prevCopy;
+		else
+			list->last = prevCopy;
+	}
+
+	assertList( list );
+	return( moved );
+}
+
+/****************************************************************************************
+*
+*	Offset Relocation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Relocation)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-GrabNextElementOff(
-	void			*element,
-	void			**nextElement,
-	ElementList		*list,
-	size_t			offset )
+RelocateElementOff(
+	void	*oldElement,
+	void	*newElement,
+	size_t	offset )
 {
-	GrabNextElement( AddOffset( element, offset ), nextElement, list );
-	*nextElement = SubtractOffset( *nextElement, offset );
+	RelocateElement( AddOffset( oldElement, offset ), AddOffset( newElement, offset ) );
 }
 
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
-	wolf		Tue, Apr 6, 1999	Created.
+	agent		Mon, Oct 19, 2026	Created.
 
 	************************************************************************************/
 
 	void
-GrabPrevElementOff(
-	void			*element,
-	void			**prevElement,
-	ElementList		*list,
-	size_t			offset )
+RelocateElementArenaOff(
+	void	*oldArena,
+	void	*newArena,
+	size_t	arenaSize,
+	size_t	elementSize,
+	size_t	offset )
 {
-	GrabPrevElement( AddOffset( element, offset ), prevElement, list );
-	*prevElement = SubtractOffset( *prevElement, offset );
+	uintptr_t	oldStart = (uintptr_t) oldArena;
+	uintptr_t	delta = (uintptr_t) newArena - oldStart;	//	Modular, so either direction works.
+	char		*slot = (char*) newArena;
+	char		*end = slot + arenaSize / elementSize * elementSize;
+
+	assertPtr( newArena );
+	assertTrue( offset + sizeof( Element ) <= elementSize );
+
+	if( oldArena == newArena )
+		return;
+
+	//	A link into the old arena is translated; a link out of the new one
+	//	is followed and pointed back. The old arena is never dereferenced.
+	#define	inOldArena( ELEMENT )	((uintptr_t) (ELEMENT) - oldStart < arenaSize)
+	for( ; slot < end; slot += elementSize ) {
+		Element		*element_ = (Element*) (slot + offset);
+		ElementList	*list = elementList( element_ );
+
+		if( list == NULL || isElementStale( element_ ) )
+			continue;
+		assertTrue( !inOldArena( list ) );
+		elementalTraced( elementTraceRelocate, list, (void*) ((uintptr_t) element_ - delta), element_ );
+
+		if( element_->prev == NULL )
+			list->first = element_;
+		else if( inOldArena( element_->prev ) )
+			element_->prev = (Element*) ((uintptr_t) element_->prev + delta);
+		else
+			element_->prev->next = element_;
+
+		if( element_->next == NULL )
+			list->last = element_;
+		else if( inOldArena( element_->next ) )
+			element_->next = (Element*) ((uintptr_t) element_->next + delta);
+		else
+			element_->next->prev = element_;
+	}
+	#undef	inOldArena
 }
 
 /****************************************************************************************
@@ -816,7 +2133,7 @@ AddOffset(
 	char	*result = (char*) element;
 
 	assertPtrIfNotNil( element );
-	assertTrue( offset >= 0 && offset < 1024 );
+	assertTrue( offset < 1024 );
 
 	if( element )
 		result += offset;
@@ -839,7 +2156,7 @@ SubtractOffset(
 	char	*result = (char*) element;
 
 	assertPtrIfNotNil( element );
-	assertTrue( offset >= 0 && offset < 1024 );
+	assertTrue( offset < 1024 );
 
 	if( element )
 		result -= offset;
@@ -847,6 +2164,384 @@ SubtractOffset(
 	return( result );
 }
 
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	wolf		Tue, Apr 6, 1999	Created.
+	wolf		Wed, May 31, 2000	Updated to support the new list field in Element.
+	agent		Sun, Oct 18, 2026	Accounts for elements marked dead.
+	agent		Sun, Oct 18, 2026	Moved here from RemoveElement(), to tell probes which
+								operation did the removing.
+	agent		Mon, Oct 19, 2026	Records the removal when tracing.
+	agent		Mon, Oct 19, 2026	Disregards elements cleared from their list.
+	agent		Mon, Oct 19, 2026	Lists no longer count their dead.
+	agent		Mon, Oct 19, 2026	Marks op used when built without probes or tracing.
+
+	************************************************************************************/
+
+	static
+	void
+RemoveElementAs(
+	void			*element,
+	ElementList		*list,
+	int				op )
+{
+	Element	*element_ = (Element*) element;
+
+	(void) op;	//	Only probes and traces read it.
+	assertElement( element );
+	assertList( list );
+	elementalProbe( remove, list, element, op );
+	elementalTraced( elementTraceRemove + op, list, element, NULL );
+
+	//	Its links went stale when its list was cleared; there's nothing to undo.
+	if( isElementStale( element_ ) ) {
+		element_->prev = element_->next = NULL;
+		element_->list = NULL;
+		clearElementHits( element_ );
+		return;
+	}
+
+	if( list->first == element_ )
+		list->first = element_->next;
+	if( list->last == element_ )
+		list->last = element_->prev;
+	if( element_->prev )
+		element_->prev->next = element_->next;
+	if( element_->next )
+		element_->next->prev = element_->prev;
+	element_->prev = element_->next = NULL;
+	element_->list = NULL;
+	clearElementHits( element_ );
+
+	assertTrue( !FindElement( element, list ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Renamed from SkipDeadForward(); also skips cursor markers.
+	agent		Mon, Oct 19, 2026	Reads the tags in the list field.
+
+	************************************************************************************/
+
+	static
+	Element*
+SkipHiddenForward(
+	Element	*element )
+{
+	while( element && elementFlags( element ) )
+		element = element->next;
+	return( element );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Renamed from SkipDeadBackward(); also skips cursor markers.
+	agent		Mon, Oct 19, 2026	Reads the tags in the list field.
+
+	************************************************************************************/
+
+	static
+	Element*
+SkipHiddenBackward(
+	Element	*element )
+{
+	while( element && elementFlags( element ) )
+		element = element->prev;
+	return( element );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+MoveElementBefore(
+	Element		*element,
+	Element		*before,
+	ElementList	*list )
+{
+#if	elementalSearchCounts
+	unsigned	hits = element->hits;	//	Putting clears them.
+#endif
+
+	RemoveElement( element, list );
+	PutBeforeElement( element, before, list );
+#if	elementalSearchCounts
+	element->hits = hits;
+#endif
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LinkMarker(
+	Element		*marker,
+	Element		*after,
+	ElementList	*list )
+{
+	Element	*before = after ? after->next : list->first;
+
+	clearElementHits( marker );
+	marker->list = tagElementList( list, elementMarkerFlag );
+	stampElement( marker, list );
+	marker->prev = after;
+	marker->next = before;
+	if( after )
+		after->next = marker;
+	else
+		list->first = marker;
+	if( before )
+		before->prev = marker;
+	else
+		list->last = marker;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnlinkMarker(
+	Element	*marker )
+{
+	ElementList	*list = elementList( marker );
+
+	if( list && !isElementStale( marker ) ) {
+		if( marker->prev )
+			marker->prev->next = marker->next;
+		else
+			list->first = marker->next;
+		if( marker->next )
+			marker->next->prev = marker->prev;
+		else
+			list->last = marker->prev;
+	}
+	marker->prev = marker->next = NULL;
+	marker->list = NULL;
+	clearElementHits( marker );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Writes a full buffer after dropping the spinlock.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	void
+TraceElement(
+	int			op,
+	const void	*list,
+	const void	*element,
+	const void	*anchor )
+{
+	ElementTraceRecord	*full = NULL;
+	uint64_t			ticket = 0;
+	int					fd = -1;
+
+	lockElementTrace();
+	//	Checked again: the trace may have stopped since the caller looked.
+	while( gElementTrace.fd >= 0 && gElementTrace.filling == NULL )
+		WaitElementTraceBuffer();
+	if( gElementTrace.fd >= 0 ) {
+		ElementTraceRecord	*record = &gElementTrace.filling[ gElementTrace.count++ ];
+
+		record->op = (uint32_t) op;
+		record->reserved = 0;
+		record->list = TraceID( list );
+		record->element = TraceID( element );
+		record->anchor = TraceID( anchor );
+
+		if( gElementTrace.count == elementalTraceBatch ) {
+			full = gElementTrace.filling;
+			fd = gElementTrace.fd;
+			ticket = gElementTrace.tickets++;
+			gElementTrace.filling = gElementTrace.spareCount
+				? gElementTrace.spares[ --gElementTrace.spareCount ] : NULL;
+			gElementTrace.count = 0;
+		}
+	}
+	unlockElementTrace();
+
+	if( full ) {
+		int	savedErrno = errno;	//	Our callers don't set errno.
+
+		WriteElementTrace( fd, full, elementalTraceBatch, ticket );
+		errno = savedErrno;
+	}
+}
+#endif
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	uint64_t
+TraceID(
+	const void	*address )
+{
+	uint64_t	id = (uint64_t) (uintptr_t) address ^ gElementTrace.key;
+
+	if( address == NULL )
+		return( 0 );
+
+	//	SplitMix64's finalizer: a bijection, so distinct addresses stay distinct.
+	id = (id ^ (id >> 30)) * UINT64_C( 0xbf58476d1ce4e5b9 );
+	id = (id ^ (id >> 27)) * UINT64_C( 0x94d049bb133111eb );
+	return( id ^ (id >> 31) );
+}
+#endif
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	void
+WaitElementTraceBuffer( void )
+{
+	//	Called, and returns, with the spinlock held. The condition is checked
+	//	under writeLock too, so a buffer coming back can't be missed.
+	unlockElementTrace();
+	pthread_mutex_lock( &gElementTrace.writeLock );
+	lockElementTrace();
+	if( gElementTrace.fd >= 0 && gElementTrace.filling == NULL ) {
+		unlockElementTrace();
+		pthread_cond_wait( &gElementTrace.wrote, &gElementTrace.writeLock );
+	} else
+		unlockElementTrace();
+	pthread_mutex_unlock( &gElementTrace.writeLock );
+	lockElementTrace();
+}
+#endif
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	void
+WaitElementTraceTurn(
+	uint64_t	ticket )
+{
+	pthread_mutex_lock( &gElementTrace.writeLock );
+	while( gElementTrace.written != ticket )
+		pthread_cond_wait( &gElementTrace.wrote, &gElementTrace.writeLock );
+	pthread_mutex_unlock( &gElementTrace.writeLock );
+}
+#endif
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	void
+EndElementTraceTurn( void )
+{
+	pthread_mutex_lock( &gElementTrace.writeLock );
+	gElementTrace.written++;
+	pthread_cond_broadcast( &gElementTrace.wrote );
+	pthread_mutex_unlock( &gElementTrace.writeLock );
+}
+#endif
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+#if	elementalTrace
+	static
+	void
+WriteElementTrace(
+	int					fd,
+	ElementTraceRecord	*records,
+	size_t				count,
+	uint64_t			ticket )
+{
+	const char	*bytes = (const char*) records;
+	size_t		length = count * sizeof( ElementTraceRecord );
+	bool		failed;
+
+	WaitElementTraceTurn( ticket );
+
+	lockElementTrace();
+	failed = gElementTrace.failed;
+	unlockElementTrace();
+	while( !failed && length ) {
+		ssize_t	written = write( fd, bytes, length );
+
+		if( written < 0 && errno == EINTR )
+			continue;
+		if( written <= 0 ) {
+			//	Stop, and drop the buffers behind this one, rather than leave a
+			//	hole in the middle of the trace.
+			lockElementTrace();
+			gElementTrace.failed = true;
+			__atomic_store_n( &gElementTrace.fd, -1, __ATOMIC_RELAXED );
+			unlockElementTrace();
+			break;
+		}
+		bytes += written;
+		length -= (size_t) written;
+	}
+
+	//	The buffer is free: fill it next if nothing is filling, else keep it spare.
+	if( records ) {
+		lockElementTrace();
+		if( gElementTrace.filling == NULL ) {
+			gElementTrace.filling = records;
+			gElementTrace.count = 0;
+		} else
+			gElementTrace.spares[ gElementTrace.spareCount++ ] = records;
+		unlockElementTrace();
+	}
+	EndElementTraceTurn();
+}
+#endif
+
 /****************************************************************************************
 	Commenter	Date				Comment
 	---------	-----------------	-----------------------------------------------------
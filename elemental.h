@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 __BEGIN_DECLS
 
@@ -23,29 +24,158 @@ __BEGIN_DECLS
 **************************/
 #pragma mark	(Types)
 
+//	Alignment and size used by the cache-conscious variants.
+#ifndef	elementalCacheLine
+	#define	elementalCacheLine	64
+#endif
+
+//	Nonzero gives every Element and ElementList a generation, which makes
+//	ClearElementList() constant-time; see there. It changes both structures'
+//	layout, so the library and all its users must agree on it.
+#ifndef	elementalGenerations
+	#define	elementalGenerations	0
+#endif
+#if	elementalGenerations
+	#define	elementalGenerationInit( VALUE )	, generation( VALUE )
+#else
+	#define	elementalGenerationInit( VALUE )
+#endif
+
+//	Nonzero gives every Element a count of FindElementByKey() hits, which the
+//	elementSearchCount policy orders by; see there. Off, an Element is three
+//	pointers. Like elementalGenerations, it changes Element's layout.
+#ifndef	elementalSearchCounts
+	#define	elementalSearchCounts	0
+#endif
+#if	elementalSearchCounts
+	#define	elementalHitsInit( VALUE )	, hits( VALUE )
+#else
+	#define	elementalHitsInit( VALUE )
+#endif
+
 typedef	struct	Element		Element;
 typedef	struct	ElementList	ElementList;
+typedef	struct	ElementCursor	ElementCursor;
+
+//	Return whether element should be removed. Must not modify the list.
+typedef	bool	(*ElementPredicate)( void *element, void *refCon );
+
+//	Return 0 if element has key, as strcmp() does for equal strings.
+typedef	int		(*ElementCompareProc)( void *element, const void *key );
+
+//	Told that element has been copied from oldElement to newElement.
+typedef	void	(*ElementRelocateProc)( void *oldElement, void *newElement, void *refCon );
+
+#ifdef	__cplusplus
+//	ElementList's destructor, and Element's move operations, call these
+//	before the sections below declare them.
+	void
+DeleteElementList(
+	ElementList	*list );
+
+	void
+RemoveElement(
+	void			*element,
+	ElementList		*list );
+
+	void
+RelocateElement(
+	void	*oldElement,
+	void	*newElement );
+
+	ElementList*
+GetElementList(
+	void	*element );
+#endif
 
 struct	Element	{
 	Element		*next;
 	Element		*prev;
-	ElementList	*list;
+	ElementList	*list;			//	Tagged, and possibly stale: read it with GetElementList().
+#if	elementalSearchCounts
+	unsigned	hits;			//	FindElementByKey() hits, saturating.
+#endif
+#if	elementalGenerations
+	uint64_t	generation;		//	list's generation when put.
+#endif
 
 #ifdef	__cplusplus
-	Element() : next( NULL ), prev( NULL ), list( NULL ){}
+	constexpr Element() : next( NULL ), prev( NULL ), list( NULL ) elementalHitsInit( 0 ) elementalGenerationInit( 0 ){}
+	constexpr Element( Element *next_, Element *prev_, ElementList *list_ )
+			: next( next_ ), prev( prev_ ), list( list_ ) elementalHitsInit( 0 ) elementalGenerationInit( 0 ){}
+
+	//	A copy starts out in no list, and assigning leaves membership alone.
+	constexpr Element( const Element& ) : next( NULL ), prev( NULL ), list( NULL ) elementalHitsInit( 0 ) elementalGenerationInit( 0 ){}
+	Element& operator=( const Element& ) { return( *this ); }
+
+	//	A move takes other's place in its list, leaving other in none. noexcept, so
+	//	containers such as std::vector move rather than copy when they grow.
+	Element( Element &&other ) noexcept : next( other.next ), prev( other.prev ), list( other.list )
+			elementalHitsInit( other.hits ) elementalGenerationInit( other.generation ) {
+		RelocateElement( &other, this );
+		other.next = other.prev = NULL;
+		other.list = NULL;
+#if	elementalSearchCounts
+		other.hits = 0;
+#endif
+	}
+	Element& operator=( Element &&other ) noexcept {
+		if( this != &other ) {
+			if( ElementList *current = GetElementList( this ) )
+				RemoveElement( this, current );
+			next = other.next;
+			prev = other.prev;
+			list = other.list;
+#if	elementalSearchCounts
+			hits = other.hits;
+			other.hits = 0;
+#endif
+#if	elementalGenerations
+			generation = other.generation;
+#endif
+			RelocateElement( &other, this );
+			other.next = other.prev = NULL;
+			other.list = NULL;
+		}
+		return( *this );
+	}
 #endif
 };
 
 struct	ElementList	{
-	Element	*first;
-	Element	*last;
+	Element		*first;
+	Element		*last;
+#if	elementalGenerations
+	uint64_t	generation;	//	Bumped by ClearElementList().
+#endif
 
 #ifdef	__cplusplus
-	ElementList() { NewElementList(this); }
+	constexpr ElementList() : first( NULL ), last( NULL ) elementalGenerationInit( 0 ){}
+	constexpr ElementList( Element *first_, Element *last_ )
+			: first( first_ ), last( last_ ) elementalGenerationInit( 0 ){}
 	~ElementList() { DeleteElementList(this); }
 #endif
 };
 
+//	Holds a scan's place in a list; see OpenElementCursor().
+struct	ElementCursor	{
+	Element		marker;
+};
+
+//	Static initializers, constant in C and C++ alike, for lists linked at
+//	compile time:
+//
+//		extern ElementList	handlers;
+//		Handler				table[] = {
+//			{ ElementInitializer( &table[1].element, NULL, &handlers ), ... },
+//			{ ElementInitializer( NULL, &table[0].element, &handlers ), ... } };
+//		ElementList			handlers = ElementListInitializer( &table[0].element, &table[1].element );
+//
+//	An empty list is ElementListInitializer( NULL, NULL ), and an element in
+//	none ElementInitializer( NULL, NULL, NULL ).
+#define	ElementInitializer( NEXT, PREV, LIST )	{ (NEXT), (PREV), (LIST) }
+#define	ElementListInitializer( FIRST, LAST )	{ (FIRST), (LAST) }
+
 /**************************
 *
 *	Lifetime
@@ -62,6 +192,23 @@ NewElementList(
 DeleteElementList(
 	ElementList	*list );
 
+//	If list == a, b, c
+//	Then list = (empty), and a, b, c are in no list
+//	Linear: visits each element to take it out.
+//	With elementalGenerations, constant-time instead: bumps list's generation,
+//	so that elements stamped with an older one count as in no list. Their own
+//	links are left stale, and all the functions here disregard them; code that
+//	reads an Element's list field directly must use GetElementList() instead.
+//	Telling that an element is stale reads its old list, so a cleared list
+//	must outlive the elements it held, or each must be put in another list or
+//	zeroed before anything else is done with it. A DEBUG build asserts when
+//	an element is asked about its deleted list. NewElementList() on a cleared
+//	list leaves its generation alone, so its old elements stay stale; it is
+//	no substitute for putting or zeroing them once the list is deleted.
+	void
+ClearElementList(
+	ElementList	*list );
+
 /**************************
 *
 *	Putters
@@ -102,6 +249,19 @@ PutAfterElement(
 	void			*after,
 	ElementList		*list );
 
+//	If from == a, b, c, d && first == b && last == c && to == x, y
+//	Then from = a, d && to = x, y, b, c, or b, c, x, y if toFront
+//	Linear in the run, which it walks to retag. Dead elements in the run go
+//	with it, still dead; cursors' markers in it stay behind in from, where
+//	the run was. Probes and traces see each element removed and put.
+	void
+SpliceElements(
+	void			*first,
+	void			*last,
+	ElementList		*from,
+	ElementList		*to,
+	bool			toFront );
+
 /**************************
 *
 *	Accessors
@@ -110,6 +270,10 @@ PutAfterElement(
 #pragma mark	-
 #pragma mark	(Accessors)
 
+//	These four, and IsListEmpty(), skip elements marked dead and cursors: each
+//	is constant-time plus one step per hidden element it passes over, so a long
+//	run of dead elements costs the first walk across it until the next sweep.
+
 //	If list == a, b, c
 //	Then *element = a
 	void
@@ -138,22 +302,54 @@ PrevElement(
 	void		*element,
 	void		**prevElement );
 
-//	Return whether element is in list. The only linear-time function here.
+//	Return whether element is in list. Linear-time.
 	bool
 FindElement(
 	void			*element,
 	ElementList		*list );
 
-//	Returns the given element's list.
+//	Returns the given element's list, or NULL if it is in none.
 	ElementList*
 GetElementList(
 	void	*element );
 
-//	Returns whether the list is empty.
+//	Returns whether the list is empty. Walks any hidden elements at its front.
 	bool
 IsListEmpty(
 	ElementList	*list );
 
+/**************************
+*
+*	Searching
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Searching)
+
+//	How FindElementByKey() reorganizes list after a hit.
+enum	{
+	elementSearchStatic,		//	Leaves the order alone.
+	elementSearchMoveToFront,	//	Moves the hit first.
+	elementSearchTranspose,		//	Swaps the hit with the element before it.
+	elementSearchCount			//	Counts hits, keeping the list in descending
+								//	count order; ties stay oldest first. Without
+								//	elementalSearchCounts, transposes instead.
+};
+
+//	If list == a, b, c && compareProc( b, key ) == 0
+//	Then *element = b, and list may be reordered by policy
+//	Otherwise *element = NULL
+//	A linear walk that, under skewed access, moves what is looked up often
+//	toward the front for the next search. Reordering moves elements across
+//	any cursors, and putting an element resets its count.
+	void
+FindElementByKey(
+	void				**element,
+	ElementList			*list,
+	const void			*key,
+	ElementCompareProc	compareProc,
+	int					policy );
+
 /**************************
 *
 *	Grabbing
@@ -200,6 +396,254 @@ GrabPrevElement(
 	void			**prevElement,
 	ElementList		*list );
 
+/**************************
+*
+*	Sweeping
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Sweeping)
+
+//	If list == a, b, c, d && predicate( b ) && predicate( d )
+//	Then list = a, c && sink = ..., b, d
+//	One linear pass that only relinks around runs of removed elements.
+//	Elements marked dead are always removed without consulting predicate,
+//	which may be NULL. sink may be NULL, in which case removed elements are
+//	simply detached. Returns the number of elements removed.
+	size_t
+RemoveElementsIf(
+	ElementList			*list,
+	ElementPredicate	predicate,
+	void				*refCon,
+	ElementList			*sink );
+
+//	O(1) lazy removal: element stays linked but is skipped by the accessors
+//	(and so by FindElement and the grabbers) until the next sweep. The mark
+//	is a tag in element's list field, so it costs no space. Marking an
+//	element that is in no list does nothing. Until it has been swept, a dead
+//	element must not be put in any list, nor freed: its neighbours still
+//	point at it.
+	void
+MarkElementDead(
+	void	*element );
+
+//	Returns whether element has been marked dead and not yet swept.
+	bool
+IsElementDead(
+	void	*element );
+
+//	If list == a, b, c && b is dead
+//	Then list = a, c && sink = ..., b
+//	Linear-time, as RemoveElementsIf() is. sink may be NULL.
+	size_t
+SweepElementList(
+	ElementList	*list,
+	ElementList	*sink );
+
+/**************************
+*
+*	Cursors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Cursors)
+
+//	A cursor is a marker Element that sits in the list itself, hidden from the
+//	accessors (and so from FindElement and the grabbers), sweeps and
+//	compaction. Elements around it may be put and removed freely, so a scan
+//	done a slice at a time resumes where it stopped in constant time. Use
+//	cursors only on lists managed by the functions in this file, and close
+//	them before the list goes away. ClearElementList() leaves them in none.
+
+//	If list == a, b, c
+//	Then list = ^, a, b, c, where ^ is cursor
+	void
+OpenElementCursor(
+	ElementCursor	*cursor,
+	ElementList		*list );
+
+	void
+CloseElementCursor(
+	ElementCursor	*cursor );
+
+//	If list == a, b, ^, c
+//	Then list = ^, a, b, c
+	void
+RewindElementCursor(
+	ElementCursor	*cursor );
+
+//	If list == a, ^, b, c
+//	Then list = a, b, ^, c && *element = b
+//	At the end of the list, *element = NULL and the cursor stays put.
+	void
+NextCursorElement(
+	void			**element,
+	ElementCursor	*cursor );
+
+//	If list == ^, a, b, c && count == 2
+//	Then list = a, b, ^, c
+//	Returns how many elements were passed, less than count at the end of the list.
+	size_t
+AdvanceElementCursor(
+	ElementCursor	*cursor,
+	size_t			count );
+
+/**************************
+*
+*	Compaction
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Compaction)
+
+//	If list == a, b, c
+//	Then a, b, c are copied to arena back-to-back, in that order, and list
+//	links the copies. Each element occupies elementSize bytes. If the arena
+//	is too small, only the leading elements that fit are moved. relocateProc,
+//	if any, is called as each element is copied so callers can patch outside
+//	references and free the original; it must not touch list. Returns the
+//	number of elements moved.
+	size_t
+CompactElementList(
+	ElementList			*list,
+	void				*arena,
+	size_t				arenaSize,
+	size_t				elementSize,
+	ElementRelocateProc	relocateProc,
+	void				*refCon );
+
+//	Returns the average distance in bytes between neighbouring elements,
+//	or 0 for lists of fewer than two. Compare against the element size to
+//	judge whether CompactElementList() is worthwhile.
+	size_t
+ElementListLocality(
+	ElementList	*list );
+
+/**************************
+*
+*	Relocation
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Relocation)
+
+//	If list == a, b, c && b has been copied bitwise to newElement
+//	Then list = a, b', c, where b' is the copy at newElement
+//	Constant-time. The original is never touched, so it may already be freed,
+//	as after realloc(). Does nothing if the copy is in no list.
+	void
+RelocateElement(
+	void	*oldElement,
+	void	*newElement );
+
+//	Repairs every link into, out of and within an arena of elementSize-byte
+//	slots, each starting with its Element, that has been copied wholesale from
+//	oldArena to newArena, as realloc() does. Slots in no list must have a NULL
+//	list field, as zero-filled and removed slots do, and the arena must not
+//	itself hold the lists. Linear in the number of slots.
+	void
+RelocateElementArena(
+	void	*oldArena,
+	void	*newArena,
+	size_t	arenaSize,
+	size_t	elementSize );
+
+/**************************
+*
+*	Registries
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Registries)
+
+//	For lists of handlers or plugins contributed from many files. Where each
+//	is defined, RegisterElement( NAME, &handler.element ) files a pointer to
+//	it in a linker section, at no runtime cost. In one file,
+//	DefineElementRegistry( NAME ) defines the list, and wherever it is used,
+//	DeclareElementRegistry( NAME ) declares GetNAMERegistry(), which links
+//	every registered element into it, in link order, on first call. ELF only.
+//	Registered elements must be in no list; with --gc-sections, the linker
+//	must also be told to keep the sections. Registrations may share a line,
+//	so a macro may expand to many. The first call stitches them in one pass,
+//	linear in their number; later calls are an acquire load.
+
+//	Puts the elements between start and stop last in list, unless state says
+//	that has been done. Safe to call from any number of threads at once.
+	void
+StitchElementRegistry(
+	ElementList		*list,
+	unsigned		*state,
+	void *const		*start,
+	void *const		*stop );
+
+#define	elementalConcat_( A, B )	A##B
+#define	elementalConcat( A, B )		elementalConcat_( A, B )
+
+#define	RegisterElement( NAME, ELEMENT )	\
+	static void *const elementalConcat( elementalRegistered##NAME, __COUNTER__ )	\
+		__attribute__(( used, section( "elementalRegistry" #NAME ) )) = (ELEMENT)
+
+#define	DefineElementRegistry( NAME )	\
+	ElementList	NAME##Registry = ElementListInitializer( NULL, NULL );	\
+	unsigned	NAME##RegistryState = 0
+
+#define	DeclareElementRegistry( NAME )	\
+	extern ElementList	NAME##Registry;	\
+	extern unsigned		NAME##RegistryState;	\
+	extern void *const	__start_elementalRegistry##NAME[] __attribute__(( weak ));	\
+	extern void *const	__stop_elementalRegistry##NAME[] __attribute__(( weak ));	\
+	\
+	static inline ElementList* Get##NAME##Registry( void ) {	\
+		if( __atomic_load_n( &NAME##RegistryState, __ATOMIC_ACQUIRE ) != 2 )	\
+			StitchElementRegistry( &NAME##Registry, &NAME##RegistryState,	\
+					__start_elementalRegistry##NAME, __stop_elementalRegistry##NAME );	\
+		return( &NAME##Registry ); }	\
+	\
+	typedef	int	NAME##RegistryDeclared	/* swallows the trailing semicolon */
+
+/**************************
+*
+*	Tracing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Tracing)
+
+//	The op of an ElementTraceRecord.
+enum	{
+	elementTracePutFirst, elementTracePutLast, elementTracePutBefore, elementTracePutAfter,
+	elementTraceRemove, elementTraceGrabFirst, elementTraceGrabLast, elementTraceGrabNext, elementTraceGrabPrev,
+	elementTraceSweep,		//	anchor is the sink, or 0.
+	elementTraceRelocate,	//	anchor is element's new ID.
+	elementTraceClear,		//	element is 0.
+	elementTraceNewList		//	Never recorded; see elementaltrace.h.
+};
+
+typedef	struct	ElementTraceRecord	ElementTraceRecord;
+
+//	IDs are element and list addresses scrambled with a per-trace key: stable
+//	within a trace, unique, zero for NULL, and meaningless outside it.
+struct	ElementTraceRecord	{
+	uint32_t	op;
+	uint32_t	reserved;
+	uint64_t	list;
+	uint64_t	element;
+	uint64_t	anchor;		//	PutBefore's before or PutAfter's after, else 0.
+};
+
+//	Starts appending an ElementTraceRecord to fd for every put and unlink, in
+//	every thread. Records are buffered; the thread that fills a buffer writes
+//	it while others go on recording, and StopElementTrace() flushes the rest.
+//	Returns false, with errno = ENOTSUP, unless built with elementalTrace.
+	bool
+StartElementTrace(
+	int	fd );
+
+//	Flushes and stops. Returns false if any write failed, which also stops
+//	the trace early, and false with errno = EINVAL if no trace was running.
+	bool
+StopElementTrace( void );
+
 /**************************
 *
 *	Offset Putters
@@ -244,6 +688,17 @@ PutAfterElementOff(
 	ElementList		*list,
 	size_t			offset );
 
+//	If from == a, b, c, d && first == b && last == c && to == x, y
+//	Then from = a, d && to = x, y, b, c, or b, c, x, y if toFront
+	void
+SpliceElementsOff(
+	void			*first,
+	void			*last,
+	ElementList		*from,
+	ElementList		*to,
+	bool			toFront,
+	size_t			offset );
+
 /**************************
 *
 *	Offset Accessors
@@ -284,19 +739,37 @@ PrevElementOff(
 	void		**prevElement,
 	size_t		offset );
 
-//	Return whether element is in list. The only linear-time function here.
+//	Return whether element is in list. Linear-time.
 	bool
 FindElementOff(
 	void			*element,
 	ElementList		*list,
 	size_t			offset );
 
-//	Returns the given element's list.
+//	Returns the given element's list, or NULL if it is in none.
 	ElementList*
 GetElementListOff(
 	void	*element,
 	size_t	offset );
 
+/**************************
+*
+*	Offset Searching
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Searching)
+
+//	As FindElementByKey(); compareProc is passed structure addresses.
+	void
+FindElementByKeyOff(
+	void				**element,
+	ElementList			*list,
+	const void			*key,
+	ElementCompareProc	compareProc,
+	int					policy,
+	size_t				offset );
+
 /**************************
 *
 *	Offset Grabbing
@@ -348,6 +821,97 @@ GrabPrevElementOff(
 	ElementList		*list,
 	size_t			offset );
 
+/**************************
+*
+*	Offset Sweeping
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Sweeping)
+
+//	If list == a, b, c, d && predicate( b ) && predicate( d )
+//	Then list = a, c && sink = ..., b, d
+	size_t
+RemoveElementsIfOff(
+	ElementList			*list,
+	ElementPredicate	predicate,
+	void				*refCon,
+	ElementList			*sink,
+	size_t				offset );
+
+//	O(1) lazy removal, swept later by SweepElementList().
+	void
+MarkElementDeadOff(
+	void	*element,
+	size_t	offset );
+
+//	Returns whether element has been marked dead and not yet swept.
+	bool
+IsElementDeadOff(
+	void	*element,
+	size_t	offset );
+
+/**************************
+*
+*	Offset Cursors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Cursors)
+
+//	If list == a, ^, b, c
+//	Then list = a, b, ^, c && *element = b
+	void
+NextCursorElementOff(
+	void			**element,
+	ElementCursor	*cursor,
+	size_t			offset );
+
+/**************************
+*
+*	Offset Compaction
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Compaction)
+
+//	As CompactElementList(), where each element's Element is offset bytes into
+//	its elementSize-byte structure. relocateProc gets structure addresses.
+	size_t
+CompactElementListOff(
+	ElementList			*list,
+	void				*arena,
+	size_t				arenaSize,
+	size_t				elementSize,
+	ElementRelocateProc	relocateProc,
+	void				*refCon,
+	size_t				offset );
+
+/**************************
+*
+*	Offset Relocation
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Relocation)
+
+//	As RelocateElement(), given the structures rather than their Elements.
+	void
+RelocateElementOff(
+	void	*oldElement,
+	void	*newElement,
+	size_t	offset );
+
+//	As RelocateElementArena(), where each slot's Element is offset bytes in.
+//	Call once per offset for structures holding several Elements.
+	void
+RelocateElementArenaOff(
+	void	*oldArena,
+	void	*newArena,
+	size_t	arenaSize,
+	size_t	elementSize,
+	size_t	offset );
+
 /**************************
 *
 *	Type Putters
@@ -378,6 +942,11 @@ GrabPrevElementOff(
 #define	PutAfterElementType( ELEMENT, AFTER, LIST, STRUCTURE, FIELD )	\
 			PutAfterElementOff( (ELEMENT), (AFTER), (LIST), offsetof( STRUCTURE, FIELD ) )
 
+//	If from == a, b, c, d && first == b && last == c && to == x, y
+//	Then from = a, d && to = x, y, b, c, or b, c, x, y if toFront
+#define	SpliceElementsType( FIRST, LAST, FROM, TO, TOFRONT, STRUCTURE, FIELD )	\
+			SpliceElementsOff( (FIRST), (LAST), (FROM), (TO), (TOFRONT), offsetof( STRUCTURE, FIELD ) )
+
 /**************************
 *
 *	Type Accessors
@@ -406,14 +975,27 @@ GrabPrevElementOff(
 #define	PrevElementType( ELEMENT, PREVELEMENT, STRUCTURE, FIELD )	\
 			PrevElementOff( (ELEMENT), (PREVELEMENT), offsetof( STRUCTURE, FIELD ) )
 
-//	Return whether element is in list. The only linear-time function here.
+//	Return whether element is in list. Linear-time.
 #define	FindElementType( ELEMENT, LIST, STRUCTURE, FIELD )	\
 			FindElementOff( (ELEMENT), (LIST), offsetof( STRUCTURE, FIELD ) )
 
-//	Returns the given element's list.
+//	Returns the given element's list, or NULL if it is in none.
 #define	GetElementListType( ELEMENT, STRUCTURE, FIELD )	\
 			GetElementListOff( (ELEMENT), offsetof( STRUCTURE, FIELD ) )
 
+/**************************
+*
+*	Type Searching
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Searching)
+
+//	If list == a, b, c && compareProc( b, key ) == 0
+//	Then *element = b, and list may be reordered by policy
+#define	FindElementByKeyType( ELEMENT, LIST, KEY, COMPAREPROC, POLICY, STRUCTURE, FIELD )	\
+			FindElementByKeyOff( (void**)(ELEMENT), (LIST), (KEY), (COMPAREPROC), (POLICY), offsetof( STRUCTURE, FIELD ) )
+
 /**************************
 *
 *	Type Grabbing
@@ -448,5 +1030,148 @@ GrabPrevElementOff(
 #define	GrabPrevElementType( ELEMENT, PREVELEMENT, LIST, STRUCTURE, FIELD )	\
 			GrabPrevElementOff( (ELEMENT), (PREVELEMENT), (LIST), offsetof( STRUCTURE, FIELD ) )
 
+/**************************
+*
+*	Type Sweeping
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Sweeping)
+
+//	If list == a, b, c, d && predicate( b ) && predicate( d )
+//	Then list = a, c && sink = ..., b, d
+#define	RemoveElementsIfType( LIST, PREDICATE, REFCON, SINK, STRUCTURE, FIELD )	\
+			RemoveElementsIfOff( (LIST), (PREDICATE), (REFCON), (SINK), offsetof( STRUCTURE, FIELD ) )
+
+//	O(1) lazy removal, swept later by SweepElementList().
+#define	MarkElementDeadType( ELEMENT, STRUCTURE, FIELD )	\
+			MarkElementDeadOff( (ELEMENT), offsetof( STRUCTURE, FIELD ) )
+
+//	Returns whether element has been marked dead and not yet swept.
+#define	IsElementDeadType( ELEMENT, STRUCTURE, FIELD )	\
+			IsElementDeadOff( (ELEMENT), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Type Cursors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Cursors)
+
+//	If list == a, ^, b, c
+//	Then list = a, b, ^, c && *element = b
+#define	NextCursorElementType( ELEMENT, CURSOR, STRUCTURE, FIELD )	\
+			NextCursorElementOff( (void**)(ELEMENT), (CURSOR), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Type Compaction
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Compaction)
+
+//	Copies list's STRUCTUREs into arena in traversal order.
+#define	CompactElementListType( LIST, ARENA, ARENASIZE, RELOCATEPROC, REFCON, STRUCTURE, FIELD )	\
+			CompactElementListOff( (LIST), (ARENA), (ARENASIZE), sizeof( STRUCTURE ), (RELOCATEPROC), (REFCON), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Type Relocation
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Relocation)
+
+//	Repairs links after a STRUCTURE is copied from OLDELEMENT to NEWELEMENT.
+#define	RelocateElementType( OLDELEMENT, NEWELEMENT, STRUCTURE, FIELD )	\
+			RelocateElementOff( (OLDELEMENT), (NEWELEMENT), offsetof( STRUCTURE, FIELD ) )
+
+//	Repairs links after an array of STRUCTUREs moves from OLDARENA to NEWARENA.
+#define	RelocateElementArenaType( OLDARENA, NEWARENA, ARENASIZE, STRUCTURE, FIELD )	\
+			RelocateElementArenaOff( (OLDARENA), (NEWARENA), (ARENASIZE), sizeof( STRUCTURE ), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Typed Lists
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Typed Lists)
+
+//	DeclareElementList( Job, JobRecord, queueElement ) declares a JobList type
+//	and static inline PutFirstJob( JobRecord*, JobList* ), NextJob(...) and so on,
+//	mirroring the functions above. Unlike the *Type macros, arguments are type
+//	checked and the field offset is a compile-time constant, so each call is a
+//	single call into the plain (offset-free) function.
+#define	DeclareElementList( NAME, STRUCTURE, FIELD )	\
+	typedef	struct	{ ElementList list; }	NAME##List;	\
+	\
+	static inline STRUCTURE* NAME##FromElement( Element *element ) {	\
+		return( element ? (STRUCTURE*) ((char*) element - offsetof( STRUCTURE, FIELD )) : NULL ); }	\
+	\
+	static inline void New##NAME##List( NAME##List *list ) {	\
+		NewElementList( &list->list ); }	\
+	static inline void Delete##NAME##List( NAME##List *list ) {	\
+		DeleteElementList( &list->list ); }	\
+	static inline void Clear##NAME##List( NAME##List *list ) {	\
+		ClearElementList( &list->list ); }	\
+	\
+	static inline void PutFirst##NAME( STRUCTURE *element, NAME##List *list ) {	\
+		PutFirstElement( &element->FIELD, &list->list ); }	\
+	static inline void PutLast##NAME( STRUCTURE *element, NAME##List *list ) {	\
+		PutLastElement( &element->FIELD, &list->list ); }	\
+	static inline void PutBefore##NAME( STRUCTURE *element, STRUCTURE *before, NAME##List *list ) {	\
+		PutBeforeElement( &element->FIELD, before ? &before->FIELD : NULL, &list->list ); }	\
+	static inline void PutAfter##NAME( STRUCTURE *element, STRUCTURE *after, NAME##List *list ) {	\
+		PutAfterElement( &element->FIELD, after ? &after->FIELD : NULL, &list->list ); }	\
+	\
+	static inline void First##NAME( STRUCTURE **element, NAME##List *list ) {	\
+		void *element_; FirstElement( &element_, &list->list );	\
+		*element = NAME##FromElement( (Element*) element_ ); }	\
+	static inline void Last##NAME( STRUCTURE **element, NAME##List *list ) {	\
+		void *element_; LastElement( &element_, &list->list );	\
+		*element = NAME##FromElement( (Element*) element_ ); }	\
+	static inline void Next##NAME( STRUCTURE *element, STRUCTURE **nextElement ) {	\
+		void *next_; NextElement( &element->FIELD, &next_ );	\
+		*nextElement = NAME##FromElement( (Element*) next_ ); }	\
+	static inline void Prev##NAME( STRUCTURE *element, STRUCTURE **prevElement ) {	\
+		void *prev_; PrevElement( &element->FIELD, &prev_ );	\
+		*prevElement = NAME##FromElement( (Element*) prev_ ); }	\
+	static inline bool Find##NAME( STRUCTURE *element, NAME##List *list ) {	\
+		return( FindElement( &element->FIELD, &list->list ) ); }	\
+	static inline NAME##List* Get##NAME##List( STRUCTURE *element ) {	\
+		return( (NAME##List*) GetElementList( &element->FIELD ) ); }	\
+	static inline bool Is##NAME##ListEmpty( NAME##List *list ) {	\
+		return( IsListEmpty( &list->list ) ); }	\
+	static inline void Find##NAME##ByKey( STRUCTURE **element, NAME##List *list, const void *key,	\
+			ElementCompareProc compareProc, int policy ) {	\
+		void *element_;	\
+		FindElementByKeyOff( &element_, &list->list, key, compareProc, policy, offsetof( STRUCTURE, FIELD ) );	\
+		*element = (STRUCTURE*) element_; }	\
+	static inline void Open##NAME##Cursor( ElementCursor *cursor, NAME##List *list ) {	\
+		OpenElementCursor( cursor, &list->list ); }	\
+	static inline void NextCursor##NAME( STRUCTURE **element, ElementCursor *cursor ) {	\
+		void *element_; NextCursorElement( &element_, cursor );	\
+		*element = NAME##FromElement( (Element*) element_ ); }	\
+	\
+	static inline void Remove##NAME( STRUCTURE *element, NAME##List *list ) {	\
+		RemoveElement( &element->FIELD, &list->list ); }	\
+	static inline void GrabFirst##NAME( STRUCTURE **element, NAME##List *list ) {	\
+		void *element_; GrabFirstElement( &element_, &list->list );	\
+		*element = NAME##FromElement( (Element*) element_ ); }	\
+	static inline void GrabLast##NAME( STRUCTURE **element, NAME##List *list ) {	\
+		void *element_; GrabLastElement( &element_, &list->list );	\
+		*element = NAME##FromElement( (Element*) element_ ); }	\
+	static inline void GrabNext##NAME( STRUCTURE *element, STRUCTURE **nextElement, NAME##List *list ) {	\
+		void *next_; GrabNextElement( &element->FIELD, &next_, &list->list );	\
+		*nextElement = NAME##FromElement( (Element*) next_ ); }	\
+	static inline void GrabPrev##NAME( STRUCTURE *element, STRUCTURE **prevElement, NAME##List *list ) {	\
+		void *prev_; GrabPrevElement( &element->FIELD, &prev_, &list->list );	\
+		*prevElement = NAME##FromElement( (Element*) prev_ ); }	\
+	\
+	typedef	int	NAME##ListDeclared	/* swallows the trailing semicolon */
+
 __END_DECLS
 #endif	//	_elemental_
\ No newline at end of file
@@ -0,0 +1,444 @@
+/****************************************************************************************
+	elementalarena.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Chunks are laid end to end from arena->start, each beginning with a
+	size_t tag: its size, a multiple of arenaAlignment, ORed with
+	arenaUsedBit and arenaPrevFreeBit. A zero-size used tag at arena->end
+	stops coalescing at the far end, and the first chunk never has a free
+	predecessor, which stops it at the near end. Two free chunks are never
+	adjacent, so freeing merges at most one neighbour on each side.
+
+	The large bins each span a range of sizes, so a request first walks its
+	own bin for a fit; every chunk in any higher non-empty bin fits, so the
+	bitmap's next set bit settles it otherwise. Small bins are exact.
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "elementalarena.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+#define	arenaAlignment		((size_t) 16)
+#define	arenaHeader			sizeof( size_t )
+#define	arenaUsedBit		((size_t) 0x1)
+#define	arenaPrevFreeBit	((size_t) 0x2)
+#define	arenaSizeMask		(~(arenaAlignment - 1))
+
+#define	arenaRoundUp( SIZE )		(((SIZE) + arenaAlignment - 1) & arenaSizeMask)
+
+//	A free chunk must hold its tag, its Element and its trailing size.
+#define	arenaMinChunk		arenaRoundUp( arenaHeader + sizeof( Element ) + sizeof( size_t ) )
+
+#define	chunkTag( CHUNK )			(*(size_t*) (CHUNK))
+#define	chunkSize( CHUNK )			(chunkTag( CHUNK ) & arenaSizeMask)
+#define	chunkFooter( CHUNK, SIZE )	(*(size_t*) ((CHUNK) + (SIZE) - sizeof( size_t )))
+#define	chunkElement( CHUNK )		((Element*) ((CHUNK) + arenaHeader))
+#define	elementChunk( ELEMENT )		((char*) (ELEMENT) - arenaHeader)
+
+	static
+	unsigned
+GetArenaBin(
+	size_t	size );
+
+	static
+	int
+FindArenaBin(
+	ElementArena	*arena,
+	unsigned		bin );
+
+	static
+	void
+BinArenaChunk(
+	ElementArena	*arena,
+	char			*chunk,
+	size_t			size );
+
+	static
+	void
+UnbinArenaChunk(
+	ElementArena	*arena,
+	char			*chunk );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementArena(
+	ElementArena	*arena,
+	void			*memory,
+	size_t			size )
+{
+	uintptr_t	base = (uintptr_t) memory;
+	uintptr_t	limit = base + size;
+	uintptr_t	start;
+	size_t		usable = 0;
+	unsigned	bin;
+
+	assertPtr( arena );
+	assertPtr( memory );
+
+	for( bin = 0; bin < elementalArenaBins; bin++ )
+		NewElementList( &arena->bins[ bin ] );
+	memset( arena->bitmap, 0, sizeof( arena->bitmap ) );
+	arena->freeBytes = 0;
+
+	//	Tags sit just below the aligned addresses blocks are handed out at.
+	start = ((base + arenaHeader + arenaAlignment - 1) & arenaSizeMask) - arenaHeader;
+	if( limit >= start + arenaHeader )
+		usable = (limit - start - arenaHeader) & arenaSizeMask;
+	if( usable < arenaMinChunk )
+		usable = 0;
+
+	arena->start = (char*) start;
+	arena->end = arena->start + usable;
+	if( limit >= start + arenaHeader )
+		chunkTag( arena->end ) = arenaUsedBit;
+	if( usable ) {
+		BinArenaChunk( arena, arena->start, usable );
+		arena->freeBytes = usable;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementArena(
+	ElementArena	*arena )
+{
+	unsigned	bin;
+
+	assertPtr( arena );
+
+	//	The free chunks' Elements live in the memory being given back.
+	for( bin = 0; bin < elementalArenaBins; bin++ ) {
+		ClearElementList( &arena->bins[ bin ] );
+		DeleteElementList( &arena->bins[ bin ] );
+	}
+	memset( arena->bitmap, 0, sizeof( arena->bitmap ) );
+	arena->start = arena->end = NULL;
+	arena->freeBytes = 0;
+}
+
+/****************************************************************************************
+*
+*	Arena Allocation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Arena Allocation)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+AllocateArenaBlock(
+	void			**block,
+	ElementArena	*arena,
+	size_t			size )
+{
+	Element	*element;
+	char	*chunk;
+	size_t	need;
+	size_t	have;
+	int		bin;
+
+	assertPtr( block );
+	assertPtr( arena );
+
+	*block = NULL;
+	if( size > (size_t) (arena->end - arena->start) )
+		return;
+	need = arenaRoundUp( size + arenaHeader );
+	if( need < arenaMinChunk )
+		need = arenaMinChunk;
+
+	bin = (int) GetArenaBin( need );
+	FirstElement( (void**) &element, &arena->bins[ bin ] );
+	while( element && chunkSize( elementChunk( element ) ) < need )
+		NextElement( element, (void**) &element );
+	if( !element ) {
+		bin = FindArenaBin( arena, (unsigned) bin + 1 );
+		if( bin < 0 )
+			return;
+		FirstElement( (void**) &element, &arena->bins[ bin ] );
+	}
+
+	chunk = elementChunk( element );
+	have = chunkSize( chunk );
+	UnbinArenaChunk( arena, chunk );
+
+	if( have - need >= arenaMinChunk )
+		BinArenaChunk( arena, chunk + need, have - need );
+	else {
+		need = have;
+		chunkTag( chunk + need ) &= ~arenaPrevFreeBit;
+	}
+	chunkTag( chunk ) = need | arenaUsedBit;	//	A free chunk's predecessor is never free.
+	arena->freeBytes -= need;
+
+	*block = chunk + arenaHeader;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FreeArenaBlock(
+	void			*block,
+	ElementArena	*arena )
+{
+	char	*chunk;
+	char	*next;
+	size_t	size;
+
+	assertPtr( arena );
+
+	if( !block )
+		return;
+
+	chunk = (char*) block - arenaHeader;
+	size = chunkSize( chunk );
+	next = chunk + size;
+
+	assertTrue( chunk >= arena->start && next <= arena->end );
+	assertTrue( chunkTag( chunk ) & arenaUsedBit );
+
+	arena->freeBytes += size;
+
+	if( !(chunkTag( next ) & arenaUsedBit) ) {
+		size += chunkSize( next );
+		UnbinArenaChunk( arena, next );
+	}
+	if( chunkTag( chunk ) & arenaPrevFreeBit ) {
+		size_t	prevSize = *(size_t*) (chunk - sizeof( size_t ));
+
+		chunk -= prevSize;
+		size += prevSize;
+		UnbinArenaChunk( arena, chunk );
+	}
+
+	BinArenaChunk( arena, chunk, size );
+}
+
+/****************************************************************************************
+*
+*	Arena Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Arena Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+GetArenaBlockSize(
+	void	*block )
+{
+	assertPtr( block );
+
+	return( chunkSize( (char*) block - arenaHeader ) - arenaHeader );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountArenaFreeBytes(
+	ElementArena	*arena )
+{
+	assertPtr( arena );
+
+	return( arena->freeBytes );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+LargestArenaBlock(
+	ElementArena	*arena )
+{
+	Element		*element;
+	size_t		largest = 0;
+	unsigned	word = elementalArenaBins / 64;
+
+	assertPtr( arena );
+
+	while( word-- ) {
+		if( arena->bitmap[ word ] ) {
+			unsigned	bin = word * 64 + 63 - (unsigned) __builtin_clzll( arena->bitmap[ word ] );
+
+			for( FirstElement( (void**) &element, &arena->bins[ bin ] ); element;
+				 NextElement( element, (void**) &element ) ) {
+				if( chunkSize( elementChunk( element ) ) > largest )
+					largest = chunkSize( elementChunk( element ) );
+			}
+			return( largest - arenaHeader );
+		}
+	}
+	return( 0 );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	unsigned
+GetArenaBin(
+	size_t	size )
+{
+	unsigned	log2;
+	unsigned	bin;
+
+	if( size < elementalArenaSmallLimit )
+		return( (unsigned) (size / arenaAlignment) );
+
+	//	Four bins to each power of two, split by the two bits below the top one.
+	log2 = 63 - (unsigned) __builtin_clzll( (unsigned long long) size );
+	bin = elementalArenaSmallLimit / arenaAlignment + (log2 - 10) * 4 + (unsigned) ((size >> (log2 - 2)) & 3);
+	return( bin < elementalArenaBins ? bin : elementalArenaBins - 1 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	int
+FindArenaBin(
+	ElementArena	*arena,
+	unsigned		bin )
+{
+	unsigned	word = bin / 64;
+	uint64_t	bits;
+
+	if( bin >= elementalArenaBins )
+		return( -1 );
+
+	bits = arena->bitmap[ word ] & (~(uint64_t) 0 << (bin % 64));
+	for( ;; ) {
+		if( bits )
+			return( (int) (word * 64 + (unsigned) __builtin_ctzll( bits )) );
+		if( ++word == elementalArenaBins / 64 )
+			return( -1 );
+		bits = arena->bitmap[ word ];
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+BinArenaChunk(
+	ElementArena	*arena,
+	char			*chunk,
+	size_t			size )
+{
+	unsigned	bin = GetArenaBin( size );
+	Element		*element = chunkElement( chunk );
+
+	chunkTag( chunk ) = size;
+	chunkFooter( chunk, size ) = size;
+	chunkTag( chunk + size ) |= arenaPrevFreeBit;
+
+	memset( element, 0, sizeof( Element ) );
+	PutFirstElement( element, &arena->bins[ bin ] );
+	arena->bitmap[ bin / 64 ] |= (uint64_t) 1 << (bin % 64);
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnbinArenaChunk(
+	ElementArena	*arena,
+	char			*chunk )
+{
+	unsigned	bin = GetArenaBin( chunkSize( chunk ) );
+
+	RemoveElement( chunkElement( chunk ), &arena->bins[ bin ] );
+	if( IsListEmpty( &arena->bins[ bin ] ) )
+		arena->bitmap[ bin / 64 ] &= ~((uint64_t) 1 << (bin % 64));
+}
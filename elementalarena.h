@@ -0,0 +1,123 @@
+/****************************************************************************************
+	elementalarena.h
+
+	Segregated-fit allocation of variable-size blocks from a caller's arena.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An ElementArena carves blocks of any size out of one region of memory.
+	Each free chunk embeds the Element that files it in one of
+	elementalArenaBins size-class ElementLists, exact to 16 bytes below
+	elementalArenaSmallLimit and four to each power of two above it, and a
+	bitmap of the non-empty bins finds the smallest class that can satisfy
+	a request in a couple of instructions.
+
+	Every chunk starts with a boundary tag holding its size and whether it
+	and its predecessor are in use; a free chunk repeats its size in its
+	last word. Freeing a block therefore finds both neighbours in constant
+	time and, if they are free, pulls them from their bins with
+	RemoveElement() and merges them, so free space never sits fragmented
+	into adjacent pieces.
+
+	Blocks are 16-byte aligned and cost one word of overhead. Not
+	thread-safe.
+
+	************************************************************************************/
+
+#ifndef		_elementalarena_
+#define		_elementalarena_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+#ifndef	elementalArenaBins
+	#define	elementalArenaBins			128		//	A multiple of 64.
+#endif
+#define	elementalArenaSmallLimit	1024
+
+typedef	struct	ElementArena	ElementArena;
+
+struct	ElementArena	{
+	ElementList	bins[ elementalArenaBins ];
+	uint64_t	bitmap[ elementalArenaBins / 64 ];	//	Bit set when bin is non-empty.
+	char		*start;
+	char		*end;		//	The sentinel tag.
+	size_t		freeBytes;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	Manages size bytes at memory, which must outlive arena.
+	void
+NewElementArena(
+	ElementArena	*arena,
+	void			*memory,
+	size_t			size );
+
+//	Blocks still allocated become invalid; the memory is the caller's again.
+	void
+DeleteElementArena(
+	ElementArena	*arena );
+
+/**************************
+*
+*	Arena Allocation
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Arena Allocation)
+
+//	*block = size bytes, 16-byte aligned, or NULL if no free chunk is big enough.
+	void
+AllocateArenaBlock(
+	void			**block,
+	ElementArena	*arena,
+	size_t			size );
+
+//	Returns block, which may be NULL, to arena, merging it with free neighbours.
+	void
+FreeArenaBlock(
+	void			*block,
+	ElementArena	*arena );
+
+/**************************
+*
+*	Arena Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Arena Accessors)
+
+//	Returns how many bytes block can hold, at least what was asked for.
+	size_t
+GetArenaBlockSize(
+	void	*block );
+
+//	Returns the bytes in free chunks, tags included.
+	size_t
+CountArenaFreeBytes(
+	ElementArena	*arena );
+
+//	Returns the largest block that could be allocated now. Together with
+//	CountArenaFreeBytes(), measures fragmentation.
+	size_t
+LargestArenaBlock(
+	ElementArena	*arena );
+
+__END_DECLS
+#endif	//	_elementalarena_
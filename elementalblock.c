@@ -0,0 +1,501 @@
+/****************************************************************************************
+	elementalblock.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A block's live slots float within it: PutFirst fills end blocks from the back
+	and PutLast from the front, so growing at either end is a single store until
+	the end block is full. A block that falls to half full after a removal is
+	merged into a neighbour that has room, which keeps iteration dense without
+	ever splitting blocks.
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "elementalblock.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+	static
+	ElementBlock*
+NewElementBlock(
+	BlockElementList	*list,
+	ElementBlock		*prev,
+	ElementBlock		*next,
+	unsigned			start );
+
+	static
+	void
+DeleteElementBlock(
+	BlockElementList	*list,
+	ElementBlock		*block );
+
+	static
+	void
+MergeElementBlocks(
+	BlockElementList	*list,
+	ElementBlock		*into,
+	ElementBlock		*from );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewBlockElementList(
+	BlockElementList	*list )
+{
+	assertPtr( list );
+
+	list->first = list->last = NULL;
+	list->count = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteBlockElementList(
+	BlockElementList	*list )
+{
+	assertPtr( list );
+
+	while( list->first )
+		DeleteElementBlock( list, list->first );
+	list->count = 0;
+}
+
+/****************************************************************************************
+*
+*	Block Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Block Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+PutFirstBlockElement(
+	void				*element,
+	BlockElementList	*list )
+{
+	ElementBlock	*block = list->first;
+
+	assertPtr( element );
+	assertPtr( list );
+
+	if( block && block->start == 0 && block->count < elementalBlockSlots ) {
+		//	Room at the back only; slide everything there.
+		unsigned	start = (unsigned) (elementalBlockSlots - block->count);
+
+		memmove( &block->slots[ start ], &block->slots[ 0 ], block->count * sizeof( void* ) );
+		block->start = (unsigned short) start;
+	} else if( block == NULL || block->start == 0 ) {
+		block = NewElementBlock( list, NULL, block, (unsigned) elementalBlockSlots );
+		if( block == NULL )
+			return( false );
+	}
+
+	block->slots[ --block->start ] = element;
+	block->count++;
+	list->count++;
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+PutLastBlockElement(
+	void				*element,
+	BlockElementList	*list )
+{
+	ElementBlock	*block = list->last;
+
+	assertPtr( element );
+	assertPtr( list );
+
+	if( block && block->start + block->count == elementalBlockSlots && block->count < elementalBlockSlots ) {
+		//	Room at the front only; slide everything there.
+		memmove( &block->slots[ 0 ], &block->slots[ block->start ], block->count * sizeof( void* ) );
+		block->start = 0;
+	} else if( block == NULL || block->start + block->count == elementalBlockSlots ) {
+		block = NewElementBlock( list, block, NULL, 0 );
+		if( block == NULL )
+			return( false );
+	}
+
+	block->slots[ block->start + block->count ] = element;
+	block->count++;
+	list->count++;
+
+	return( true );
+}
+
+/****************************************************************************************
+*
+*	Block Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Block Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstBlockElement(
+	void				**element,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor )
+{
+	ElementBlock	*block = list->first;
+
+	assertPtr( element );
+	assertPtr( list );
+	assertPtr( cursor );
+
+	cursor->block = block;
+	cursor->slot = block ? block->start : 0;
+	*element = block ? block->slots[ cursor->slot ] : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+LastBlockElement(
+	void				**element,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor )
+{
+	ElementBlock	*block = list->last;
+
+	assertPtr( element );
+	assertPtr( list );
+	assertPtr( cursor );
+
+	cursor->block = block;
+	cursor->slot = block ? block->start + block->count - 1 : 0;
+	*element = block ? block->slots[ cursor->slot ] : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextBlockElement(
+	void				**nextElement,
+	BlockElementCursor	*cursor )
+{
+	ElementBlock	*block = cursor->block;
+
+	assertPtr( nextElement );
+	assertPtr( cursor );
+
+	if( block == NULL ) {
+		*nextElement = NULL;
+		return;
+	}
+	if( ++cursor->slot == (unsigned) (block->start + block->count) ) {
+		block = cursor->block = block->next;
+		cursor->slot = block ? block->start : 0;
+	}
+	*nextElement = block ? block->slots[ cursor->slot ] : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PrevBlockElement(
+	void				**prevElement,
+	BlockElementCursor	*cursor )
+{
+	ElementBlock	*block = cursor->block;
+
+	assertPtr( prevElement );
+	assertPtr( cursor );
+
+	if( block == NULL ) {
+		*prevElement = NULL;
+		return;
+	}
+	if( cursor->slot-- == block->start ) {
+		block = cursor->block = block->prev;
+		cursor->slot = block ? block->start + block->count - 1 : 0;
+	}
+	*prevElement = block ? block->slots[ cursor->slot ] : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountBlockElements(
+	BlockElementList	*list )
+{
+	assertPtr( list );
+
+	return( list->count );
+}
+
+/****************************************************************************************
+*
+*	Block Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Block Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveBlockElement(
+	void				**nextElement,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor )
+{
+	ElementBlock	*block = cursor->block;
+	unsigned		index;	//	Position within the block, which is also the next element's.
+
+	assertPtr( nextElement );
+	assertPtr( list );
+	assertPtr( block );
+	assertTrue( cursor->slot >= block->start && cursor->slot < (unsigned) (block->start + block->count) );
+
+	index = cursor->slot - block->start;
+	if( index == 0 )
+		block->start++;
+	else
+		memmove( &block->slots[ cursor->slot ], &block->slots[ cursor->slot + 1 ],
+				(block->count - index - 1) * sizeof( void* ) );
+	block->count--;
+	list->count--;
+
+	if( block->count == 0 ) {
+		ElementBlock	*next = block->next;
+
+		DeleteElementBlock( list, block );
+		block = next;
+		index = 0;
+	} else if( block->count <= elementalBlockSlots / 2 ) {
+		if( block->next && block->count + block->next->count <= elementalBlockSlots )
+			MergeElementBlocks( list, block, block->next );
+		else if( block->prev && block->prev->count + block->count <= elementalBlockSlots ) {
+			index += block->prev->count;
+			block = block->prev;
+			MergeElementBlocks( list, block, block->next );
+		}
+	}
+
+	//	The element that followed may have been the block's last.
+	if( block && index == block->count ) {
+		block = block->next;
+		index = 0;
+	}
+	cursor->block = block;
+	cursor->slot = block ? block->start + index : 0;
+	*nextElement = block ? block->slots[ cursor->slot ] : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstBlockElement(
+	void				**element,
+	BlockElementList	*list )
+{
+	BlockElementCursor	cursor;
+	void				*next;
+
+	FirstBlockElement( element, list, &cursor );
+	if( *element )
+		RemoveBlockElement( &next, list, &cursor );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabLastBlockElement(
+	void				**element,
+	BlockElementList	*list )
+{
+	BlockElementCursor	cursor;
+	void				*next;
+
+	LastBlockElement( element, list, &cursor );
+	if( *element )
+		RemoveBlockElement( &next, list, &cursor );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	ElementBlock*
+NewElementBlock(
+	BlockElementList	*list,
+	ElementBlock		*prev,
+	ElementBlock		*next,
+	unsigned			start )
+{
+	void			*memory;
+	ElementBlock	*block;
+
+	if( posix_memalign( &memory, elementalCacheLine, sizeof( ElementBlock ) ) != 0 )
+		return( NULL );
+	block = (ElementBlock*) memory;
+
+	block->start = (unsigned short) start;
+	block->count = 0;
+	block->prev = prev;
+	block->next = next;
+	if( prev )
+		prev->next = block;
+	else
+		list->first = block;
+	if( next )
+		next->prev = block;
+	else
+		list->last = block;
+
+	return( block );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+DeleteElementBlock(
+	BlockElementList	*list,
+	ElementBlock		*block )
+{
+	if( block->prev )
+		block->prev->next = block->next;
+	else
+		list->first = block->next;
+	if( block->next )
+		block->next->prev = block->prev;
+	else
+		list->last = block->prev;
+	free( block );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+MergeElementBlocks(
+	BlockElementList	*list,
+	ElementBlock		*into,
+	ElementBlock		*from )
+{
+	assertTrue( into->next == from );
+	assertTrue( into->count + from->count <= elementalBlockSlots );
+
+	memmove( &into->slots[ 0 ], &into->slots[ into->start ], into->count * sizeof( void* ) );
+	memcpy( &into->slots[ into->count ], &from->slots[ from->start ], from->count * sizeof( void* ) );
+	into->start = 0;
+	into->count += from->count;
+	DeleteElementBlock( list, from );
+}
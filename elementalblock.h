@@ -0,0 +1,178 @@
+/****************************************************************************************
+	elementalblock.h
+
+	Unrolled lists: element pointers packed into cache-line-sized blocks.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Walking an ElementList costs one dependent cache miss per element. A
+	BlockElementList instead keeps up to elementalBlockSlots element pointers
+	in each cache-line-aligned ElementBlock, so a walk chases one link per
+	block and the pointers within a block stream in together.
+
+	Elements need no embedded hook and may be any non-NULL pointer. Because
+	elements don't know where they live, positions are named by a
+	BlockElementCursor, filled in by the accessors and consumed by
+	RemoveBlockElement(). Blocks are allocated on demand, and a block that
+	underflows is merged into a neighbour.
+
+	************************************************************************************/
+
+#ifndef		_elementalblock_
+#define		_elementalblock_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+//	Whatever fits in a cache line after the block's header.
+#define	elementalBlockSlots	((elementalCacheLine - 3 * sizeof( void* )) / sizeof( void* ))
+
+typedef	struct	ElementBlock		ElementBlock;
+typedef	struct	BlockElementList	BlockElementList;
+typedef	struct	BlockElementCursor	BlockElementCursor;
+
+struct	ElementBlock	{
+	ElementBlock	*next;
+	ElementBlock	*prev;
+	unsigned short	start;	//	Live slots are [ start, start + count ).
+	unsigned short	count;
+	void			*slots[ elementalBlockSlots ];
+} __attribute__(( aligned( elementalCacheLine ) ));
+
+struct	BlockElementList	{
+	ElementBlock	*first;
+	ElementBlock	*last;
+	size_t			count;
+};
+
+struct	BlockElementCursor	{
+	ElementBlock	*block;
+	unsigned		slot;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+	void
+NewBlockElementList(
+	BlockElementList	*list );
+
+//	Frees the list's blocks. The elements themselves are untouched.
+	void
+DeleteBlockElementList(
+	BlockElementList	*list );
+
+/**************************
+*
+*	Block Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Block Putters)
+
+//	If list == a, b, c && element == x
+//	Then list = x, a, b, c
+//	Returns false if a new block was needed and could not be allocated.
+	bool
+PutFirstBlockElement(
+	void				*element,
+	BlockElementList	*list );
+
+//	If list == a, b, c && element == x
+//	Then list = a, b, c, x
+//	Returns false if a new block was needed and could not be allocated.
+	bool
+PutLastBlockElement(
+	void				*element,
+	BlockElementList	*list );
+
+/**************************
+*
+*	Block Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Block Accessors)
+
+//	If list == a, b, c
+//	Then *element = a && cursor is at a
+	void
+FirstBlockElement(
+	void				**element,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor );
+
+//	If list == a, b, c
+//	Then *element = c && cursor is at c
+	void
+LastBlockElement(
+	void				**element,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor );
+
+//	If list == a, b, c && cursor is at b
+//	Then *nextElement = c && cursor is at c
+	void
+NextBlockElement(
+	void				**nextElement,
+	BlockElementCursor	*cursor );
+
+//	If list == a, b, c && cursor is at b
+//	Then *prevElement = a && cursor is at a
+	void
+PrevBlockElement(
+	void				**prevElement,
+	BlockElementCursor	*cursor );
+
+//	Returns the number of elements in list.
+	size_t
+CountBlockElements(
+	BlockElementList	*list );
+
+/**************************
+*
+*	Block Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Block Grabbing)
+
+//	If list == a, b, c && cursor is at b
+//	Then list = a, c && *nextElement = c && cursor is at c
+//	Any other cursors into list are invalidated.
+	void
+RemoveBlockElement(
+	void				**nextElement,
+	BlockElementList	*list,
+	BlockElementCursor	*cursor );
+
+//	If list == a, b, c
+//	Then list = b, c && *element = a
+	void
+GrabFirstBlockElement(
+	void				**element,
+	BlockElementList	*list );
+
+//	If list == a, b, c
+//	Then list = a, b && *element = c
+	void
+GrabLastBlockElement(
+	void				**element,
+	BlockElementList	*list );
+
+__END_DECLS
+#endif	//	_elementalblock_
@@ -0,0 +1,482 @@
+/****************************************************************************************
+	elementalbuffer.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The gathered iovecs live on the stack. Spares are kept most recently
+	released first, so a busy connection keeps reusing the same few warm
+	descriptors. A flush cuts the run it sent from the chain and splices it
+	onto the spares whole, relinking only the run's two ends; beyond
+	elementalBufferSpares, the coldest spares are freed.
+
+	************************************************************************************/
+
+#ifndef	_POSIX_C_SOURCE
+	#define	_POSIX_C_SOURCE	200809L	//	IOV_MAX
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+
+#include "elementalbuffer.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+//	Descriptors gathered per writev().
+#ifndef	elementalBufferBatch
+	#ifdef	IOV_MAX
+		#define	elementalBufferBatch	IOV_MAX
+	#else
+		#define	elementalBufferBatch	1024
+	#endif
+#endif
+
+//	Most spare descriptors a pool keeps.
+#ifndef	elementalBufferSpares
+	#define	elementalBufferSpares	1024
+#endif
+
+	static
+	void
+ReleaseSentBuffers(
+	BufferChain	*chain,
+	size_t		sent,
+	BufferPool	*pool );
+
+	static
+	void
+ReleaseBufferRun(
+	BufferChain		*chain,
+	ElementBuffer	*last,
+	BufferPool		*pool );
+
+	static
+	void
+TrimPoolSpares(
+	BufferPool	*pool );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewBufferChain(
+	BufferChain	*chain )
+{
+	assertPtr( chain );
+
+	NewElementList( &chain->buffers );
+	chain->length = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteBufferChain(
+	BufferChain	*chain )
+{
+	assertPtr( chain );
+	assertTrue( IsListEmpty( &chain->buffers ) );
+
+	DeleteElementList( &chain->buffers );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewBufferPool(
+	BufferPool			*pool,
+	ElementBufferProc	releaseProc,
+	void				*refCon )
+{
+	assertPtr( pool );
+
+	NewElementList( &pool->spares );
+	pool->spareCount = 0;
+	pool->releaseProc = releaseProc;
+	pool->refCon = refCon;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteBufferPool(
+	BufferPool	*pool )
+{
+	ElementBuffer	*buffer;
+
+	assertPtr( pool );
+
+	for( GrabFirstElement( (void**) &buffer, &pool->spares ); buffer;
+		 GrabFirstElement( (void**) &buffer, &pool->spares ) )
+		free( buffer );
+	pool->spareCount = 0;
+	DeleteElementList( &pool->spares );
+}
+
+/****************************************************************************************
+*
+*	Pool
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Pool)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabPoolBuffer(
+	ElementBuffer	**buffer,
+	BufferPool		*pool )
+{
+	assertPtr( buffer );
+	assertPtr( pool );
+
+	GrabFirstElement( (void**) buffer, &pool->spares );
+	if( *buffer )
+		pool->spareCount--;
+	else
+		*buffer = (ElementBuffer*) calloc( 1, sizeof( ElementBuffer ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Keeps no more than elementalBufferSpares.
+
+	************************************************************************************/
+
+	void
+ReleasePoolBuffer(
+	ElementBuffer	*buffer,
+	BufferPool		*pool )
+{
+	assertPtr( buffer );
+	assertPtr( pool );
+	assertTrue( GetElementList( buffer ) == NULL );
+
+	if( pool->releaseProc )
+		pool->releaseProc( buffer, pool->refCon );
+	buffer->bytes = NULL;
+	buffer->length = 0;
+	buffer->refCon = NULL;
+	PutFirstElement( buffer, &pool->spares );
+	pool->spareCount++;
+	TrimPoolSpares( pool );
+}
+
+/****************************************************************************************
+*
+*	Chain Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Chain Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+AppendChainBuffer(
+	ElementBuffer	*buffer,
+	BufferChain		*chain,
+	const void		*bytes,
+	size_t			length )
+{
+	assertPtr( buffer );
+	assertPtr( chain );
+	assertTrue( bytes || length == 0 );
+
+	buffer->bytes = bytes;
+	buffer->length = length;
+	PutLastElement( buffer, &chain->buffers );
+	chain->length += length;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PrependChainBuffer(
+	ElementBuffer	*buffer,
+	BufferChain		*chain,
+	const void		*bytes,
+	size_t			length )
+{
+	assertPtr( buffer );
+	assertPtr( chain );
+	assertTrue( bytes || length == 0 );
+
+	buffer->bytes = bytes;
+	buffer->length = length;
+	PutFirstElement( buffer, &chain->buffers );
+	chain->length += length;
+}
+
+/****************************************************************************************
+*
+*	Chain Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Chain Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountChainBytes(
+	BufferChain	*chain )
+{
+	assertPtr( chain );
+
+	return( chain->length );
+}
+
+/****************************************************************************************
+*
+*	Flushing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Flushing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+FlushBufferChain(
+	BufferChain	*chain,
+	int			fd,
+	BufferPool	*pool )
+{
+	struct iovec	vectors[ elementalBufferBatch ];
+
+	assertPtr( chain );
+	assertPtr( pool );
+
+	while( chain->length ) {
+		ElementBuffer	*buffer;
+		size_t			gathered = 0;
+		size_t			count = 0;
+		ssize_t			sent;
+
+		FirstElement( (void**) &buffer, &chain->buffers );
+		for( ; buffer && count < elementalBufferBatch; NextElement( buffer, (void**) &buffer ) ) {
+			if( buffer->length == 0 )
+				continue;
+			vectors[ count ].iov_base = (void*) buffer->bytes;
+			vectors[ count ].iov_len = buffer->length;
+			gathered += buffer->length;
+			count++;
+		}
+
+		sent = writev( fd, vectors, (int) count );
+		if( sent < 0 ) {
+			if( errno == EINTR )
+				continue;
+			return( errno == EAGAIN || errno == EWOULDBLOCK );
+		}
+
+		ReleaseSentBuffers( chain, (size_t) sent, pool );
+		if( (size_t) sent < gathered )
+			return( true );		//	fd is full.
+	}
+
+	//	Empty buffers left at the end.
+	ReleaseSentBuffers( chain, 0, pool );
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Releases the chain in one splice.
+
+	************************************************************************************/
+
+	void
+DiscardBufferChain(
+	BufferChain	*chain,
+	BufferPool	*pool )
+{
+	ElementBuffer	*last;
+
+	assertPtr( chain );
+	assertPtr( pool );
+
+	LastElement( (void**) &last, &chain->buffers );
+	if( last )
+		ReleaseBufferRun( chain, last, pool );
+	chain->length = 0;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Releases the whole buffers in one splice.
+
+	************************************************************************************/
+
+	static
+	void
+ReleaseSentBuffers(
+	BufferChain	*chain,
+	size_t		sent,
+	BufferPool	*pool )
+{
+	ElementBuffer	*buffer;
+	ElementBuffer	*last = NULL;
+
+	chain->length -= sent;
+
+	//	Whole buffers first, along with any empty ones among them...
+	for( FirstElement( (void**) &buffer, &chain->buffers ); buffer && buffer->length <= sent;
+		 NextElement( buffer, (void**) &buffer ) ) {
+		sent -= buffer->length;
+		last = buffer;
+	}
+	if( last )
+		ReleaseBufferRun( chain, last, pool );
+
+	//	...then whatever of the next one went out.
+	if( sent ) {
+		assertTrue( buffer && sent < buffer->length );
+		buffer->bytes = (const char*) buffer->bytes + sent;
+		buffer->length -= sent;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Splices with SpliceElements(), which probes, traces and skips markers.
+
+	************************************************************************************/
+
+	static
+	void
+ReleaseBufferRun(
+	BufferChain		*chain,
+	ElementBuffer	*last,
+	BufferPool		*pool )
+{
+	ElementBuffer	*first;
+	ElementBuffer	*buffer;
+
+	assertTrue( GetElementList( last ) == &chain->buffers );
+
+	//	The run onto the front of the spares in one splice...
+	FirstElement( (void**) &first, &chain->buffers );
+	SpliceElements( first, last, &chain->buffers, &pool->spares, true );
+
+	//	...then only its buffers' fields need resetting.
+	for( buffer = first; ; NextElement( buffer, (void**) &buffer ) ) {
+		if( pool->releaseProc )
+			pool->releaseProc( buffer, pool->refCon );
+		buffer->bytes = NULL;
+		buffer->length = 0;
+		buffer->refCon = NULL;
+		pool->spareCount++;
+		if( buffer == last )
+			break;
+	}
+	TrimPoolSpares( pool );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+TrimPoolSpares(
+	BufferPool	*pool )
+{
+	ElementBuffer	*buffer;
+
+	//	The coldest go.
+	while( pool->spareCount > elementalBufferSpares ) {
+		GrabLastElement( (void**) &buffer, &pool->spares );
+		free( buffer );
+		pool->spareCount--;
+	}
+}
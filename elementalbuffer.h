@@ -0,0 +1,176 @@
+/****************************************************************************************
+	elementalbuffer.h
+
+	Zero-copy output: chains of buffer descriptors flushed with writev(). POSIX only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A response built from many small pieces need not be copied into one send
+	buffer. Each piece gets an ElementBuffer, a descriptor that embeds the
+	Element linking it into a BufferChain and points at bytes living wherever
+	they already are. Bodies are appended and headers, once known, prepended,
+	both in constant time.
+
+	FlushBufferChain() hands up to IOV_MAX descriptors at a time to writev().
+	A short write trims the front descriptor in place, and the descriptors
+	sent in full go back to a BufferPool together, in one splice, and its
+	releaseProc can free the bytes each pointed at. A pool keeps at most
+	elementalBufferSpares descriptors, freeing the least recently used.
+
+	************************************************************************************/
+
+#ifndef		_elementalbuffer_
+#define		_elementalbuffer_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementBuffer	ElementBuffer;
+typedef	struct	BufferChain		BufferChain;
+typedef	struct	BufferPool		BufferPool;
+
+//	Told that buffer's bytes have been sent, or discarded, and are no longer needed.
+typedef	void	(*ElementBufferProc)( ElementBuffer *buffer, void *refCon );
+
+struct	ElementBuffer	{
+	Element		element;
+	const void	*bytes;		//	Next byte to send.
+	size_t		length;		//	Bytes left to send.
+	void		*refCon;	//	The owner's, e.g. the allocation bytes points into.
+};
+
+struct	BufferChain	{
+	ElementList	buffers;
+	size_t		length;		//	Bytes queued, over all buffers.
+};
+
+struct	BufferPool	{
+	ElementList			spares;		//	Most recently released first.
+	size_t				spareCount;	//	At most elementalBufferSpares.
+	ElementBufferProc	releaseProc;
+	void				*refCon;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+	void
+NewBufferChain(
+	BufferChain	*chain );
+
+//	chain must be empty; see DiscardBufferChain().
+	void
+DeleteBufferChain(
+	BufferChain	*chain );
+
+//	releaseProc, which may be NULL, is called on each buffer as it comes back.
+	void
+NewBufferPool(
+	BufferPool			*pool,
+	ElementBufferProc	releaseProc,
+	void				*refCon );
+
+//	Frees the spare descriptors. Those out on chains are untouched.
+	void
+DeleteBufferPool(
+	BufferPool	*pool );
+
+/**************************
+*
+*	Pool
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Pool)
+
+//	*buffer = a spare descriptor, or a newly allocated one, or NULL if memory ran out.
+	void
+GrabPoolBuffer(
+	ElementBuffer	**buffer,
+	BufferPool		*pool );
+
+//	Calls pool's releaseProc on buffer, which must be in no chain, and keeps
+//	the descriptor for reuse.
+	void
+ReleasePoolBuffer(
+	ElementBuffer	*buffer,
+	BufferPool		*pool );
+
+/**************************
+*
+*	Chain Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Chain Putters)
+
+//	If chain == a, b, c
+//	Then chain = a, b, c, buffer, where buffer describes length bytes at bytes
+	void
+AppendChainBuffer(
+	ElementBuffer	*buffer,
+	BufferChain		*chain,
+	const void		*bytes,
+	size_t			length );
+
+//	If chain == a, b, c
+//	Then chain = buffer, a, b, c, where buffer describes length bytes at bytes
+	void
+PrependChainBuffer(
+	ElementBuffer	*buffer,
+	BufferChain		*chain,
+	const void		*bytes,
+	size_t			length );
+
+/**************************
+*
+*	Chain Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Chain Accessors)
+
+	size_t
+CountChainBytes(
+	BufferChain	*chain );
+
+/**************************
+*
+*	Flushing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Flushing)
+
+//	Writes as much of chain to fd as fd will take, releasing each buffer sent
+//	in full to pool. Returns true if chain emptied or fd would block; false,
+//	with errno set, if writev() failed otherwise. Writing to a socket whose
+//	peer has gone raises SIGPIPE unless that is ignored.
+	bool
+FlushBufferChain(
+	BufferChain	*chain,
+	int			fd,
+	BufferPool	*pool );
+
+//	Releases every buffer in chain to pool unsent.
+	void
+DiscardBufferChain(
+	BufferChain	*chain,
+	BufferPool	*pool );
+
+__END_DECLS
+#endif	//	_elementalbuffer_
@@ -0,0 +1,530 @@
+/****************************************************************************************
+	elementalchannel.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The mutex is Drepper's three-state futex lock. Each side's condition is a
+	futex word that is bumped on every wakeup, so a waiter that has counted
+	itself in but not yet gone to sleep sees the word change and returns at
+	once instead of missing its wakeup.
+
+	Every operation ends in UnlockChannelAndWake(), which applies one rule
+	to each side: of the waiters, as many as there are elements (or room)
+	for should be awake, and those already woken but not yet back count
+	toward it. Any shortfall is made up with a single FUTEX_WAKE, so a burst
+	of puts wakes the consumers it can feed in one syscall rather than one
+	per item or a chain of one per consumer.
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "elementalchannel.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+	static
+	void
+LockChannel(
+	ElementChannel	*channel );
+
+	static
+	void
+UnlockChannel(
+	ElementChannel	*channel );
+
+	static
+	void
+UnlockChannelAndWake(
+	ElementChannel	*channel );
+
+	static
+	bool
+WaitChannel(
+	ElementChannel			*channel,
+	unsigned				*word,
+	unsigned				*waiting,
+	unsigned				*wakesPending,
+	const struct timespec	*deadline );
+
+	static
+	int
+SignalChannel(
+	unsigned	*word,
+	size_t		available,
+	unsigned	waiting,
+	unsigned	*wakesPending );
+
+	static
+	int
+FutexWait(
+	unsigned				*word,
+	unsigned				expected,
+	const struct timespec	*deadline );
+
+	static
+	void
+FutexWake(
+	unsigned	*word,
+	int			count );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementChannel(
+	ElementChannel	*channel,
+	size_t			capacity )
+{
+	assertPtr( channel );
+	assertTrue( capacity > 0 );
+
+	NewElementList( &channel->list );
+	channel->count = 0;
+	channel->capacity = capacity;
+	channel->closed = false;
+	channel->lock = 0;
+	channel->notEmpty = channel->notFull = 0;
+	channel->consumersWaiting = channel->producersWaiting = 0;
+	channel->consumerWakesPending = channel->producerWakesPending = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementChannel(
+	ElementChannel	*channel )
+{
+	assertPtr( channel );
+	assertTrue( channel->consumersWaiting == 0 && channel->producersWaiting == 0 );
+
+	DeleteElementList( &channel->list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+CloseElementChannel(
+	ElementChannel	*channel )
+{
+	assertPtr( channel );
+
+	LockChannel( channel );
+	channel->closed = true;
+	__atomic_fetch_add( &channel->notEmpty, 1, __ATOMIC_RELAXED );
+	__atomic_fetch_add( &channel->notFull, 1, __ATOMIC_RELAXED );
+	UnlockChannelAndWake( channel );
+
+	FutexWake( &channel->notEmpty, INT_MAX );
+	FutexWake( &channel->notFull, INT_MAX );
+}
+
+/****************************************************************************************
+*
+*	Channel Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Channel Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+PutChannelElement(
+	void					*element,
+	ElementChannel			*channel,
+	const struct timespec	*deadline )
+{
+	bool	put;
+
+	assertPtr( element );
+	assertPtr( channel );
+
+	LockChannel( channel );
+	while( channel->count >= channel->capacity && !channel->closed ) {
+		if( !WaitChannel( channel, &channel->notFull, &channel->producersWaiting,
+				&channel->producerWakesPending, deadline ) )
+			break;
+	}
+	put = !channel->closed && channel->count < channel->capacity;
+	if( put ) {
+		PutLastElement( element, &channel->list );
+		channel->count++;
+	}
+	UnlockChannelAndWake( channel );
+
+	return( put );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+PutChannelElements(
+	ElementList				*batch,
+	ElementChannel			*channel,
+	const struct timespec	*deadline )
+{
+	size_t	moved = 0;
+
+	assertPtr( batch );
+	assertPtr( channel );
+
+	for( ;; ) {
+		bool	more = true;
+
+		LockChannel( channel );
+		while( channel->count >= channel->capacity && !channel->closed ) {
+			if( !WaitChannel( channel, &channel->notFull, &channel->producersWaiting,
+					&channel->producerWakesPending, deadline ) ) {
+				more = false;
+				break;
+			}
+		}
+		if( channel->closed )
+			more = false;
+		else {
+			while( channel->count < channel->capacity ) {
+				void	*element;
+
+				GrabFirstElement( &element, batch );
+				if( element == NULL ) {
+					more = false;
+					break;
+				}
+				PutLastElement( element, &channel->list );
+				channel->count++;
+				moved++;
+			}
+		}
+		//	Let consumers at this chunk before waiting for room for the next.
+		UnlockChannelAndWake( channel );
+
+		if( !more || IsListEmpty( batch ) )
+			return( moved );
+	}
+}
+
+/****************************************************************************************
+*
+*	Channel Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Channel Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+GrabChannelElement(
+	void					**element,
+	ElementChannel			*channel,
+	const struct timespec	*deadline )
+{
+	assertPtr( element );
+	assertPtr( channel );
+
+	LockChannel( channel );
+	while( channel->count == 0 && !channel->closed ) {
+		if( !WaitChannel( channel, &channel->notEmpty, &channel->consumersWaiting,
+				&channel->consumerWakesPending, deadline ) )
+			break;
+	}
+	GrabFirstElement( element, &channel->list );
+	if( *element )
+		channel->count--;
+	UnlockChannelAndWake( channel );
+
+	return( *element != NULL );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+GrabChannelElements(
+	ElementList				*batch,
+	size_t					maxCount,
+	ElementChannel			*channel,
+	const struct timespec	*deadline )
+{
+	size_t	moved = 0;
+
+	assertPtr( batch );
+	assertPtr( channel );
+
+	//	Waiting for nothing would only hold an element up from other consumers.
+	if( maxCount == 0 )
+		return( 0 );
+
+	LockChannel( channel );
+	while( channel->count == 0 && !channel->closed ) {
+		if( !WaitChannel( channel, &channel->notEmpty, &channel->consumersWaiting,
+				&channel->consumerWakesPending, deadline ) )
+			break;
+	}
+	while( moved < maxCount && channel->count ) {
+		void	*element;
+
+		GrabFirstElement( &element, &channel->list );
+		PutLastElement( element, batch );
+		channel->count--;
+		moved++;
+	}
+	UnlockChannelAndWake( channel );
+
+	return( moved );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountChannelElements(
+	ElementChannel	*channel )
+{
+	size_t	count;
+
+	assertPtr( channel );
+
+	LockChannel( channel );
+	count = channel->count;
+	UnlockChannelAndWake( channel );
+
+	return( count );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LockChannel(
+	ElementChannel	*channel )
+{
+	unsigned	state = 0;
+
+	if( __atomic_compare_exchange_n( &channel->lock, &state, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+		return;
+	if( state != 2 )
+		state = __atomic_exchange_n( &channel->lock, 2, __ATOMIC_ACQUIRE );
+	while( state != 0 ) {
+		FutexWait( &channel->lock, 2, NULL );
+		state = __atomic_exchange_n( &channel->lock, 2, __ATOMIC_ACQUIRE );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnlockChannel(
+	ElementChannel	*channel )
+{
+	if( __atomic_fetch_sub( &channel->lock, 1, __ATOMIC_RELEASE ) != 1 ) {
+		__atomic_store_n( &channel->lock, 0, __ATOMIC_RELEASE );
+		FutexWake( &channel->lock, 1 );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Wakes as many as there is work for, at once.
+
+	************************************************************************************/
+
+	static
+	void
+UnlockChannelAndWake(
+	ElementChannel	*channel )
+{
+	int	wakeConsumers = SignalChannel( &channel->notEmpty, channel->count,
+			channel->consumersWaiting, &channel->consumerWakesPending );
+	int	wakeProducers = SignalChannel( &channel->notFull, channel->capacity - channel->count,
+			channel->producersWaiting, &channel->producerWakesPending );
+
+	UnlockChannel( channel );
+
+	if( wakeConsumers )
+		FutexWake( &channel->notEmpty, wakeConsumers );
+	if( wakeProducers )
+		FutexWake( &channel->notFull, wakeProducers );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Counts wakeups in flight rather than flagging one.
+
+	************************************************************************************/
+
+	static
+	bool
+WaitChannel(
+	ElementChannel			*channel,
+	unsigned				*word,
+	unsigned				*waiting,
+	unsigned				*wakesPending,
+	const struct timespec	*deadline )
+{
+	unsigned	seen = *word;
+	bool		timedOut;
+
+	(*waiting)++;
+	UnlockChannel( channel );
+
+	timedOut = FutexWait( word, seen, deadline ) != 0 && errno == ETIMEDOUT;
+
+	LockChannel( channel );
+	(*waiting)--;
+	//	Whichever waiter a wakeup was meant for, one is now awake to re-check
+	//	and, on its way out, wake others if there is more than it can take.
+	if( *wakesPending )
+		(*wakesPending)--;
+
+	return( !timedOut );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Returns how many to wake, not whether to.
+
+	************************************************************************************/
+
+	static
+	int
+SignalChannel(
+	unsigned	*word,
+	size_t		available,
+	unsigned	waiting,
+	unsigned	*wakesPending )
+{
+	unsigned	wanted = available < waiting ? (unsigned) available : waiting;
+
+	if( wanted <= *wakesPending )
+		return( 0 );
+
+	wanted -= *wakesPending;
+	*wakesPending += wanted;
+	__atomic_fetch_add( word, 1, __ATOMIC_RELAXED );
+	return( (int) wanted );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	int
+FutexWait(
+	unsigned				*word,
+	unsigned				expected,
+	const struct timespec	*deadline )
+{
+	//	FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC deadline.
+	return( (int) syscall( SYS_futex, word, FUTEX_WAIT_BITSET_PRIVATE, expected, deadline,
+			NULL, FUTEX_BITSET_MATCH_ANY ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+FutexWake(
+	unsigned	*word,
+	int			count )
+{
+	syscall( SYS_futex, word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0 );
+}
@@ -0,0 +1,134 @@
+/****************************************************************************************
+	elementalchannel.h
+
+	Bounded blocking ElementChannels for producer/consumer handoff. Linux only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An ElementChannel is an ElementList with a capacity, guarded by a futex
+	mutex, that producers block on when it is full and consumers block on when
+	it is empty. Nobody enters the kernel unless someone actually has to sleep:
+	a put or grab that finds no waiters on the other side makes no syscall.
+	Waiters are woken in batches, as many as there are elements (or room)
+	for, with one syscall, so a burst of puts costs the producer one wakeup
+	rather than one per item.
+
+	Every blocking call takes an absolute CLOCK_MONOTONIC deadline, or NULL to
+	wait indefinitely. Pass an already-expired deadline to poll.
+
+	************************************************************************************/
+
+#ifndef		_elementalchannel_
+#define		_elementalchannel_
+
+#include <time.h>
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementChannel	ElementChannel;
+
+struct	ElementChannel	{
+	ElementList	list;
+	size_t		count;
+	size_t		capacity;
+	bool		closed;
+
+	unsigned	lock;				//	0 unlocked, 1 locked, 2 locked with waiters.
+
+	unsigned	notEmpty;			//	Futex words, bumped on each wakeup.
+	unsigned	notFull;
+	unsigned	consumersWaiting;
+	unsigned	producersWaiting;
+	unsigned	consumerWakesPending;	//	Woken, but not yet back under the lock.
+	unsigned	producerWakesPending;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+	void
+NewElementChannel(
+	ElementChannel	*channel,
+	size_t			capacity );
+
+	void
+DeleteElementChannel(
+	ElementChannel	*channel );
+
+//	Wakes every waiter. Subsequent puts fail; grabs drain what is left, then fail.
+	void
+CloseElementChannel(
+	ElementChannel	*channel );
+
+/**************************
+*
+*	Channel Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Channel Putters)
+
+//	Puts element last, waiting for room until deadline. Returns false on
+//	timeout or if the channel is closed, leaving element untouched.
+	bool
+PutChannelElement(
+	void					*element,
+	ElementChannel			*channel,
+	const struct timespec	*deadline );
+
+//	Moves elements from the front of batch to the channel as room allows,
+//	waiting until deadline. Returns how many were moved; the rest stay in batch.
+	size_t
+PutChannelElements(
+	ElementList				*batch,
+	ElementChannel			*channel,
+	const struct timespec	*deadline );
+
+/**************************
+*
+*	Channel Grabbers
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Channel Grabbers)
+
+//	Grabs the first element, waiting until deadline. Returns false (and
+//	*element = NULL) on timeout or once a closed channel is drained.
+	bool
+GrabChannelElement(
+	void					**element,
+	ElementChannel			*channel,
+	const struct timespec	*deadline );
+
+//	Waits until deadline for at least one element, then moves up to maxCount
+//	onto the end of batch. Returns how many were moved; a maxCount of 0 returns
+//	0 at once, without waiting.
+	size_t
+GrabChannelElements(
+	ElementList				*batch,
+	size_t					maxCount,
+	ElementChannel			*channel,
+	const struct timespec	*deadline );
+
+//	Returns the number of elements in the channel; stale as soon as it returns.
+	size_t
+CountChannelElements(
+	ElementChannel	*channel );
+
+__END_DECLS
+#endif	//	_elementalchannel_
@@ -0,0 +1,635 @@
+/****************************************************************************************
+	elementalcoro.hpp
+
+	C++20 coroutine channel and mutex whose waiters cost no allocation.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Awaiting AsyncElementChannel::Put(), AsyncElementChannel::Grab() or
+	AsyncElementMutex::Lock() constructs an awaiter in the awaiting coroutine's
+	frame. The awaiter embeds an ElementWaiter, and that waiter is what gets
+	queued on the channel's or mutex's ElementList when the coroutine has to
+	suspend, so no waiter node is ever allocated. The waiter lives exactly as
+	long as the suspension does.
+
+	A woken coroutine is resumed on the executor it suspended under:
+	ElementLoop runs coroutines on the one thread that calls Run(), while
+	ElementThreadLoop accepts work from any thread and may be Run() by several.
+	A coroutine that suspended outside any executor is resumed inline by
+	whoever wakes it. Wakers never resume anyone while holding a lock.
+
+	Values on the channel are ordinary intrusive elements, as for ElementList.
+
+	************************************************************************************/
+
+#ifndef		_elementalcoro_
+#define		_elementalcoro_
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+
+#include "elemental.h"
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+class	ElementExecutor;
+
+//	A suspended coroutine, queued by its embedded element.
+struct	ElementWaiter	{
+	Element					element;	//	Must be first: waiters are queued as elements.
+	std::coroutine_handle<>	handle;
+	ElementExecutor			*executor;	//	Where to resume; NULL resumes inline.
+	void					*value;		//	Element being put, or handed to a grabber.
+	bool					ok;
+
+	ElementWaiter() : executor( NULL ), value( NULL ), ok( false ){}
+	ElementWaiter( const ElementWaiter& ) = delete;
+	ElementWaiter& operator=( const ElementWaiter& ) = delete;
+};
+
+class	ElementExecutor	{
+public:
+	virtual	~ElementExecutor() {}
+
+	//	Queues waiter to be resumed by this executor.
+	virtual	void	Schedule( ElementWaiter *waiter ) = 0;
+
+	//	The executor running on this thread, if any.
+	static	ElementExecutor*&	Current();
+};
+
+//	A fire-and-forget coroutine. Starts suspended; see SpawnElementTask().
+struct	ElementTask	{
+	struct	promise_type	{
+		ElementWaiter	waiter;		//	Queues the task for its first run.
+
+		ElementTask			get_return_object() { return( ElementTask( std::coroutine_handle<promise_type>::from_promise( *this ) ) ); }
+		std::suspend_always	initial_suspend() noexcept { return( std::suspend_always() ); }
+		std::suspend_never	final_suspend() noexcept { return( std::suspend_never() ); }
+		void				return_void() {}
+		void				unhandled_exception() { std::terminate(); }
+	};
+
+	explicit ElementTask( std::coroutine_handle<promise_type> handle_ ) : handle( handle_ ){}
+
+	std::coroutine_handle<promise_type>	handle;
+};
+
+/**************************
+*
+*	Executors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Executors)
+
+//	Runs coroutines on a single thread. Schedule() must only be called from
+//	the thread calling Run(), which includes channel and mutex wakeups.
+class	ElementLoop : public ElementExecutor	{
+public:
+	void	Schedule( ElementWaiter *waiter ) override;
+
+	//	Resumes ready coroutines until there are none.
+	void	Run();
+
+private:
+	ElementList	ready;
+};
+
+//	Runs coroutines on whichever threads call Run(). Schedule() may be called
+//	from any thread.
+class	ElementThreadLoop : public ElementExecutor	{
+public:
+	ElementThreadLoop() : idle( 0 ), stopping( false ){}
+
+	void	Schedule( ElementWaiter *waiter ) override;
+
+	//	Resumes ready coroutines, sleeping when there are none, until Stop()
+	//	has been called and nothing is left to run.
+	void	Run();
+	void	Stop();
+
+private:
+	std::mutex				lock;
+	std::condition_variable	wake;
+	ElementList				ready;
+	unsigned				idle;		//	Threads sleeping in Run().
+	bool					stopping;
+};
+
+//	Queues task's first run on executor. The frame frees itself on completion.
+	void
+SpawnElementTask(
+	ElementTask		task,
+	ElementExecutor	&executor );
+
+/**************************
+*
+*	Channel
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Channel)
+
+//	A bounded FIFO of elements. A capacity of zero makes every put wait for a
+//	grabber.
+class	AsyncElementChannel	{
+public:
+	class	PutAwaiter	{
+	public:
+		PutAwaiter( AsyncElementChannel *channel_, void *element ) : channel( channel_ ) { waiter.value = element; }
+
+		bool	await_ready() noexcept { return( false ); }
+		bool	await_suspend( std::coroutine_handle<> handle ) { return( channel->SuspendPut( &waiter, handle ) ); }
+		bool	await_resume() noexcept { return( waiter.ok ); }
+
+	private:
+		AsyncElementChannel	*channel;
+		ElementWaiter		waiter;
+	};
+
+	class	GrabAwaiter	{
+	public:
+		explicit GrabAwaiter( AsyncElementChannel *channel_ ) : channel( channel_ ){}
+
+		bool	await_ready() noexcept { return( false ); }
+		bool	await_suspend( std::coroutine_handle<> handle ) { return( channel->SuspendGrab( &waiter, handle ) ); }
+		void*	await_resume() noexcept { return( waiter.value ); }
+
+	private:
+		AsyncElementChannel	*channel;
+		ElementWaiter		waiter;
+	};
+
+	explicit AsyncElementChannel( size_t capacity_ ) : count( 0 ), capacity( capacity_ ), closed( false ){}
+	AsyncElementChannel( const AsyncElementChannel& ) = delete;
+	AsyncElementChannel& operator=( const AsyncElementChannel& ) = delete;
+
+	//	co_await Put( element ) puts element last, waiting for room. Yields false
+	//	if the channel is closed, leaving element untouched.
+	PutAwaiter	Put( void *element ) { return( PutAwaiter( this, element ) ); }
+
+	//	co_await Grab() yields the first element, waiting for one. Yields NULL
+	//	once a closed channel is drained.
+	GrabAwaiter	Grab() { return( GrabAwaiter( this ) ); }
+
+	//	Wakes every waiter. Subsequent puts fail; grabs drain what is left, then fail.
+	void	Close();
+
+	//	Returns the number of elements in the channel; stale as soon as it returns.
+	size_t	Count();
+
+private:
+	bool	SuspendPut( ElementWaiter *waiter, std::coroutine_handle<> handle );
+	bool	SuspendGrab( ElementWaiter *waiter, std::coroutine_handle<> handle );
+
+	std::mutex	lock;
+	ElementList	list;
+	size_t		count;
+	size_t		capacity;
+	bool		closed;
+	ElementList	putters;	//	Waiting for room, each holding its element.
+	ElementList	grabbers;	//	Waiting for an element.
+};
+
+/**************************
+*
+*	Mutex
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Mutex)
+
+//	A FIFO mutex for coroutines. Unlock() hands ownership straight to the
+//	first waiter, so a barging locker can't starve it.
+class	AsyncElementMutex	{
+public:
+	class	LockAwaiter	{
+	public:
+		explicit LockAwaiter( AsyncElementMutex *mutex_ ) : mutex( mutex_ ){}
+
+		bool	await_ready() noexcept { return( false ); }
+		bool	await_suspend( std::coroutine_handle<> handle ) { return( mutex->SuspendLock( &waiter, handle ) ); }
+		void	await_resume() noexcept {}
+
+	private:
+		AsyncElementMutex	*mutex;
+		ElementWaiter		waiter;
+	};
+
+	AsyncElementMutex() : locked( false ){}
+	AsyncElementMutex( const AsyncElementMutex& ) = delete;
+	AsyncElementMutex& operator=( const AsyncElementMutex& ) = delete;
+
+	//	co_await Lock() returns once the mutex is held.
+	LockAwaiter	Lock() { return( LockAwaiter( this ) ); }
+	bool		TryLock();
+	void		Unlock();
+
+private:
+	bool	SuspendLock( ElementWaiter *waiter, std::coroutine_handle<> handle );
+
+	std::mutex	lock;
+	bool		locked;
+	ElementList	waiters;
+};
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Implementation)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+WakeElementWaiter(
+	ElementWaiter	*waiter )
+{
+	if( waiter->executor )
+		waiter->executor->Schedule( waiter );
+	else
+		waiter->handle.resume();
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+PrepareElementWaiter(
+	ElementWaiter			*waiter,
+	std::coroutine_handle<>	handle )
+{
+	waiter->handle = handle;
+	waiter->executor = ElementExecutor::Current();
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	ElementExecutor*&
+ElementExecutor::Current()
+{
+	static thread_local ElementExecutor	*current = NULL;
+
+	return( current );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+ElementLoop::Schedule(
+	ElementWaiter	*waiter )
+{
+	PutLastElement( waiter, &ready );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+ElementLoop::Run()
+{
+	ElementExecutor	*outer = Current();
+	void			*waiter;
+
+	Current() = this;
+	for( GrabFirstElement( &waiter, &ready ); waiter; GrabFirstElement( &waiter, &ready ) )
+		((ElementWaiter*) waiter)->handle.resume();
+	Current() = outer;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+ElementThreadLoop::Schedule(
+	ElementWaiter	*waiter )
+{
+	bool	sleeper;
+
+	{
+		std::lock_guard<std::mutex>	guard( lock );
+
+		PutLastElement( waiter, &ready );
+		sleeper = idle != 0;
+	}
+	if( sleeper )
+		wake.notify_one();
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+ElementThreadLoop::Run()
+{
+	ElementExecutor	*outer = Current();
+	void			*waiter;
+
+	Current() = this;
+	for(;;) {
+		{
+			std::unique_lock<std::mutex>	guard( lock );
+
+			for( GrabFirstElement( &waiter, &ready ); !waiter && !stopping; GrabFirstElement( &waiter, &ready ) ) {
+				idle++;
+				wake.wait( guard );
+				idle--;
+			}
+		}
+		if( !waiter )
+			break;
+		((ElementWaiter*) waiter)->handle.resume();
+	}
+	Current() = outer;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+ElementThreadLoop::Stop()
+{
+	{
+		std::lock_guard<std::mutex>	guard( lock );
+
+		stopping = true;
+	}
+	wake.notify_all();
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+SpawnElementTask(
+	ElementTask		task,
+	ElementExecutor	&executor )
+{
+	ElementWaiter	*waiter = &task.handle.promise().waiter;
+
+	waiter->handle = task.handle;
+	waiter->executor = &executor;
+	executor.Schedule( waiter );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	bool
+AsyncElementChannel::SuspendPut(
+	ElementWaiter			*waiter,
+	std::coroutine_handle<>	handle )
+{
+	void	*grabber;
+
+	PrepareElementWaiter( waiter, handle );
+
+	std::unique_lock<std::mutex>	guard( lock );
+
+	if( closed ) {
+		waiter->ok = false;
+		return( false );
+	}
+	waiter->ok = true;
+
+	GrabFirstElement( &grabber, &grabbers );
+	if( grabber ) {
+		//	Anyone waiting to grab found the channel empty; hand it over directly.
+		((ElementWaiter*) grabber)->value = waiter->value;
+		guard.unlock();
+		WakeElementWaiter( (ElementWaiter*) grabber );
+		return( false );
+	}
+	if( count < capacity ) {
+		PutLastElement( waiter->value, &list );
+		count++;
+		return( false );
+	}
+
+	PutLastElement( waiter, &putters );
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	bool
+AsyncElementChannel::SuspendGrab(
+	ElementWaiter			*waiter,
+	std::coroutine_handle<>	handle )
+{
+	void	*putter;
+
+	PrepareElementWaiter( waiter, handle );
+
+	std::unique_lock<std::mutex>	guard( lock );
+
+	GrabFirstElement( &waiter->value, &list );
+	GrabFirstElement( &putter, &putters );
+	if( waiter->value ) {
+		count--;
+		if( putter ) {
+			//	Refill the slot just freed.
+			PutLastElement( ((ElementWaiter*) putter)->value, &list );
+			count++;
+		}
+	} else if( putter )
+		//	Unbuffered: take straight from the putter.
+		waiter->value = ((ElementWaiter*) putter)->value;
+	else if( !closed ) {
+		PutLastElement( waiter, &grabbers );
+		return( true );
+	}
+
+	guard.unlock();
+	if( putter )
+		WakeElementWaiter( (ElementWaiter*) putter );
+	return( false );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+AsyncElementChannel::Close()
+{
+	ElementList	woken;
+	void		*waiter;
+
+	{
+		std::lock_guard<std::mutex>	guard( lock );
+
+		closed = true;
+		for( GrabFirstElement( &waiter, &grabbers ); waiter; GrabFirstElement( &waiter, &grabbers ) ) {
+			((ElementWaiter*) waiter)->value = NULL;
+			PutLastElement( waiter, &woken );
+		}
+		for( GrabFirstElement( &waiter, &putters ); waiter; GrabFirstElement( &waiter, &putters ) ) {
+			((ElementWaiter*) waiter)->ok = false;
+			PutLastElement( waiter, &woken );
+		}
+	}
+	for( GrabFirstElement( &waiter, &woken ); waiter; GrabFirstElement( &waiter, &woken ) )
+		WakeElementWaiter( (ElementWaiter*) waiter );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	size_t
+AsyncElementChannel::Count()
+{
+	std::lock_guard<std::mutex>	guard( lock );
+
+	return( count );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	bool
+AsyncElementMutex::SuspendLock(
+	ElementWaiter			*waiter,
+	std::coroutine_handle<>	handle )
+{
+	PrepareElementWaiter( waiter, handle );
+
+	std::lock_guard<std::mutex>	guard( lock );
+
+	if( !locked ) {
+		locked = true;
+		return( false );
+	}
+	PutLastElement( waiter, &waiters );
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	bool
+AsyncElementMutex::TryLock()
+{
+	std::lock_guard<std::mutex>	guard( lock );
+
+	if( locked )
+		return( false );
+	locked = true;
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	inline
+	void
+AsyncElementMutex::Unlock()
+{
+	void	*waiter;
+
+	{
+		std::lock_guard<std::mutex>	guard( lock );
+
+		GrabFirstElement( &waiter, &waiters );
+		if( !waiter )
+			locked = false;
+	}
+	//	Still locked: ownership passes to waiter.
+	if( waiter )
+		WakeElementWaiter( (ElementWaiter*) waiter );
+}
+
+#endif	//	_elementalcoro_
@@ -0,0 +1,458 @@
+/****************************************************************************************
+	elementalhash.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An element's chain Element points back at its bucket, so removal never
+	rehashes, and whether an element still awaits migration is just whether
+	that bucket lies in the old array. Migration walks the old array in order,
+	so the old buckets still in use are always [ migrated, oldBucketCount ).
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "elementalhash.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+	static
+	ElementList*
+NewHashBuckets(
+	size_t	bucketCount );
+
+	static
+	void
+GrowElementHashTable(
+	ElementHashTable	*table );
+
+	static
+	void
+MigrateHashBuckets(
+	ElementHashTable	*table,
+	size_t				steps );
+
+	static
+	void
+FindInHashBucket(
+	void				**element,
+	ElementHashTable	*table,
+	ElementList			*bucket,
+	const void			*key );
+
+	static
+	void
+ScanHashBuckets(
+	void				**element,
+	ElementHashTable	*table,
+	ElementList			*bucket );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+NewElementHashTable(
+	ElementHashTable	*table,
+	size_t				bucketCount,
+	size_t				chainOffset,
+	size_t				orderOffset,
+	ElementHashProc		hashProc,
+	ElementMatchProc	matchProc,
+	void				*refCon )
+{
+	size_t	count = 1;
+
+	assertPtr( table );
+	assertPtr( hashProc );
+	assertPtr( matchProc );
+
+	while( count < bucketCount )
+		count <<= 1;
+
+	table->buckets = NewHashBuckets( count );
+	if( table->buckets == NULL )
+		return( false );
+	table->bucketCount = count;
+	table->oldBuckets = NULL;
+	table->oldBucketCount = 0;
+	table->migrated = 0;
+	table->count = 0;
+
+	NewElementList( &table->order );
+	table->chainOffset = chainOffset;
+	table->orderOffset = orderOffset;
+
+	table->hashProc = hashProc;
+	table->matchProc = matchProc;
+	table->refCon = refCon;
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementHashTable(
+	ElementHashTable	*table )
+{
+	assertPtr( table );
+
+	free( table->buckets );
+	free( table->oldBuckets );
+	table->buckets = table->oldBuckets = NULL;
+	table->bucketCount = table->oldBucketCount = 0;
+	table->count = 0;
+	DeleteElementList( &table->order );
+}
+
+/****************************************************************************************
+*
+*	Hash Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Hash Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutHashElement(
+	void				*element,
+	ElementHashTable	*table )
+{
+	size_t	hash;
+
+	assertPtr( element );
+	assertPtr( table );
+
+	if( table->count >= table->bucketCount && table->oldBuckets == NULL )
+		GrowElementHashTable( table );
+	MigrateHashBuckets( table, elementalHashMigrateStep );
+
+	hash = table->hashProc( element, table->refCon );
+	PutFirstElementOff( element, &table->buckets[ hash & (table->bucketCount - 1) ], table->chainOffset );
+	if( table->orderOffset != elementalHashUnordered )
+		PutLastElementOff( element, &table->order, table->orderOffset );
+	table->count++;
+}
+
+/****************************************************************************************
+*
+*	Hash Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Hash Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FindHashElement(
+	void				**element,
+	ElementHashTable	*table,
+	size_t				hash,
+	const void			*key )
+{
+	assertPtr( element );
+	assertPtr( table );
+
+	FindInHashBucket( element, table, &table->buckets[ hash & (table->bucketCount - 1) ], key );
+	if( *element == NULL && table->oldBuckets ) {
+		size_t	index = hash & (table->oldBucketCount - 1);
+
+		if( index >= table->migrated )
+			FindInHashBucket( element, table, &table->oldBuckets[ index ], key );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountHashElements(
+	ElementHashTable	*table )
+{
+	assertPtr( table );
+
+	return( table->count );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstHashElement(
+	void				**element,
+	ElementHashTable	*table )
+{
+	assertPtr( element );
+	assertPtr( table );
+
+	if( table->orderOffset != elementalHashUnordered )
+		FirstElementOff( element, &table->order, table->orderOffset );
+	else
+		ScanHashBuckets( element, table,
+			table->oldBuckets ? &table->oldBuckets[ table->migrated ] : table->buckets );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextHashElement(
+	void				*element,
+	void				**nextElement,
+	ElementHashTable	*table )
+{
+	assertPtr( element );
+	assertPtr( nextElement );
+	assertPtr( table );
+
+	if( table->orderOffset != elementalHashUnordered ) {
+		NextElementOff( element, nextElement, table->orderOffset );
+		return;
+	}
+	NextElementOff( element, nextElement, table->chainOffset );
+	if( *nextElement == NULL )
+		ScanHashBuckets( nextElement, table, GetElementListOff( element, table->chainOffset ) + 1 );
+}
+
+/****************************************************************************************
+*
+*	Hash Grabbing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Hash Grabbing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveHashElement(
+	void				*element,
+	ElementHashTable	*table )
+{
+	ElementList	*bucket;
+
+	assertPtr( element );
+	assertPtr( table );
+
+	bucket = GetElementListOff( element, table->chainOffset );
+	assertPtr( bucket );
+
+	RemoveElementOff( element, bucket, table->chainOffset );
+	if( table->orderOffset != elementalHashUnordered )
+		RemoveElementOff( element, &table->order, table->orderOffset );
+	table->count--;
+
+	MigrateHashBuckets( table, elementalHashMigrateStep );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabHashElement(
+	void				**element,
+	ElementHashTable	*table,
+	size_t				hash,
+	const void			*key )
+{
+	FindHashElement( element, table, hash, key );
+	if( *element )
+		RemoveHashElement( *element, table );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	calloc() instead of NewElementList() on each bucket.
+
+	************************************************************************************/
+
+	static
+	ElementList*
+NewHashBuckets(
+	size_t	bucketCount )
+{
+	//	An all-zero ElementList is an empty one. A large array comes straight
+	//	from mmap(), already zero, so growing doesn't stop to touch every new
+	//	bucket; the pages are faulted in as migration and puts reach them.
+	return( (ElementList*) calloc( bucketCount, sizeof( ElementList ) ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+GrowElementHashTable(
+	ElementHashTable	*table )
+{
+	ElementList	*buckets = NewHashBuckets( table->bucketCount * 2 );
+
+	if( buckets == NULL )
+		return;
+
+	table->oldBuckets = table->buckets;
+	table->oldBucketCount = table->bucketCount;
+	table->migrated = 0;
+	table->buckets = buckets;
+	table->bucketCount *= 2;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+MigrateHashBuckets(
+	ElementHashTable	*table,
+	size_t				steps )
+{
+	size_t	mask = table->bucketCount - 1;
+
+	for( ; table->oldBuckets && steps; steps-- ) {
+		ElementList	*bucket = &table->oldBuckets[ table->migrated ];
+		void		*element;
+
+		for( GrabFirstElementOff( &element, bucket, table->chainOffset ); element;
+			 GrabFirstElementOff( &element, bucket, table->chainOffset ) )
+			PutFirstElementOff( element, &table->buckets[ table->hashProc( element, table->refCon ) & mask ],
+								table->chainOffset );
+
+		if( ++table->migrated == table->oldBucketCount ) {
+			free( table->oldBuckets );
+			table->oldBuckets = NULL;
+			table->oldBucketCount = 0;
+			table->migrated = 0;
+		}
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+FindInHashBucket(
+	void				**element,
+	ElementHashTable	*table,
+	ElementList			*bucket,
+	const void			*key )
+{
+	FirstElementOff( element, bucket, table->chainOffset );
+	while( *element && !table->matchProc( *element, key, table->refCon ) )
+		NextElementOff( *element, element, table->chainOffset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+ScanHashBuckets(
+	void				**element,
+	ElementHashTable	*table,
+	ElementList			*bucket )
+{
+	//	Old buckets come first, then the current ones.
+	for(;;) {
+		if( table->oldBuckets && bucket == &table->oldBuckets[ table->oldBucketCount ] )
+			bucket = table->buckets;
+		if( bucket == &table->buckets[ table->bucketCount ] ) {
+			*element = NULL;
+			return;
+		}
+		FirstElementOff( element, bucket++, table->chainOffset );
+		if( *element )
+			return;
+	}
+}
@@ -0,0 +1,197 @@
+/****************************************************************************************
+	elementalhash.h
+
+	Intrusive hash tables whose buckets are ElementLists.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An ElementHashTable chains elements through an Element embedded in each
+	one, so indexing an element costs no allocation beyond the bucket array.
+	A table may also keep every element on an insertion-ordered ElementList,
+	threaded through a second embedded Element, for ordered iteration.
+
+	The table doubles once it holds as many elements as buckets. Rather than
+	rehash everything at once, a grown table keeps its old bucket array and
+	each put or remove migrates elementalHashMigrateStep old buckets into the
+	new one. Lookups consult both arrays until migration finishes.
+
+	************************************************************************************/
+
+#ifndef		_elementalhash_
+#define		_elementalhash_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+//	Old buckets migrated per put or remove while growing.
+#ifndef	elementalHashMigrateStep
+	#define	elementalHashMigrateStep	2
+#endif
+
+//	Pass as orderOffset for a table without an insertion-ordered list.
+#define	elementalHashUnordered	((size_t) -1)
+
+typedef	struct	ElementHashTable	ElementHashTable;
+
+//	Returns element's hash. Must agree with the hashes passed to the finders.
+typedef	size_t	(*ElementHashProc)( void *element, void *refCon );
+
+//	Return whether element has the given key.
+typedef	bool	(*ElementMatchProc)( void *element, const void *key, void *refCon );
+
+struct	ElementHashTable	{
+	ElementList			*buckets;
+	size_t				bucketCount;	//	Always a power of two.
+	ElementList			*oldBuckets;	//	Being migrated from, or NULL.
+	size_t				oldBucketCount;
+	size_t				migrated;		//	Old buckets already emptied.
+	size_t				count;
+
+	ElementList			order;
+	size_t				chainOffset;
+	size_t				orderOffset;
+
+	ElementHashProc		hashProc;
+	ElementMatchProc	matchProc;
+	void				*refCon;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	chainOffset locates the Element used for bucket chains; orderOffset, the
+//	Element used for the insertion-ordered list, or elementalHashUnordered.
+//	bucketCount is rounded up to a power of two. Returns false if the bucket
+//	array could not be allocated.
+	bool
+NewElementHashTable(
+	ElementHashTable	*table,
+	size_t				bucketCount,
+	size_t				chainOffset,
+	size_t				orderOffset,
+	ElementHashProc		hashProc,
+	ElementMatchProc	matchProc,
+	void				*refCon );
+
+//	Frees the bucket arrays. The elements themselves are untouched.
+	void
+DeleteElementHashTable(
+	ElementHashTable	*table );
+
+/**************************
+*
+*	Hash Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Hash Putters)
+
+//	Adds element, which must not already be in a table. Elements with equal
+//	keys may coexist; finders return whichever they meet first. If the table
+//	needs to grow and can't, it carries on overloaded.
+	void
+PutHashElement(
+	void				*element,
+	ElementHashTable	*table );
+
+/**************************
+*
+*	Hash Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Hash Accessors)
+
+//	*element = an element matching key, or NULL. hash is key's hash.
+	void
+FindHashElement(
+	void				**element,
+	ElementHashTable	*table,
+	size_t				hash,
+	const void			*key );
+
+//	Returns the number of elements in table.
+	size_t
+CountHashElements(
+	ElementHashTable	*table );
+
+//	Iterates table in insertion order if it is ordered, else in bucket order.
+//	Putting or removing during iteration may migrate buckets, so only
+//	the order list is safe to modify while iterating.
+	void
+FirstHashElement(
+	void				**element,
+	ElementHashTable	*table );
+
+	void
+NextHashElement(
+	void				*element,
+	void				**nextElement,
+	ElementHashTable	*table );
+
+/**************************
+*
+*	Hash Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Hash Grabbing)
+
+//	Removes element, which must be in table.
+	void
+RemoveHashElement(
+	void				*element,
+	ElementHashTable	*table );
+
+//	Finds an element matching key and removes it. *element = NULL if none.
+	void
+GrabHashElement(
+	void				**element,
+	ElementHashTable	*table,
+	size_t				hash,
+	const void			*key );
+
+/**************************
+*
+*	Type Variants
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Variants)
+
+#define	NewElementHashTableType( TABLE, BUCKETCOUNT, STRUCTURE, FIELD, HASHPROC, MATCHPROC, REFCON )	\
+			NewElementHashTable( (TABLE), (BUCKETCOUNT), offsetof( STRUCTURE, FIELD ), elementalHashUnordered,	\
+				(HASHPROC), (MATCHPROC), (REFCON) )
+
+#define	NewOrderedElementHashTableType( TABLE, BUCKETCOUNT, STRUCTURE, FIELD, ORDERFIELD, HASHPROC, MATCHPROC, REFCON )	\
+			NewElementHashTable( (TABLE), (BUCKETCOUNT), offsetof( STRUCTURE, FIELD ), offsetof( STRUCTURE, ORDERFIELD ),	\
+				(HASHPROC), (MATCHPROC), (REFCON) )
+
+#define	FindHashElementType( ELEMENT, TABLE, HASH, KEY )	\
+			FindHashElement( (void**)(ELEMENT), (TABLE), (HASH), (KEY) )
+
+#define	FirstHashElementType( ELEMENT, TABLE )	\
+			FirstHashElement( (void**)(ELEMENT), (TABLE) )
+
+#define	NextHashElementType( ELEMENT, NEXTELEMENT, TABLE )	\
+			NextHashElement( (ELEMENT), (void**)(NEXTELEMENT), (TABLE) )
+
+#define	GrabHashElementType( ELEMENT, TABLE, HASH, KEY )	\
+			GrabHashElement( (void**)(ELEMENT), (TABLE), (HASH), (KEY) )
+
+__END_DECLS
+#endif	//	_elementalhash_
@@ -0,0 +1,576 @@
+/****************************************************************************************
+	elementalheap.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The plain functions are the Off functions with an offset of zero, since
+	every comparison needs the structure a HeapElement is embedded in.
+
+	Pairing is the standard two passes: link the children in pairs left to
+	right, then fold the pairs into one tree right to left. The first pass
+	stacks its results through their next fields, so the second pass walks
+	them in reverse without any extra storage.
+
+	************************************************************************************/
+
+#include <assert.h>
+
+#include "elementalheap.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+#define	heapElementAt( ELEMENT, OFFSET )	((HeapElement*) ((char*) (ELEMENT) + (OFFSET)))
+#define	structureOf( ELEMENT, OFFSET )		((void*) ((char*) (ELEMENT) - (OFFSET)))
+
+	static
+	HeapElement*
+LinkHeapElements(
+	HeapElement	*a,
+	HeapElement	*b,
+	ElementHeap	*heap,
+	size_t		offset );
+
+	static
+	HeapElement*
+PairHeapElements(
+	HeapElement	*first,
+	ElementHeap	*heap,
+	size_t		offset );
+
+	static
+	void
+CutHeapElement(
+	HeapElement	*element );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementHeap(
+	ElementHeap			*heap,
+	ElementOrderProc	orderProc,
+	void				*refCon )
+{
+	assertPtr( heap );
+	assertPtr( orderProc );
+
+	heap->root = NULL;
+	heap->count = 0;
+	heap->orderProc = orderProc;
+	heap->refCon = refCon;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementHeap(
+	ElementHeap	*heap )
+{
+	(void) heap;
+}
+
+/****************************************************************************************
+*
+*	Heap Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Heap Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutHeapElement(
+	void			*element,
+	ElementHeap		*heap )
+{
+	PutHeapElementOff( element, heap, 0 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+MeldElementHeaps(
+	ElementHeap	*heap,
+	ElementHeap	*other )
+{
+	MeldElementHeapsOff( heap, other, 0 );
+}
+
+/****************************************************************************************
+*
+*	Heap Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Heap Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstHeapElement(
+	void			**element,
+	ElementHeap		*heap )
+{
+	FirstHeapElementOff( element, heap, 0 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+IsHeapElementQueued(
+	void			*element,
+	ElementHeap		*heap )
+{
+	return( IsHeapElementQueuedOff( element, heap, 0 ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountHeapElements(
+	ElementHeap	*heap )
+{
+	assertPtr( heap );
+
+	return( heap->count );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+IsHeapEmpty(
+	ElementHeap	*heap )
+{
+	assertPtr( heap );
+
+	return( heap->root == NULL );
+}
+
+/****************************************************************************************
+*
+*	Heap Grabbing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Heap Grabbing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstHeapElement(
+	void			**element,
+	ElementHeap		*heap )
+{
+	GrabFirstHeapElementOff( element, heap, 0 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveHeapElement(
+	void			*element,
+	ElementHeap		*heap )
+{
+	RemoveHeapElementOff( element, heap, 0 );
+}
+
+/****************************************************************************************
+*
+*	Heap Reordering
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Heap Reordering)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DecreaseHeapElement(
+	void			*element,
+	ElementHeap		*heap )
+{
+	DecreaseHeapElementOff( element, heap, 0 );
+}
+
+/****************************************************************************************
+*
+*	Offset Heap Functions
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Heap Functions)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	HeapElement	*element_ = heapElementAt( element, offset );
+
+	assertPtr( element );
+	assertPtr( heap );
+	assertTrue( !IsHeapElementQueuedOff( element, heap, offset ) );
+
+	element_->child = element_->next = element_->prev = NULL;
+	heap->root = heap->root ? LinkHeapElements( heap->root, element_, heap, offset ) : element_;
+	heap->count++;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+MeldElementHeapsOff(
+	ElementHeap	*heap,
+	ElementHeap	*other,
+	size_t		offset )
+{
+	assertPtr( heap );
+	assertPtr( other );
+	assertTrue( heap != other );
+	assertTrue( heap->orderProc == other->orderProc );
+
+	if( other->root == NULL )
+		return;
+
+	heap->root = heap->root ? LinkHeapElements( heap->root, other->root, heap, offset ) : other->root;
+	heap->count += other->count;
+	other->root = NULL;
+	other->count = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstHeapElementOff(
+	void			**element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	assertPtr( element );
+	assertPtr( heap );
+
+	*element = heap->root ? structureOf( heap->root, offset ) : NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+IsHeapElementQueuedOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	HeapElement	*element_ = heapElementAt( element, offset );
+
+	assertPtr( element );
+	assertPtr( heap );
+
+	//	Only the root has no prev.
+	return( element_->prev != NULL || heap->root == element_ );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstHeapElementOff(
+	void			**element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	HeapElement	*root;
+
+	assertPtr( element );
+	assertPtr( heap );
+
+	root = heap->root;
+	if( root == NULL ) {
+		*element = NULL;
+		return;
+	}
+
+	heap->root = root->child ? PairHeapElements( root->child, heap, offset ) : NULL;
+	heap->count--;
+	root->child = NULL;
+	*element = structureOf( root, offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	HeapElement	*element_ = heapElementAt( element, offset );
+
+	assertPtr( element );
+	assertPtr( heap );
+	assertTrue( IsHeapElementQueuedOff( element, heap, offset ) );
+
+	if( heap->root == element_ ) {
+		void	*grabbed;
+
+		GrabFirstHeapElementOff( &grabbed, heap, offset );
+		return;
+	}
+
+	//	Everything under element still belongs after the root.
+	CutHeapElement( element_ );
+	if( element_->child ) {
+		HeapElement	*children = PairHeapElements( element_->child, heap, offset );
+
+		element_->child = NULL;
+		heap->root = LinkHeapElements( heap->root, children, heap, offset );
+	}
+	heap->count--;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DecreaseHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset )
+{
+	HeapElement	*element_ = heapElementAt( element, offset );
+
+	assertPtr( element );
+	assertPtr( heap );
+	assertTrue( IsHeapElementQueuedOff( element, heap, offset ) );
+
+	//	Its subtree can only come out later than it does, so it moves along.
+	if( heap->root != element_ ) {
+		CutHeapElement( element_ );
+		heap->root = LinkHeapElements( heap->root, element_, heap, offset );
+	}
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	HeapElement*
+LinkHeapElements(
+	HeapElement	*a,
+	HeapElement	*b,
+	ElementHeap	*heap,
+	size_t		offset )
+{
+	HeapElement	*winner, *loser;
+
+	//	On a tie, a stays on top.
+	if( heap->orderProc( structureOf( b, offset ), structureOf( a, offset ), heap->refCon ) )
+		winner = b, loser = a;
+	else
+		winner = a, loser = b;
+
+	loser->prev = winner;
+	loser->next = winner->child;
+	if( winner->child )
+		winner->child->prev = loser;
+	winner->child = loser;
+	winner->next = winner->prev = NULL;
+
+	return( winner );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	HeapElement*
+PairHeapElements(
+	HeapElement	*first,
+	ElementHeap	*heap,
+	size_t		offset )
+{
+	HeapElement	*pairs = NULL;
+	HeapElement	*result;
+
+	assertTrue( first != NULL );
+
+	//	Left to right, pushing each linked pair onto a stack.
+	while( first ) {
+		HeapElement	*a = first;
+		HeapElement	*b = a->next;
+
+		if( b == NULL ) {
+			a->prev = NULL;
+			a->next = pairs;
+			pairs = a;
+			break;
+		}
+		first = b->next;
+		a = LinkHeapElements( a, b, heap, offset );
+		a->next = pairs;
+		pairs = a;
+	}
+
+	//	Right to left, folding the stack into one tree.
+	result = pairs;
+	pairs = pairs->next;
+	result->next = NULL;
+	while( pairs ) {
+		HeapElement	*next = pairs->next;
+
+		result = LinkHeapElements( result, pairs, heap, offset );
+		pairs = next;
+	}
+
+	return( result );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+CutHeapElement(
+	HeapElement	*element )
+{
+	assertTrue( element->prev != NULL );
+
+	if( element->prev->child == element )
+		element->prev->child = element->next;
+	else
+		element->prev->next = element->next;
+	if( element->next )
+		element->next->prev = element->prev;
+	element->next = element->prev = NULL;
+}
@@ -0,0 +1,248 @@
+/****************************************************************************************
+	elementalheap.h
+
+	Intrusive pairing heaps whose nodes are embedded like Elements.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An object queued on an ElementHeap embeds a HeapElement, just as it would
+	an Element to sit on an ElementList, so the heap never allocates and an
+	object can be reprioritized or removed through its own hook instead of
+	being searched for or left behind as a stale entry.
+
+	Putting and melding are constant-time. Grabbing the first element pairs
+	up the root's children, amortized O(log n). Decreasing a key cuts the
+	element's subtree off and links it back at the root, a constant amount of
+	work that can leave more for later pairings to do: its amortized cost is
+	sub-logarithmic, o(log n), though not known to be O(1). Removing an
+	arbitrary element cuts it out and pairs up its children, amortized
+	O(log n), like grabbing the first; only a childless element, as most are,
+	comes out in constant time.
+
+	************************************************************************************/
+
+#ifndef		_elementalheap_
+#define		_elementalheap_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	HeapElement	HeapElement;
+typedef	struct	ElementHeap	ElementHeap;
+
+//	Return whether a should come out of the heap before b.
+typedef	bool	(*ElementOrderProc)( void *a, void *b, void *refCon );
+
+//	A leftmost child's prev is its parent; any other's is its left sibling.
+struct	HeapElement	{
+	HeapElement	*child;
+	HeapElement	*next;
+	HeapElement	*prev;
+
+#ifdef	__cplusplus
+	HeapElement() : child( NULL ), next( NULL ), prev( NULL ){}
+#endif
+};
+
+struct	ElementHeap	{
+	HeapElement			*root;
+	size_t				count;
+	ElementOrderProc	orderProc;
+	void				*refCon;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	orderProc is passed the structures the HeapElements are embedded in.
+	void
+NewElementHeap(
+	ElementHeap			*heap,
+	ElementOrderProc	orderProc,
+	void				*refCon );
+
+	void
+DeleteElementHeap(
+	ElementHeap	*heap );
+
+/**************************
+*
+*	Heap Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Heap Putters)
+
+//	Queues element, which must not be in a heap. Constant-time.
+	void
+PutHeapElement(
+	void			*element,
+	ElementHeap		*heap );
+
+//	Moves all of other's elements into heap, leaving other empty. Both must
+//	share an order. Constant-time.
+	void
+MeldElementHeaps(
+	ElementHeap	*heap,
+	ElementHeap	*other );
+
+/**************************
+*
+*	Heap Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Heap Accessors)
+
+//	*element = the element that comes out first, or NULL if heap is empty.
+	void
+FirstHeapElement(
+	void			**element,
+	ElementHeap		*heap );
+
+//	Returns whether element, which is in heap if in any heap, is queued.
+//	The HeapElement must have been zeroed before its first put.
+	bool
+IsHeapElementQueued(
+	void			*element,
+	ElementHeap		*heap );
+
+	size_t
+CountHeapElements(
+	ElementHeap	*heap );
+
+	bool
+IsHeapEmpty(
+	ElementHeap	*heap );
+
+/**************************
+*
+*	Heap Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Heap Grabbing)
+
+//	Removes and returns the element that comes out first, or NULL.
+//	Amortized O(log n).
+	void
+GrabFirstHeapElement(
+	void			**element,
+	ElementHeap		*heap );
+
+//	Removes element, which must be in heap. Amortized O(log n).
+	void
+RemoveHeapElement(
+	void			*element,
+	ElementHeap		*heap );
+
+/**************************
+*
+*	Heap Reordering
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Heap Reordering)
+
+//	Call after changing element's key so that it comes out sooner.
+//	Amortized o(log n). For a later key, remove and put it again.
+	void
+DecreaseHeapElement(
+	void			*element,
+	ElementHeap		*heap );
+
+/**************************
+*
+*	Offset Heap Functions
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Heap Functions)
+
+	void
+PutHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+	void
+MeldElementHeapsOff(
+	ElementHeap	*heap,
+	ElementHeap	*other,
+	size_t		offset );
+
+	void
+FirstHeapElementOff(
+	void			**element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+	bool
+IsHeapElementQueuedOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+	void
+GrabFirstHeapElementOff(
+	void			**element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+	void
+RemoveHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+	void
+DecreaseHeapElementOff(
+	void			*element,
+	ElementHeap		*heap,
+	size_t			offset );
+
+/**************************
+*
+*	Type Heap Functions
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Heap Functions)
+
+#define	PutHeapElementType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			PutHeapElementOff( (ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+#define	MeldElementHeapsType( HEAP, OTHER, STRUCTURE, FIELD )	\
+			MeldElementHeapsOff( (HEAP), (OTHER), offsetof( STRUCTURE, FIELD ) )
+
+#define	FirstHeapElementType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			FirstHeapElementOff( (void**)(ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+#define	IsHeapElementQueuedType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			IsHeapElementQueuedOff( (ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+#define	GrabFirstHeapElementType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			GrabFirstHeapElementOff( (void**)(ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+#define	RemoveHeapElementType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			RemoveHeapElementOff( (ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+#define	DecreaseHeapElementType( ELEMENT, HEAP, STRUCTURE, FIELD )	\
+			DecreaseHeapElementOff( (ELEMENT), (HEAP), offsetof( STRUCTURE, FIELD ) )
+
+__END_DECLS
+#endif	//	_elementalheap_
@@ -0,0 +1,390 @@
+/****************************************************************************************
+	elementallfu.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A touch that would empty its bucket and finds no bucket for the next
+	frequency just bumps the bucket's frequency in place, so an entry that is
+	alone at its frequency climbs without ever allocating.
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "elementallfu.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+	static
+	ElementFrequency*
+GetElementFrequency(
+	void		*element,
+	ElementLFU	*lfu );
+
+	static
+	ElementFrequency*
+NewElementFrequency(
+	ElementLFU			*lfu,
+	size_t				frequency,
+	ElementFrequency	*after );
+
+	static
+	void
+DeleteElementFrequency(
+	ElementLFU			*lfu,
+	ElementFrequency	*bucket );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementLFU(
+	ElementLFU	*lfu,
+	size_t		offset,
+	size_t		agingInterval )
+{
+	assertPtr( lfu );
+
+	NewElementList( &lfu->frequencies );
+	NewElementList( &lfu->spares );
+	lfu->count = 0;
+	lfu->offset = offset;
+	lfu->agingInterval = agingInterval;
+	lfu->touches = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementLFU(
+	ElementLFU	*lfu )
+{
+	void	*bucket;
+
+	assertPtr( lfu );
+
+	for( GrabFirstElement( &bucket, &lfu->frequencies ); bucket; GrabFirstElement( &bucket, &lfu->frequencies ) )
+		free( bucket );
+	for( GrabFirstElement( &bucket, &lfu->spares ); bucket; GrabFirstElement( &bucket, &lfu->spares ) )
+		free( bucket );
+	lfu->count = 0;
+	DeleteElementList( &lfu->frequencies );
+	DeleteElementList( &lfu->spares );
+}
+
+/****************************************************************************************
+*
+*	LFU Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(LFU Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+PutLFUElement(
+	void		*element,
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket;
+
+	assertPtr( element );
+	assertPtr( lfu );
+
+	FirstElement( (void**) &bucket, &lfu->frequencies );
+	if( bucket == NULL || bucket->frequency != 1 ) {
+		bucket = NewElementFrequency( lfu, 1, NULL );
+		if( bucket == NULL )
+			return( false );
+	}
+	PutFirstElementOff( element, &bucket->entries, lfu->offset );
+	lfu->count++;
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+TouchLFUElement(
+	void		*element,
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket = GetElementFrequency( element, lfu );
+	ElementFrequency	*next;
+
+	NextElement( bucket, (void**) &next );
+	if( next && next->frequency != bucket->frequency + 1 )
+		next = NULL;
+
+	if( next == NULL && bucket->entries.first == bucket->entries.last )
+		bucket->frequency++;
+	else {
+		if( next == NULL ) {
+			next = NewElementFrequency( lfu, bucket->frequency + 1, bucket );
+			if( next == NULL )
+				return( false );
+		}
+		RemoveElementOff( element, &bucket->entries, lfu->offset );
+		PutFirstElementOff( element, &next->entries, lfu->offset );
+		if( IsListEmpty( &bucket->entries ) )
+			DeleteElementFrequency( lfu, bucket );
+	}
+
+	if( lfu->agingInterval && ++lfu->touches >= lfu->agingInterval ) {
+		lfu->touches = 0;
+		AgeElementLFU( lfu );
+	}
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+AgeElementLFU(
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket, *next, *prev;
+
+	assertPtr( lfu );
+
+	for( FirstElement( (void**) &bucket, &lfu->frequencies ); bucket; bucket = next ) {
+		NextElement( bucket, (void**) &next );
+		PrevElement( bucket, (void**) &prev );
+		bucket->frequency = (bucket->frequency + 1) / 2;
+
+		if( prev && prev->frequency == bucket->frequency ) {
+			//	The hotter entries go in front, keeping their order.
+			void	*entry;
+
+			for( GrabLastElementOff( &entry, &bucket->entries, lfu->offset ); entry;
+				 GrabLastElementOff( &entry, &bucket->entries, lfu->offset ) )
+				PutFirstElementOff( entry, &prev->entries, lfu->offset );
+			DeleteElementFrequency( lfu, bucket );
+		}
+	}
+}
+
+/****************************************************************************************
+*
+*	LFU Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(LFU Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+GetLFUElementFrequency(
+	void		*element,
+	ElementLFU	*lfu )
+{
+	return( GetElementFrequency( element, lfu )->frequency );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountLFUElements(
+	ElementLFU	*lfu )
+{
+	assertPtr( lfu );
+
+	return( lfu->count );
+}
+
+/****************************************************************************************
+*
+*	LFU Grabbing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(LFU Grabbing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+EvictLFUElement(
+	void		**element,
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket;
+
+	assertPtr( element );
+	assertPtr( lfu );
+
+	FirstElement( (void**) &bucket, &lfu->frequencies );
+	if( bucket == NULL ) {
+		*element = NULL;
+		return;
+	}
+	GrabLastElementOff( element, &bucket->entries, lfu->offset );
+	if( IsListEmpty( &bucket->entries ) )
+		DeleteElementFrequency( lfu, bucket );
+	lfu->count--;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveLFUElement(
+	void		*element,
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket = GetElementFrequency( element, lfu );
+
+	RemoveElementOff( element, &bucket->entries, lfu->offset );
+	if( IsListEmpty( &bucket->entries ) )
+		DeleteElementFrequency( lfu, bucket );
+	lfu->count--;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	ElementFrequency*
+GetElementFrequency(
+	void		*element,
+	ElementLFU	*lfu )
+{
+	ElementList	*entries;
+
+	assertPtr( element );
+	assertPtr( lfu );
+
+	entries = GetElementListOff( element, lfu->offset );
+	assertPtr( entries );
+
+	return( (ElementFrequency*) ((char*) entries - offsetof( ElementFrequency, entries )) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Zeroes a new bucket, which the putters check.
+
+	************************************************************************************/
+
+	static
+	ElementFrequency*
+NewElementFrequency(
+	ElementLFU			*lfu,
+	size_t				frequency,
+	ElementFrequency	*after )
+{
+	ElementFrequency	*bucket;
+
+	GrabFirstElement( (void**) &bucket, &lfu->spares );
+	if( bucket == NULL ) {
+		bucket = (ElementFrequency*) calloc( 1, sizeof( ElementFrequency ) );
+		if( bucket == NULL )
+			return( NULL );
+	}
+	NewElementList( &bucket->entries );
+	bucket->frequency = frequency;
+	PutAfterElement( bucket, after, &lfu->frequencies );
+
+	return( bucket );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+DeleteElementFrequency(
+	ElementLFU			*lfu,
+	ElementFrequency	*bucket )
+{
+	RemoveElement( bucket, &lfu->frequencies );
+	DeleteElementList( &bucket->entries );
+	PutFirstElement( bucket, &lfu->spares );
+}
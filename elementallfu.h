@@ -0,0 +1,156 @@
+/****************************************************************************************
+	elementallfu.h
+
+	Constant-time least-frequently-used eviction built from ElementLists.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An ElementLFU keeps an ascending ElementList of ElementFrequency buckets,
+	one per frequency in use, each holding an ElementList of the entries with
+	that frequency, most recently touched first. Touching an entry moves it to
+	the adjacent bucket, creating that bucket if need be; eviction grabs the
+	least recently touched entry of the lowest bucket. Both are constant-time,
+	as is finding an entry's frequency: its Element's list is its bucket's.
+
+	Frequencies only grow, so yesterday's hot entries can squat in the cache.
+	AgeElementLFU() halves every frequency, and can be run automatically every
+	agingInterval touches.
+
+	************************************************************************************/
+
+#ifndef		_elementallfu_
+#define		_elementallfu_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementFrequency	ElementFrequency;
+typedef	struct	ElementLFU			ElementLFU;
+
+struct	ElementFrequency	{
+	Element		element;
+	ElementList	entries;
+	size_t		frequency;
+};
+
+struct	ElementLFU	{
+	ElementList	frequencies;	//	Ascending.
+	ElementList	spares;			//	Emptied buckets, kept for reuse.
+	size_t		count;
+	size_t		offset;
+	size_t		agingInterval;	//	Touches between automatic agings, or 0.
+	size_t		touches;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	offset locates the Element within each entry.
+	void
+NewElementLFU(
+	ElementLFU	*lfu,
+	size_t		offset,
+	size_t		agingInterval );
+
+//	Frees the buckets. The entries themselves are untouched.
+	void
+DeleteElementLFU(
+	ElementLFU	*lfu );
+
+/**************************
+*
+*	LFU Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(LFU Putters)
+
+//	Adds element with a frequency of 1. Returns false if a bucket was needed
+//	and could not be allocated, leaving element out.
+	bool
+PutLFUElement(
+	void		*element,
+	ElementLFU	*lfu );
+
+//	Adds one to element's frequency. Returns false if a bucket was needed and
+//	could not be allocated, leaving the frequency unchanged.
+	bool
+TouchLFUElement(
+	void		*element,
+	ElementLFU	*lfu );
+
+//	Halves every frequency, rounding up, merging buckets that collide. Linear
+//	in the number of entries that move.
+	void
+AgeElementLFU(
+	ElementLFU	*lfu );
+
+/**************************
+*
+*	LFU Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(LFU Accessors)
+
+	size_t
+GetLFUElementFrequency(
+	void		*element,
+	ElementLFU	*lfu );
+
+//	Returns the number of entries in lfu.
+	size_t
+CountLFUElements(
+	ElementLFU	*lfu );
+
+/**************************
+*
+*	LFU Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(LFU Grabbing)
+
+//	*element = the least recently touched of the least frequently used
+//	entries, now removed, or NULL if lfu is empty.
+	void
+EvictLFUElement(
+	void		**element,
+	ElementLFU	*lfu );
+
+//	Removes element, which must be in lfu.
+	void
+RemoveLFUElement(
+	void		*element,
+	ElementLFU	*lfu );
+
+/**************************
+*
+*	Type Variants
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Variants)
+
+#define	NewElementLFUType( LFU, STRUCTURE, FIELD, AGINGINTERVAL )	\
+			NewElementLFU( (LFU), offsetof( STRUCTURE, FIELD ), (AGINGINTERVAL) )
+
+#define	EvictLFUElementType( ELEMENT, LFU )	\
+			EvictLFUElement( (void**)(ELEMENT), (LFU) )
+
+__END_DECLS
+#endif	//	_elementallfu_
@@ -0,0 +1,367 @@
+/****************************************************************************************
+	elementalpark.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A parker is removed from its bucket by whoever unparks it, with the bucket
+	locked; only then is its futex word set. UnparkAllAddress() chains the
+	parkers it takes through nextTaken, so that each is in no list once the
+	bucket is unlocked. A parker whose deadline passes
+	locks the bucket too and, finding it has already been taken, waits out
+	the wakeup that is on its way rather than leaving while the unparker
+	still holds a pointer to it.
+
+	The unparker's FutexWake() can land after the woken thread has moved on.
+	At worst that is a spurious wakeup of some later futex at the same
+	address, which every futex waiter must already tolerate.
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "elementalpark.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+//	log2 of the number of buckets addresses hash to.
+#ifndef	elementalParkBucketBits
+	#define	elementalParkBucketBits	8
+#endif
+
+typedef	struct	Parker		Parker;
+typedef	struct	ParkBucket	ParkBucket;
+
+struct	Parker	{
+	Element			element;
+	const void		*address;
+	intptr_t		token;
+	Parker			*nextTaken;	//	UnparkAllAddress()'s, not in any list.
+	unsigned		woken;		//	Futex word.
+};
+
+struct	ParkBucket	{
+	ElementList		parkers;
+	int				lock;
+} __attribute__(( aligned( elementalCacheLine ) ));
+
+static	ParkBucket		gParkBuckets[ 1 << elementalParkBucketBits ];
+static	__thread Parker	gParker;
+
+	static
+	ParkBucket*
+GetParkBucket(
+	const void	*address );
+
+	static
+	void
+LockParkBucket(
+	ParkBucket	*bucket );
+
+	static
+	void
+UnlockParkBucket(
+	ParkBucket	*bucket );
+
+	static
+	void
+WakeParker(
+	Parker	*parker );
+
+	static
+	int
+FutexWait(
+	unsigned				*word,
+	unsigned				expected,
+	const struct timespec	*deadline );
+
+	static
+	void
+FutexWake(
+	unsigned	*word,
+	int			count );
+
+/****************************************************************************************
+*
+*	Parking
+*
+****************************************************************************************/
+#pragma mark	(Parking)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+ParkAddress(
+	const void				*address,
+	ParkValidateProc		validateProc,
+	void					*refCon,
+	const struct timespec	*deadline,
+	intptr_t				*token )
+{
+	Parker		*parker = &gParker;
+	ParkBucket	*bucket = GetParkBucket( address );
+	bool		unparked;
+
+	assertTrue( GetElementList( parker ) == NULL );
+
+	LockParkBucket( bucket );
+	if( validateProc && !validateProc( address, refCon ) ) {
+		UnlockParkBucket( bucket );
+		errno = EAGAIN;
+		return( false );
+	}
+	parker->address = address;
+	parker->token = 0;
+	__atomic_store_n( &parker->woken, 0, __ATOMIC_RELAXED );
+	PutLastElement( parker, &bucket->parkers );
+	UnlockParkBucket( bucket );
+
+	while( !(unparked = __atomic_load_n( &parker->woken, __ATOMIC_ACQUIRE )) ) {
+		if( FutexWait( &parker->woken, 0, deadline ) != 0 && errno == ETIMEDOUT )
+			break;
+	}
+
+	if( !unparked ) {
+		LockParkBucket( bucket );
+		unparked = GetElementList( parker ) == NULL;
+		if( !unparked )
+			RemoveElement( parker, &bucket->parkers );
+		UnlockParkBucket( bucket );
+
+		//	Taken just as the deadline passed: the wakeup is on its way.
+		if( unparked ) {
+			while( !__atomic_load_n( &parker->woken, __ATOMIC_ACQUIRE ) )
+				FutexWait( &parker->woken, 0, NULL );
+		}
+	}
+
+	if( !unparked ) {
+		errno = ETIMEDOUT;
+		return( false );
+	}
+	if( token )
+		*token = parker->token;
+	return( true );
+}
+
+/****************************************************************************************
+*
+*	Unparking
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Unparking)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+UnparkOneAddress(
+	const void	*address,
+	UnparkProc	unparkProc,
+	void		*refCon )
+{
+	ParkBucket	*bucket = GetParkBucket( address );
+	Parker		*parker, *next = NULL;
+	intptr_t	token = 0;
+
+	LockParkBucket( bucket );
+
+	FirstElement( (void**) &parker, &bucket->parkers );
+	while( parker && parker->address != address )
+		NextElement( parker, (void**) &parker );
+	if( parker ) {
+		NextElement( parker, (void**) &next );
+		while( next && next->address != address )
+			NextElement( next, (void**) &next );
+		RemoveElement( parker, &bucket->parkers );
+	}
+
+	if( unparkProc )
+		token = unparkProc( address, parker != NULL, next != NULL, refCon );
+	if( parker )
+		parker->token = token;
+
+	UnlockParkBucket( bucket );
+
+	if( parker )
+		WakeParker( parker );
+	return( parker != NULL );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Chains the taken parkers through nextTaken, in no list, so
+								that one timing out can't unlink itself from under us.
+
+	************************************************************************************/
+
+	size_t
+UnparkAllAddress(
+	const void	*address )
+{
+	ParkBucket	*bucket = GetParkBucket( address );
+	Parker		*taken = NULL;
+	Parker		**tail = &taken;
+	Parker		*parker, *next;
+	size_t		count = 0;
+
+	LockParkBucket( bucket );
+	for( FirstElement( (void**) &parker, &bucket->parkers ); parker; parker = next ) {
+		NextElement( parker, (void**) &next );
+		if( parker->address == address ) {
+			RemoveElement( parker, &bucket->parkers );
+			parker->token = 0;
+			parker->nextTaken = NULL;
+			*tail = parker;
+			tail = &parker->nextTaken;
+		}
+	}
+	UnlockParkBucket( bucket );
+
+	//	Read each link before waking its parker, which may then park again.
+	for( parker = taken; parker; parker = next ) {
+		next = parker->nextTaken;
+		WakeParker( parker );
+		count++;
+	}
+
+	return( count );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	ParkBucket*
+GetParkBucket(
+	const void	*address )
+{
+	uint64_t	hash = (uint64_t) (uintptr_t) address * 0x9E3779B97F4A7C15ull;
+
+	return( &gParkBuckets[ hash >> (64 - elementalParkBucketBits) ] );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LockParkBucket(
+	ParkBucket	*bucket )
+{
+	while( __atomic_exchange_n( &bucket->lock, 1, __ATOMIC_ACQUIRE ) ) {
+		while( __atomic_load_n( &bucket->lock, __ATOMIC_RELAXED ) )
+			;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnlockParkBucket(
+	ParkBucket	*bucket )
+{
+	__atomic_store_n( &bucket->lock, 0, __ATOMIC_RELEASE );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+WakeParker(
+	Parker	*parker )
+{
+	__atomic_store_n( &parker->woken, 1, __ATOMIC_RELEASE );
+	FutexWake( &parker->woken, 1 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	int
+FutexWait(
+	unsigned				*word,
+	unsigned				expected,
+	const struct timespec	*deadline )
+{
+	//	FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC deadline.
+	return( (int) syscall( SYS_futex, word, FUTEX_WAIT_BITSET_PRIVATE, expected, deadline,
+			NULL, FUTEX_BITSET_MATCH_ANY ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+FutexWake(
+	unsigned	*word,
+	int			count )
+{
+	syscall( SYS_futex, word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0 );
+}
@@ -0,0 +1,103 @@
+/****************************************************************************************
+	elementalpark.h
+
+	A global parking lot: FIFO wait queues keyed by address. Linux only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Locks and conditions built on the parking lot need carry no wait-queue
+	state of their own, often just a word with a "someone is parked" bit.
+	A parking thread puts its thread-local Element last on the ElementList of
+	the bucket its address hashes to, guarded by that bucket's spinlock, and
+	sleeps on a futex word of its own. Unparking takes threads parked on an
+	address in the order they arrived, and wakes just the ones it takes.
+
+	Both sides run a callback with the bucket locked, which is what makes
+	them atomic with respect to each other. ParkAddress()'s validateProc
+	re-checks that the thread should still sleep; UnparkOneAddress()'s
+	unparkProc learns whether a thread was taken and whether any are left,
+	and returns a token the woken thread receives. A fair lock passes
+	ownership in the token rather than releasing the lock for all comers:
+
+		unlock:	if the word is just "locked", clear it and return. Otherwise
+				UnparkOneAddress( word ), whose unparkProc, given a thread,
+				leaves the word locked, clears the parked bit if none are
+				left, and returns 1; given none, clears the word.
+		lock:	on contention set the parked bit and ParkAddress( word ),
+				whose validateProc checks the word is still locked with the
+				bit set. A token of 1 means the lock is already ours.
+
+	Callbacks must not park or unpark. Deadlines are absolute CLOCK_MONOTONIC,
+	or NULL to wait indefinitely.
+
+	************************************************************************************/
+
+#ifndef		_elementalpark_
+#define		_elementalpark_
+
+#include <time.h>
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+//	Return whether the thread should go ahead and park.
+typedef	bool		(*ParkValidateProc)( const void *address, void *refCon );
+
+//	Return the token for the thread taken, if unparked.
+typedef	intptr_t	(*UnparkProc)( const void *address, bool unparked, bool moreParked, void *refCon );
+
+/**************************
+*
+*	Parking
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Parking)
+
+//	Parks the calling thread on address until unparked or deadline passes.
+//	validateProc, if not NULL, is called first with address's bucket locked.
+//	Returns true, and the unparker's token in *token if token is not NULL,
+//	once unparked. Returns false with errno = EAGAIN if validateProc said
+//	no, or ETIMEDOUT.
+	bool
+ParkAddress(
+	const void				*address,
+	ParkValidateProc		validateProc,
+	void					*refCon,
+	const struct timespec	*deadline,
+	intptr_t				*token );
+
+/**************************
+*
+*	Unparking
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Unparking)
+
+//	Unparks the thread that has been parked on address longest. unparkProc,
+//	if not NULL, is called with address's bucket locked even if no thread
+//	was parked. Returns whether a thread was unparked.
+	bool
+UnparkOneAddress(
+	const void	*address,
+	UnparkProc	unparkProc,
+	void		*refCon );
+
+//	Unparks every thread parked on address, each with a token of 0. Returns
+//	how many.
+	size_t
+UnparkAllAddress(
+	const void	*address );
+
+__END_DECLS
+#endif	//	_elementalpark_
@@ -0,0 +1,1017 @@
+/****************************************************************************************
+	elementalpersistent.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A change is built as one log record of (offset, length, bytes) entries at
+	the tail of the in-memory log buffer, applying each entry to the mapping as
+	it goes. Room for the whole record is reserved up front, so a change either
+	fails before touching anything or completes.
+
+	Entries hold new values only. That suffices because the file never runs
+	ahead of the durable log: the mapping is private, and a checkpoint syncs
+	the log before writing pages back. Replaying the log over a file holding
+	any mix of checkpointed and newer bytes therefore lands on the state as of
+	the last synced record, which also makes a torn checkpoint harmless. A
+	record whose checksum fails ends replay, so a torn log tail is dropped.
+
+	A new file is built and synced under "<path>.new" and then renamed into
+	place, so a crash while creating leaves either no list or an empty one,
+	never a sized file without its header. The directory is synced once the
+	file and its log both exist, so neither name can be lost with records
+	already written under it.
+
+	************************************************************************************/
+
+#ifndef	_POSIX_C_SOURCE
+	#define	_POSIX_C_SOURCE	200809L	//	pread(), fdatasync(), O_DIRECTORY
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "elementalpersistent.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+#define	elementalPersistentMagic	0x5352455034454C45ULL	//	"ELE4PERS"
+
+typedef	struct	PersistentLinks		PersistentLinks;
+typedef	struct	PersistentRecord	PersistentRecord;
+typedef	struct	PersistentEntry		PersistentEntry;
+
+//	The start of every slot; the payload follows.
+struct	PersistentLinks	{
+	PersistentOffset	next;
+	PersistentOffset	prev;
+};
+
+struct	PersistentRecord	{
+	uint32_t	length;		//	Of the entries that follow.
+	uint32_t	checksum;	//	Of the entries.
+};
+
+//	Followed by length bytes, padded to eight.
+struct	PersistentEntry	{
+	uint64_t	offset;
+	uint64_t	length;
+};
+
+#define	PaddedLength( LENGTH )	(((LENGTH) + 7) & ~(size_t) 7)
+#define	SlotLinks( LIST, SLOT )	((PersistentLinks*) ((LIST)->base + (SLOT)))
+#define	HeaderField( FIELD )	offsetof( PersistentListHeader, FIELD )
+
+	static
+	int
+CreatePersistentFile(
+	const char	*path,
+	size_t		elementSize,
+	size_t		capacity );
+
+	static
+	bool
+SyncPersistentDirectory(
+	const char	*path );
+
+	static
+	bool
+WritePersistentLog(
+	PersistentElementList	*list );
+
+	static
+	bool
+ReplayPersistentLog(
+	PersistentElementList	*list );
+
+	static
+	bool
+BeginPersistentChange(
+	PersistentElementList	*list );
+
+	static
+	void
+LogPersistentWrite(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	const void				*data,
+	size_t					length );
+
+	static
+	void
+LogPersistentLink(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	PersistentOffset		value );
+
+	static
+	void
+CommitPersistentChange(
+	PersistentElementList	*list );
+
+	static
+	void
+MarkPersistentDirty(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	size_t					length );
+
+	static
+	uint32_t
+PersistentChecksum(
+	const uint8_t	*bytes,
+	size_t			length );
+
+	static
+	void
+PutPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list,
+	bool					first );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Creates atomically, and syncs the directory after creating.
+
+	************************************************************************************/
+
+	bool
+OpenPersistentElementList(
+	PersistentElementList	*list,
+	const char				*path,
+	size_t					elementSize,
+	size_t					capacity,
+	size_t					syncBatch )
+{
+	PersistentListHeader	header;
+	char					*logPath;
+	bool					created = false;
+	int						error;
+
+	assertPtr( list );
+	assertPtr( path );
+
+	memset( list, 0, sizeof( *list ) );
+	list->fd = list->logFD = -1;
+	list->syncBatch = syncBatch;
+	list->pageSize = (size_t) sysconf( _SC_PAGESIZE );
+	list->slotSize = PaddedLength( sizeof( PersistentLinks ) + elementSize );
+
+	list->fd = open( path, O_RDWR );
+	if( list->fd < 0 && errno == ENOENT ) {
+		list->fd = CreatePersistentFile( path, elementSize, capacity );
+		created = true;
+	}
+	if( list->fd < 0 )
+		goto failed;
+
+	if( pread( list->fd, &header, sizeof( header ), 0 ) != (ssize_t) sizeof( header ) )
+		goto failed;
+	if( header.magic != elementalPersistentMagic || header.elementSize != elementSize ) {
+		errno = EINVAL;
+		goto failed;
+	}
+
+	list->mapSize = elementalPersistentHeaderSize + header.capacity * list->slotSize;
+	list->base = (uint8_t*) mmap( NULL, list->mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, list->fd, 0 );
+	if( list->base == MAP_FAILED ) {
+		list->base = NULL;
+		goto failed;
+	}
+	list->header = (PersistentListHeader*) list->base;
+
+	list->dirty = (uint8_t*) calloc( (list->mapSize / list->pageSize + 8) / 8, 1 );
+	logPath = (char*) malloc( strlen( path ) + sizeof( ".log" ) );
+	if( list->dirty == NULL || logPath == NULL ) {
+		free( logPath );
+		errno = ENOMEM;
+		goto failed;
+	}
+	strcat( strcpy( logPath, path ), ".log" );
+	list->logFD = open( logPath, O_RDWR | O_APPEND );
+	if( list->logFD < 0 && errno == ENOENT ) {
+		list->logFD = open( logPath, O_RDWR | O_CREAT | O_APPEND, 0644 );
+		created = true;
+	}
+	free( logPath );
+	if( list->logFD < 0 )
+		goto failed;
+	if( created && !SyncPersistentDirectory( path ) )
+		goto failed;
+
+	if( !ReplayPersistentLog( list ) )
+		goto failed;
+
+	return( true );
+
+failed:
+	error = errno;
+	if( list->base )
+		munmap( list->base, list->mapSize );
+	if( list->fd >= 0 )
+		close( list->fd );
+	if( list->logFD >= 0 )
+		close( list->logFD );
+	free( list->dirty );
+	free( list->log );
+	errno = error;
+	return( false );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+ClosePersistentElementList(
+	PersistentElementList	*list )
+{
+	bool	checkpointed;
+	int		error;
+
+	assertPtr( list );
+
+	checkpointed = CheckpointPersistentElementList( list );
+	error = errno;
+
+	munmap( list->base, list->mapSize );
+	close( list->fd );
+	close( list->logFD );
+	free( list->dirty );
+	free( list->log );
+	list->base = list->dirty = list->log = NULL;
+	list->header = NULL;
+
+	errno = error;
+	return( checkpointed );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Checkpoints past elementalPersistentLogLimit, whatever syncBatch is.
+
+	************************************************************************************/
+
+	bool
+SyncPersistentElementList(
+	PersistentElementList	*list )
+{
+	assertPtr( list );
+
+	if( !WritePersistentLog( list ) )
+		return( false );
+
+	//	The operations are durable now. A checkpoint that fails leaves them in
+	//	the log, and the next sync tries again.
+	if( list->logBytes > elementalPersistentLogLimit )
+		CheckpointPersistentElementList( list );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Writes the log without checkpointing.
+
+	************************************************************************************/
+
+	bool
+CheckpointPersistentElementList(
+	PersistentElementList	*list )
+{
+	size_t	pageCount = list->mapSize / list->pageSize + 1;
+	size_t	page, run;
+
+	assertPtr( list );
+
+	if( !WritePersistentLog( list ) )
+		return( false );
+
+	for( page = 0; page < pageCount; page += run ) {
+		uint64_t	offset;
+		size_t		length;
+
+		for( run = 0; page + run < pageCount && (list->dirty[ (page + run) / 8 ] & (1 << ((page + run) % 8))); run++ )
+			;
+		if( run == 0 ) {
+			run = 1;
+			continue;
+		}
+
+		offset = (uint64_t) page * list->pageSize;
+		length = run * list->pageSize;
+		if( offset + length > list->mapSize )
+			length = list->mapSize - (size_t) offset;
+		while( length ) {
+			ssize_t	result = pwrite( list->fd, list->base + offset, length, (off_t) offset );
+
+			if( result < 0 ) {
+				if( errno == EINTR )
+					continue;
+				return( false );
+			}
+			offset += (uint64_t) result;
+			length -= (size_t) result;
+		}
+	}
+	if( fdatasync( list->fd ) != 0 )
+		return( false );
+
+	//	The file now holds everything the log did.
+	if( ftruncate( list->logFD, 0 ) != 0 || fdatasync( list->logFD ) != 0 )
+		return( false );
+	list->logBytes = 0;
+	memset( list->dirty, 0, (pageCount + 7) / 8 );
+
+	return( true );
+}
+
+/****************************************************************************************
+*
+*	Persistent Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Persistent Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutFirstPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list )
+{
+	PutPersistentElement( element, data, list, true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutLastPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list )
+{
+	PutPersistentElement( element, data, list, false );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+UpdatePersistentElement(
+	PersistentOffset		element,
+	const void				*data,
+	PersistentElementList	*list )
+{
+	assertTrue( element );
+	assertPtr( data );
+	assertPtr( list );
+
+	if( !BeginPersistentChange( list ) )
+		return( false );
+	LogPersistentWrite( list, element + sizeof( PersistentLinks ), data, list->header->elementSize );
+	CommitPersistentChange( list );
+
+	return( true );
+}
+
+/****************************************************************************************
+*
+*	Persistent Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Persistent Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstPersistentElement(
+	PersistentOffset		*element,
+	PersistentElementList	*list )
+{
+	assertPtr( element );
+	assertPtr( list );
+
+	*element = list->header->first;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+LastPersistentElement(
+	PersistentOffset		*element,
+	PersistentElementList	*list )
+{
+	assertPtr( element );
+	assertPtr( list );
+
+	*element = list->header->last;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextPersistentElement(
+	PersistentOffset		element,
+	PersistentOffset		*nextElement,
+	PersistentElementList	*list )
+{
+	assertTrue( element );
+	assertPtr( nextElement );
+	assertPtr( list );
+
+	*nextElement = SlotLinks( list, element )->next;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PrevPersistentElement(
+	PersistentOffset		element,
+	PersistentOffset		*prevElement,
+	PersistentElementList	*list )
+{
+	assertTrue( element );
+	assertPtr( prevElement );
+	assertPtr( list );
+
+	*prevElement = SlotLinks( list, element )->prev;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	const void*
+GetPersistentElementData(
+	PersistentOffset		element,
+	PersistentElementList	*list )
+{
+	assertTrue( element );
+	assertPtr( list );
+
+	return( list->base + element + sizeof( PersistentLinks ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountPersistentElements(
+	PersistentElementList	*list )
+{
+	assertPtr( list );
+
+	return( (size_t) list->header->count );
+}
+
+/****************************************************************************************
+*
+*	Persistent Grabbing
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Persistent Grabbing)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+RemovePersistentElement(
+	PersistentOffset		element,
+	PersistentElementList	*list )
+{
+	PersistentLinks	links;
+
+	assertTrue( element );
+	assertPtr( list );
+
+	if( !BeginPersistentChange( list ) )
+		return( false );
+
+	links = *SlotLinks( list, element );
+	LogPersistentLink( list, links.prev ? links.prev + offsetof( PersistentLinks, next ) : HeaderField( first ), links.next );
+	LogPersistentLink( list, links.next ? links.next + offsetof( PersistentLinks, prev ) : HeaderField( last ), links.prev );
+	LogPersistentLink( list, HeaderField( count ), list->header->count - 1 );
+
+	LogPersistentLink( list, element + offsetof( PersistentLinks, next ), list->header->free );
+	LogPersistentLink( list, HeaderField( free ), element );
+
+	CommitPersistentChange( list );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+GrabFirstPersistentElement(
+	void					*data,
+	PersistentElementList	*list )
+{
+	PersistentOffset	first;
+
+	assertPtr( data );
+	assertPtr( list );
+
+	first = list->header->first;
+	if( first == 0 )
+		return( false );
+	memcpy( data, GetPersistentElementData( first, list ), list->header->elementSize );
+
+	return( RemovePersistentElement( first, list ) );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+PutPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list,
+	bool					first )
+{
+	PersistentListHeader	*header = list->header;
+	PersistentLinks			links;
+	PersistentOffset		slot;
+
+	assertPtr( element );
+	assertPtr( data );
+	assertPtr( list );
+
+	*element = 0;
+	if( header->free )
+		slot = header->free;
+	else if( header->fresh < list->mapSize )
+		slot = header->fresh;
+	else
+		return;
+	if( !BeginPersistentChange( list ) )
+		return;
+
+	if( slot == header->free )
+		LogPersistentLink( list, HeaderField( free ), SlotLinks( list, slot )->next );
+	else
+		LogPersistentLink( list, HeaderField( fresh ), header->fresh + list->slotSize );
+
+	links.next = first ? header->first : 0;
+	links.prev = first ? 0 : header->last;
+	LogPersistentWrite( list, slot, &links, sizeof( links ) );
+	LogPersistentWrite( list, slot + sizeof( links ), data, header->elementSize );
+
+	if( first ) {
+		LogPersistentLink( list, links.next ? links.next + offsetof( PersistentLinks, prev ) : HeaderField( last ), slot );
+		LogPersistentLink( list, HeaderField( first ), slot );
+	} else {
+		LogPersistentLink( list, links.prev ? links.prev + offsetof( PersistentLinks, next ) : HeaderField( first ), slot );
+		LogPersistentLink( list, HeaderField( last ), slot );
+	}
+	LogPersistentLink( list, HeaderField( count ), header->count + 1 );
+
+	CommitPersistentChange( list );
+	*element = slot;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+	agent		Mon, Oct 19, 2026	Built under a temporary name and renamed into place.
+
+	************************************************************************************/
+
+	static
+	int
+CreatePersistentFile(
+	const char	*path,
+	size_t		elementSize,
+	size_t		capacity )
+{
+	PersistentListHeader	header;
+	char					*temporary;
+	int						fd;
+	int						error;
+
+	temporary = (char*) malloc( strlen( path ) + sizeof( ".new" ) );
+	if( temporary == NULL ) {
+		errno = ENOMEM;
+		return( -1 );
+	}
+	strcat( strcpy( temporary, path ), ".new" );
+
+	memset( &header, 0, sizeof( header ) );
+	header.magic = elementalPersistentMagic;
+	header.elementSize = elementSize;
+	header.capacity = capacity;
+	header.fresh = elementalPersistentHeaderSize;
+
+	//	Only a whole, synced file ever appears under path.
+	fd = open( temporary, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	if( fd >= 0
+			&& ftruncate( fd, (off_t) (elementalPersistentHeaderSize
+				+ capacity * PaddedLength( sizeof( PersistentLinks ) + elementSize )) ) == 0
+			&& pwrite( fd, &header, sizeof( header ), 0 ) == (ssize_t) sizeof( header )
+			&& fdatasync( fd ) == 0
+			&& rename( temporary, path ) == 0 ) {
+		free( temporary );
+		return( fd );
+	}
+
+	error = errno;
+	if( fd >= 0 ) {
+		close( fd );
+		unlink( temporary );
+	}
+	free( temporary );
+	errno = error;
+	return( -1 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+SyncPersistentDirectory(
+	const char	*path )
+{
+	const char	*slash = strrchr( path, '/' );
+	char		*directory;
+	int			fd;
+	bool		synced;
+	int			error;
+
+	if( slash == NULL )
+		directory = strdup( "." );
+	else
+		directory = strndup( path, slash == path ? 1 : (size_t) (slash - path) );
+	if( directory == NULL ) {
+		errno = ENOMEM;
+		return( false );
+	}
+
+	fd = open( directory, O_RDONLY | O_DIRECTORY );
+	free( directory );
+	if( fd < 0 )
+		return( false );
+	synced = fsync( fd ) == 0;
+	error = errno;
+	close( fd );
+	errno = error;
+
+	return( synced );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+WritePersistentLog(
+	PersistentElementList	*list )
+{
+	size_t	written = 0;
+
+	while( written < list->logLength ) {
+		ssize_t	result = write( list->logFD, list->log + written, list->logLength - written );
+
+		if( result < 0 && errno == EINTR )
+			continue;
+		if( result < 0 )
+			break;
+		written += (size_t) result;
+	}
+	if( written < list->logLength || (list->logLength && fdatasync( list->logFD ) != 0) ) {
+		int	error = errno;
+		int	truncated;
+
+		//	Drop any partial record so later ones stay reachable. Failing that,
+		//	replay still stops at the torn record.
+		truncated = ftruncate( list->logFD, (off_t) list->logBytes );
+		(void) truncated;
+		errno = error;
+		return( false );
+	}
+
+	list->logBytes += list->logLength;
+	list->logLength = 0;
+	list->unsynced = 0;
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+ReplayPersistentLog(
+	PersistentElementList	*list )
+{
+	struct stat	status;
+	uint8_t		*log;
+	size_t		position = 0;
+
+	if( fstat( list->logFD, &status ) != 0 )
+		return( false );
+	if( status.st_size == 0 )
+		return( true );
+
+	log = (uint8_t*) malloc( (size_t) status.st_size );
+	if( log == NULL ) {
+		errno = ENOMEM;
+		return( false );
+	}
+	if( pread( list->logFD, log, (size_t) status.st_size, 0 ) != (ssize_t) status.st_size ) {
+		free( log );
+		return( false );
+	}
+
+	while( position + sizeof( PersistentRecord ) <= (size_t) status.st_size ) {
+		PersistentRecord	*record = (PersistentRecord*) (log + position);
+		size_t				entry, end;
+
+		end = position + sizeof( PersistentRecord ) + record->length;
+		if( end > (size_t) status.st_size
+				|| PersistentChecksum( (uint8_t*) (record + 1), record->length ) != record->checksum )
+			break;
+
+		for( entry = position + sizeof( PersistentRecord ); entry < end; ) {
+			PersistentEntry	*header = (PersistentEntry*) (log + entry);
+
+			if( header->offset + header->length > list->mapSize )
+				break;
+			memcpy( list->base + header->offset, header + 1, (size_t) header->length );
+			MarkPersistentDirty( list, header->offset, (size_t) header->length );
+			entry += sizeof( PersistentEntry ) + PaddedLength( (size_t) header->length );
+		}
+		position = end;
+	}
+	free( log );
+
+	//	Fold the log, and any torn tail, into the file.
+	return( CheckpointPersistentElementList( list ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+BeginPersistentChange(
+	PersistentElementList	*list )
+{
+	//	Enough for the biggest change: a put's seven entries, one with a payload.
+	size_t	needed = list->logLength + sizeof( PersistentRecord )
+					+ 7 * sizeof( PersistentEntry ) + 6 * sizeof( uint64_t ) + list->slotSize;
+
+	if( needed > list->logCapacity ) {
+		size_t	capacity = list->logCapacity ? list->logCapacity : 4096;
+		uint8_t	*log;
+
+		while( capacity < needed )
+			capacity *= 2;
+		log = (uint8_t*) realloc( list->log, capacity );
+		if( log == NULL )
+			return( false );
+		list->log = log;
+		list->logCapacity = capacity;
+	}
+	list->changeLength = sizeof( PersistentRecord );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LogPersistentWrite(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	const void				*data,
+	size_t					length )
+{
+	uint8_t			*tail = list->log + list->logLength + list->changeLength;
+	PersistentEntry	entry;
+
+	assertTrue( offset + length <= list->mapSize );
+
+	entry.offset = offset;
+	entry.length = length;
+	memcpy( tail, &entry, sizeof( entry ) );
+	memcpy( tail + sizeof( entry ), data, length );
+	memset( tail + sizeof( entry ) + length, 0, PaddedLength( length ) - length );
+	list->changeLength += sizeof( entry ) + PaddedLength( length );
+
+	memcpy( list->base + offset, data, length );
+	MarkPersistentDirty( list, offset, length );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LogPersistentLink(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	PersistentOffset		value )
+{
+	LogPersistentWrite( list, offset, &value, sizeof( value ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+CommitPersistentChange(
+	PersistentElementList	*list )
+{
+	PersistentRecord	*record = (PersistentRecord*) (list->log + list->logLength);
+
+	record->length = (uint32_t) (list->changeLength - sizeof( PersistentRecord ));
+	record->checksum = PersistentChecksum( (uint8_t*) (record + 1), record->length );
+	list->logLength += list->changeLength;
+	list->changeLength = 0;
+
+	//	A failed sync leaves the records buffered for the next one to retry.
+	if( list->syncBatch && ++list->unsynced >= list->syncBatch )
+		SyncPersistentElementList( list );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+MarkPersistentDirty(
+	PersistentElementList	*list,
+	uint64_t				offset,
+	size_t					length )
+{
+	size_t	page = (size_t) (offset / list->pageSize);
+	size_t	last = (size_t) ((offset + length - 1) / list->pageSize);
+
+	for( ; page <= last; page++ )
+		list->dirty[ page / 8 ] |= (uint8_t) (1 << (page % 8));
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	uint32_t
+PersistentChecksum(
+	const uint8_t	*bytes,
+	size_t			length )
+{
+	uint32_t	hash = 2166136261u;	//	FNV-1a.
+
+	while( length-- )
+		hash = (hash ^ *bytes++) * 16777619u;
+	return( hash );
+}
@@ -0,0 +1,227 @@
+/****************************************************************************************
+	elementalpersistent.h
+
+	Crash-consistent ElementLists that live in a memory-mapped file. POSIX only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A PersistentElementList keeps fixed-size elements in slots of a file,
+	linked by file offsets rather than pointers, so the file means the same
+	thing wherever it is mapped. Elements carry their payload by value: puts
+	copy it in, and UpdatePersistentElement() changes it.
+
+	Every put, update and remove appends one redo record to "<path>.log"
+	describing exactly the bytes it changed. Records are buffered in memory
+	and made durable together by SyncPersistentElementList(), which is called
+	automatically every syncBatch operations; operations since the last sync
+	are lost by a crash, but nothing else is. Opening a list maps the file and
+	replays whatever complete records the log holds.
+
+	The mapping is private, so the file itself changes only at a checkpoint,
+	which copies out the dirtied pages and then empties the log. Checkpoints
+	happen on close, after recovery, and whenever a sync leaves the log
+	larger than elementalPersistentLogLimit.
+
+	************************************************************************************/
+
+#ifndef		_elementalpersistent_
+#define		_elementalpersistent_
+
+#include <stdint.h>
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+//	Log bytes beyond which a sync also checkpoints.
+#ifndef	elementalPersistentLogLimit
+	#define	elementalPersistentLogLimit	(64 * 1024 * 1024)
+#endif
+
+//	Slots start after this much header, whatever the page size.
+#define	elementalPersistentHeaderSize	4096
+
+//	An element's position in the file. Zero means none.
+typedef	uint64_t	PersistentOffset;
+
+typedef	struct	PersistentListHeader	PersistentListHeader;
+typedef	struct	PersistentElementList	PersistentElementList;
+
+//	The file's first elementalPersistentHeaderSize bytes.
+struct	PersistentListHeader	{
+	uint64_t			magic;
+	uint64_t			elementSize;
+	uint64_t			capacity;
+	PersistentOffset	first;
+	PersistentOffset	last;
+	uint64_t			count;
+	PersistentOffset	free;		//	Chain of removed slots.
+	PersistentOffset	fresh;		//	First slot never used.
+};
+
+struct	PersistentElementList	{
+	int						fd;
+	int						logFD;
+	uint8_t					*base;
+	size_t					mapSize;
+	PersistentListHeader	*header;
+	size_t					slotSize;
+
+	uint8_t					*dirty;			//	One bit per page changed since the checkpoint.
+	size_t					pageSize;
+
+	uint8_t					*log;			//	Records not yet written to logFD.
+	size_t					logLength;
+	size_t					logCapacity;
+	size_t					changeLength;	//	Of the record being built after them.
+	uint64_t				logBytes;		//	Durable size of logFD.
+	size_t					unsynced;
+	size_t					syncBatch;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	Opens the list stored at path, creating it with room for capacity elements
+//	of elementSize bytes if it doesn't exist, and recovers it from its log.
+//	Creating uses "<path>.new" as scratch.
+//	syncBatch is how many operations to buffer between syncs; 0 syncs only
+//	when asked. Returns false, with errno set, on failure.
+	bool
+OpenPersistentElementList(
+	PersistentElementList	*list,
+	const char				*path,
+	size_t					elementSize,
+	size_t					capacity,
+	size_t					syncBatch );
+
+//	Checkpoints and closes. Returns false, with errno set, if the checkpoint
+//	failed; the list is closed regardless and will recover on reopening.
+	bool
+ClosePersistentElementList(
+	PersistentElementList	*list );
+
+//	Makes every operation so far durable, and checkpoints if the log has
+//	outgrown elementalPersistentLogLimit.
+	bool
+SyncPersistentElementList(
+	PersistentElementList	*list );
+
+//	Syncs, writes the changed pages back to the file and empties the log.
+	bool
+CheckpointPersistentElementList(
+	PersistentElementList	*list );
+
+/**************************
+*
+*	Persistent Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Persistent Putters)
+
+//	If list == a, b, c
+//	Then list = x, a, b, c, where x holds a copy of data
+//	*element = x, or 0 if the list is full or memory ran out.
+	void
+PutFirstPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list );
+
+//	If list == a, b, c
+//	Then list = a, b, c, x, where x holds a copy of data
+//	*element = x, or 0 if the list is full or memory ran out.
+	void
+PutLastPersistentElement(
+	PersistentOffset		*element,
+	const void				*data,
+	PersistentElementList	*list );
+
+//	Replaces element's payload with a copy of data. Returns false if memory ran out.
+	bool
+UpdatePersistentElement(
+	PersistentOffset		element,
+	const void				*data,
+	PersistentElementList	*list );
+
+/**************************
+*
+*	Persistent Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Persistent Accessors)
+
+	void
+FirstPersistentElement(
+	PersistentOffset		*element,
+	PersistentElementList	*list );
+
+	void
+LastPersistentElement(
+	PersistentOffset		*element,
+	PersistentElementList	*list );
+
+	void
+NextPersistentElement(
+	PersistentOffset		element,
+	PersistentOffset		*nextElement,
+	PersistentElementList	*list );
+
+	void
+PrevPersistentElement(
+	PersistentOffset		element,
+	PersistentOffset		*prevElement,
+	PersistentElementList	*list );
+
+//	Returns element's payload, valid until element is removed. Read-only:
+//	change it with UpdatePersistentElement().
+	const void*
+GetPersistentElementData(
+	PersistentOffset		element,
+	PersistentElementList	*list );
+
+	size_t
+CountPersistentElements(
+	PersistentElementList	*list );
+
+/**************************
+*
+*	Persistent Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Persistent Grabbing)
+
+//	If list == a, b, c && element == b
+//	Then list = a, c, and b's slot is free for reuse
+//	Returns false if memory ran out, leaving the list unchanged.
+	bool
+RemovePersistentElement(
+	PersistentOffset		element,
+	PersistentElementList	*list );
+
+//	If list == a, b, c
+//	Then list = b, c, with a's payload copied to data
+//	Returns false if list was empty or memory ran out.
+	bool
+GrabFirstPersistentElement(
+	void					*data,
+	PersistentElementList	*list );
+
+__END_DECLS
+#endif	//	_elementalpersistent_
@@ -0,0 +1,532 @@
+/****************************************************************************************
+	elementalrcu.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Classic three-bucket epoch-based reclamation. An element retired during
+	epoch e can only be held by readers that entered at epoch e or earlier, and
+	the epoch only advances from e to e + 1 once every active reader has
+	observed e. So when the epoch becomes n, everything retired at n - 2 is
+	unreachable and lives in limbo[ (n + 1) % 3 ].
+
+	************************************************************************************/
+
+#include <assert.h>
+#include <sched.h>
+
+#include "elementalrcu.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+#define	loadAcquire( PTR )				__atomic_load_n( (PTR), __ATOMIC_ACQUIRE )
+#define	storeRelease( PTR, VALUE )		__atomic_store_n( (PTR), (VALUE), __ATOMIC_RELEASE )
+#define	storeRelaxed( PTR, VALUE )		__atomic_store_n( (PTR), (VALUE), __ATOMIC_RELAXED )
+
+	static
+	void
+ReclaimLimbo(
+	ElementEpoch	*epoch,
+	unsigned		bucket );
+
+/****************************************************************************************
+*
+*	Epochs
+*
+****************************************************************************************/
+#pragma mark	(Epochs)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementEpoch(
+	ElementEpoch		*epoch,
+	ElementReclaimProc	reclaimProc,
+	void				*refCon,
+	size_t				offset )
+{
+	assertPtr( epoch );
+
+	epoch->epoch = 0;
+	epoch->readers = NULL;
+	epoch->limbo[ 0 ] = epoch->limbo[ 1 ] = epoch->limbo[ 2 ] = NULL;
+	epoch->reclaimProc = reclaimProc;
+	epoch->refCon = refCon;
+	epoch->offset = offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementEpoch(
+	ElementEpoch	*epoch )
+{
+	assertPtr( epoch );
+
+	SynchronizeElementEpoch( epoch );
+	epoch->readers = NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RegisterElementReader(
+	ElementReader	*reader,
+	ElementEpoch	*epoch )
+{
+	assertPtr( reader );
+	assertPtr( epoch );
+
+	reader->epoch = epoch;
+	reader->state = 0;
+	reader->nextReader = epoch->readers;
+	storeRelease( &epoch->readers, reader );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+UnregisterElementReader(
+	ElementReader	*reader )
+{
+	ElementReader	**link;
+
+	assertPtr( reader );
+	assertTrue( reader->state == 0 );
+
+	for( link = &reader->epoch->readers; *link; link = &(*link)->nextReader ) {
+		if( *link == reader ) {
+			*link = reader->nextReader;
+			break;
+		}
+	}
+	reader->nextReader = NULL;
+	reader->epoch = NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+EnterElementEpoch(
+	ElementReader	*reader )
+{
+	unsigned long	epoch;
+
+	assertPtr( reader );
+	assertTrue( reader->state == 0 );
+
+	epoch = loadAcquire( &reader->epoch->epoch );
+	storeRelaxed( &reader->state, (epoch << 1) | 1 );
+	//	Pairs with the fence in TryAdvanceElementEpoch(): either the writer sees
+	//	us as active, or we see every unlink it made before looking.
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+ExitElementEpoch(
+	ElementReader	*reader )
+{
+	assertPtr( reader );
+	assertTrue( reader->state & 1 );
+
+	storeRelease( &reader->state, 0 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+TryAdvanceElementEpoch(
+	ElementEpoch	*epoch )
+{
+	unsigned long	current;
+	ElementReader	*reader;
+
+	assertPtr( epoch );
+
+	current = epoch->epoch;
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+
+	for( reader = epoch->readers; reader; reader = reader->nextReader ) {
+		unsigned long	state = loadAcquire( &reader->state );
+		if( (state & 1) && (state >> 1) != current )
+			return( false );
+	}
+
+	storeRelease( &epoch->epoch, current + 1 );
+	ReclaimLimbo( epoch, (unsigned) ((current + 2) % 3) );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+SynchronizeElementEpoch(
+	ElementEpoch	*epoch )
+{
+	int	advanced = 0;
+
+	assertPtr( epoch );
+
+	//	Three advances empty all three buckets.
+	while( advanced < 3 ) {
+		if( TryAdvanceElementEpoch( epoch ) )
+			advanced++;
+		else
+			sched_yield();
+	}
+}
+
+/****************************************************************************************
+*
+*	RCU Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(RCU Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+
+	************************************************************************************/
+
+	void
+PutFirstElementRCU(
+	void			*element,
+	ElementList		*list )
+{
+	Element	*element_ = (Element*) element;
+
+	assertPtr( element );
+	assertPtr( list );
+
+	element_->prev = NULL;
+	element_->next = list->first;
+	element_->list = list;
+#if	elementalGenerations
+	element_->generation = list->generation;
+#endif
+	if( list->first )
+		list->first->prev = element_;
+	else
+		list->last = element_;
+	storeRelease( &list->first, element_ );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+
+	************************************************************************************/
+
+	void
+PutLastElementRCU(
+	void			*element,
+	ElementList		*list )
+{
+	Element	*element_ = (Element*) element;
+	Element	*last = list->last;
+
+	assertPtr( element );
+	assertPtr( list );
+
+	element_->prev = last;
+	element_->next = NULL;
+	element_->list = list;
+#if	elementalGenerations
+	element_->generation = list->generation;
+#endif
+	list->last = element_;
+	if( last )
+		storeRelease( &last->next, element_ );
+	else
+		storeRelease( &list->first, element_ );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+
+	************************************************************************************/
+
+	void
+PutBeforeElementRCU(
+	void			*element,
+	void			*before,
+	ElementList		*list )
+{
+	Element	*element_ = (Element*) element;
+	Element	*before_ = (Element*) before;
+
+	assertPtr( element );
+	assertTrue( element != before );
+	assertPtr( list );
+
+	if( before_ == NULL )
+		PutLastElementRCU( element_, list );
+	else if( before_ == list->first )
+		PutFirstElementRCU( element_, list );
+	else {
+		element_->prev = before_->prev;
+		element_->next = before_;
+		element_->list = list;
+#if	elementalGenerations
+		element_->generation = list->generation;
+#endif
+		before_->prev = element_;
+		storeRelease( &element_->prev->next, element_ );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+
+	************************************************************************************/
+
+	void
+PutAfterElementRCU(
+	void			*element,
+	void			*after,
+	ElementList		*list )
+{
+	Element	*element_ = (Element*) element;
+	Element	*after_ = (Element*) after;
+
+	assertPtr( element );
+	assertTrue( element != after );
+	assertPtr( list );
+
+	if( after_ == NULL )
+		PutFirstElementRCU( element_, list );
+	else if( after_ == list->last )
+		PutLastElementRCU( element_, list );
+	else {
+		element_->prev = after_;
+		element_->next = after_->next;
+		element_->list = list;
+#if	elementalGenerations
+		element_->generation = list->generation;
+#endif
+		after_->next->prev = element_;
+		storeRelease( &after_->next, element_ );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveElementRCU(
+	void			*element,
+	ElementList		*list,
+	ElementEpoch	*epoch )
+{
+	Element		*element_ = (Element*) element;
+	unsigned	bucket;
+
+	assertPtr( element );
+	assertPtr( list );
+	assertPtr( epoch );
+	assertTrue( element_->list == list );
+
+	if( element_->prev )
+		storeRelease( &element_->prev->next, element_->next );
+	else
+		storeRelease( &list->first, element_->next );
+	if( element_->next )
+		element_->next->prev = element_->prev;
+	else
+		list->last = element_->prev;
+
+	//	Leave `next` alone: a reader standing on element must still be able to
+	//	walk off it. `prev` is free to chain the limbo bucket.
+	bucket = (unsigned) (epoch->epoch % 3);
+	element_->list = NULL;
+	element_->prev = epoch->limbo[ bucket ];
+	epoch->limbo[ bucket ] = element_;
+
+	TryAdvanceElementEpoch( epoch );
+}
+
+/****************************************************************************************
+*
+*	RCU Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(RCU Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstElementRCU(
+	void			**element,
+	ElementList		*list )
+{
+	assertPtr( element );
+	assertPtr( list );
+
+	*element = loadAcquire( &list->first );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextElementRCU(
+	void		*element,
+	void		**nextElement )
+{
+	assertPtr( element );
+	assertPtr( nextElement );
+
+	*nextElement = loadAcquire( &((Element*) element)->next );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstElementRCUOff(
+	void			**element,
+	ElementList		*list,
+	size_t			offset )
+{
+	FirstElementRCU( element, list );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextElementRCUOff(
+	void		*element,
+	void		**nextElement,
+	size_t		offset )
+{
+	NextElementRCU( (char*) element + offset, nextElement );
+	if( *nextElement )
+		*nextElement = (char*) *nextElement - offset;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+ReclaimLimbo(
+	ElementEpoch	*epoch,
+	unsigned		bucket )
+{
+	Element	*element = epoch->limbo[ bucket ];
+
+	epoch->limbo[ bucket ] = NULL;
+	while( element ) {
+		Element	*prev = element->prev;
+
+		element->prev = element->next = NULL;
+		if( epoch->reclaimProc )
+			epoch->reclaimProc( (char*) element - epoch->offset, epoch->refCon );
+		element = prev;
+	}
+}
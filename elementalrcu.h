@@ -0,0 +1,206 @@
+/****************************************************************************************
+	elementalrcu.h
+
+	Read-mostly ElementLists: lock-free readers, epoch-deferred reclamation.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	The RCU putters publish each element's forward link with release semantics,
+	so any number of readers can walk a list with FirstElementRCU() and
+	NextElementRCU() while a writer mutates it, without taking a lock and
+	without any atomic read-modify-write. Readers only ever follow `next`.
+
+	Removed elements keep their `next` pointer (so a reader standing on one can
+	still walk off it) and are handed to an ElementEpoch, which calls its
+	reclaim proc once every reader that could have seen them has left its
+	read-side section.
+
+	Writers (all the Put/Remove functions below, plus reader registration)
+	must be serialized against each other by the caller. A list mutated with
+	these functions must not also be mutated with the classic putters.
+
+	************************************************************************************/
+
+#ifndef		_elementalrcu_
+#define		_elementalrcu_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementEpoch	ElementEpoch;
+typedef	struct	ElementReader	ElementReader;
+
+//	Called once per removed element after its grace period, with the address of
+//	the enclosing structure (the Element's address minus the epoch's offset).
+typedef	void	(*ElementReclaimProc)( void *element, void *refCon );
+
+struct	ElementReader	{
+	ElementReader	*nextReader;
+	ElementEpoch	*epoch;
+	unsigned long	state;	//	(observed epoch << 1) | 1 while reading, 0 otherwise.
+};
+
+struct	ElementEpoch	{
+	unsigned long		epoch;
+	ElementReader		*readers;
+	Element				*limbo[ 3 ];	//	Retired elements chained through `prev`.
+	ElementReclaimProc	reclaimProc;
+	void				*refCon;
+	size_t				offset;
+};
+
+/**************************
+*
+*	Epochs
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Epochs)
+
+//	reclaimProc may be NULL if removed elements need no cleanup.
+	void
+NewElementEpoch(
+	ElementEpoch		*epoch,
+	ElementReclaimProc	reclaimProc,
+	void				*refCon,
+	size_t				offset );
+
+//	Waits out every reader and reclaims everything still in limbo.
+	void
+DeleteElementEpoch(
+	ElementEpoch	*epoch );
+
+//	Writer-side. Each reading thread registers its own ElementReader once.
+	void
+RegisterElementReader(
+	ElementReader	*reader,
+	ElementEpoch	*epoch );
+
+//	Writer-side. The reader must not be inside a read-side section.
+	void
+UnregisterElementReader(
+	ElementReader	*reader );
+
+//	Begins a read-side section. Elements reached between here and
+//	ExitElementEpoch() will not be reclaimed out from under the reader.
+	void
+EnterElementEpoch(
+	ElementReader	*reader );
+
+	void
+ExitElementEpoch(
+	ElementReader	*reader );
+
+//	Writer-side. Advances the epoch if every active reader has caught up,
+//	reclaiming whatever became unreachable. Returns whether it advanced.
+	bool
+TryAdvanceElementEpoch(
+	ElementEpoch	*epoch );
+
+//	Writer-side. Blocks until every element removed so far has been reclaimed.
+	void
+SynchronizeElementEpoch(
+	ElementEpoch	*epoch );
+
+/**************************
+*
+*	RCU Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(RCU Putters)
+
+//	If list == a, b, c && element == x
+//	Then list = x, a, b, c
+	void
+PutFirstElementRCU(
+	void			*element,
+	ElementList		*list );
+
+//	If list == a, b, c && element == x
+//	Then list = a, b, c, x
+	void
+PutLastElementRCU(
+	void			*element,
+	ElementList		*list );
+
+//	If list == a, b, c && element == x && before == b
+//	Then list = a, x, b, c
+//	Special Case: if before == NULL then PutLastElementRCU( element )
+	void
+PutBeforeElementRCU(
+	void			*element,
+	void			*before,
+	ElementList		*list );
+
+//	If list == a, b, c && element == x && after == b
+//	Then list = a, b, x, c
+//	Special Case: if after == NULL then PutFirstElementRCU( element )
+	void
+PutAfterElementRCU(
+	void			*element,
+	void			*after,
+	ElementList		*list );
+
+//	If list == a, b, c && element == b
+//	Then list = a, c
+//	element is handed to epoch and must not be reused until it is reclaimed.
+	void
+RemoveElementRCU(
+	void			*element,
+	ElementList		*list,
+	ElementEpoch	*epoch );
+
+/**************************
+*
+*	RCU Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(RCU Accessors)
+
+//	Safe to call concurrently with the RCU putters from inside a read-side section.
+
+//	If list == a, b, c
+//	Then *element = a
+	void
+FirstElementRCU(
+	void			**element,
+	ElementList		*list );
+
+//	If list == a, b, c && element == b
+//	Then *nextElement = c
+	void
+NextElementRCU(
+	void		*element,
+	void		**nextElement );
+
+	void
+FirstElementRCUOff(
+	void			**element,
+	ElementList		*list,
+	size_t			offset );
+
+	void
+NextElementRCUOff(
+	void		*element,
+	void		**nextElement,
+	size_t		offset );
+
+#define	FirstElementRCUType( ELEMENT, LIST, STRUCTURE, FIELD )	\
+			FirstElementRCUOff( (void**)(ELEMENT), (LIST), offsetof( STRUCTURE, FIELD ) )
+
+#define	NextElementRCUType( ELEMENT, NEXTELEMENT, STRUCTURE, FIELD )	\
+			NextElementRCUOff( (ELEMENT), (void**)(NEXTELEMENT), offsetof( STRUCTURE, FIELD ) )
+
+__END_DECLS
+#endif	//	_elementalrcu_
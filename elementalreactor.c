@@ -0,0 +1,446 @@
+/****************************************************************************************
+	elementalreactor.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Epoll is level-triggered. EPOLLOUT is asked for only while a connection is
+	write-blocked, and its arrival just moves the connection back onto the
+	write-pending list, so procs see elementalWritable only when flushing.
+
+	Every kernel event of a pass is folded into the ready list before any proc
+	runs, so a proc may remove and free any connection without leaving stale
+	pointers in the event buffer. Once a connection's proc has been called the
+	reactor doesn't touch that connection again.
+
+	************************************************************************************/
+
+#ifndef	_POSIX_C_SOURCE
+	#define	_POSIX_C_SOURCE	200809L	//	clock_gettime()
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "elementalreactor.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+#define	readyOffset		offsetof( ElementConnection, readyElement )
+#define	writeOffset		offsetof( ElementConnection, writeElement )
+#define	idleOffset		offsetof( ElementConnection, idleElement )
+
+	static
+	uint64_t
+ReactorNow( void );
+
+	static
+	void
+UpdateReactorInterest(
+	ElementConnection	*connection,
+	ElementReactor		*reactor );
+
+	static
+	void
+GatherReactorEvents(
+	ElementReactor	*reactor,
+	int				count );
+
+	static
+	void
+ExpireIdleConnections(
+	ElementReactor	*reactor );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+NewElementReactor(
+	ElementReactor	*reactor,
+	uint64_t		idleTimeout )
+{
+	assertPtr( reactor );
+
+	reactor->epollFD = epoll_create1( EPOLL_CLOEXEC );
+	if( reactor->epollFD < 0 )
+		return( false );
+
+	NewElementList( &reactor->ready );
+	NewElementList( &reactor->writePending );
+	NewElementList( &reactor->idle );
+	reactor->idleTimeout = idleTimeout;
+	reactor->now = ReactorNow();
+	reactor->flushing = NULL;
+	reactor->stopping = false;
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementReactor(
+	ElementReactor	*reactor )
+{
+	assertPtr( reactor );
+
+	close( reactor->epollFD );
+	reactor->epollFD = -1;
+	DeleteElementList( &reactor->ready );
+	DeleteElementList( &reactor->writePending );
+	DeleteElementList( &reactor->idle );
+}
+
+/****************************************************************************************
+*
+*	Connections
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Connections)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+AddReactorConnection(
+	ElementConnection		*connection,
+	ElementReactor			*reactor,
+	int						fd,
+	ElementConnectionProc	proc,
+	void					*refCon )
+{
+	struct epoll_event	event;
+
+	assertPtr( connection );
+	assertPtr( reactor );
+	assertPtr( proc );
+
+	event.events = EPOLLIN;
+	event.data.ptr = connection;
+	if( epoll_ctl( reactor->epollFD, EPOLL_CTL_ADD, fd, &event ) != 0 )
+		return( false );
+
+	connection->readyElement.list = connection->writeElement.list = NULL;
+	connection->fd = fd;
+	connection->events = 0;
+	connection->interest = EPOLLIN;
+	connection->writeBlocked = false;
+	connection->lastActive = reactor->now;
+	connection->proc = proc;
+	connection->refCon = refCon;
+	PutLastElementOff( connection, &reactor->idle, idleOffset );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveReactorConnection(
+	ElementConnection	*connection,
+	ElementReactor		*reactor )
+{
+	ElementList	*list;
+
+	assertPtr( connection );
+	assertPtr( reactor );
+
+	epoll_ctl( reactor->epollFD, EPOLL_CTL_DEL, connection->fd, NULL );
+
+	if( (list = connection->readyElement.list) != NULL )
+		RemoveElementOff( connection, list, readyOffset );
+	if( (list = connection->writeElement.list) != NULL )
+		RemoveElementOff( connection, list, writeOffset );
+	RemoveElementOff( connection, &reactor->idle, idleOffset );
+
+	if( reactor->flushing == connection )
+		reactor->flushing = NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PendReactorWrite(
+	ElementConnection	*connection,
+	ElementReactor		*reactor )
+{
+	assertPtr( connection );
+	assertPtr( reactor );
+
+	if( reactor->flushing == connection ) {
+		connection->writeBlocked = true;
+		UpdateReactorInterest( connection, reactor );
+	} else if( !connection->writeBlocked && connection->writeElement.list == NULL )
+		PutLastElementOff( connection, &reactor->writePending, writeOffset );
+}
+
+/****************************************************************************************
+*
+*	Running
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Running)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+RunReactorOnce(
+	ElementReactor	*reactor,
+	int				timeout )
+{
+	ElementConnection	*connection;
+	int					count;
+
+	assertPtr( reactor );
+
+	//	Don't sleep past the next idle deadline, nor at all with writes pending.
+	reactor->now = ReactorNow();
+	if( !IsListEmpty( &reactor->writePending ) )
+		timeout = 0;
+	else if( reactor->idleTimeout ) {
+		FirstElementOff( (void**) &connection, &reactor->idle, idleOffset );
+		if( connection ) {
+			uint64_t	deadline = connection->lastActive + reactor->idleTimeout;
+			uint64_t	remaining = deadline > reactor->now ? deadline - reactor->now : 0;
+
+			if( timeout < 0 || remaining < (uint64_t) timeout )
+				timeout = (int) remaining;
+		}
+	}
+
+	count = epoll_wait( reactor->epollFD, reactor->events, elementalReactorBatch, timeout );
+	if( count < 0 ) {
+		if( errno != EINTR )
+			return( false );
+		count = 0;
+	}
+	reactor->now = ReactorNow();
+	GatherReactorEvents( reactor, count );
+
+	for( GrabFirstElementOff( (void**) &connection, &reactor->ready, readyOffset ); connection;
+		 GrabFirstElementOff( (void**) &connection, &reactor->ready, readyOffset ) ) {
+		unsigned	events = connection->events;
+
+		connection->events = 0;
+		RemoveElementOff( connection, &reactor->idle, idleOffset );
+		connection->lastActive = reactor->now;
+		PutLastElementOff( connection, &reactor->idle, idleOffset );
+
+		connection->proc( connection, events, connection->refCon );
+	}
+
+	//	Whatever was pended above goes out in one write per connection.
+	for( GrabFirstElementOff( (void**) &connection, &reactor->writePending, writeOffset ); connection;
+		 GrabFirstElementOff( (void**) &connection, &reactor->writePending, writeOffset ) ) {
+		reactor->flushing = connection;
+		connection->proc( connection, elementalWritable, connection->refCon );
+		reactor->flushing = NULL;
+	}
+
+	if( reactor->idleTimeout )
+		ExpireIdleConnections( reactor );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+RunElementReactor(
+	ElementReactor	*reactor )
+{
+	assertPtr( reactor );
+
+	reactor->stopping = false;
+	while( !reactor->stopping )
+		if( !RunReactorOnce( reactor, -1 ) )
+			return( false );
+
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+StopElementReactor(
+	ElementReactor	*reactor )
+{
+	assertPtr( reactor );
+
+	reactor->stopping = true;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	uint64_t
+ReactorNow( void )
+{
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return( (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UpdateReactorInterest(
+	ElementConnection	*connection,
+	ElementReactor		*reactor )
+{
+	struct epoll_event	event;
+
+	event.events = connection->writeBlocked ? EPOLLIN | EPOLLOUT : EPOLLIN;
+	if( event.events == connection->interest )
+		return;
+
+	event.data.ptr = connection;
+	if( epoll_ctl( reactor->epollFD, EPOLL_CTL_MOD, connection->fd, &event ) == 0 )
+		connection->interest = event.events;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+GatherReactorEvents(
+	ElementReactor	*reactor,
+	int				count )
+{
+	int	index;
+
+	for( index = 0; index < count; index++ ) {
+		ElementConnection	*connection = (ElementConnection*) reactor->events[ index ].data.ptr;
+		uint32_t			events = reactor->events[ index ].events;
+
+		if( (events & EPOLLOUT) && connection->writeBlocked ) {
+			connection->writeBlocked = false;
+			UpdateReactorInterest( connection, reactor );
+			if( connection->writeElement.list == NULL )
+				PutLastElementOff( connection, &reactor->writePending, writeOffset );
+		}
+
+		if( events & EPOLLIN )
+			connection->events |= elementalReadable;
+		if( events & (EPOLLHUP | EPOLLERR) )
+			connection->events |= elementalHangup;
+		if( connection->events && connection->readyElement.list == NULL )
+			PutLastElementOff( connection, &reactor->ready, readyOffset );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+ExpireIdleConnections(
+	ElementReactor	*reactor )
+{
+	ElementConnection	*connection;
+
+	for(;;) {
+		FirstElementOff( (void**) &connection, &reactor->idle, idleOffset );
+		if( connection == NULL || connection->lastActive + reactor->idleTimeout > reactor->now )
+			break;
+
+		//	Rearmed before the proc runs, so the proc is free to remove it.
+		RemoveElementOff( connection, &reactor->idle, idleOffset );
+		connection->lastActive = reactor->now;
+		PutLastElementOff( connection, &reactor->idle, idleOffset );
+
+		connection->proc( connection, elementalIdle, connection->refCon );
+	}
+}
@@ -0,0 +1,164 @@
+/****************************************************************************************
+	elementalreactor.h
+
+	A small epoll event loop built on ElementLists. Linux only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Each ElementConnection embeds the Elements that put it on the reactor's
+	ready, write-pending and idle lists, so dispatch never allocates. One pass
+	of RunReactorOnce():
+
+		1.	waits for events, folding every event for a connection into one
+			entry on the ready list;
+		2.	calls each ready connection's proc once with all its events;
+		3.	calls each write-pending connection's proc once with
+			elementalWritable, however many times it was pended, so output
+			queued while handling many reads goes out in one write;
+		4.	calls the proc of each connection idle for idleTimeout with
+			elementalIdle.
+
+	A proc that is flushing and can't write everything pends itself again;
+	the reactor then waits for the socket to drain before flushing it again.
+
+	************************************************************************************/
+
+#ifndef		_elementalreactor_
+#define		_elementalreactor_
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+//	Kernel events fetched per epoll_wait().
+#ifndef	elementalReactorBatch
+	#define	elementalReactorBatch	64
+#endif
+
+//	The events argument of an ElementConnectionProc.
+enum	{
+	elementalReadable	= 0x1,
+	elementalWritable	= 0x2,
+	elementalHangup		= 0x4,	//	Includes errors; reading reports which.
+	elementalIdle		= 0x8
+};
+
+typedef	struct	ElementReactor		ElementReactor;
+typedef	struct	ElementConnection	ElementConnection;
+
+//	May pend writes, and may remove any connection, including this one.
+typedef	void	(*ElementConnectionProc)( ElementConnection *connection, unsigned events, void *refCon );
+
+struct	ElementConnection	{
+	Element					readyElement;
+	Element					writeElement;
+	Element					idleElement;
+	int						fd;
+	unsigned				events;			//	Gathered while on the ready list.
+	uint32_t				interest;		//	As registered with epoll.
+	bool					writeBlocked;	//	Waiting for the socket to drain.
+	uint64_t				lastActive;		//	Milliseconds, CLOCK_MONOTONIC.
+	ElementConnectionProc	proc;
+	void					*refCon;
+};
+
+struct	ElementReactor	{
+	int					epollFD;
+	ElementList			ready;
+	ElementList			writePending;
+	ElementList			idle;			//	Least recently active first.
+	uint64_t			idleTimeout;	//	Milliseconds, or 0 for never.
+	uint64_t			now;
+	ElementConnection	*flushing;
+	bool				stopping;
+	struct epoll_event	events[ elementalReactorBatch ];
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	Returns false, with errno set, if the epoll instance couldn't be created.
+	bool
+NewElementReactor(
+	ElementReactor	*reactor,
+	uint64_t		idleTimeout );
+
+//	Closes the epoll instance. Connections and their descriptors are untouched.
+	void
+DeleteElementReactor(
+	ElementReactor	*reactor );
+
+/**************************
+*
+*	Connections
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Connections)
+
+//	Watches fd, which should be non-blocking, for reads. Returns false, with
+//	errno set, if epoll refused it.
+	bool
+AddReactorConnection(
+	ElementConnection		*connection,
+	ElementReactor			*reactor,
+	int						fd,
+	ElementConnectionProc	proc,
+	void					*refCon );
+
+//	Stops watching connection and takes it off every list. Doesn't close fd.
+	void
+RemoveReactorConnection(
+	ElementConnection	*connection,
+	ElementReactor		*reactor );
+
+//	Asks for connection's proc to be called with elementalWritable at the end
+//	of this pass. Called by that proc itself, it means the socket is full.
+	void
+PendReactorWrite(
+	ElementConnection	*connection,
+	ElementReactor		*reactor );
+
+/**************************
+*
+*	Running
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Running)
+
+//	Waits up to timeout milliseconds (-1 forever) for events, then dispatches
+//	as above. Returns false, with errno set, if epoll_wait() failed.
+	bool
+RunReactorOnce(
+	ElementReactor	*reactor,
+	int				timeout );
+
+//	Runs passes until StopElementReactor(). Returns false as RunReactorOnce().
+	bool
+RunElementReactor(
+	ElementReactor	*reactor );
+
+//	Makes RunElementReactor() return after the current pass. Not thread-safe.
+	void
+StopElementReactor(
+	ElementReactor	*reactor );
+
+__END_DECLS
+#endif	//	_elementalreactor_
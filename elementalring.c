@@ -0,0 +1,668 @@
+/****************************************************************************************
+	elementalring.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Everything funnels through LinkRingElement() and UnlinkRingElement(), which
+	are straight-line. The only conditionals left are the NULL <-> sentinel
+	translations at the API boundary, which compile to conditional moves.
+
+	************************************************************************************/
+
+#include <assert.h>
+
+#include "elementalring.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+//	Sentinel -> NULL, for handing elements back to callers.
+#define	RingResult( RING, ELEMENT )	\
+			((ELEMENT) == &(RING)->sentinel ? NULL : (void*) (ELEMENT))
+
+	static
+	void
+LinkRingElement(
+	Element	*element,
+	Element	*prev,
+	Element	*next );
+
+	static
+	void
+UnlinkRingElement(
+	Element	*element );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewElementRing(
+	ElementRing	*ring )
+{
+	assertPtr( ring );
+
+	ring->sentinel.next = ring->sentinel.prev = &ring->sentinel;
+	ring->sentinel.list = NULL;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteElementRing(
+	ElementRing	*ring )
+{
+	(void) ring;
+}
+
+/****************************************************************************************
+*
+*	Ring Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Ring Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutFirstRingElement(
+	void			*element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	LinkRingElement( (Element*) element, &ring->sentinel, ring->sentinel.next );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutLastRingElement(
+	void			*element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	LinkRingElement( (Element*) element, ring->sentinel.prev, &ring->sentinel );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutBeforeRingElement(
+	void			*element,
+	void			*before,
+	ElementRing		*ring )
+{
+	Element	*before_ = before ? (Element*) before : &ring->sentinel;
+
+	assertPtr( element );
+	assertTrue( element != before );
+
+	LinkRingElement( (Element*) element, before_->prev, before_ );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutAfterRingElement(
+	void			*element,
+	void			*after,
+	ElementRing		*ring )
+{
+	Element	*after_ = after ? (Element*) after : &ring->sentinel;
+
+	assertPtr( element );
+	assertTrue( element != after );
+
+	LinkRingElement( (Element*) element, after_, after_->next );
+}
+
+/****************************************************************************************
+*
+*	Ring Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Ring Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstRingElement(
+	void			**element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	*element = RingResult( ring, ring->sentinel.next );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+LastRingElement(
+	void			**element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	*element = RingResult( ring, ring->sentinel.prev );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextRingElement(
+	void			*element,
+	void			**nextElement,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( nextElement );
+
+	*nextElement = RingResult( ring, ((Element*) element)->next );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PrevRingElement(
+	void			*element,
+	void			**prevElement,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( prevElement );
+
+	*prevElement = RingResult( ring, ((Element*) element)->prev );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+IsRingEmpty(
+	ElementRing	*ring )
+{
+	assertPtr( ring );
+
+	return( ring->sentinel.next == &ring->sentinel );
+}
+
+/****************************************************************************************
+*
+*	Ring Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Ring Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveRingElement(
+	void	*element )
+{
+	assertPtr( element );
+
+	UnlinkRingElement( (Element*) element );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstRingElement(
+	void			**element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	FirstRingElement( element, ring );
+	if( *element )
+		UnlinkRingElement( (Element*) *element );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabLastRingElement(
+	void			**element,
+	ElementRing		*ring )
+{
+	assertPtr( element );
+	assertPtr( ring );
+
+	LastRingElement( element, ring );
+	if( *element )
+		UnlinkRingElement( (Element*) *element );
+}
+
+/****************************************************************************************
+*
+*	Ring Reordering
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Ring Reordering)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RotateElementRing(
+	ElementRing	*ring )
+{
+	Element	*sentinel = &ring->sentinel;
+	Element	*first = sentinel->next;
+
+	assertPtr( ring );
+
+	//	Step the sentinel forward over the first element. On an empty ring
+	//	first is the sentinel itself, and unlinking and relinking it is a no-op.
+	UnlinkRingElement( sentinel );
+	LinkRingElement( sentinel, first, first->next );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RotateElementRingBack(
+	ElementRing	*ring )
+{
+	Element	*sentinel = &ring->sentinel;
+	Element	*last = sentinel->prev;
+
+	assertPtr( ring );
+
+	UnlinkRingElement( sentinel );
+	LinkRingElement( sentinel, last->prev, last );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+SwapElementRingEnds(
+	ElementRing	*ring )
+{
+	Element	*sentinel = &ring->sentinel;
+	Element	*first = sentinel->next;
+	Element	*last = sentinel->prev;
+
+	assertPtr( ring );
+
+	if( first == last )
+		return;	//	Empty, or a single element.
+
+	UnlinkRingElement( last );
+	LinkRingElement( last, sentinel, first );
+	UnlinkRingElement( first );
+	LinkRingElement( first, sentinel->prev, sentinel );
+}
+
+/****************************************************************************************
+*
+*	Offset Ring Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutFirstRingElementOff(
+	void			*element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	PutFirstRingElement( (char*) element + offset, ring );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutLastRingElementOff(
+	void			*element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	PutLastRingElement( (char*) element + offset, ring );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutBeforeRingElementOff(
+	void			*element,
+	void			*before,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	PutBeforeRingElement( (char*) element + offset, before ? (char*) before + offset : NULL, ring );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PutAfterRingElementOff(
+	void			*element,
+	void			*after,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	PutAfterRingElement( (char*) element + offset, after ? (char*) after + offset : NULL, ring );
+}
+
+/****************************************************************************************
+*
+*	Offset Ring Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	FirstRingElement( element, ring );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+LastRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	LastRingElement( element, ring );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextRingElementOff(
+	void			*element,
+	void			**nextElement,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	NextRingElement( (char*) element + offset, nextElement, ring );
+	if( *nextElement )
+		*nextElement = (char*) *nextElement - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PrevRingElementOff(
+	void			*element,
+	void			**prevElement,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	PrevRingElement( (char*) element + offset, prevElement, ring );
+	if( *prevElement )
+		*prevElement = (char*) *prevElement - offset;
+}
+
+/****************************************************************************************
+*
+*	Offset Ring Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+RemoveRingElementOff(
+	void	*element,
+	size_t	offset )
+{
+	RemoveRingElement( (char*) element + offset );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabFirstRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	GrabFirstRingElement( element, ring );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+GrabLastRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset )
+{
+	GrabLastRingElement( element, ring );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LinkRingElement(
+	Element	*element,
+	Element	*prev,
+	Element	*next )
+{
+	element->prev = prev;
+	element->next = next;
+	prev->next = element;
+	next->prev = element;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnlinkRingElement(
+	Element	*element )
+{
+	element->prev->next = element->next;
+	element->next->prev = element->prev;
+	element->prev = element->next = element;
+}
@@ -0,0 +1,391 @@
+/****************************************************************************************
+	elementalring.h
+
+	Sentinel-based circular ElementRings with straight-line insert and remove.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An ElementRing embeds a sentinel Element, so the ring is never truly empty
+	and every Put/Remove is a handful of unconditional pointer writes: no test
+	for an empty list, no test for a NULL neighbour. The sentinel also makes
+	rotating the ring and swapping its ends constant-time.
+
+	Ring elements use the same Element hook as ElementLists, but their `list`
+	field is not maintained. The accessors translate the sentinel back to NULL
+	so ring iteration reads the same as list iteration.
+
+	************************************************************************************/
+
+#ifndef		_elementalring_
+#define		_elementalring_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementRing	ElementRing;
+
+struct	ElementRing	{
+	Element	sentinel;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+	void
+NewElementRing(
+	ElementRing	*ring );
+
+	void
+DeleteElementRing(
+	ElementRing	*ring );
+
+/**************************
+*
+*	Ring Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Ring Putters)
+
+//	If ring == a, b, c && element == x
+//	Then ring = x, a, b, c
+	void
+PutFirstRingElement(
+	void			*element,
+	ElementRing		*ring );
+
+//	If ring == a, b, c && element == x
+//	Then ring = a, b, c, x
+	void
+PutLastRingElement(
+	void			*element,
+	ElementRing		*ring );
+
+//	If ring == a, b, c && element == x && before == b
+//	Then ring = a, x, b, c
+//	Special Case: if before == NULL then PutLastRingElement( element )
+	void
+PutBeforeRingElement(
+	void			*element,
+	void			*before,
+	ElementRing		*ring );
+
+//	If ring == a, b, c && element == x && after == b
+//	Then ring = a, b, x, c
+//	Special Case: if after == NULL then PutFirstRingElement( element )
+	void
+PutAfterRingElement(
+	void			*element,
+	void			*after,
+	ElementRing		*ring );
+
+/**************************
+*
+*	Ring Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Ring Accessors)
+
+//	If ring == a, b, c
+//	Then *element = a
+	void
+FirstRingElement(
+	void			**element,
+	ElementRing		*ring );
+
+//	If ring == a, b, c
+//	Then *element = c
+	void
+LastRingElement(
+	void			**element,
+	ElementRing		*ring );
+
+//	If ring == a, b, c && element == b
+//	Then *nextElement = c
+	void
+NextRingElement(
+	void			*element,
+	void			**nextElement,
+	ElementRing		*ring );
+
+//	If ring == a, b, c && element == b
+//	Then *prevElement = a
+	void
+PrevRingElement(
+	void			*element,
+	void			**prevElement,
+	ElementRing		*ring );
+
+//	Returns whether the ring is empty.
+	bool
+IsRingEmpty(
+	ElementRing	*ring );
+
+/**************************
+*
+*	Ring Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Ring Grabbing)
+
+//	If ring == a, b, c && element == b
+//	Then ring = a, c
+//	Unlike RemoveElement(), element must be in a ring.
+	void
+RemoveRingElement(
+	void	*element );
+
+//	If ring == a, b, c
+//	Then ring = b, c && *element = a
+	void
+GrabFirstRingElement(
+	void			**element,
+	ElementRing		*ring );
+
+//	If ring == a, b, c
+//	Then ring = a, b && *element = c
+	void
+GrabLastRingElement(
+	void			**element,
+	ElementRing		*ring );
+
+/**************************
+*
+*	Ring Reordering
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Ring Reordering)
+
+//	If ring == a, b, c
+//	Then ring = b, c, a
+	void
+RotateElementRing(
+	ElementRing	*ring );
+
+//	If ring == a, b, c
+//	Then ring = c, a, b
+	void
+RotateElementRingBack(
+	ElementRing	*ring );
+
+//	If ring == a, b, c, d
+//	Then ring = d, b, c, a
+	void
+SwapElementRingEnds(
+	ElementRing	*ring );
+
+/**************************
+*
+*	Offset Ring Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Putters)
+
+//	If ring == a, b, c && element == x
+//	Then ring = x, a, b, c
+	void
+PutFirstRingElementOff(
+	void			*element,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c && element == x
+//	Then ring = a, b, c, x
+	void
+PutLastRingElementOff(
+	void			*element,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c && element == x && before == b
+//	Then ring = a, x, b, c
+//	Special Case: if before == NULL then PutLastRingElement( element )
+	void
+PutBeforeRingElementOff(
+	void			*element,
+	void			*before,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c && element == x && after == b
+//	Then ring = a, b, x, c
+//	Special Case: if after == NULL then PutFirstRingElement( element )
+	void
+PutAfterRingElementOff(
+	void			*element,
+	void			*after,
+	ElementRing		*ring,
+	size_t			offset );
+
+/**************************
+*
+*	Offset Ring Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Accessors)
+
+//	If ring == a, b, c
+//	Then *element = a
+	void
+FirstRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c
+//	Then *element = c
+	void
+LastRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c && element == b
+//	Then *nextElement = c
+	void
+NextRingElementOff(
+	void			*element,
+	void			**nextElement,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c && element == b
+//	Then *prevElement = a
+	void
+PrevRingElementOff(
+	void			*element,
+	void			**prevElement,
+	ElementRing		*ring,
+	size_t			offset );
+
+/**************************
+*
+*	Offset Ring Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Ring Grabbing)
+
+//	If ring == a, b, c && element == b
+//	Then ring = a, c
+	void
+RemoveRingElementOff(
+	void	*element,
+	size_t	offset );
+
+//	If ring == a, b, c
+//	Then ring = b, c && *element = a
+	void
+GrabFirstRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset );
+
+//	If ring == a, b, c
+//	Then ring = a, b && *element = c
+	void
+GrabLastRingElementOff(
+	void			**element,
+	ElementRing		*ring,
+	size_t			offset );
+
+/**************************
+*
+*	Type Ring Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Ring Putters)
+
+//	If ring == a, b, c && element == x
+//	Then ring = x, a, b, c
+#define	PutFirstRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			PutFirstRingElementOff( (ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c && element == x
+//	Then ring = a, b, c, x
+#define	PutLastRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			PutLastRingElementOff( (ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c && element == x && before == b
+//	Then ring = a, x, b, c
+#define	PutBeforeRingElementType( ELEMENT, BEFORE, RING, STRUCTURE, FIELD )	\
+			PutBeforeRingElementOff( (ELEMENT), (BEFORE), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c && element == x && after == b
+//	Then ring = a, b, x, c
+#define	PutAfterRingElementType( ELEMENT, AFTER, RING, STRUCTURE, FIELD )	\
+			PutAfterRingElementOff( (ELEMENT), (AFTER), (RING), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Type Ring Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Ring Accessors)
+
+//	If ring == a, b, c
+//	Then *element = a
+#define	FirstRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			FirstRingElementOff( (void**)(ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c
+//	Then *element = c
+#define	LastRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			LastRingElementOff( (void**)(ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c && element == b
+//	Then *nextElement = c
+#define	NextRingElementType( ELEMENT, NEXTELEMENT, RING, STRUCTURE, FIELD )	\
+			NextRingElementOff( (ELEMENT), (void**)(NEXTELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c && element == b
+//	Then *prevElement = a
+#define	PrevRingElementType( ELEMENT, PREVELEMENT, RING, STRUCTURE, FIELD )	\
+			PrevRingElementOff( (ELEMENT), (void**)(PREVELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+/**************************
+*
+*	Type Ring Grabbing
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Type Ring Grabbing)
+
+//	If ring == a, b, c && element == b
+//	Then ring = a, c
+#define	RemoveRingElementType( ELEMENT, STRUCTURE, FIELD )	\
+			RemoveRingElementOff( (ELEMENT), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c
+//	Then ring = b, c && *element = a
+#define	GrabFirstRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			GrabFirstRingElementOff( (void**)(ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+//	If ring == a, b, c
+//	Then ring = a, b && *element = c
+#define	GrabLastRingElementType( ELEMENT, RING, STRUCTURE, FIELD )	\
+			GrabLastRingElementOff( (void**)(ELEMENT), (RING), offsetof( STRUCTURE, FIELD ) )
+
+__END_DECLS
+#endif	//	_elementalring_
@@ -0,0 +1,690 @@
+/****************************************************************************************
+	elementalsharded.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Spills and publishing take the coldest elements from the back of local;
+	pops take from the front. Steals probe each victim's overflowCount without
+	the lock first, so empty shards cost one shared read apiece and a busy
+	victim is skipped rather than waited on. A thief moves its take straight
+	into its own local list, which no one else touches, so no function here
+	holds two locks at once.
+
+	hungry sits on the owner's line and a thief stores to it only when it is
+	clear, so an owner no one is waiting on pays one load of a line it
+	already holds per push or pop. localCount is stored relaxed by its owner
+	alone, for CountShardedElements() and thieves to read.
+
+	************************************************************************************/
+
+#include <assert.h>
+
+#include "elementalsharded.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+	static
+	size_t
+MoveElementRun(
+	ElementList	*from,
+	ElementList	*to,
+	size_t		count,
+	bool		fromLast,
+	size_t		*taken );
+
+	static
+	bool
+TryLockShard(
+	ElementShard	*shard );
+
+	static
+	void
+LockShard(
+	ElementShard	*shard );
+
+	static
+	void
+UnlockShard(
+	ElementShard	*shard );
+
+	static
+	void
+PublishShardElements(
+	ShardedElementList	*sharded,
+	ElementShard		*shard,
+	size_t				count );
+
+	static
+	ElementShard*
+ShardOfList(
+	ShardedElementList	*sharded,
+	ElementList			*list );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Initializes localLock.
+	agent		Mon, Oct 19, 2026	Initializes hungry instead.
+
+	************************************************************************************/
+
+	void
+NewShardedElementList(
+	ShardedElementList	*sharded,
+	ElementShard		*shards,
+	unsigned			shardCount,
+	size_t				batch )
+{
+	unsigned	i;
+
+	assertPtr( sharded );
+	assertPtr( shards );
+	assertTrue( shardCount > 0 );
+	assertTrue( batch > 0 );
+
+	sharded->shards = shards;
+	sharded->shardCount = shardCount;
+	sharded->nextShard = 0;
+	sharded->batch = batch;
+
+	for( i = 0; i < shardCount; i++ ) {
+		NewElementList( &shards[ i ].local );
+		shards[ i ].localCount = 0;
+		shards[ i ].hungry = 0;
+		NewElementList( &shards[ i ].overflow );
+		shards[ i ].overflowCount = 0;
+		shards[ i ].lock = 0;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteShardedElementList(
+	ShardedElementList	*sharded )
+{
+	unsigned	i;
+
+	assertPtr( sharded );
+
+	for( i = 0; i < sharded->shardCount; i++ ) {
+		DeleteElementList( &sharded->shards[ i ].local );
+		DeleteElementList( &sharded->shards[ i ].overflow );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Asserts the indexes don't wrap.
+
+	************************************************************************************/
+
+	unsigned
+AcquireElementShard(
+	ShardedElementList	*sharded )
+{
+	unsigned	shard;
+
+	assertPtr( sharded );
+
+	shard = __atomic_fetch_add( &sharded->nextShard, 1, __ATOMIC_RELAXED );
+	assertTrue( shard < sharded->shardCount );
+	return( shard % sharded->shardCount );
+}
+
+/****************************************************************************************
+*
+*	Shard Putters and Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Shard Putters and Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Holds localLock, so thieves may take from local.
+	agent		Mon, Oct 19, 2026	Takes no lock again; publishes to overflow when hungry.
+
+	************************************************************************************/
+
+	void
+PushShardElement(
+	void				*element,
+	ShardedElementList	*sharded,
+	unsigned			shard )
+{
+	ElementShard	*shard_ = &sharded->shards[ shard ];
+
+	assertPtr( element );
+	assertTrue( shard < sharded->shardCount );
+
+	PutFirstElement( element, &shard_->local );
+	__atomic_store_n( &shard_->localCount, shard_->localCount + 1, __ATOMIC_RELAXED );
+	if( shard_->localCount > 2 * sharded->batch )
+		PublishShardElements( sharded, shard_, sharded->batch );
+	else if( __atomic_load_n( &shard_->hungry, __ATOMIC_RELAXED ) )
+		PublishShardElements( sharded, shard_, shard_->localCount / 2 );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Holds localLock, sweeps a local list left only dead
+								elements, and retries after a successful steal.
+	agent		Mon, Oct 19, 2026	Takes no lock again, so needs no retry; publishes to
+								overflow when hungry.
+
+	************************************************************************************/
+
+	void
+PopShardElement(
+	void				**element,
+	ShardedElementList	*sharded,
+	unsigned			shard )
+{
+	ElementShard	*shard_ = &sharded->shards[ shard ];
+
+	assertPtr( element );
+	assertTrue( shard < sharded->shardCount );
+
+	//	localCount still counts elements marked dead since they were put.
+	if( shard_->localCount && IsListEmpty( &shard_->local ) ) {
+		SweepElementList( &shard_->local, NULL );
+		__atomic_store_n( &shard_->localCount, 0, __ATOMIC_RELAXED );
+	}
+	if( shard_->localCount == 0 && __atomic_load_n( &shard_->overflowCount, __ATOMIC_RELAXED ) ) {
+		size_t	moved, taken;
+
+		LockShard( shard_ );
+		moved = MoveElementRun( &shard_->overflow, &shard_->local, sharded->batch, false, &taken );
+		__atomic_store_n( &shard_->overflowCount, shard_->overflowCount - taken, __ATOMIC_RELAXED );
+		UnlockShard( shard_ );
+		__atomic_store_n( &shard_->localCount, moved, __ATOMIC_RELAXED );
+	}
+	if( shard_->localCount == 0 )
+		StealShardElements( sharded, shard );
+
+	GrabFirstElement( element, &shard_->local );
+	if( *element ) {
+		__atomic_store_n( &shard_->localCount, shard_->localCount - 1, __ATOMIC_RELAXED );
+		if( __atomic_load_n( &shard_->hungry, __ATOMIC_RELAXED ) )
+			PublishShardElements( sharded, shard_, shard_->localCount / 2 );
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Falls back to other shards' local lists once every
+								overflow is empty.
+	agent		Mon, Oct 19, 2026	Raises other shards' hungry flags instead, and moves its
+								take straight into local.
+
+	************************************************************************************/
+
+	size_t
+StealShardElements(
+	ShardedElementList	*sharded,
+	unsigned			shard )
+{
+	ElementShard	*shard_ = &sharded->shards[ shard ];
+	size_t			moved = 0;
+	size_t			taken;
+	unsigned		i;
+
+	assertPtr( sharded );
+	assertTrue( shard < sharded->shardCount );
+
+	for( i = 1; i < sharded->shardCount && moved == 0; i++ ) {
+		ElementShard	*victim = &sharded->shards[ (shard + i) % sharded->shardCount ];
+
+		if( __atomic_load_n( &victim->overflowCount, __ATOMIC_RELAXED ) == 0 )
+			continue;
+		if( !TryLockShard( victim ) )
+			continue;
+		moved = MoveElementRun( &victim->overflow, &shard_->local, sharded->batch, false, &taken );
+		__atomic_store_n( &victim->overflowCount, victim->overflowCount - taken, __ATOMIC_RELAXED );
+		UnlockShard( victim );
+	}
+	if( moved ) {
+		__atomic_store_n( &shard_->localCount, shard_->localCount + moved, __ATOMIC_RELAXED );
+		return( moved );
+	}
+
+	//	Every overflow was empty or busy: ask owners with some to spare to
+	//	publish it. Only a clear flag is stored to, to spare the owner's line.
+	for( i = 1; i < sharded->shardCount; i++ ) {
+		ElementShard	*victim = &sharded->shards[ (shard + i) % sharded->shardCount ];
+
+		if( __atomic_load_n( &victim->localCount, __ATOMIC_RELAXED ) > 1
+		&& !__atomic_load_n( &victim->hungry, __ATOMIC_RELAXED ) )
+			__atomic_store_n( &victim->hungry, 1, __ATOMIC_RELAXED );
+	}
+	return( 0 );
+}
+
+/****************************************************************************************
+*
+*	Global Access
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Global Access)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Also takes localLock.
+	agent		Mon, Oct 19, 2026	Reads localCount relaxed; there is no localLock.
+
+	************************************************************************************/
+
+	size_t
+CountShardedElements(
+	ShardedElementList	*sharded )
+{
+	size_t		count = 0;
+	unsigned	i;
+
+	assertPtr( sharded );
+
+	for( i = 0; i < sharded->shardCount; i++ ) {
+		ElementShard	*shard = &sharded->shards[ i ];
+
+		count += __atomic_load_n( &shard->localCount, __ATOMIC_RELAXED )
+			+ __atomic_load_n( &shard->overflowCount, __ATOMIC_RELAXED );
+	}
+	return( count );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstShardedElement(
+	void				**element,
+	ShardedElementList	*sharded )
+{
+	assertPtr( element );
+	assertPtr( sharded );
+
+	FirstElement( element, &sharded->shards[ 0 ].local );
+	if( *element == NULL )
+		NextShardedElement( NULL, element, sharded );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextShardedElement(
+	void				*element,
+	void				**nextElement,
+	ShardedElementList	*sharded )
+{
+	ElementShard	*shard;
+	ElementList		*list;
+
+	assertPtr( nextElement );
+	assertPtr( sharded );
+
+	//	element == NULL means "after the empty local list of shard 0".
+	if( element ) {
+		NextElement( element, nextElement );
+		if( *nextElement )
+			return;
+		list = GetElementList( element );
+	} else
+		list = &sharded->shards[ 0 ].local;
+
+	//	Walk local, overflow, local, overflow... until something turns up.
+	shard = ShardOfList( sharded, list );
+	for( ;; ) {
+		if( list == &shard->local )
+			list = &shard->overflow;
+		else if( ++shard < sharded->shards + sharded->shardCount )
+			list = &shard->local;
+		else {
+			*nextElement = NULL;
+			return;
+		}
+		FirstElement( nextElement, list );
+		if( *nextElement )
+			return;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Also takes localLock; detaches dead elements rather than
+								draining them.
+	agent		Mon, Oct 19, 2026	Takes only lock; owners must be quiescent.
+
+	************************************************************************************/
+
+	void
+DrainShardedElementList(
+	ShardedElementList	*sharded,
+	ElementList			*sink )
+{
+	unsigned	i;
+
+	assertPtr( sharded );
+	assertPtr( sink );
+
+	for( i = 0; i < sharded->shardCount; i++ ) {
+		ElementShard	*shard = &sharded->shards[ i ];
+
+		size_t	taken;
+
+		MoveElementRun( &shard->local, sink, (size_t) -1, false, &taken );
+		__atomic_store_n( &shard->localCount, 0, __ATOMIC_RELAXED );
+		LockShard( shard );
+		MoveElementRun( &shard->overflow, sink, (size_t) -1, false, &taken );
+		__atomic_store_n( &shard->overflowCount, 0, __ATOMIC_RELAXED );
+		UnlockShard( shard );
+	}
+}
+
+/****************************************************************************************
+*
+*	Offset Variants
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Offset Variants)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PushShardElementOff(
+	void				*element,
+	ShardedElementList	*sharded,
+	unsigned			shard,
+	size_t				offset )
+{
+	PushShardElement( (char*) element + offset, sharded, shard );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+PopShardElementOff(
+	void				**element,
+	ShardedElementList	*sharded,
+	unsigned			shard,
+	size_t				offset )
+{
+	PopShardElement( element, sharded, shard );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+FirstShardedElementOff(
+	void				**element,
+	ShardedElementList	*sharded,
+	size_t				offset )
+{
+	FirstShardedElement( element, sharded );
+	if( *element )
+		*element = (char*) *element - offset;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NextShardedElementOff(
+	void				*element,
+	void				**nextElement,
+	ShardedElementList	*sharded,
+	size_t				offset )
+{
+	NextShardedElement( (char*) element + offset, nextElement, sharded );
+	if( *nextElement )
+		*nextElement = (char*) *nextElement - offset;
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+	agent		Mon, Oct 19, 2026	Stamps the list's generation.
+	agent		Mon, Oct 19, 2026	Detaches elements marked dead rather than moving them,
+								and counts them in *taken but not toward count.
+	agent		Mon, Oct 19, 2026	Moves the run with SpliceElements(), which probes, traces
+								and leaves markers in from.
+
+	************************************************************************************/
+
+	static
+	size_t
+MoveElementRun(
+	ElementList	*from,
+	ElementList	*to,
+	size_t		count,
+	bool		fromLast,
+	size_t		*taken )
+{
+	void	*element;
+	void	*start = NULL;
+	void	*end = NULL;
+	Element	*hidden = fromLast ? from->last : from->first;
+	size_t	moved = 0;
+
+	*taken = 0;
+	if( count == 0 )
+		return( 0 );
+
+	//	Live elements from the near end. Dead ones between them are detached
+	//	on the way, so what is left is the run; cursors' markers are left be.
+	if( fromLast )
+		LastElement( &element, from );
+	else
+		FirstElement( &element, from );
+	for( ;; ) {
+		while( hidden != element ) {
+			Element	*next = fromLast ? hidden->prev : hidden->next;
+
+			if( IsElementDead( hidden ) ) {
+				RemoveElement( hidden, from );
+				++*taken;
+			}
+			hidden = next;
+		}
+		if( !element )
+			break;
+
+		++*taken;
+		if( !start )
+			start = element;
+		end = element;
+		if( ++moved == count )
+			break;
+		hidden = fromLast ? ((Element*) element)->prev : ((Element*) element)->next;
+		if( fromLast )
+			PrevElement( element, &element );
+		else
+			NextElement( element, &element );
+	}
+	if( end == NULL )
+		return( 0 );
+
+	if( fromLast )
+		SpliceElements( end, start, from, to, false );
+	else
+		SpliceElements( start, end, from, to, false );
+	return( moved );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+TryLockShard(
+	ElementShard	*shard )
+{
+	return( !__atomic_exchange_n( &shard->lock, 1, __ATOMIC_ACQUIRE ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+LockShard(
+	ElementShard	*shard )
+{
+	while( !TryLockShard( shard ) ) {
+		while( __atomic_load_n( &shard->lock, __ATOMIC_RELAXED ) )
+			;
+	}
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+UnlockShard(
+	ElementShard	*shard )
+{
+	__atomic_store_n( &shard->lock, 0, __ATOMIC_RELEASE );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+PublishShardElements(
+	ShardedElementList	*sharded,
+	ElementShard		*shard,
+	size_t				count )
+{
+	size_t	moved, taken;
+
+	//	Up to count from the cold back of local, at most a batch.
+	__atomic_store_n( &shard->hungry, 0, __ATOMIC_RELAXED );
+	if( count > sharded->batch )
+		count = sharded->batch;
+	if( count == 0 )
+		return;
+
+	LockShard( shard );
+	moved = MoveElementRun( &shard->local, &shard->overflow, count, true, &taken );
+	__atomic_store_n( &shard->overflowCount, shard->overflowCount + moved, __ATOMIC_RELAXED );
+	UnlockShard( shard );
+	__atomic_store_n( &shard->localCount, shard->localCount - taken, __ATOMIC_RELAXED );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Sun, Oct 18, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	ElementShard*
+ShardOfList(
+	ShardedElementList	*sharded,
+	ElementList			*list )
+{
+	size_t	index = (size_t) ((char*) list - (char*) sharded->shards) / sizeof( ElementShard );
+
+	assertTrue( index < sharded->shardCount );
+
+	return( &sharded->shards[ index ] );
+}
@@ -0,0 +1,216 @@
+/****************************************************************************************
+	elementalsharded.h
+
+	Unordered ElementLists sharded per thread, with batch stealing.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	For free lists and work sets that need no global order. Each thread owns
+	one ElementShard and pushes and pops on its `local` list with no locks and
+	no atomic read-modify-writes, but for moving a batch to or from overflow.
+	When local grows past twice the batch size, its coldest batch is spilled
+	to the shard's `overflow` list, which sits on its own cache line behind a
+	spinlock. A thread that runs dry refills a batch from its own overflow,
+	then steals a batch from other shards' overflows. When all of those are
+	empty, it raises the `hungry` flag of each shard holding more than one
+	element locally, and comes back empty; each of those owners sees its flag
+	with a plain load at its next push or pop and publishes up to half its
+	local list, at most a batch, to its overflow, where the next steal finds
+	it. An owner that neither pushes nor pops publishes nothing, so its local
+	list is reached only by draining.
+
+	Elements marked dead (see MarkElementDead()) while in a shard are skipped
+	by pops and detached, rather than moved, by spills, refills, steals and
+	drains. Until then they still count in CountShardedElements().
+
+	Global iteration and draining walk local lists no one else may touch, so
+	they require every shard's owner to be quiescent.
+
+	************************************************************************************/
+
+#ifndef		_elementalsharded_
+#define		_elementalsharded_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementShard		ElementShard;
+typedef	struct	ShardedElementList	ShardedElementList;
+
+struct	ElementShard	{
+	//	The owner's alone, but for thieves raising hungry.
+	ElementList	local;
+	size_t		localCount;
+	int			hungry;
+
+	//	Shared, guarded by lock.
+	ElementList	overflow __attribute__(( aligned( elementalCacheLine ) ));
+	size_t		overflowCount;
+	int			lock;
+} __attribute__(( aligned( elementalCacheLine ) ));
+
+struct	ShardedElementList	{
+	ElementShard	*shards;
+	unsigned		shardCount;
+	unsigned		nextShard;
+	size_t			batch;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	shards is caller-provided storage for shardCount shards. batch is how many
+//	elements move at once when spilling, refilling or stealing.
+	void
+NewShardedElementList(
+	ShardedElementList	*sharded,
+	ElementShard		*shards,
+	unsigned			shardCount,
+	size_t				batch );
+
+	void
+DeleteShardedElementList(
+	ShardedElementList	*sharded );
+
+//	Hands out shard indexes round-robin. Each thread calls this once and keeps
+//	the result. Local lists take no locks, so no two threads may share a
+//	shard: make at least as many shards as threads. Asserts that no more than
+//	shardCount indexes are handed out.
+	unsigned
+AcquireElementShard(
+	ShardedElementList	*sharded );
+
+/**************************
+*
+*	Shard Putters and Grabbers
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Shard Putters and Grabbers)
+
+//	Puts element on shard's local list. Contends with no one unless a batch
+//	spills, or a thief has asked for one, while a thief is stealing from this
+//	shard. Only shard's owner may call this.
+	void
+PushShardElement(
+	void				*element,
+	ShardedElementList	*sharded,
+	unsigned			shard );
+
+//	Grabs an element from shard's local list, refilling from its overflow or
+//	stealing from other shards when it runs dry. *element = NULL if shard and
+//	every other overflow are empty; other owners are then asked to publish
+//	some of their local lists for the next try. Only shard's owner may call this.
+	void
+PopShardElement(
+	void				**element,
+	ShardedElementList	*sharded,
+	unsigned			shard );
+
+//	Moves up to one batch from another shard's overflow list to shard's local
+//	list. If every overflow is empty, raises the hungry flag of each other
+//	shard holding more than one element locally. Returns the number of
+//	elements moved. Only shard's owner may call this.
+	size_t
+StealShardElements(
+	ShardedElementList	*sharded,
+	unsigned			shard );
+
+/**************************
+*
+*	Global Access
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Global Access)
+
+//	Counting reads one shard at a time without its locks, so with owners
+//	running it sees no single moment. Iterating and draining require every
+//	owner to be quiescent.
+
+//	Returns the number of elements across all shards.
+	size_t
+CountShardedElements(
+	ShardedElementList	*sharded );
+
+//	Iterates every element of every shard, in no particular order.
+	void
+FirstShardedElement(
+	void				**element,
+	ShardedElementList	*sharded );
+
+	void
+NextShardedElement(
+	void				*element,
+	void				**nextElement,
+	ShardedElementList	*sharded );
+
+//	Moves every element of every shard onto the end of sink.
+	void
+DrainShardedElementList(
+	ShardedElementList	*sharded,
+	ElementList			*sink );
+
+/**************************
+*
+*	Offset Variants
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Offset Variants)
+
+	void
+PushShardElementOff(
+	void				*element,
+	ShardedElementList	*sharded,
+	unsigned			shard,
+	size_t				offset );
+
+	void
+PopShardElementOff(
+	void				**element,
+	ShardedElementList	*sharded,
+	unsigned			shard,
+	size_t				offset );
+
+	void
+FirstShardedElementOff(
+	void				**element,
+	ShardedElementList	*sharded,
+	size_t				offset );
+
+	void
+NextShardedElementOff(
+	void				*element,
+	void				**nextElement,
+	ShardedElementList	*sharded,
+	size_t				offset );
+
+#define	PushShardElementType( ELEMENT, SHARDED, SHARD, STRUCTURE, FIELD )	\
+			PushShardElementOff( (ELEMENT), (SHARDED), (SHARD), offsetof( STRUCTURE, FIELD ) )
+
+#define	PopShardElementType( ELEMENT, SHARDED, SHARD, STRUCTURE, FIELD )	\
+			PopShardElementOff( (void**)(ELEMENT), (SHARDED), (SHARD), offsetof( STRUCTURE, FIELD ) )
+
+#define	FirstShardedElementType( ELEMENT, SHARDED, STRUCTURE, FIELD )	\
+			FirstShardedElementOff( (void**)(ELEMENT), (SHARDED), offsetof( STRUCTURE, FIELD ) )
+
+#define	NextShardedElementType( ELEMENT, NEXTELEMENT, SHARDED, STRUCTURE, FIELD )	\
+			NextShardedElementOff( (ELEMENT), (void**)(NEXTELEMENT), (SHARDED), offsetof( STRUCTURE, FIELD ) )
+
+__END_DECLS
+#endif	//	_elementalsharded_
@@ -0,0 +1,655 @@
+/****************************************************************************************
+	elementalspill.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A segment is a run of records, each a native-endian uint32_t length and
+	then that many encoded bytes. A batch is encoded into the scratch buffer
+	and written with one pwrite(); its elements are released only after the
+	write succeeds, and go back to the front of the tail if it fails.
+
+	Reading back pulls a chunk of at least elementalSpillReadSize bytes into
+	a buffer of its own, growing it for any record too big to fit, and
+	decodes only the batch asked for. The rest stays in the buffer for the
+	next read-back, which reads the file again only once it runs short, so
+	every byte is read once. Each read advises the kernel to fetch the
+	chunk after it, so the next one finds it in the page cache.
+
+	************************************************************************************/
+
+#ifndef	_POSIX_C_SOURCE
+	#define	_POSIX_C_SOURCE	200809L	//	pread(), mkstemp(), posix_fadvise()
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "elementalspill.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+//	A segment past this many bytes takes no more writes.
+#ifndef	elementalSpillSegmentSize
+	#define	elementalSpillSegmentSize	(64 * 1024 * 1024)
+#endif
+
+//	Least bytes read back, and read ahead, at once.
+#ifndef	elementalSpillReadSize
+	#define	elementalSpillReadSize		(256 * 1024)
+#endif
+
+#define	spillRecordHeader	sizeof( uint32_t )
+
+struct	SpillSegment	{
+	Element		element;
+	int			fd;
+	off_t		writeOffset;
+	off_t		readOffset;
+	size_t		count;			//	Records not yet read back.
+};
+
+	static
+	bool
+SpillTail(
+	SpillQueue	*queue );
+
+	static
+	bool
+ReadBackSpilled(
+	SpillQueue	*queue );
+
+	static
+	SpillSegment*
+NewSpillSegment(
+	SpillQueue	*queue );
+
+	static
+	void
+DeleteSpillSegment(
+	SpillSegment	*segment,
+	SpillQueue		*queue );
+
+	static
+	bool
+GrowSpillBuffer(
+	char	**buffer,
+	size_t	*bufferSize,
+	size_t	size );
+
+	static
+	bool
+WriteSpillBytes(
+	int			fd,
+	const char	*bytes,
+	size_t		length,
+	off_t		offset );
+
+	static
+	bool
+ReadSpillBytes(
+	int		fd,
+	char	*bytes,
+	size_t	length,
+	off_t	offset );
+
+/****************************************************************************************
+*
+*	Lifetime
+*
+****************************************************************************************/
+#pragma mark	(Lifetime)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+NewSpillQueue(
+	SpillQueue			*queue,
+	const char			*directory,
+	size_t				budget,
+	size_t				batch,
+	SpillEncodeProc		encodeProc,
+	SpillDecodeProc		decodeProc,
+	SpillReleaseProc	releaseProc,
+	void				*refCon )
+{
+	assertPtr( queue );
+	assertPtr( directory );
+	assertTrue( batch > 0 && batch < budget );
+	assertPtr( encodeProc );
+	assertPtr( decodeProc );
+
+	NewElementList( &queue->head );
+	NewElementList( &queue->tail );
+	NewElementList( &queue->segments );
+	queue->headCount = 0;
+	queue->tailCount = 0;
+	queue->spilledCount = 0;
+	queue->budget = budget;
+	queue->batch = batch;
+	queue->directory = directory;
+	queue->encodeProc = encodeProc;
+	queue->decodeProc = decodeProc;
+	queue->releaseProc = releaseProc;
+	queue->refCon = refCon;
+	queue->buffer = NULL;
+	queue->bufferSize = 0;
+	queue->readBuffer = NULL;
+	queue->readBufferSize = 0;
+	queue->readStart = queue->readEnd = 0;
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+DeleteSpillQueue(
+	SpillQueue	*queue )
+{
+	SpillSegment	*segment;
+
+	assertPtr( queue );
+	assertTrue( queue->headCount == 0 && queue->tailCount == 0 );
+
+	for( FirstElement( (void**) &segment, &queue->segments ); segment;
+		 FirstElement( (void**) &segment, &queue->segments ) )
+		DeleteSpillSegment( segment, queue );
+	queue->spilledCount = 0;
+
+	free( queue->buffer );
+	queue->buffer = NULL;
+	queue->bufferSize = 0;
+	free( queue->readBuffer );
+	queue->readBuffer = NULL;
+	queue->readBufferSize = 0;
+	queue->readStart = queue->readEnd = 0;
+
+	DeleteElementList( &queue->head );
+	DeleteElementList( &queue->tail );
+	DeleteElementList( &queue->segments );
+}
+
+/****************************************************************************************
+*
+*	Queue Putters
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Queue Putters)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+PutSpillElement(
+	void		*element,
+	SpillQueue	*queue )
+{
+	assertPtr( element );
+	assertPtr( queue );
+
+	PutLastElement( element, &queue->tail );
+	queue->tailCount++;
+
+	if( queue->headCount + queue->tailCount <= queue->budget )
+		return( true );
+	return( SpillTail( queue ) );
+}
+
+/****************************************************************************************
+*
+*	Queue Grabbers
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Queue Grabbers)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+GrabSpillElement(
+	void		**element,
+	SpillQueue	*queue )
+{
+	assertPtr( element );
+	assertPtr( queue );
+
+	*element = NULL;
+
+	//	Spilled elements come before the tail, so the head must be refilled
+	//	from them before the tail may be touched.
+	if( queue->headCount == 0 && queue->spilledCount ) {
+		if( !ReadBackSpilled( queue ) && queue->headCount == 0 )
+			return( false );
+	}
+
+	if( queue->headCount ) {
+		GrabFirstElement( element, &queue->head );
+		queue->headCount--;
+	} else if( queue->tailCount ) {
+		GrabFirstElement( element, &queue->tail );
+		queue->tailCount--;
+	}
+	return( true );
+}
+
+/****************************************************************************************
+*
+*	Queue Accessors
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Queue Accessors)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	size_t
+CountSpillElements(
+	SpillQueue	*queue )
+{
+	assertPtr( queue );
+
+	return( queue->headCount + queue->spilledCount + queue->tailCount );
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+SpillTail(
+	SpillQueue	*queue )
+{
+	SpillSegment	*segment;
+	ElementList		encoded;
+	void			*element;
+	size_t			length = 0;
+	size_t			count = 0;
+	int				error = 0;
+
+	//	With nothing spilled yet, the oldest batch is the next to be grabbed;
+	//	it moves to the head instead of making a round trip through the disk.
+	if( queue->spilledCount == 0 && queue->headCount == 0 ) {
+		while( queue->headCount < queue->batch && queue->tailCount > queue->batch ) {
+			GrabFirstElement( &element, &queue->tail );
+			PutLastElement( element, &queue->head );
+			queue->tailCount--;
+			queue->headCount++;
+		}
+	}
+
+	LastElement( (void**) &segment, &queue->segments );
+	if( !segment || segment->writeOffset >= elementalSpillSegmentSize ) {
+		segment = NewSpillSegment( queue );
+		if( !segment )
+			return( false );
+	}
+
+	NewElementList( &encoded );
+	while( count < queue->batch && !error ) {
+		GrabFirstElement( &element, &queue->tail );
+		if( !element )
+			break;
+
+		for( ;; ) {
+			size_t		room;
+			size_t		size;
+			uint32_t	header;
+
+			if( !GrowSpillBuffer( &queue->buffer, &queue->bufferSize, length + spillRecordHeader ) ) {
+				error = errno;
+				break;
+			}
+			room = queue->bufferSize - length - spillRecordHeader;
+			size = queue->encodeProc( element, queue->buffer + length + spillRecordHeader, room, queue->refCon );
+			if( size > UINT32_MAX ) {
+				error = EFBIG;
+				break;
+			}
+			if( size <= room ) {
+				header = (uint32_t) size;
+				memcpy( queue->buffer + length, &header, spillRecordHeader );
+				length += spillRecordHeader + size;
+				break;
+			}
+			if( !GrowSpillBuffer( &queue->buffer, &queue->bufferSize, length + spillRecordHeader + size ) ) {
+				error = errno;
+				break;
+			}
+		}
+
+		if( error )
+			PutFirstElement( element, &queue->tail );
+		else {
+			PutLastElement( element, &encoded );
+			count++;
+		}
+	}
+
+	if( !error && count && !WriteSpillBytes( segment->fd, queue->buffer, length, segment->writeOffset ) )
+		error = errno;
+
+	if( error ) {
+		//	Back to the front of the tail, in order.
+		for( GrabLastElement( &element, &encoded ); element; GrabLastElement( &element, &encoded ) )
+			PutFirstElement( element, &queue->tail );
+		DeleteElementList( &encoded );
+		errno = error;
+		return( false );
+	}
+
+	segment->writeOffset += (off_t) length;
+	segment->count += count;
+	queue->spilledCount += count;
+	queue->tailCount -= count;
+
+	for( GrabFirstElement( &element, &encoded ); element; GrabFirstElement( &element, &encoded ) )
+		if( queue->releaseProc )
+			queue->releaseProc( element, queue->refCon );
+	DeleteElementList( &encoded );
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+ReadBackSpilled(
+	SpillQueue	*queue )
+{
+	SpillSegment	*segment;
+	SpillSegment	*writing;
+	size_t			count = 0;
+
+	LastElement( (void**) &writing, &queue->segments );
+	FirstElement( (void**) &segment, &queue->segments );
+	while( count < queue->batch && segment ) {
+		size_t		carried = queue->readEnd - queue->readStart;
+		size_t		available;
+		size_t		want = elementalSpillReadSize;
+		size_t		chunk;
+		uint32_t	length = 0;
+
+		assertTrue( segment->count > 0 );
+
+		//	Whole records already read, which start at segment's readOffset.
+		while( count < queue->batch && carried >= spillRecordHeader ) {
+			void	*element;
+
+			memcpy( &length, queue->readBuffer + queue->readStart, spillRecordHeader );
+			if( spillRecordHeader + length > carried )
+				break;
+
+			element = queue->decodeProc( queue->readBuffer + queue->readStart + spillRecordHeader,
+				length, queue->refCon );
+			if( !element ) {
+				errno = ENOMEM;
+				return( false );
+			}
+			PutLastElement( element, &queue->head );
+			queue->headCount++;
+			queue->spilledCount--;
+			segment->count--;
+			count++;
+			queue->readStart += spillRecordHeader + length;
+			segment->readOffset += (off_t) (spillRecordHeader + length);
+			carried -= spillRecordHeader + length;
+		}
+
+		if( segment->count == 0 ) {
+			//	Drained. The segment still being written is emptied for reuse.
+			assertTrue( carried == 0 && segment->readOffset == segment->writeOffset );
+			queue->readStart = queue->readEnd = 0;
+			if( segment == writing ) {
+				if( ftruncate( segment->fd, 0 ) == 0 )
+					segment->writeOffset = segment->readOffset = 0;
+				break;
+			}
+			DeleteSpillSegment( segment, queue );
+			FirstElement( (void**) &segment, &queue->segments );
+			continue;
+		}
+		if( count == queue->batch )
+			break;
+
+		//	Short of a whole record: keep what's carried and read on after it.
+		if( carried >= spillRecordHeader && spillRecordHeader + length > want )
+			want = spillRecordHeader + length;
+		if( !GrowSpillBuffer( &queue->readBuffer, &queue->readBufferSize, want ) )
+			return( false );
+		memmove( queue->readBuffer, queue->readBuffer + queue->readStart, carried );
+		queue->readStart = 0;
+		queue->readEnd = carried;
+
+		available = (size_t) (segment->writeOffset - segment->readOffset) - carried;
+		chunk = queue->readBufferSize - carried;
+		if( chunk > available )
+			chunk = available;
+		assertTrue( chunk > 0 );
+		if( !ReadSpillBytes( segment->fd, queue->readBuffer + carried, chunk,
+				segment->readOffset + (off_t) carried ) )
+			return( false );
+		queue->readEnd += chunk;
+		if( chunk < available )
+			posix_fadvise( segment->fd, segment->readOffset + (off_t) queue->readEnd,
+				elementalSpillReadSize, POSIX_FADV_WILLNEED );
+	}
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	SpillSegment*
+NewSpillSegment(
+	SpillQueue	*queue )
+{
+	static	const char	name[] = "/elementalspill.XXXXXX";
+	size_t				directoryLength = strlen( queue->directory );
+	char				*path = (char*) malloc( directoryLength + sizeof( name ) );
+	SpillSegment		*segment = (SpillSegment*) calloc( 1, sizeof( SpillSegment ) );
+	int					error;
+
+	if( !path || !segment ) {
+		free( path );
+		free( segment );
+		errno = ENOMEM;
+		return( NULL );
+	}
+
+	memcpy( path, queue->directory, directoryLength );
+	memcpy( path + directoryLength, name, sizeof( name ) );
+	segment->fd = mkstemp( path );
+	if( segment->fd < 0 ) {
+		error = errno;
+		free( path );
+		free( segment );
+		errno = error;
+		return( NULL );
+	}
+	unlink( path );
+	free( path );
+
+	posix_fadvise( segment->fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+	PutLastElement( segment, &queue->segments );
+	return( segment );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void
+DeleteSpillSegment(
+	SpillSegment	*segment,
+	SpillQueue		*queue )
+{
+	queue->spilledCount -= segment->count;
+	RemoveElement( segment, &queue->segments );
+	close( segment->fd );
+	free( segment );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+GrowSpillBuffer(
+	char	**buffer,
+	size_t	*bufferSize,
+	size_t	size )
+{
+	size_t	newSize = *bufferSize ? *bufferSize : 4096;
+	char	*grown;
+
+	if( size <= *bufferSize )
+		return( true );
+
+	while( newSize < size )
+		newSize *= 2;
+	grown = (char*) realloc( *buffer, newSize );
+	if( !grown ) {
+		errno = ENOMEM;
+		return( false );
+	}
+	*buffer = grown;
+	*bufferSize = newSize;
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+WriteSpillBytes(
+	int			fd,
+	const char	*bytes,
+	size_t		length,
+	off_t		offset )
+{
+	while( length ) {
+		ssize_t	result = pwrite( fd, bytes, length, offset );
+
+		if( result < 0 ) {
+			if( errno == EINTR )
+				continue;
+			return( false );
+		}
+		bytes += result;
+		length -= (size_t) result;
+		offset += result;
+	}
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+ReadSpillBytes(
+	int		fd,
+	char	*bytes,
+	size_t	length,
+	off_t	offset )
+{
+	while( length ) {
+		ssize_t	result = pread( fd, bytes, length, offset );
+
+		if( result < 0 ) {
+			if( errno == EINTR )
+				continue;
+			return( false );
+		}
+		if( result == 0 ) {
+			errno = EIO;	//	Truncated behind our back.
+			return( false );
+		}
+		bytes += result;
+		length -= (size_t) result;
+		offset += result;
+	}
+	return( true );
+}
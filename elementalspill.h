@@ -0,0 +1,152 @@
+/****************************************************************************************
+	elementalspill.h
+
+	FIFO queues that spill to disk past a memory budget. POSIX only.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A SpillQueue keeps its oldest elements in a head ElementList and its
+	newest in a tail ElementList, both ordinary in-memory lists. Once more
+	than budget elements are in memory, the oldest batch of the tail is
+	encoded by the caller's encodeProc and appended to a segment file; the
+	queue's order is head, then the segments oldest first, then tail. When
+	the head drains, the next batch is decoded back in, with the kernel
+	asked to read ahead of it, so a burst far bigger than memory costs a
+	sequential write and a sequential read rather than the process.
+
+	Segment files are created in the given directory and unlinked at once,
+	so nothing is left behind by a crash. A segment whose elements have all
+	been read back is closed, or emptied and reused if it is still being
+	written. Elements must start with their Element.
+
+	************************************************************************************/
+
+#ifndef		_elementalspill_
+#define		_elementalspill_
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	SpillQueue		SpillQueue;
+typedef	struct	SpillSegment	SpillSegment;
+
+//	Encodes element into at most capacity bytes at buffer, returning how many
+//	it took. If it needs more, it returns how many, and is called again with
+//	at least that much room. Must not touch element's links.
+typedef	size_t	(*SpillEncodeProc)( void *element, void *buffer, size_t capacity, void *refCon );
+
+//	Returns a new element decoded from length bytes at buffer, or NULL if
+//	memory ran out.
+typedef	void*	(*SpillDecodeProc)( const void *buffer, size_t length, void *refCon );
+
+//	Disposes of element once its encoding is safely written.
+typedef	void	(*SpillReleaseProc)( void *element, void *refCon );
+
+struct	SpillQueue	{
+	ElementList			head;			//	Oldest, never spilled or read back.
+	ElementList			tail;			//	Newest.
+	ElementList			segments;		//	SpillSegments, oldest first.
+	size_t				headCount;
+	size_t				tailCount;
+	size_t				spilledCount;
+
+	size_t				budget;			//	Most elements to hold in memory.
+	size_t				batch;			//	Elements spilled or read back at once.
+	const char			*directory;
+	SpillEncodeProc		encodeProc;
+	SpillDecodeProc		decodeProc;
+	SpillReleaseProc	releaseProc;
+	void				*refCon;
+
+	char				*buffer;		//	Encoding scratch.
+	size_t				bufferSize;
+	char				*readBuffer;	//	Read back from the first segment.
+	size_t				readBufferSize;
+	size_t				readStart;		//	Not yet decoded: readStart up to readEnd.
+	size_t				readEnd;
+};
+
+/**************************
+*
+*	Lifetime
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Lifetime)
+
+//	directory, where segment files go, must outlive queue. batch should be
+//	well under budget.
+	void
+NewSpillQueue(
+	SpillQueue			*queue,
+	const char			*directory,
+	size_t				budget,
+	size_t				batch,
+	SpillEncodeProc		encodeProc,
+	SpillDecodeProc		decodeProc,
+	SpillReleaseProc	releaseProc,
+	void				*refCon );
+
+//	Elements still in memory must have been grabbed; spilled ones are
+//	discarded unread.
+	void
+DeleteSpillQueue(
+	SpillQueue	*queue );
+
+/**************************
+*
+*	Queue Putters
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Queue Putters)
+
+//	Puts element last, then spills a batch if memory is over budget. Returns
+//	false, with errno set, if spilling failed; element is queued regardless,
+//	and the queue is over budget until a later spill succeeds.
+	bool
+PutSpillElement(
+	void		*element,
+	SpillQueue	*queue );
+
+/**************************
+*
+*	Queue Grabbers
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Queue Grabbers)
+
+//	Grabs the first element, reading spilled ones back as needed, or
+//	*element = NULL if queue is empty. Returns false, with errno set and
+//	*element = NULL, if reading back failed; nothing is lost, so it may be
+//	tried again.
+	bool
+GrabSpillElement(
+	void		**element,
+	SpillQueue	*queue );
+
+/**************************
+*
+*	Queue Accessors
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Queue Accessors)
+
+//	Elements in memory and spilled.
+	size_t
+CountSpillElements(
+	SpillQueue	*queue );
+
+__END_DECLS
+#endif	//	_elementalspill_
@@ -0,0 +1,537 @@
+/****************************************************************************************
+	elementaltrace.c
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Stand-ins live in an ElementHashTable keyed by trace ID. A stand-in is a
+	TraceStandIn header followed by the zeroed object the proc sees; the IDs
+	are already well mixed, so they serve as their own hashes.
+
+	Cache misses are counted with perf_event_open() where Linux allows it.
+
+	************************************************************************************/
+
+#if	defined( __linux__ ) && !defined( _GNU_SOURCE )
+	#define	_GNU_SOURCE	//	syscall()
+#endif
+#ifndef	_POSIX_C_SOURCE
+	#define	_POSIX_C_SOURCE	200809L	//	clock_gettime()
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef	__linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+#endif
+
+#include "elementalhash.h"
+#include "elementaltrace.h"
+
+#ifndef elementalAssertions
+    #ifdef DEBUG
+        #define elementalAssertions DEBUG
+    #else
+        #define elementalAssertions 0
+    #endif
+#endif
+#if	elementalAssertions
+    #define assertTrue( CONDITION )           assert(CONDITION)
+    #define assertPtr(PTR)                    assert((PTR))
+#else
+    #define assertTrue( CONDITION )
+    #define assertPtr(PTR)
+#endif
+
+typedef	struct	TraceStandIn	TraceStandIn;
+typedef	struct	TraceStep		TraceStep;
+
+struct	TraceStandIn	{
+	Element		chain;
+	uint64_t	id;
+};
+
+struct	TraceStep	{
+	int		op;
+	void	*list;
+	void	*element;
+	void	*anchor;
+};
+
+//	Where a stand-in's object starts, keeping it as aligned as malloc()'s.
+#define	standInHeaderSize	((sizeof( TraceStandIn ) + 15) & ~(size_t) 15)
+#define	standInObject( STANDIN )	((void*) ((char*) (STANDIN) + standInHeaderSize))
+
+	static
+	size_t
+HashTraceStandIn(
+	void	*element,
+	void	*refCon );
+
+	static
+	bool
+MatchTraceStandIn(
+	void		*element,
+	const void	*key,
+	void		*refCon );
+
+	static
+	bool
+ReadElementTrace(
+	int					fd,
+	ElementTraceRecord	**records,
+	size_t				*count );
+
+	static
+	void*
+ResolveTraceID(
+	ElementHashTable	*standIns,
+	uint64_t			id,
+	size_t				size,
+	bool				*isNew );
+
+	static
+	bool
+RenameTraceStandIn(
+	ElementHashTable	*standIns,
+	uint64_t			id,
+	uint64_t			newID );
+
+	static
+	int
+OpenCacheMissCounter( void );
+
+	static
+	uint64_t
+TraceNow( void );
+
+/****************************************************************************************
+*
+*	Replay
+*
+****************************************************************************************/
+#pragma mark	(Replay)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	bool
+ReplayElementTrace(
+	int					fd,
+	ElementTraceProc	proc,
+	size_t				listSize,
+	size_t				elementSize,
+	void				*refCon,
+	ElementTraceStats	*stats )
+{
+	ElementHashTable	standIns;
+	ElementTraceRecord	*records = NULL;
+	TraceStep			*steps = NULL;
+	size_t				recordCount, stepCount = 0, index;
+	TraceStandIn		*standIn;
+	bool				succeeded = false;
+	int					counter;
+	uint64_t			start;
+
+	assertPtr( proc );
+	assertPtr( stats );
+
+	memset( stats, 0, sizeof( *stats ) );
+	stats->cacheMisses = UINT64_MAX;
+	if( !ReadElementTrace( fd, &records, &recordCount ) )
+		return( false );
+	if( !NewElementHashTableType( &standIns, 1024, TraceStandIn, chain, HashTraceStandIn, MatchTraceStandIn, NULL ) ) {
+		free( records );
+		return( false );
+	}
+
+	//	Each record yields a step, plus one per list it introduces; sinks can
+	//	introduce a second.
+	steps = (TraceStep*) malloc( (recordCount * 3 + 1) * sizeof( TraceStep ) );
+	if( steps == NULL )
+		goto done;
+
+	for( index = 0; index < recordCount; index++ ) {
+		ElementTraceRecord	*record = &records[ index ];
+		TraceStep			*step;
+		bool				isNew;
+		void				*list, *element, *anchor = NULL;
+
+		if( record->op == elementTraceRelocate ) {
+			if( !RenameTraceStandIn( &standIns, record->element, record->anchor ) )
+				goto done;
+			continue;
+		}
+		if( record->op > elementTraceClear || record->list == 0
+				|| (record->element == 0) != (record->op == elementTraceClear) ) {
+			errno = EINVAL;
+			goto done;
+		}
+
+		if( (list = ResolveTraceID( &standIns, record->list, listSize, &isNew )) == NULL )
+			goto done;
+		if( isNew ) {
+			steps[ stepCount ].op = elementTraceNewList;
+			steps[ stepCount ].list = list;
+			steps[ stepCount ].element = steps[ stepCount ].anchor = NULL;
+			stepCount++;
+			stats->lists++;
+		}
+		if( record->op == elementTraceClear )
+			element = NULL;
+		else if( (element = ResolveTraceID( &standIns, record->element, elementSize, &isNew )) == NULL )
+			goto done;
+		else if( isNew )
+			stats->elements++;
+
+		if( record->anchor && record->op == elementTraceSweep ) {
+			if( (anchor = ResolveTraceID( &standIns, record->anchor, listSize, &isNew )) == NULL )
+				goto done;
+			if( isNew ) {
+				steps[ stepCount ].op = elementTraceNewList;
+				steps[ stepCount ].list = anchor;
+				steps[ stepCount ].element = steps[ stepCount ].anchor = NULL;
+				stepCount++;
+				stats->lists++;
+			}
+		} else if( record->anchor ) {
+			if( (anchor = ResolveTraceID( &standIns, record->anchor, elementSize, &isNew )) == NULL )
+				goto done;
+			if( isNew )
+				stats->elements++;
+		}
+
+		step = &steps[ stepCount++ ];
+		step->op = (int) record->op;
+		step->list = list;
+		step->element = element;
+		step->anchor = anchor;
+	}
+	free( records );
+	records = NULL;
+
+	//	Only this loop is measured.
+	counter = OpenCacheMissCounter();
+	start = TraceNow();
+	for( index = 0; index < stepCount; index++ )
+		proc( steps[ index ].op, steps[ index ].list, steps[ index ].element, steps[ index ].anchor, refCon );
+	stats->nanoseconds = TraceNow() - start;
+	stats->operations = stepCount;
+#ifdef	__linux__
+	if( counter >= 0 ) {
+		uint64_t	misses;
+
+		ioctl( counter, PERF_EVENT_IOC_DISABLE, 0 );
+		if( read( counter, &misses, sizeof( misses ) ) == sizeof( misses ) )
+			stats->cacheMisses = misses;
+		close( counter );
+	}
+#endif
+	succeeded = true;
+
+done:
+	for( FirstHashElementType( &standIn, &standIns ); standIn; FirstHashElementType( &standIn, &standIns ) ) {
+		RemoveHashElement( standIn, &standIns );
+		free( standIn );
+	}
+	DeleteElementHashTable( &standIns );
+	free( steps );
+	free( records );
+	return( succeeded );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	void
+ElementTraceCoreProc(
+	int		op,
+	void	*list,
+	void	*element,
+	void	*anchor,
+	void	*refCon )
+{
+	ElementList	*list_ = (ElementList*) list;
+	Element		*element_ = (Element*) element;
+	void		*grabbed;
+
+	(void) refCon;
+
+	if( op == elementTraceNewList ) {
+		NewElementList( list_ );
+		return;
+	}
+	if( op == elementTraceClear ) {
+		ClearElementList( list_ );
+		return;
+	}
+
+	if( op <= elementTracePutAfter ) {
+		ElementList	*current = GetElementList( element_ );
+
+		if( current )
+			RemoveElement( element_, current );
+		if( anchor && GetElementList( anchor ) != list_ )
+			anchor = NULL;
+	} else if( GetElementList( element_ ) != list_ )
+		return;
+
+	switch( op ) {
+		case elementTracePutFirst:
+			PutFirstElement( element_, list_ );
+			break;
+		case elementTracePutLast:
+			PutLastElement( element_, list_ );
+			break;
+		case elementTracePutBefore:
+			PutBeforeElement( element_, anchor, list_ );
+			break;
+		case elementTracePutAfter:
+			PutAfterElement( element_, anchor, list_ );
+			break;
+		case elementTraceGrabFirst:
+			if( list_->first == element_ )
+				GrabFirstElement( &grabbed, list_ );
+			else
+				RemoveElement( element_, list_ );
+			break;
+		case elementTraceGrabLast:
+			if( list_->last == element_ )
+				GrabLastElement( &grabbed, list_ );
+			else
+				RemoveElement( element_, list_ );
+			break;
+		case elementTraceGrabNext:
+			GrabNextElement( element_, &grabbed, list_ );
+			break;
+		case elementTraceGrabPrev:
+			GrabPrevElement( element_, &grabbed, list_ );
+			break;
+		case elementTraceSweep:
+			RemoveElement( element_, list_ );
+			if( anchor )
+				PutLastElement( element_, (ElementList*) anchor );
+			break;
+		default:
+			RemoveElement( element_, list_ );
+			break;
+	}
+}
+
+/****************************************************************************************
+*
+*	Implementation
+*
+****************************************************************************************/
+#pragma mark	-
+#pragma mark	(Private)
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	size_t
+HashTraceStandIn(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	return( (size_t) ((TraceStandIn*) element)->id );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+MatchTraceStandIn(
+	void		*element,
+	const void	*key,
+	void		*refCon )
+{
+	(void) refCon;
+	return( ((TraceStandIn*) element)->id == *(const uint64_t*) key );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+ReadElementTrace(
+	int					fd,
+	ElementTraceRecord	**records,
+	size_t				*count )
+{
+	char	*buffer = NULL;
+	size_t	length = 0, capacity = 0;
+
+	for(;;) {
+		ssize_t	got;
+
+		if( length == capacity ) {
+			size_t	newCapacity = capacity ? capacity * 2 : 64 * sizeof( ElementTraceRecord );
+			char	*newBuffer = (char*) realloc( buffer, newCapacity );
+
+			if( newBuffer == NULL ) {
+				free( buffer );
+				return( false );
+			}
+			buffer = newBuffer;
+			capacity = newCapacity;
+		}
+
+		got = read( fd, buffer + length, capacity - length );
+		if( got < 0 && errno == EINTR )
+			continue;
+		if( got < 0 ) {
+			free( buffer );
+			return( false );
+		}
+		if( got == 0 )
+			break;
+		length += (size_t) got;
+	}
+
+	*records = (ElementTraceRecord*) buffer;
+	*count = length / sizeof( ElementTraceRecord );
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	void*
+ResolveTraceID(
+	ElementHashTable	*standIns,
+	uint64_t			id,
+	size_t				size,
+	bool				*isNew )
+{
+	TraceStandIn	*standIn;
+
+	FindHashElementType( &standIn, standIns, (size_t) id, &id );
+	*isNew = standIn == NULL;
+	if( standIn == NULL ) {
+		standIn = (TraceStandIn*) calloc( 1, standInHeaderSize + size );
+		if( standIn == NULL )
+			return( NULL );
+		standIn->id = id;
+		PutHashElement( standIn, standIns );
+	}
+	return( standInObject( standIn ) );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	bool
+RenameTraceStandIn(
+	ElementHashTable	*standIns,
+	uint64_t			id,
+	uint64_t			newID )
+{
+	TraceStandIn	*standIn;
+
+	if( newID == 0 ) {
+		errno = EINVAL;
+		return( false );
+	}
+
+	//	A move of something never seen needs no stand-in yet.
+	FindHashElementType( &standIn, standIns, (size_t) id, &id );
+	if( standIn ) {
+		RemoveHashElement( standIn, standIns );
+		standIn->id = newID;
+		PutHashElement( standIn, standIns );
+	}
+	return( true );
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	int
+OpenCacheMissCounter( void )
+{
+#ifdef	__linux__
+	struct perf_event_attr	attr;
+	int						counter;
+
+	memset( &attr, 0, sizeof( attr ) );
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof( attr );
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	//	This thread only, on any CPU.
+	counter = (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+	if( counter >= 0 && ioctl( counter, PERF_EVENT_IOC_ENABLE, 0 ) != 0 ) {
+		close( counter );
+		counter = -1;
+	}
+	return( counter );
+#else
+	return( -1 );
+#endif
+}
+
+/****************************************************************************************
+	Commenter	Date				Comment
+	---------	-----------------	-----------------------------------------------------
+	agent		Mon, Oct 19, 2026	Created.
+
+	************************************************************************************/
+
+	static
+	uint64_t
+TraceNow( void )
+{
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return( (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec );
+}
@@ -0,0 +1,88 @@
+/****************************************************************************************
+	elementaltrace.h
+
+	Replays traces recorded by StartElementTrace() against any list variant.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Build elemental.c with elementalTrace, wrap a real workload in
+	StartElementTrace() and StopElementTrace(), and the resulting file
+	captures that workload's puts and unlinks: which list, which element,
+	where, in order. ReplayElementTrace() then reruns those operations
+	against this build, or against another list implementation through an
+	ElementTraceProc, and reports how long they took. bench/elementalreplay
+	does both from the command line.
+
+	Replay happens in two phases. The first reads the whole trace and turns
+	every ID into a zeroed stand-in object, allocated in order of first
+	appearance, so the second, timed phase does nothing but call the proc.
+
+	************************************************************************************/
+
+#ifndef		_elementaltrace_
+#define		_elementaltrace_
+
+#include <stdint.h>
+
+#include "elemental.h"
+
+__BEGIN_DECLS
+
+/**************************
+*
+*	Types
+*
+**************************/
+#pragma mark	(Types)
+
+typedef	struct	ElementTraceStats	ElementTraceStats;
+
+//	Performs one traced operation on stand-ins: list and the sink of
+//	elementTraceSweep are list stand-ins, element and the anchor of the putters
+//	are element stand-ins, and unused arguments are NULL. Every list is first
+//	passed alone with elementTraceNewList. elementTraceRelocate never reaches
+//	a proc: the replayer just renames the element's stand-in.
+typedef	void	(*ElementTraceProc)( int op, void *list, void *element, void *anchor, void *refCon );
+
+struct	ElementTraceStats	{
+	uint64_t	operations;		//	Proc calls timed, including elementTraceNewList.
+	uint64_t	nanoseconds;	//	Wall-clock time spent in them.
+	uint64_t	cacheMisses;	//	Hardware count, or UINT64_MAX if unavailable.
+	size_t		lists;
+	size_t		elements;
+};
+
+/**************************
+*
+*	Replay
+*
+**************************/
+#pragma mark	-
+#pragma mark	(Replay)
+
+//	Reads a trace from fd to its end and replays it through proc, handing it
+//	stand-ins of listSize and elementSize bytes. A torn final record is
+//	ignored. Returns false, with errno set, if reading or allocation failed.
+	bool
+ReplayElementTrace(
+	int					fd,
+	ElementTraceProc	proc,
+	size_t				listSize,
+	size_t				elementSize,
+	void				*refCon,
+	ElementTraceStats	*stats );
+
+//	The proc for plain ElementLists: pass sizeof( ElementList ) and
+//	sizeof( Element ). Steps a mid-run trace makes impossible, such as
+//	removing an element put before tracing began, are skipped.
+	void
+ElementTraceCoreProc(
+	int		op,
+	void	*list,
+	void	*element,
+	void	*anchor,
+	void	*refCon );
+
+__END_DECLS
+#endif	//	_elementaltrace_
@@ -0,0 +1,235 @@
+/****************************************************************************************
+	elementalarenatest.c
+
+	Tests of ElementArenas.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random allocations of every size class, freed in random order, fill
+	each block with a pattern that must survive until it is freed, so no two
+	blocks may overlap, and each must be aligned and hold what was asked.
+	Free bytes and the blocks' sizes must always add up to the whole arena,
+	the bitmap must mark exactly the non-empty bins, and the largest block
+	the arena offers must be allocatable. Once everything is freed, the
+	arena must have coalesced back into one chunk. Arenas too small to use,
+	at odd addresses, and requests too big for any chunk return NULL.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "elementalarena.h"
+#include "elementaltest.h"
+
+#define	kArenaSize		(4 * 1024 * 1024)
+#define	kBlocks			2000
+#define	kOperations		200000
+
+typedef	struct	Block	Block;
+
+struct	Block	{
+	unsigned char	*bytes;
+	size_t			size;
+};
+
+static	Block	gBlocks[ kBlocks ];
+
+	static
+	size_t
+RandomSize(
+	uint64_t	*random );
+
+	static
+	void
+Fill(
+	Block		*block,
+	unsigned	index );
+
+	static
+	void
+CheckFill(
+	Block		*block,
+	unsigned	index );
+
+	static
+	void
+CheckArena(
+	ElementArena	*arena,
+	size_t			total );
+
+	int
+main( void )
+{
+	ElementArena	arena;
+	char			*memory = (char*) malloc( kArenaSize + 64 );
+	uint64_t		random = 53;
+	size_t			total;
+	long			operation;
+	unsigned		index;
+	void			*block;
+
+	check( memory != NULL );
+
+	//	Too small, and at an odd address.
+	NewElementArena( &arena, memory + 3, 40 );
+	check( CountArenaFreeBytes( &arena ) == 0 && LargestArenaBlock( &arena ) == 0 );
+	AllocateArenaBlock( &block, &arena, 1 );
+	check( block == NULL );
+	DeleteElementArena( &arena );
+
+	NewElementArena( &arena, memory + 5, kArenaSize );
+	total = CountArenaFreeBytes( &arena );
+	check( total > kArenaSize - 64 && total <= kArenaSize );
+	check( LargestArenaBlock( &arena ) + sizeof( size_t ) == total );
+	AllocateArenaBlock( &block, &arena, kArenaSize );
+	check( block == NULL );
+	AllocateArenaBlock( &block, &arena, (size_t) -1 );
+	check( block == NULL );
+	FreeArenaBlock( NULL, &arena );
+
+	//	The whole arena as one block, and back.
+	AllocateArenaBlock( &block, &arena, LargestArenaBlock( &arena ) );
+	check( block != NULL && CountArenaFreeBytes( &arena ) == 0 && LargestArenaBlock( &arena ) == 0 );
+	FreeArenaBlock( block, &arena );
+	check( CountArenaFreeBytes( &arena ) == total );
+
+	for( operation = 0; operation < kOperations; operation++ ) {
+		index = (unsigned) (TestRandom( &random ) % kBlocks);
+		if( gBlocks[ index ].bytes ) {
+			CheckFill( &gBlocks[ index ], index );
+			FreeArenaBlock( gBlocks[ index ].bytes, &arena );
+			gBlocks[ index ].bytes = NULL;
+		} else {
+			size_t	size = RandomSize( &random );
+
+			AllocateArenaBlock( &block, &arena, size );
+			if( !block ) {
+				check( size > LargestArenaBlock( &arena ) );
+				continue;
+			}
+			check( (uintptr_t) block % 16 == 0 );
+			check( GetArenaBlockSize( block ) >= size );
+			gBlocks[ index ].bytes = (unsigned char*) block;
+			gBlocks[ index ].size = size;
+			Fill( &gBlocks[ index ], index );
+		}
+		if( operation % 64 == 0 )
+			CheckArena( &arena, total );
+	}
+	CheckArena( &arena, total );
+
+	//	Whatever is largest can be had.
+	{
+		size_t	largest = LargestArenaBlock( &arena );
+
+		if( largest ) {
+			size_t	freeBytes = CountArenaFreeBytes( &arena );
+
+			AllocateArenaBlock( &block, &arena, largest );
+			check( block != NULL && GetArenaBlockSize( block ) == largest );
+			check( CountArenaFreeBytes( &arena ) == freeBytes - largest - sizeof( size_t ) );
+			FreeArenaBlock( block, &arena );
+			check( CountArenaFreeBytes( &arena ) == freeBytes );
+		}
+	}
+
+	//	Freeing every other block, then the rest, coalesces it all.
+	for( index = 0; index < kBlocks; index += 2 )
+		if( gBlocks[ index ].bytes ) {
+			CheckFill( &gBlocks[ index ], index );
+			FreeArenaBlock( gBlocks[ index ].bytes, &arena );
+			gBlocks[ index ].bytes = NULL;
+		}
+	CheckArena( &arena, total );
+	for( index = 1; index < kBlocks; index += 2 )
+		if( gBlocks[ index ].bytes ) {
+			CheckFill( &gBlocks[ index ], index );
+			FreeArenaBlock( gBlocks[ index ].bytes, &arena );
+			gBlocks[ index ].bytes = NULL;
+		}
+	check( CountArenaFreeBytes( &arena ) == total );
+	check( LargestArenaBlock( &arena ) + sizeof( size_t ) == total );
+	CheckArena( &arena, total );
+
+	//	Small blocks packed end to end, freed from both ends toward the middle.
+	for( index = 0; index < kBlocks; index++ ) {
+		AllocateArenaBlock( &block, &arena, 24 );
+		check( block != NULL );
+		gBlocks[ index ].bytes = (unsigned char*) block;
+		gBlocks[ index ].size = 24;
+		Fill( &gBlocks[ index ], index );
+	}
+	for( index = 0; index < kBlocks / 2; index++ ) {
+		CheckFill( &gBlocks[ index ], index );
+		FreeArenaBlock( gBlocks[ index ].bytes, &arena );
+		CheckFill( &gBlocks[ kBlocks - 1 - index ], kBlocks - 1 - index );
+		FreeArenaBlock( gBlocks[ kBlocks - 1 - index ].bytes, &arena );
+		gBlocks[ index ].bytes = gBlocks[ kBlocks - 1 - index ].bytes = NULL;
+	}
+	check( LargestArenaBlock( &arena ) + sizeof( size_t ) == total );
+	CheckArena( &arena, total );
+
+	DeleteElementArena( &arena );
+	free( memory );
+
+	return( 0 );
+}
+
+//	Mostly small, some in each large class, a few big.
+	static
+	size_t
+RandomSize(
+	uint64_t	*random )
+{
+	unsigned	kind = (unsigned) (TestRandom( random ) % 100);
+
+	if( kind < 60 )
+		return( (size_t) (TestRandom( random ) % 256) );
+	if( kind < 90 )
+		return( (size_t) (TestRandom( random ) % 4096) );
+	if( kind < 99 )
+		return( (size_t) (TestRandom( random ) % 65536) );
+	return( (size_t) (TestRandom( random ) % (512 * 1024)) );
+}
+
+	static
+	void
+Fill(
+	Block		*block,
+	unsigned	index )
+{
+	memset( block->bytes, (int) (index % 251), block->size );
+}
+
+	static
+	void
+CheckFill(
+	Block		*block,
+	unsigned	index )
+{
+	size_t	at;
+
+	for( at = 0; at < block->size; at++ )
+		check( block->bytes[ at ] == index % 251 );
+}
+
+	static
+	void
+CheckArena(
+	ElementArena	*arena,
+	size_t			total )
+{
+	size_t		used = 0;
+	unsigned	index;
+	unsigned	bin;
+
+	for( index = 0; index < kBlocks; index++ )
+		if( gBlocks[ index ].bytes )
+			used += GetArenaBlockSize( gBlocks[ index ].bytes ) + sizeof( size_t );
+	check( used + CountArenaFreeBytes( arena ) == total );
+
+	for( bin = 0; bin < elementalArenaBins; bin++ )
+		check( !((arena->bitmap[ bin / 64 ] >> (bin % 64)) & 1) == IsListEmpty( &arena->bins[ bin ] ) );
+}
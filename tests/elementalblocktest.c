@@ -0,0 +1,121 @@
+/****************************************************************************************
+	elementalblocktest.c
+
+	Tests of BlockElementList against a plain array model, under random puts,
+	grabs and cursor removals that split and merge blocks.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elementalblock.h"
+#include "elementaltest.h"
+
+#define	kMost		4000
+#define	kSteps		200000
+
+static	long	gModel[ kMost ];
+static	int		gCount;
+
+	static
+	void
+CheckList(
+	BlockElementList	*list );
+
+	int
+main( void )
+{
+	BlockElementList	list;
+	ElementBlock		*block;
+	uint64_t			state = 1;
+	long				next = 1;
+	int					step;
+
+	NewBlockElementList( &list );
+	check( sizeof( ElementBlock ) == elementalCacheLine );
+	CheckList( &list );
+
+	for( step = 0; step < kSteps; step++ ) {
+		int		op = (int) (TestRandom( &state ) % 9);
+		void	*element;
+
+		//	Puts are likelier than the rest, so the list grows to many blocks.
+		if( op >= 6 )
+			op = (int) (TestRandom( &state ) % 2);
+		if( op == 0 && gCount < kMost ) {
+			memmove( gModel + 1, gModel, (size_t) gCount * sizeof( long ) );
+			gModel[ 0 ] = next;
+			gCount++;
+			check( PutFirstBlockElement( (void*) next++, &list ) );
+		} else if( op == 1 && gCount < kMost ) {
+			gModel[ gCount++ ] = next;
+			check( PutLastBlockElement( (void*) next++, &list ) );
+		} else if( op == 2 ) {
+			GrabFirstBlockElement( &element, &list );
+			if( gCount ) {
+				check( (long) element == gModel[ 0 ] );
+				memmove( gModel, gModel + 1, (size_t) --gCount * sizeof( long ) );
+			} else
+				check( element == NULL );
+		} else if( op == 3 ) {
+			GrabLastBlockElement( &element, &list );
+			if( gCount )
+				check( (long) element == gModel[ --gCount ] );
+			else
+				check( element == NULL );
+		} else if( gCount ) {
+			//	Removes a short run from a random position through a cursor.
+			BlockElementCursor	cursor;
+			int					at = (int) (TestRandom( &state ) % (uint64_t) gCount);
+			int					run = (int) (TestRandom( &state ) % 3);
+			int					index;
+
+			FirstBlockElement( &element, &list, &cursor );
+			for( index = 0; index < at; index++ )
+				NextBlockElement( &element, &cursor );
+			while( run-- && element ) {
+				check( (long) element == gModel[ at ] );
+				memmove( gModel + at, gModel + at + 1, (size_t) (gCount - at - 1) * sizeof( long ) );
+				gCount--;
+				RemoveBlockElement( &element, &list, &cursor );
+				check( at < gCount ? (long) element == gModel[ at ] : element == NULL );
+			}
+		}
+		if( step % 97 == 0 )
+			CheckList( &list );
+	}
+	CheckList( &list );
+
+	//	Emptied blocks are freed, never left in the chain.
+	for( block = list.first; block; block = block->next ) {
+		check( block->count > 0 && block->start + block->count <= elementalBlockSlots );
+		gCount -= block->count;
+	}
+	check( gCount == 0 );
+
+	DeleteBlockElementList( &list );
+	return( 0 );
+}
+
+	static
+	void
+CheckList(
+	BlockElementList	*list )
+{
+	BlockElementCursor	cursor;
+	void				*element;
+	int					index = 0;
+
+	for( FirstBlockElement( &element, list, &cursor ); element; NextBlockElement( &element, &cursor ) ) {
+		check( index < gCount && (long) element == gModel[ index ] );
+		index++;
+	}
+	check( index == gCount && CountBlockElements( list ) == (size_t) gCount );
+
+	for( LastBlockElement( &element, list, &cursor ); element; PrevBlockElement( &element, &cursor ) )
+		check( (long) element == gModel[ --index ] );
+	check( index == 0 );
+}
@@ -0,0 +1,185 @@
+/****************************************************************************************
+	elementalbuffertest.c
+
+	Tests of BufferChains and BufferPools, over a socketpair.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A chain of thousands of descriptors, some empty, behind a prepended
+	header, is flushed into a small socket buffer drained by odd amounts, so
+	nearly every writev() is short. The bytes must arrive whole and in
+	order, and each descriptor must be released exactly once, out of the
+	chain, with its bytes still described. The pool must hold no more than
+	its cap. A discarded chain releases everything unsent, and a flush to a
+	closed peer fails with EPIPE.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "elementalbuffer.h"
+#include "elementaltest.h"
+
+#define	kBuffers	3000
+#define	kPieceSize	97
+
+static	char		gPieces[ kBuffers ][ kPieceSize ];
+static	int			gReleases[ kBuffers + 1 ];
+static	BufferChain	*gChain;
+
+	static
+	void
+CountRelease(
+	ElementBuffer	*buffer,
+	void			*refCon );
+
+	static
+	void
+FillChain(
+	BufferChain	*chain,
+	BufferPool	*pool,
+	char		*expected,
+	size_t		*length );
+
+	int
+main( void )
+{
+	BufferChain	chain;
+	BufferPool	pool;
+	char		*expected = (char*) malloc( kBuffers * kPieceSize + 16 );
+	char		*received = (char*) malloc( kBuffers * kPieceSize + 16 );
+	size_t		length;
+	size_t		got = 0;
+	uint64_t	random = 7;
+	int			sockets[ 2 ];
+	int			size = 4096;
+	int			index;
+
+	for( index = 0; index < kBuffers; index++ )
+		memset( gPieces[ index ], 'a' + index % 26, kPieceSize );
+	signal( SIGPIPE, SIG_IGN );
+	check( socketpair( AF_UNIX, SOCK_STREAM, 0, sockets ) == 0 );
+	check( setsockopt( sockets[ 0 ], SOL_SOCKET, SO_SNDBUF, &size, sizeof( size ) ) == 0 );
+	check( fcntl( sockets[ 0 ], F_SETFL, O_NONBLOCK ) == 0 );
+	check( fcntl( sockets[ 1 ], F_SETFL, O_NONBLOCK ) == 0 );
+
+	NewBufferPool( &pool, CountRelease, NULL );
+	NewBufferChain( &chain );
+	gChain = &chain;
+
+	//	Flushed through short writes.
+	FillChain( &chain, &pool, expected, &length );
+	check( CountChainBytes( &chain ) == length );
+	while( CountChainBytes( &chain ) ) {
+		size_t	before = CountChainBytes( &chain );
+		ssize_t	read_;
+
+		check( FlushBufferChain( &chain, sockets[ 0 ], &pool ) );
+		read_ = read( sockets[ 1 ], received + got, (size_t) (TestRandom( &random ) % 5000) + 1 );
+		if( read_ > 0 )
+			got += (size_t) read_;
+		check( CountChainBytes( &chain ) <= before );
+	}
+	check( FlushBufferChain( &chain, sockets[ 0 ], &pool ) );
+	check( IsListEmpty( &chain.buffers ) );
+	for( ssize_t read_; (read_ = read( sockets[ 1 ], received + got, 65536 )) > 0; )
+		got += (size_t) read_;
+	check( got == length && memcmp( received, expected, length ) == 0 );
+	for( index = 0; index <= kBuffers; index++ )
+		check( gReleases[ index ] == 1 );
+	check( pool.spareCount == 1024 );
+
+	//	Discarded unsent, reusing the spares.
+	memset( gReleases, 0, sizeof( gReleases ) );
+	FillChain( &chain, &pool, expected, &length );
+	DiscardBufferChain( &chain, &pool );
+	check( IsListEmpty( &chain.buffers ) && CountChainBytes( &chain ) == 0 );
+	for( index = 0; index <= kBuffers; index++ )
+		check( gReleases[ index ] == 1 );
+	check( pool.spareCount == 1024 );
+	{
+		void	*spare;
+		size_t	spares = 0;
+
+		for( FirstElement( &spare, &pool.spares ); spare; NextElement( spare, &spare ) )
+			spares++;
+		check( spares == pool.spareCount );
+	}
+
+	//	A single release, and a peer that's gone.
+	{
+		ElementBuffer	*buffer;
+
+		GrabPoolBuffer( &buffer, &pool );
+		check( buffer && pool.spareCount == 1023 );
+		buffer->refCon = (void*) (uintptr_t) 0;
+		gReleases[ 0 ] = 0;
+		AppendChainBuffer( buffer, &chain, "gone", 4 );
+		close( sockets[ 1 ] );
+		check( !FlushBufferChain( &chain, sockets[ 0 ], &pool ) && errno == EPIPE );
+		check( CountChainBytes( &chain ) == 4 );
+		RemoveElement( buffer, &chain.buffers );
+		chain.length = 0;
+		ReleasePoolBuffer( buffer, &pool );
+		check( gReleases[ 0 ] == 1 && pool.spareCount == 1024 );
+	}
+
+	close( sockets[ 0 ] );
+	DeleteBufferChain( &chain );
+	DeleteBufferPool( &pool );
+	check( pool.spareCount == 0 );
+	free( expected );
+	free( received );
+
+	return( 0 );
+}
+
+	static
+	void
+CountRelease(
+	ElementBuffer	*buffer,
+	void			*refCon )
+{
+	(void) refCon;
+	check( GetElementList( buffer ) != &gChain->buffers );
+	check( buffer->bytes != NULL || buffer->length == 0 );
+	gReleases[ (uintptr_t) buffer->refCon ]++;
+}
+
+	static
+	void
+FillChain(
+	BufferChain	*chain,
+	BufferPool	*pool,
+	char		*expected,
+	size_t		*length )
+{
+	ElementBuffer	*buffer;
+	int				index;
+
+	*length = 4;
+	memcpy( expected, "HDR:", 4 );
+	for( index = 0; index < kBuffers; index++ ) {
+		size_t	pieceLength = index % 5 ? kPieceSize : 0;
+
+		GrabPoolBuffer( &buffer, pool );
+		check( buffer != NULL );
+		AppendChainBuffer( buffer, chain, gPieces[ index ], pieceLength );
+		buffer->refCon = (void*) (uintptr_t) (index + 1);
+		memcpy( expected + *length, gPieces[ index ], pieceLength );
+		*length += pieceLength;
+	}
+
+	//	The header, known last, goes first.
+	GrabPoolBuffer( &buffer, pool );
+	check( buffer != NULL );
+	PrependChainBuffer( buffer, chain, "HDR:", 4 );
+	buffer->refCon = (void*) (uintptr_t) 0;
+}
@@ -0,0 +1,226 @@
+/****************************************************************************************
+	elementalchanneltest.c
+
+	Tests of ElementChannels: handoff, backpressure, deadlines and closing.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Producers put a known series, singly and in batches, through a small
+	channel to consumers that grab singly and in batches; every value must
+	come out exactly once, however the wakeups fall.
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+
+#include "elementalchannel.h"
+#include "elementaltest.h"
+
+#define	kProducers		4
+#define	kConsumers		3
+#define	kPerProducer	100000
+#define	kCapacity		64
+#define	kSleepers		4
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	Element	element;
+	long	value;
+};
+
+static	ElementChannel	gChannel;
+static	Item			*gItems;
+static	long			gSums[ kConsumers ];
+static	long			gCounts[ kConsumers ];
+
+	static
+	void*
+Producer(
+	void	*refCon );
+
+	static
+	void*
+Consumer(
+	void	*refCon );
+
+	static
+	void*
+Sleeper(
+	void	*refCon );
+
+	static
+	void
+DeadlineAfter(
+	struct timespec	*deadline,
+	long			nanoseconds );
+
+	int
+main( void )
+{
+	pthread_t		producers[ kProducers ];
+	pthread_t		consumers[ kConsumers ];
+	pthread_t		sleepers[ kSleepers ];
+	struct timespec	deadline;
+	ElementList		batch;
+	Item			items[ kSleepers + 1 ];
+	void			*element;
+	long			sum = 0;
+	long			count = 0;
+	long			index;
+
+	//	Many to many.
+	gItems = (Item*) calloc( (size_t) kProducers * kPerProducer, sizeof( Item ) );
+	NewElementChannel( &gChannel, kCapacity );
+	for( index = 0; index < kConsumers; index++ )
+		check( pthread_create( &consumers[ index ], NULL, Consumer, (void*) index ) == 0 );
+	for( index = 0; index < kProducers; index++ )
+		check( pthread_create( &producers[ index ], NULL, Producer, (void*) index ) == 0 );
+	for( index = 0; index < kProducers; index++ )
+		pthread_join( producers[ index ], NULL );
+	CloseElementChannel( &gChannel );
+	for( index = 0; index < kConsumers; index++ ) {
+		pthread_join( consumers[ index ], NULL );
+		sum += gSums[ index ];
+		count += gCounts[ index ];
+	}
+	check( count == (long) kProducers * kPerProducer );
+	check( sum == (long) kProducers * ((long) kPerProducer * (kPerProducer - 1) / 2) );
+	check( CountChannelElements( &gChannel ) == 0 );
+
+	//	A closed, drained channel refuses puts and grabs.
+	check( !PutChannelElement( &items[ 0 ], &gChannel, NULL ) );
+	check( !GrabChannelElement( &element, &gChannel, NULL ) && element == NULL );
+	DeleteElementChannel( &gChannel );
+	free( gItems );
+
+	//	Deadlines, on a channel of one.
+	memset( items, 0, sizeof( items ) );
+	NewElementChannel( &gChannel, 1 );
+	DeadlineAfter( &deadline, 20000000 );
+	check( !GrabChannelElement( &element, &gChannel, &deadline ) && element == NULL );
+	check( PutChannelElement( &items[ 0 ], &gChannel, NULL ) );
+	DeadlineAfter( &deadline, 20000000 );
+	check( !PutChannelElement( &items[ 1 ], &gChannel, &deadline ) );
+	check( GetElementList( &items[ 1 ] ) == NULL );
+
+	//	A maxCount of 0 is refused without taking anything.
+	NewElementList( &batch );
+	check( GrabChannelElements( &batch, 0, &gChannel, NULL ) == 0 );
+	check( IsListEmpty( &batch ) && CountChannelElements( &gChannel ) == 1 );
+	check( GrabChannelElements( &batch, 8, &gChannel, NULL ) == 1 );
+	GrabFirstElement( &element, &batch );
+	check( element == &items[ 0 ] );
+	DeleteElementChannel( &gChannel );
+
+	//	One batch put wakes every consumer it can feed.
+	NewElementChannel( &gChannel, kSleepers );
+	for( index = 0; index < kSleepers; index++ )
+		check( pthread_create( &sleepers[ index ], NULL, Sleeper, NULL ) == 0 );
+	//	Give them time to fall asleep; the test holds either way.
+	deadline.tv_sec = 0;
+	deadline.tv_nsec = 20000000;
+	nanosleep( &deadline, NULL );
+	for( index = 0; index < kSleepers; index++ )
+		PutLastElement( &items[ index ], &batch );
+	check( PutChannelElements( &batch, &gChannel, NULL ) == kSleepers );
+	check( IsListEmpty( &batch ) );
+	for( index = 0; index < kSleepers; index++ )
+		pthread_join( sleepers[ index ], NULL );
+	check( CountChannelElements( &gChannel ) == 0 );
+
+	//	A partial batch put leaves the rest in the batch.
+	for( index = 0; index <= kSleepers; index++ )
+		PutLastElement( &items[ index ], &batch );
+	DeadlineAfter( &deadline, 20000000 );
+	check( PutChannelElements( &batch, &gChannel, &deadline ) == kSleepers );
+	FirstElement( &element, &batch );
+	check( element == &items[ kSleepers ] );
+	DeleteElementChannel( &gChannel );
+
+	return( 0 );
+}
+
+	static
+	void*
+Producer(
+	void	*refCon )
+{
+	long		id = (long) refCon;
+	Item		*items = gItems + id * kPerProducer;
+	ElementList	batch;
+	long		index;
+
+	NewElementList( &batch );
+	for( index = 0; index < kPerProducer; index++ ) {
+		items[ index ].value = index;
+		if( index % 3 == 0 ) {
+			PutLastElement( &items[ index ], &batch );
+			if( index % 30 == 0 )
+				check( PutChannelElements( &batch, &gChannel, NULL ) == 10 || index == 0 );
+		} else
+			check( PutChannelElement( &items[ index ], &gChannel, NULL ) );
+	}
+	PutChannelElements( &batch, &gChannel, NULL );
+	check( IsListEmpty( &batch ) );
+	return( NULL );
+}
+
+	static
+	void*
+Consumer(
+	void	*refCon )
+{
+	long		id = (long) refCon;
+	ElementList	batch;
+	void		*element;
+
+	NewElementList( &batch );
+	for( ;; ) {
+		if( id == 0 ) {
+			if( !GrabChannelElement( &element, &gChannel, NULL ) )
+				break;
+			gSums[ id ] += ((Item*) element)->value;
+			gCounts[ id ]++;
+		} else {
+			size_t	moved = GrabChannelElements( &batch, 16, &gChannel, NULL );
+
+			if( moved == 0 )
+				break;
+			check( moved <= 16 );
+			while( GrabFirstElement( &element, &batch ), element ) {
+				gSums[ id ] += ((Item*) element)->value;
+				gCounts[ id ]++;
+			}
+		}
+	}
+	return( NULL );
+}
+
+	static
+	void*
+Sleeper(
+	void	*refCon )
+{
+	void	*element;
+
+	(void) refCon;
+	check( GrabChannelElement( &element, &gChannel, NULL ) );
+	return( NULL );
+}
+
+	static
+	void
+DeadlineAfter(
+	struct timespec	*deadline,
+	long			nanoseconds )
+{
+	clock_gettime( CLOCK_MONOTONIC, deadline );
+	deadline->tv_nsec += nanoseconds;
+	if( deadline->tv_nsec >= 1000000000 ) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000;
+	}
+}
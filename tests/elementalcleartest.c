@@ -0,0 +1,132 @@
+/****************************************************************************************
+	elementalcleartest.c
+
+	Tests of ClearElementList(), with and without elementalGenerations.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A list refilled and cleared many times, as a request-scoped list is, with
+	dead elements and an open cursor in it: after each clear every element
+	must be in no list, the cursor must find itself in none, and the elements
+	must go back into it, or into another list, as good as new, and stay in
+	none when the list is initialized again. Built with
+	elementalGenerations, asking an element about its deleted list must
+	assert.
+
+	************************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kElements	1000
+#define	kRequests	2000
+
+static	Element	gElements[ kElements ];
+
+	int
+main( void )
+{
+	ElementList	list;
+	ElementList	other;
+	uint64_t	random = 11;
+	int			request;
+	int			index;
+
+	NewElementList( &list );
+	NewElementList( &other );
+
+	for( request = 0; request < kRequests; request++ ) {
+		ElementCursor	cursor;
+		size_t			count = (size_t) (TestRandom( &random ) % kElements) + 1;
+		void			*element;
+		size_t			seen;
+
+		for( index = 0; index < (int) count; index++ )
+			PutLastElement( &gElements[ index ], &list );
+		for( index = 0; index < (int) count; index += 7 )
+			MarkElementDead( &gElements[ index ] );
+		OpenElementCursor( &cursor, &list );
+		AdvanceElementCursor( &cursor, count / 2 );
+
+		ClearElementList( &list );
+		check( IsListEmpty( &list ) && list.first == NULL && list.last == NULL );
+		for( index = 0; index < kElements; index++ ) {
+			check( GetElementList( &gElements[ index ] ) == NULL );
+			check( !IsElementDead( &gElements[ index ] ) );
+		}
+		NextCursorElement( &element, &cursor );
+		check( element == NULL );
+		CloseElementCursor( &cursor );
+		check( list.first == NULL );
+
+		//	Every other request, half go elsewhere before the next fill.
+		if( request & 1 ) {
+			for( index = 0; index < (int) count; index += 2 )
+				PutFirstElement( &gElements[ index ], &other );
+			for( seen = 0, FirstElement( &element, &other ); element; NextElement( element, &element ) ) {
+				check( element == &gElements[ (count - 1) / 2 * 2 - 2 * seen ] );
+				seen++;
+			}
+			check( seen == (count + 1) / 2 );
+			for( index = 0; index < (int) count; index += 2 )
+				RemoveElement( &gElements[ index ], &other );
+			check( IsListEmpty( &other ) );
+		}
+	}
+
+	//	The elements refill the cleared list in order.
+	for( index = 0; index < kElements; index++ )
+		PutLastElement( &gElements[ index ], &list );
+	{
+		void	*element;
+
+		for( index = 0, FirstElement( &element, &list ); element; NextElement( element, &element ), index++ ) {
+			check( element == &gElements[ index ] );
+			check( GetElementList( element ) == &list );
+		}
+		check( index == kElements );
+	}
+	ClearElementList( &list );
+
+	//	Initializing a cleared list again doesn't bring its elements back,
+	//	even those put before its first clear.
+	PutLastElement( &gElements[ 0 ], &other );
+	PutLastElement( &gElements[ 1 ], &other );
+	ClearElementList( &other );
+	NewElementList( &other );
+	check( GetElementList( &gElements[ 0 ] ) == NULL && GetElementList( &gElements[ 1 ] ) == NULL );
+	PutLastElement( &gElements[ 1 ], &other );
+	check( other.first == &gElements[ 1 ] && other.last == &gElements[ 1 ] );
+	RemoveElement( &gElements[ 1 ], &other );
+	DeleteElementList( &other );
+
+#if	elementalGenerations
+	//	An element outliving its list, cleared or not, is caught.
+	{
+		pid_t	child;
+		int		status;
+
+		PutLastElement( &gElements[ 0 ], &list );
+		DeleteElementList( &list );
+		child = fork();
+		check( child >= 0 );
+		if( child == 0 ) {
+			close( STDERR_FILENO );
+			GetElementList( &gElements[ 0 ] );
+			_exit( 0 );
+		}
+		check( waitpid( child, &status, 0 ) == child );
+		check( WIFSIGNALED( status ) && WTERMSIG( status ) == SIGABRT );
+	}
+#else
+	DeleteElementList( &list );
+#endif
+
+	return( 0 );
+}
@@ -0,0 +1,111 @@
+/****************************************************************************************
+	elementalcompacttest.c
+
+	Tests of CompactElementList() and ElementListLocality().
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <stdlib.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kCount		10
+#define	kArena		6
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	long	value;
+	char	pad[ 40 ];
+	Element	element;
+};
+
+static	Node	*gWhere[ kCount ];	//	An outside reference to each node.
+
+	static
+	void
+Relocate(
+	void	*oldElement,
+	void	*newElement,
+	void	*refCon );
+
+	int
+main( void )
+{
+	ElementList		list;
+	ElementCursor	cursor;
+	Node			*arena = (Node*) malloc( kArena * sizeof( Node ) );
+	Node			*node;
+	void			*junk[ kCount ];
+	int				calls = 0;
+	int				index;
+
+	NewElementList( &list );
+	check( ElementListLocality( &list ) == 0 );
+	for( index = 0; index < kCount; index++ ) {
+		gWhere[ index ] = node = (Node*) malloc( sizeof( Node ) );
+		junk[ index ] = malloc( 1000 + (size_t) index * 77 );	//	Spreads the nodes out.
+		node->value = index;
+		PutLastElementType( node, &list, Node, element );
+	}
+	check( ElementListLocality( &list ) > sizeof( Node ) );
+
+	//	A cursor after the third node stays where it is, linked in sequence.
+	OpenElementCursor( &cursor, &list );
+	check( AdvanceElementCursor( &cursor, 3 ) == 3 );
+
+	//	Only the first kArena fit; the rest stay where they were.
+	check( CompactElementListType( &list, arena, kArena * sizeof( Node ), Relocate, &calls, Node, element ) == kArena );
+	check( calls == kArena );
+	for( index = 0; index < kArena; index++ ) {
+		check( gWhere[ index ] == &arena[ index ] && arena[ index ].value == index );
+		check( GetElementListType( &arena[ index ], Node, element ) == &list );
+	}
+
+	index = 0;
+	for( FirstElementType( &node, &list, Node, element ); node; NextElementType( node, (void**) &node, Node, element ) ) {
+		check( node == gWhere[ index ] && node->value == index );
+		index++;
+	}
+	check( index == kCount );
+	for( LastElementType( (void**) &node, &list, Node, element ); node; PrevElementType( node, (void**) &node, Node, element ) )
+		check( node->value == --index );
+	check( index == 0 );
+
+	NextCursorElementType( &node, &cursor, Node, element );
+	check( node == &arena[ 3 ] );
+	CloseElementCursor( &cursor );
+
+	//	Now the compacted prefix's neighbours are one node apart.
+	RemoveElementType( gWhere[ kArena ], &list, Node, element );
+	for( index = kArena + 1; index < kCount; index++ )
+		RemoveElementType( gWhere[ index ], &list, Node, element );
+	check( ElementListLocality( &list ) == sizeof( Node ) );
+
+	for( index = kArena; index < kCount; index++ )
+		free( gWhere[ index ] );
+	for( index = 0; index < kCount; index++ )
+		free( junk[ index ] );
+	DeleteElementList( &list );
+	free( arena );
+	return( 0 );
+}
+
+	static
+	void
+Relocate(
+	void	*oldElement,
+	void	*newElement,
+	void	*refCon )
+{
+	Node	*node = (Node*) newElement;
+
+	check( gWhere[ node->value ] == oldElement );
+	gWhere[ node->value ] = node;
+	free( oldElement );
+	(*(int*) refCon)++;
+}
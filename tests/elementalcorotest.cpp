@@ -0,0 +1,207 @@
+/****************************************************************************************
+	elementalcorotest.cpp
+
+	Tests of the coroutine channel, mutex and executors.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Every value put must be grabbed exactly once, at each capacity including
+	the unbuffered one, on one thread and on several. Global operator new is
+	counted, so the test also checks that once the coroutines exist, handing
+	elements back and forth allocates nothing.
+
+	************************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "elementalcoro.hpp"
+#include "elementaltest.h"
+
+#define	kPerProducer	5000
+#define	kLockers		8
+#define	kLocks			10000
+
+struct	Item	{
+	Element	element;
+	long	value;
+};
+
+static	std::atomic<long>	gAllocations( 0 );
+static	std::atomic<long>	gSum( 0 );
+static	std::atomic<long>	gGot( 0 );
+static	std::atomic<int>	gDone( 0 );
+static	AsyncElementMutex	gMutex;
+static	long				gShared;
+
+//	These pair malloc() with free(), but GCC sees operator delete() free what
+//	operator new returned and warns, even out of line.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+	void*
+operator new(
+	size_t	size )
+{
+	void	*block = malloc( size ? size : 1 );
+
+	if( !block )
+		throw std::bad_alloc();
+	gAllocations++;
+	return( block );
+}
+
+	void
+operator delete(
+	void	*block ) noexcept
+{
+	free( block );
+}
+
+	void
+operator delete(
+	void	*block,
+	size_t	size ) noexcept
+{
+	(void) size;
+	operator delete( block );
+}
+
+#pragma GCC diagnostic pop
+
+	static
+	ElementTask
+Producer(
+	AsyncElementChannel	&channel,
+	Item				*items,
+	long				base,
+	int					count )
+{
+	for( int index = 0; index < count; index++ ) {
+		items[ index ].value = base + index;
+		check( co_await channel.Put( &items[ index ] ) );
+	}
+}
+
+	static
+	ElementTask
+Consumer(
+	AsyncElementChannel	&channel )
+{
+	Item	*item;
+
+	while( (item = (Item*) co_await channel.Grab()) != NULL ) {
+		gSum += item->value;
+		gGot++;
+	}
+}
+
+	static
+	ElementTask
+Locker(
+	ElementThreadLoop	&loop )
+{
+	for( int index = 0; index < kLocks; index++ ) {
+		co_await gMutex.Lock();
+		gShared++;
+		gMutex.Unlock();
+	}
+	if( ++gDone == kLockers )
+		loop.Stop();
+}
+
+	static
+	ElementTask
+LatePutter(
+	AsyncElementChannel	&channel,
+	Item				*item,
+	bool				*ok )
+{
+	*ok = co_await channel.Put( item );
+}
+
+	int
+main( void )
+{
+	std::vector<Item>	items( 4 * kPerProducer );
+
+	for( size_t capacity : { 0, 1, 4 } ) {
+		//	One thread: two producers, one consumer.
+		{
+			ElementLoop			loop;
+			AsyncElementChannel	channel( capacity );
+			long				allocations;
+
+			gSum = gGot = 0;
+			SpawnElementTask( Consumer( channel ), loop );
+			SpawnElementTask( Producer( channel, &items[ 0 ], 0, kPerProducer ), loop );
+			SpawnElementTask( Producer( channel, &items[ kPerProducer ], kPerProducer, kPerProducer ), loop );
+			allocations = gAllocations;
+			loop.Run();
+			check( gAllocations == allocations );
+			check( gGot == 2 * kPerProducer );
+			check( gSum == (long) 2 * kPerProducer * (2 * kPerProducer - 1) / 2 );
+			check( channel.Count() == 0 );
+
+			//	The consumer is still waiting; closing lets it finish.
+			channel.Close();
+			loop.Run();
+
+			bool	ok = true;
+
+			SpawnElementTask( LatePutter( channel, &items[ 0 ], &ok ), loop );
+			loop.Run();
+			check( !ok );
+		}
+
+		//	Four threads: four producers, three consumers.
+		{
+			ElementThreadLoop			loop;
+			AsyncElementChannel			channel( capacity );
+			std::vector<std::thread>	threads;
+
+			gSum = gGot = 0;
+			for( int index = 0; index < 3; index++ )
+				SpawnElementTask( Consumer( channel ), loop );
+			for( int index = 0; index < 4; index++ )
+				SpawnElementTask( Producer( channel, &items[ index * kPerProducer ],
+					(long) index * kPerProducer, kPerProducer ), loop );
+			for( int index = 0; index < 4; index++ )
+				threads.emplace_back( [&loop]{ loop.Run(); } );
+			while( gGot < 4 * kPerProducer )
+				std::this_thread::yield();
+			channel.Close();
+			loop.Stop();
+			for( std::thread &thread : threads )
+				thread.join();
+			check( gGot == 4 * kPerProducer );
+			check( gSum == (long) 4 * kPerProducer * (4 * kPerProducer - 1) / 2 );
+		}
+	}
+
+	//	The mutex, contended across threads.
+	{
+		ElementThreadLoop			loop;
+		std::vector<std::thread>	threads;
+
+		check( gMutex.TryLock() );
+		check( !gMutex.TryLock() );
+		gMutex.Unlock();
+
+		for( int index = 0; index < kLockers; index++ )
+			SpawnElementTask( Locker( loop ), loop );
+		for( int index = 0; index < 4; index++ )
+			threads.emplace_back( [&loop]{ loop.Run(); } );
+		for( std::thread &thread : threads )
+			thread.join();
+		check( gShared == (long) kLockers * kLocks );
+		check( gMutex.TryLock() );
+		gMutex.Unlock();
+	}
+
+	return( 0 );
+}
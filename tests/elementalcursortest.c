@@ -0,0 +1,299 @@
+/****************************************************************************************
+	elementalcursortest.c
+
+	Tests of ElementCursors, against a model of the list with its markers.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random puts of every kind, removals, grabs, steps, advances, rewinds,
+	closes and reopens of several cursors at once. After each operation the
+	raw links, markers included, must match the model, and the accessors
+	must see just the elements. Each scan must return what the model says
+	follows its cursor, whatever happened around it since its last step.
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kNodes		200
+#define	kCursors	4
+#define	kOperations	100000
+#define	kSlots		(kNodes + kCursors)
+
+static	Element			gNodes[ kNodes ];
+static	ElementCursor	gCursors[ kCursors ];
+static	bool			gOpen[ kCursors ];
+static	int				gOrder[ kSlots ];	//	Node indexes, and kNodes + cursor for markers.
+static	int				gCount;
+
+	static
+	int
+ModelFind(
+	int	slot );
+
+	static
+	void
+ModelInsert(
+	int	at,
+	int	slot );
+
+	static
+	void
+ModelRemove(
+	int	slot );
+
+	static
+	int
+ModelStep(
+	int	cursor );
+
+	static
+	void
+CheckList(
+	ElementList	*list );
+
+	int
+main( void )
+{
+	ElementList	list;
+	uint64_t	random = 17;
+	long		operation;
+	int			cursor;
+
+	memset( gNodes, 0, sizeof( gNodes ) );
+	memset( gCursors, 0, sizeof( gCursors ) );
+	NewElementList( &list );
+
+	//	A cursor in an empty list, and one alone with a single element.
+	OpenElementCursor( &gCursors[ 0 ], &list );
+	check( IsListEmpty( &list ) );
+	{
+		void	*element;
+
+		FirstElement( &element, &list );
+		check( element == NULL );
+		NextCursorElement( &element, &gCursors[ 0 ] );
+		check( element == NULL );
+		PutLastElement( &gNodes[ 0 ], &list );
+		check( !IsListEmpty( &list ) && list.first == &gCursors[ 0 ].marker );
+		NextCursorElement( &element, &gCursors[ 0 ] );
+		check( element == &gNodes[ 0 ] );
+		NextCursorElement( &element, &gCursors[ 0 ] );
+		check( element == NULL );
+		GrabFirstElement( &element, &list );
+		check( element == &gNodes[ 0 ] && IsListEmpty( &list ) );
+		CloseElementCursor( &gCursors[ 0 ] );
+		check( list.first == NULL && list.last == NULL );
+	}
+
+	for( operation = 0; operation < kOperations; operation++ ) {
+		unsigned	choice = (unsigned) (TestRandom( &random ) % 100);
+		int			node = (int) (TestRandom( &random ) % kNodes);
+		int			anchor = (int) (TestRandom( &random ) % kNodes);
+		int			at = ModelFind( node );
+		int			anchorAt = ModelFind( anchor );
+
+		cursor = (int) (TestRandom( &random ) % kCursors);
+		if( choice < 30 ) {
+			//	Puts, which land beside markers exactly as the raw links say.
+			if( at >= 0 )
+				continue;
+			switch( choice % 4 ) {
+				case 0:
+					PutFirstElement( &gNodes[ node ], &list );
+					ModelInsert( 0, node );
+					break;
+				case 1:
+					PutLastElement( &gNodes[ node ], &list );
+					ModelInsert( gCount, node );
+					break;
+				case 2:
+					if( anchorAt < 0 )
+						continue;
+					PutBeforeElement( &gNodes[ node ], &gNodes[ anchor ], &list );
+					ModelInsert( anchorAt, node );
+					break;
+				default:
+					if( anchorAt < 0 )
+						continue;
+					PutAfterElement( &gNodes[ node ], &gNodes[ anchor ], &list );
+					ModelInsert( anchorAt + 1, node );
+					break;
+			}
+		} else if( choice < 50 ) {
+			if( at < 0 )
+				continue;
+			check( FindElement( &gNodes[ node ], &list ) );
+			RemoveElement( &gNodes[ node ], &list );
+			ModelRemove( node );
+		} else if( choice < 55 ) {
+			void	*element;
+			int		expected;
+
+			for( expected = 0; expected < gCount && gOrder[ expected ] >= kNodes; expected++ )
+				;
+			GrabFirstElement( &element, &list );
+			if( expected == gCount )
+				check( element == NULL );
+			else {
+				check( element == &gNodes[ gOrder[ expected ] ] );
+				ModelRemove( gOrder[ expected ] );
+			}
+		} else if( choice < 75 ) {
+			void	*element;
+			int		expected;
+
+			if( !gOpen[ cursor ] )
+				continue;
+			expected = ModelStep( cursor );
+			NextCursorElement( &element, &gCursors[ cursor ] );
+			check( expected < 0 ? element == NULL : element == &gNodes[ expected ] );
+		} else if( choice < 85 ) {
+			size_t	count = (size_t) (TestRandom( &random ) % 20);
+			size_t	advanced = 0;
+
+			if( !gOpen[ cursor ] )
+				continue;
+			while( advanced < count && ModelStep( cursor ) >= 0 )
+				advanced++;
+			check( AdvanceElementCursor( &gCursors[ cursor ], count ) == advanced );
+		} else if( choice < 90 ) {
+			if( !gOpen[ cursor ] )
+				continue;
+			RewindElementCursor( &gCursors[ cursor ] );
+			ModelRemove( kNodes + cursor );
+			ModelInsert( 0, kNodes + cursor );
+		} else if( choice < 95 ) {
+			if( gOpen[ cursor ] )
+				continue;
+			OpenElementCursor( &gCursors[ cursor ], &list );
+			ModelInsert( 0, kNodes + cursor );
+			gOpen[ cursor ] = true;
+		} else {
+			if( !gOpen[ cursor ] )
+				continue;
+			CloseElementCursor( &gCursors[ cursor ] );
+			ModelRemove( kNodes + cursor );
+			gOpen[ cursor ] = false;
+		}
+		if( operation % 16 == 0 )
+			CheckList( &list );
+	}
+	CheckList( &list );
+
+	for( cursor = 0; cursor < kCursors; cursor++ )
+		if( gOpen[ cursor ] )
+			CloseElementCursor( &gCursors[ cursor ] );
+	{
+		void	*element;
+
+		for( GrabLastElement( &element, &list ); element; GrabLastElement( &element, &list ) )
+			;
+	}
+	check( list.first == NULL && list.last == NULL );
+	DeleteElementList( &list );
+
+	return( 0 );
+}
+
+	static
+	int
+ModelFind(
+	int	slot )
+{
+	int	index;
+
+	for( index = 0; index < gCount; index++ )
+		if( gOrder[ index ] == slot )
+			return( index );
+	return( -1 );
+}
+
+	static
+	void
+ModelInsert(
+	int	at,
+	int	slot )
+{
+	memmove( &gOrder[ at + 1 ], &gOrder[ at ], (size_t) (gCount - at) * sizeof( int ) );
+	gOrder[ at ] = slot;
+	gCount++;
+}
+
+	static
+	void
+ModelRemove(
+	int	slot )
+{
+	int	at = ModelFind( slot );
+
+	check( at >= 0 );
+	memmove( &gOrder[ at ], &gOrder[ at + 1 ], (size_t) (gCount - at - 1) * sizeof( int ) );
+	gCount--;
+}
+
+//	Moves cursor's marker just past the next node, returning it, or -1 at the end.
+	static
+	int
+ModelStep(
+	int	cursor )
+{
+	int	at = ModelFind( kNodes + cursor );
+	int	next;
+
+	for( next = at + 1; next < gCount && gOrder[ next ] >= kNodes; next++ )
+		;
+	if( next == gCount )
+		return( -1 );
+	ModelRemove( kNodes + cursor );
+	ModelInsert( next, kNodes + cursor );
+	return( gOrder[ next - 1 ] );
+}
+
+	static
+	void
+CheckList(
+	ElementList	*list )
+{
+	Element	*raw;
+	Element	*prev = NULL;
+	void	*element;
+	int		index = 0;
+	int		nodes = 0;
+
+	//	The raw links, markers and all.
+	for( raw = list->first; raw; raw = raw->next ) {
+		int	slot;
+
+		check( index < gCount );
+		slot = gOrder[ index ];
+		check( raw == (slot < kNodes ? &gNodes[ slot ] : &gCursors[ slot - kNodes ].marker) );
+		check( raw->prev == prev );
+		prev = raw;
+		index++;
+	}
+	check( index == gCount && list->last == prev );
+
+	//	What the accessors see.
+	for( index = 0, FirstElement( &element, list ); element; NextElement( element, &element ) ) {
+		while( gOrder[ index ] >= kNodes )
+			index++;
+		check( element == &gNodes[ gOrder[ index ] ] );
+		check( GetElementList( element ) == list );
+		index++;
+		nodes++;
+	}
+	check( IsListEmpty( list ) == (nodes == 0) );
+	for( index = gCount - 1, LastElement( &element, list ); element; PrevElement( element, &element ) ) {
+		while( gOrder[ index ] >= kNodes )
+			index--;
+		check( element == &gNodes[ gOrder[ index ] ] );
+		index--;
+		nodes--;
+	}
+	check( nodes == 0 );
+}
@@ -0,0 +1,199 @@
+/****************************************************************************************
+	elementalhashtest.c
+
+	Tests of ElementHashTables, against a table of which keys are present.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random puts, finds and grabs on a table that starts with a handful of
+	buckets, so it is growing, and migrating, for much of the run. Every
+	answer is compared with the model, and now and then the whole table is
+	walked, in insertion order where the table keeps one.
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elementalhash.h"
+#include "elementaltest.h"
+
+#define	kNodes		4000
+#define	kOperations	300000
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	int			pad;
+	Element		chain;
+	Element		order;
+	unsigned	key;
+	bool		live;
+	unsigned	serial;		//	When it was put, to check insertion order.
+};
+
+static	Node	gNodes[ kNodes ];
+
+	static
+	size_t
+HashKey(
+	unsigned	key );
+
+	static
+	size_t
+HashNode(
+	void	*element,
+	void	*refCon );
+
+	static
+	bool
+MatchNode(
+	void		*element,
+	const void	*key,
+	void		*refCon );
+
+	static
+	void
+CheckWalk(
+	ElementHashTable	*table,
+	size_t				live,
+	bool				ordered );
+
+	int
+main( void )
+{
+	uint64_t	random = 1;
+	int			ordered;
+
+	for( ordered = 0; ordered < 2; ordered++ ) {
+		ElementHashTable	table;
+		size_t				live = 0;
+		unsigned			serial = 0;
+		bool				grew = false;
+		int					operation;
+		Node				*node;
+
+		memset( gNodes, 0, sizeof( gNodes ) );
+		for( operation = 0; operation < kNodes; operation++ )
+			gNodes[ operation ].key = (unsigned) operation;
+		if( ordered )
+			check( NewOrderedElementHashTableType( &table, 3, Node, chain, order, HashNode, MatchNode, NULL ) );
+		else
+			check( NewElementHashTableType( &table, 3, Node, chain, HashNode, MatchNode, NULL ) );
+		check( table.bucketCount == 4 );
+
+		for( operation = 0; operation < kOperations; operation++ ) {
+			unsigned	key = (unsigned) (TestRandom( &random ) % kNodes);
+			unsigned	choice = (unsigned) (TestRandom( &random ) % 10);
+
+			if( choice < 6 ) {
+				if( !gNodes[ key ].live ) {
+					PutHashElement( &gNodes[ key ], &table );
+					gNodes[ key ].live = true;
+					gNodes[ key ].serial = serial++;
+					live++;
+				}
+			} else if( choice < 8 ) {
+				FindHashElementType( &node, &table, HashKey( key ), &key );
+				check( gNodes[ key ].live ? node == &gNodes[ key ] : node == NULL );
+			} else {
+				GrabHashElementType( &node, &table, HashKey( key ), &key );
+				check( gNodes[ key ].live ? node == &gNodes[ key ] : node == NULL );
+				if( node ) {
+					check( GetElementList( &node->chain ) == NULL );
+					node->live = false;
+					live--;
+				}
+			}
+			check( CountHashElements( &table ) == live );
+			grew |= table.oldBuckets != NULL;
+			if( operation % 5000 == 0 || (table.oldBuckets && operation % 97 == 0) )
+				CheckWalk( &table, live, ordered );
+		}
+		check( grew );
+		check( table.bucketCount >= live );
+
+		//	Equal keys coexist; removing one leaves the other findable.
+		{
+			Node		twin = gNodes[ 0 ];
+			unsigned	key = 0;
+
+			memset( &twin.chain, 0, sizeof( twin.chain ) );
+			memset( &twin.order, 0, sizeof( twin.order ) );
+			if( !gNodes[ 0 ].live ) {
+				PutHashElement( &gNodes[ 0 ], &table );
+				gNodes[ 0 ].live = true;
+				live++;
+			}
+			PutHashElement( &twin, &table );
+			RemoveHashElement( &gNodes[ 0 ], &table );
+			FindHashElementType( &node, &table, HashKey( key ), &key );
+			check( node == &twin );
+			RemoveHashElement( &twin, &table );
+			gNodes[ 0 ].live = false;
+			live--;
+			check( CountHashElements( &table ) == live );
+		}
+
+		//	Drain through the iterator's answers.
+		while( FirstHashElementType( &node, &table ), node ) {
+			RemoveHashElement( node, &table );
+			node->live = false;
+			live--;
+		}
+		check( live == 0 && CountHashElements( &table ) == 0 );
+		DeleteElementHashTable( &table );
+	}
+
+	return( 0 );
+}
+
+	static
+	size_t
+HashKey(
+	unsigned	key )
+{
+	return( (size_t) key * 2654435761u );
+}
+
+	static
+	size_t
+HashNode(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	return( HashKey( ((Node*) element)->key ) );
+}
+
+	static
+	bool
+MatchNode(
+	void		*element,
+	const void	*key,
+	void		*refCon )
+{
+	(void) refCon;
+	return( ((Node*) element)->key == *(const unsigned*) key );
+}
+
+	static
+	void
+CheckWalk(
+	ElementHashTable	*table,
+	size_t				live,
+	bool				ordered )
+{
+	size_t	count = 0;
+	Node	*previous = NULL;
+	Node	*node;
+
+	for( FirstHashElementType( &node, table ); node; NextHashElementType( node, &node, table ) ) {
+		check( node->live );
+		if( ordered && previous )
+			check( previous->serial < node->serial );
+		previous = node;
+		count++;
+	}
+	check( count == live );
+}
@@ -0,0 +1,210 @@
+/****************************************************************************************
+	elementalheaptest.c
+
+	Tests of ElementHeaps, against a model of which heap holds what.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random puts, decreases, removals, melds and grabs across two heaps of
+	nodes whose hook is not at offset zero. Every grab must return the
+	smallest key in its heap, and the heaps must drain in order. Then the
+	plain functions, on a hook at offset zero.
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elementalheap.h"
+#include "elementaltest.h"
+
+#define	kNodes		2000
+#define	kOperations	200000
+
+typedef	struct	Node	Node;
+typedef	struct	Plain	Plain;
+
+struct	Node	{
+	int			pad;
+	long		key;
+	HeapElement	hook;
+	int			which;		//	Heap index, or -1.
+};
+
+struct	Plain	{
+	HeapElement	hook;
+	long		key;
+};
+
+static	Node	gNodes[ kNodes ];
+
+	static
+	bool
+NodeBefore(
+	void	*a,
+	void	*b,
+	void	*refCon );
+
+	static
+	bool
+PlainBefore(
+	void	*a,
+	void	*b,
+	void	*refCon );
+
+	static
+	void
+CheckFirst(
+	ElementHeap	*heap,
+	int			which );
+
+	int
+main( void )
+{
+	ElementHeap	heaps[ 2 ];
+	uint64_t	random = 5;
+	long		operation;
+	int			which;
+
+	memset( gNodes, 0, sizeof( gNodes ) );
+	for( which = 0; which < kNodes; which++ )
+		gNodes[ which ].which = -1;
+	NewElementHeap( &heaps[ 0 ], NodeBefore, NULL );
+	NewElementHeap( &heaps[ 1 ], NodeBefore, NULL );
+
+	for( operation = 0; operation < kOperations; operation++ ) {
+		unsigned	choice = (unsigned) (TestRandom( &random ) % 100);
+		Node		*node = &gNodes[ TestRandom( &random ) % kNodes ];
+		int			heap = (int) (TestRandom( &random ) & 1);
+
+		if( choice < 35 ) {
+			if( node->which < 0 ) {
+				node->key = (long) (TestRandom( &random ) % 100000);
+				PutHeapElementType( node, &heaps[ heap ], Node, hook );
+				node->which = heap;
+			}
+		} else if( choice < 60 ) {
+			if( node->which >= 0 ) {
+				node->key -= (long) (TestRandom( &random ) % 1000);
+				DecreaseHeapElementType( node, &heaps[ node->which ], Node, hook );
+			}
+		} else if( choice < 75 ) {
+			if( node->which >= 0 ) {
+				RemoveHeapElementType( node, &heaps[ node->which ], Node, hook );
+				check( !IsHeapElementQueuedType( node, &heaps[ node->which ], Node, hook ) );
+				node->which = -1;
+			}
+		} else if( choice < 76 ) {
+			MeldElementHeapsType( &heaps[ heap ], &heaps[ !heap ], Node, hook );
+			check( IsHeapEmpty( &heaps[ !heap ] ) );
+			for( which = 0; which < kNodes; which++ )
+				if( gNodes[ which ].which == !heap )
+					gNodes[ which ].which = heap;
+		} else {
+			Node	*first;
+
+			CheckFirst( &heaps[ heap ], heap );
+			GrabFirstHeapElementType( &first, &heaps[ heap ], Node, hook );
+			if( first ) {
+				check( first->which == heap );
+				check( !IsHeapElementQueuedType( first, &heaps[ heap ], Node, hook ) );
+				first->which = -1;
+			}
+		}
+		if( operation % 1000 == 0 ) {
+			size_t	counts[ 2 ] = { 0, 0 };
+
+			for( which = 0; which < kNodes; which++ )
+				if( gNodes[ which ].which >= 0 ) {
+					counts[ gNodes[ which ].which ]++;
+					check( IsHeapElementQueuedType( &gNodes[ which ], &heaps[ gNodes[ which ].which ], Node, hook ) );
+				}
+			check( CountHeapElements( &heaps[ 0 ] ) == counts[ 0 ] );
+			check( CountHeapElements( &heaps[ 1 ] ) == counts[ 1 ] );
+		}
+	}
+
+	for( which = 0; which < 2; which++ ) {
+		Node	*first;
+		long	last = -(1L << 40);
+
+		for( GrabFirstHeapElementType( &first, &heaps[ which ], Node, hook ); first;
+				GrabFirstHeapElementType( &first, &heaps[ which ], Node, hook ) ) {
+			check( first->key >= last );
+			last = first->key;
+		}
+		check( IsHeapEmpty( &heaps[ which ] ) && CountHeapElements( &heaps[ which ] ) == 0 );
+		DeleteElementHeap( &heaps[ which ] );
+	}
+
+	//	The plain functions, with the hook first.
+	{
+		Plain		plains[ 5 ];
+		ElementHeap	heap;
+		void		*first;
+		int			index;
+
+		memset( plains, 0, sizeof( plains ) );
+		NewElementHeap( &heap, PlainBefore, NULL );
+		for( index = 0; index < 5; index++ ) {
+			plains[ index ].key = 10 * index;
+			PutHeapElement( &plains[ index ], &heap );
+		}
+		plains[ 3 ].key = -1;
+		DecreaseHeapElement( &plains[ 3 ], &heap );
+		FirstHeapElement( &first, &heap );
+		check( first == &plains[ 3 ] );
+		RemoveHeapElement( &plains[ 0 ], &heap );
+		check( !IsHeapElementQueued( &plains[ 0 ], &heap ) );
+		GrabFirstHeapElement( &first, &heap );
+		check( first == &plains[ 3 ] );
+		GrabFirstHeapElement( &first, &heap );
+		check( first == &plains[ 1 ] );
+		check( CountHeapElements( &heap ) == 2 );
+		DeleteElementHeap( &heap );
+	}
+
+	return( 0 );
+}
+
+	static
+	bool
+NodeBefore(
+	void	*a,
+	void	*b,
+	void	*refCon )
+{
+	(void) refCon;
+	return( ((Node*) a)->key < ((Node*) b)->key );
+}
+
+	static
+	bool
+PlainBefore(
+	void	*a,
+	void	*b,
+	void	*refCon )
+{
+	(void) refCon;
+	return( ((Plain*) a)->key < ((Plain*) b)->key );
+}
+
+	static
+	void
+CheckFirst(
+	ElementHeap	*heap,
+	int			which )
+{
+	Node	*first;
+	long	smallest = 1L << 40;
+	int		index;
+
+	for( index = 0; index < kNodes; index++ )
+		if( gNodes[ index ].which == which && gNodes[ index ].key < smallest )
+			smallest = gNodes[ index ].key;
+	FirstHeapElementType( &first, heap, Node, hook );
+	if( smallest == 1L << 40 )
+		check( first == NULL );
+	else
+		check( first && first->key == smallest );
+}
@@ -0,0 +1,159 @@
+/****************************************************************************************
+	elementallfutest.c
+
+	Tests of ElementLFUs, against a model of each entry's frequency.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random puts, touches, evictions, removals and, in the second pass, agings.
+	Every eviction must take an entry of the lowest frequency and, until
+	aging has merged buckets, the least recently touched of those.
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elementallfu.h"
+#include "elementaltest.h"
+
+#define	kNodes		500
+#define	kOperations	200000
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	int		pad;
+	Element	element;
+	size_t	frequency;
+	long	touched;
+	bool	live;
+};
+
+static	Node	gNodes[ kNodes ];
+
+	static
+	void
+CheckFrequencies(
+	ElementLFU	*lfu );
+
+	int
+main( void )
+{
+	uint64_t	random = 3;
+	int			aging;
+
+	for( aging = 0; aging < 2; aging++ ) {
+		ElementLFU	lfu;
+		size_t		live = 0;
+		long		now;
+		Node		*node;
+		int			index;
+
+		memset( gNodes, 0, sizeof( gNodes ) );
+		NewElementLFUType( &lfu, Node, element, 0 );
+		EvictLFUElementType( &node, &lfu );
+		check( node == NULL );
+
+		for( now = 0; now < kOperations; now++ ) {
+			int			which = (int) (TestRandom( &random ) % kNodes);
+			unsigned	choice = (unsigned) (TestRandom( &random ) % 20);
+
+			node = &gNodes[ which ];
+			if( choice < 5 ) {
+				if( !node->live ) {
+					check( PutLFUElement( node, &lfu ) );
+					node->live = true;
+					node->frequency = 1;
+					node->touched = now;
+					live++;
+				}
+			} else if( choice < 15 ) {
+				if( node->live ) {
+					check( TouchLFUElement( node, &lfu ) );
+					node->frequency++;
+					node->touched = now;
+				}
+			} else if( choice < 17 ) {
+				EvictLFUElementType( &node, &lfu );
+				check( (node != NULL) == (live != 0) );
+				if( node ) {
+					for( index = 0; index < kNodes; index++ ) {
+						Node	*other = &gNodes[ index ];
+
+						if( !other->live || other == node )
+							continue;
+						check( other->frequency >= node->frequency );
+						if( !aging && other->frequency == node->frequency )
+							check( other->touched > node->touched );
+					}
+					check( GetElementList( &node->element ) == NULL );
+					node->live = false;
+					live--;
+				}
+			} else if( choice < 19 ) {
+				if( node->live ) {
+					RemoveLFUElement( node, &lfu );
+					node->live = false;
+					live--;
+				}
+			} else if( aging ) {
+				AgeElementLFU( &lfu );
+				for( index = 0; index < kNodes; index++ )
+					gNodes[ index ].frequency = (gNodes[ index ].frequency + 1) / 2;
+			}
+			check( CountLFUElements( &lfu ) == live );
+			if( now % 1000 == 0 )
+				CheckFrequencies( &lfu );
+		}
+		CheckFrequencies( &lfu );
+
+		while( EvictLFUElementType( &node, &lfu ), node )
+			live--;
+		check( live == 0 && IsListEmpty( &lfu.frequencies ) );
+		DeleteElementLFU( &lfu );
+	}
+
+	//	Automatic aging, every 4 touches.
+	{
+		ElementLFU	lfu;
+
+		memset( gNodes, 0, sizeof( gNodes ) );
+		NewElementLFUType( &lfu, Node, element, 4 );
+		check( PutLFUElement( &gNodes[ 0 ], &lfu ) );
+		check( PutLFUElement( &gNodes[ 1 ], &lfu ) );
+		check( TouchLFUElement( &gNodes[ 0 ], &lfu ) );
+		check( TouchLFUElement( &gNodes[ 0 ], &lfu ) );
+		check( TouchLFUElement( &gNodes[ 0 ], &lfu ) );
+		check( GetLFUElementFrequency( &gNodes[ 0 ], &lfu ) == 4 );
+		check( TouchLFUElement( &gNodes[ 0 ], &lfu ) );
+		check( GetLFUElementFrequency( &gNodes[ 0 ], &lfu ) == 3 );
+		check( GetLFUElementFrequency( &gNodes[ 1 ], &lfu ) == 1 );
+		RemoveLFUElement( &gNodes[ 0 ], &lfu );
+		RemoveLFUElement( &gNodes[ 1 ], &lfu );
+		DeleteElementLFU( &lfu );
+	}
+
+	return( 0 );
+}
+
+	static
+	void
+CheckFrequencies(
+	ElementLFU	*lfu )
+{
+	ElementFrequency	*bucket;
+	ElementFrequency	*next;
+	int					index;
+
+	for( index = 0; index < kNodes; index++ )
+		if( gNodes[ index ].live )
+			check( GetLFUElementFrequency( &gNodes[ index ], lfu ) == gNodes[ index ].frequency );
+
+	//	Buckets ascend, and none is left empty.
+	for( FirstElement( (void**) &bucket, &lfu->frequencies ); bucket; bucket = next ) {
+		NextElement( bucket, (void**) &next );
+		check( !next || next->frequency > bucket->frequency );
+		check( !IsListEmpty( &bucket->entries ) );
+	}
+}
@@ -0,0 +1,146 @@
+/****************************************************************************************
+	elementalmovetest.cpp
+
+	Tests of the C++ Element's move and copy.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	A std::vector of listed items, grown one item at a time, must keep its
+	list in order through every reallocation. Moving into an item takes the
+	source's place and leaves the source in no list; moving into a listed
+	item first takes it out of its own list, so erasing from the vector
+	unlists the erased items; a copy joins no list.
+
+	************************************************************************************/
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kItems		1000
+#define	kGrowth		5000
+
+struct	Item	{
+	int		value;
+	Element	element;
+
+	explicit Item( int value_ ) : value( value_ ) {}
+};
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*values,
+	size_t		count );
+
+	int
+main( void )
+{
+	ElementList			list;
+	ElementList			other;
+	std::vector<Item>	items;
+	std::vector<int>	values;
+
+	//	Growth moves every item, listed or not.
+	items.reserve( 1 );
+	for( int index = 0; index < kItems; index++ ) {
+		items.emplace_back( index );
+		if( index % 3 != 2 ) {
+			PutLastElementType( &items.back(), &list, Item, element );
+			values.push_back( index );
+		}
+		CheckOrder( &list, values.data(), values.size() );
+	}
+	for( int index = 0; index < kGrowth; index++ )
+		items.emplace_back( -1 );
+	CheckOrder( &list, values.data(), values.size() );
+	for( size_t index = kItems; index < items.size(); index++ )
+		check( GetElementList( &items[ index ].element ) == NULL );
+
+	//	Move construction takes the last item's place.
+	{
+		Item	moved( std::move( items[ kItems - 1 ] ) );
+
+		check( list.last == &moved.element );
+		check( GetElementList( &items[ kItems - 1 ].element ) == NULL );
+		CheckOrder( &list, values.data(), values.size() );
+		RemoveElementType( &moved, &list, Item, element );
+		values.pop_back();
+	}
+
+	//	Move assignment into an item listed elsewhere leaves that list first.
+	{
+		Item	target( -2 );
+
+		PutLastElementType( &target, &other, Item, element );
+		target = std::move( items[ 0 ] );
+		check( IsListEmpty( &other ) );
+		check( list.first == &target.element );
+		check( GetElementList( &items[ 0 ].element ) == NULL );
+		CheckOrder( &list, values.data(), values.size() );
+
+		//	Moving an item onto itself changes nothing.
+		Item	&alias = target;
+
+		target = std::move( alias );
+		check( list.first == &target.element );
+		RemoveElementType( &target, &list, Item, element );
+		values.erase( values.begin() );
+	}
+
+	//	Copies, constructed or assigned, join no list and leave their target's alone.
+	{
+		Item	copy( items[ 1 ] );
+		Item	assigned( -3 );
+
+		check( GetElementList( &copy.element ) == NULL );
+		PutLastElementType( &assigned, &other, Item, element );
+		assigned = items[ 1 ];
+		check( GetElementList( &assigned.element ) == &other && other.first == &assigned.element );
+		RemoveElementType( &assigned, &other, Item, element );
+		CheckOrder( &list, values.data(), values.size() );
+	}
+
+	//	Erasing from the front moves every later item down a slot, and the
+	//	erased items leave the list as they're overwritten.
+	items.erase( items.begin(), items.begin() + 10 );
+	while( values.front() < 10 )
+		values.erase( values.begin() );
+	CheckOrder( &list, values.data(), values.size() );
+
+	while( !IsListEmpty( &list ) )
+		RemoveElement( list.first, &list );
+
+	return( 0 );
+}
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*values,
+	size_t		count )
+{
+	Item	*item;
+	Item	*prev = NULL;
+	size_t	index = 0;
+
+	for( FirstElementType( (void**) &item, list, Item, element ); item; NextElementType( item, (void**) &item, Item, element ) ) {
+		Item	*back;
+
+		check( index < count && item->value == values[ index ] );
+		check( GetElementList( &item->element ) == list );
+		PrevElementType( item, (void**) &back, Item, element );
+		check( back == prev );
+		prev = item;
+		index++;
+	}
+	check( index == count );
+	LastElementType( (void**) &item, list, Item, element );
+	check( item == prev );
+}
@@ -0,0 +1,304 @@
+/****************************************************************************************
+	elementalparktest.c
+
+	Tests of the parking lot.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Threads parked one after another must be unparked in that order, each
+	with its token, and a validateProc saying no must keep a thread from
+	parking. Parkers with deadlines of microseconds race threads unparking
+	them all: every park that succeeds must have been counted by exactly one
+	UnparkAllAddress(), and no other. Last, a fair lock built as the header
+	describes must exclude.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "elementalpark.h"
+#include "elementaltest.h"
+
+#define	kQueued			8
+#define	kRacers			6
+#define	kRacerParks		20000
+#define	kUnparkers		2
+#define	kLockers		4
+#define	kLocks			20000
+
+static	int			gAddress;
+static	int			gArrived;
+static	int			gRacersLeft;
+static	size_t		gParked;
+static	size_t		gUnparked;
+static	unsigned	gLock;		//	Bit 0 locked, bit 1 someone parked.
+static	long		gCounter;
+
+	static
+	void*
+ParkInOrder(
+	void	*refCon );
+
+	static
+	void*
+ParkBriefly(
+	void	*refCon );
+
+	static
+	void*
+UnparkAll(
+	void	*refCon );
+
+	static
+	void*
+Locker(
+	void	*refCon );
+
+	static
+	bool
+CountArrival(
+	const void	*address,
+	void		*refCon );
+
+	static
+	bool
+Refuse(
+	const void	*address,
+	void		*refCon );
+
+	static
+	intptr_t
+NextToken(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon );
+
+	static
+	bool
+StillContended(
+	const void	*address,
+	void		*refCon );
+
+	static
+	intptr_t
+HandOver(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon );
+
+	int
+main( void )
+{
+	pthread_t	threads[ kQueued ];
+	pthread_t	unparkers[ kUnparkers ];
+	intptr_t	token = 0;
+	intptr_t	index;
+
+	//	First parked, first unparked.
+	for( index = 0; index < kQueued; index++ ) {
+		check( pthread_create( &threads[ index ], NULL, ParkInOrder, (void*) index ) == 0 );
+		while( __atomic_load_n( &gArrived, __ATOMIC_ACQUIRE ) <= index )
+			sched_yield();
+	}
+	for( index = 0; index < kQueued; index++ )
+		check( UnparkOneAddress( &gAddress, NextToken, &token ) );
+	for( index = 0; index < kQueued; index++ )
+		check( pthread_join( threads[ index ], NULL ) == 0 );
+	check( !UnparkOneAddress( &gAddress, NextToken, &token ) );
+	check( UnparkAllAddress( &gAddress ) == 0 );
+
+	//	Refused, and timed out.
+	{
+		struct timespec	deadline;
+
+		check( !ParkAddress( &gAddress, Refuse, NULL, NULL, NULL ) && errno == EAGAIN );
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		deadline.tv_nsec += 1000000;
+		if( deadline.tv_nsec >= 1000000000 ) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+		check( !ParkAddress( &gAddress, NULL, NULL, &deadline, NULL ) && errno == ETIMEDOUT );
+	}
+
+	//	Timed parks against UnparkAllAddress().
+	gRacersLeft = kRacers;
+	for( index = 0; index < kUnparkers; index++ )
+		check( pthread_create( &unparkers[ index ], NULL, UnparkAll, NULL ) == 0 );
+	for( index = 0; index < kRacers; index++ )
+		check( pthread_create( &threads[ index ], NULL, ParkBriefly, NULL ) == 0 );
+	for( index = 0; index < kRacers; index++ )
+		check( pthread_join( threads[ index ], NULL ) == 0 );
+	for( index = 0; index < kUnparkers; index++ )
+		check( pthread_join( unparkers[ index ], NULL ) == 0 );
+	check( gParked == gUnparked );
+	check( gParked > 0 );
+
+	//	A fair lock.
+	for( index = 0; index < kLockers; index++ )
+		check( pthread_create( &threads[ index ], NULL, Locker, NULL ) == 0 );
+	for( index = 0; index < kLockers; index++ )
+		check( pthread_join( threads[ index ], NULL ) == 0 );
+	check( gCounter == kLockers * kLocks && gLock == 0 );
+
+	return( 0 );
+}
+
+	static
+	void*
+ParkInOrder(
+	void	*refCon )
+{
+	intptr_t	token = -1;
+
+	check( ParkAddress( &gAddress, CountArrival, NULL, NULL, &token ) );
+	check( token == (intptr_t) refCon );
+	return( NULL );
+}
+
+	static
+	void*
+ParkBriefly(
+	void	*refCon )
+{
+	size_t	parked = 0;
+	int		index;
+
+	(void) refCon;
+	for( index = 0; index < kRacerParks; index++ ) {
+		struct timespec	deadline;
+
+		clock_gettime( CLOCK_MONOTONIC, &deadline );
+		deadline.tv_nsec += 20000;
+		if( deadline.tv_nsec >= 1000000000 ) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+		if( ParkAddress( &gAddress, NULL, NULL, &deadline, NULL ) )
+			parked++;
+		else
+			check( errno == ETIMEDOUT );
+	}
+	__atomic_add_fetch( &gParked, parked, __ATOMIC_RELAXED );
+	__atomic_sub_fetch( &gRacersLeft, 1, __ATOMIC_RELEASE );
+	return( NULL );
+}
+
+	static
+	void*
+UnparkAll(
+	void	*refCon )
+{
+	size_t	unparked = 0;
+
+	(void) refCon;
+	while( __atomic_load_n( &gRacersLeft, __ATOMIC_ACQUIRE ) ) {
+		unparked += UnparkAllAddress( &gAddress );
+		sched_yield();
+	}
+	__atomic_add_fetch( &gUnparked, unparked, __ATOMIC_RELAXED );
+	return( NULL );
+}
+
+	static
+	bool
+CountArrival(
+	const void	*address,
+	void		*refCon )
+{
+	(void) address;
+	(void) refCon;
+	__atomic_add_fetch( &gArrived, 1, __ATOMIC_RELEASE );
+	return( true );
+}
+
+	static
+	bool
+Refuse(
+	const void	*address,
+	void		*refCon )
+{
+	(void) address;
+	(void) refCon;
+	return( false );
+}
+
+	static
+	intptr_t
+NextToken(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon )
+{
+	intptr_t	*token = (intptr_t*) refCon;
+
+	(void) address;
+	if( !unparked )
+		return( 0 );
+	check( moreParked == (*token < kQueued - 1) );
+	return( (*token)++ );
+}
+
+	static
+	bool
+StillContended(
+	const void	*address,
+	void		*refCon )
+{
+	(void) refCon;
+	return( __atomic_load_n( (unsigned*) address, __ATOMIC_RELAXED ) == 3 );
+}
+
+	static
+	intptr_t
+HandOver(
+	const void	*address,
+	bool		unparked,
+	bool		moreParked,
+	void		*refCon )
+{
+	(void) refCon;
+	__atomic_store_n( (unsigned*) address, unparked ? (moreParked ? 3u : 1u) : 0u, __ATOMIC_RELEASE );
+	return( unparked );
+}
+
+	static
+	void*
+Locker(
+	void	*refCon )
+{
+	int	index;
+
+	(void) refCon;
+	for( index = 0; index < kLocks; index++ ) {
+		for( ;; ) {
+			unsigned	word = __atomic_load_n( &gLock, __ATOMIC_RELAXED );
+			intptr_t	token = 0;
+
+			if( !(word & 1) ) {
+				if( __atomic_compare_exchange_n( &gLock, &word, word | 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+					break;
+				continue;
+			}
+			if( !(word & 2) && !__atomic_compare_exchange_n( &gLock, &word, 3, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+				continue;
+			if( ParkAddress( &gLock, StillContended, NULL, NULL, &token ) && token == 1 )
+				break;
+		}
+		gCounter++;
+		{
+			unsigned	locked = 1;
+
+			if( !__atomic_compare_exchange_n( &gLock, &locked, 0, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
+				UnparkOneAddress( &gLock, HandOver, NULL );
+		}
+	}
+	return( NULL );
+}
@@ -0,0 +1,230 @@
+/****************************************************************************************
+	elementalpersistenttest.c
+
+	Tests of PersistentElementLists, against a model, across crashes.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random puts, updates, removes and grabs must match the model through
+	close and reopen. A child that dies without closing must leave exactly
+	what it last synced; a torn log tail and a creation interrupted before
+	its rename must both be harmless. Syncing by hand must still checkpoint
+	once the log passes elementalPersistentLogLimit.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "elementalpersistent.h"
+#include "elementaltest.h"
+
+#define	kPath		"elementalpersistenttest.dat"
+#define	kCapacity	1000
+
+typedef	struct	Item	Item;
+typedef	struct	Model	Model;
+
+struct	Item	{
+	uint64_t	key;
+	char		pad[ 16 ];
+};
+
+struct	Model	{
+	size_t				count;
+	uint64_t			keys[ kCapacity ];
+	PersistentOffset	offsets[ kCapacity ];
+};
+
+static	Model	gModel;
+static	Model	*gSynced;	//	Shared with the crashing child.
+
+	static
+	void
+RemoveFiles( void );
+
+	static
+	void
+RunOperations(
+	PersistentElementList	*list,
+	uint64_t				*random,
+	uint64_t				*nextKey,
+	size_t					count,
+	size_t					syncEvery );
+
+	static
+	void
+CheckModel(
+	PersistentElementList	*list );
+
+	int
+main( void )
+{
+	PersistentElementList	list;
+	uint64_t				random = 11;
+	uint64_t				nextKey = 1;
+	struct stat				status;
+	pid_t					child;
+	int						result;
+	int						fd;
+
+	RemoveFiles();
+
+	//	A creation that died before its rename left only scratch behind.
+	fd = open( kPath ".new", O_WRONLY | O_CREAT, 0644 );
+	check( fd >= 0 && write( fd, "torn", 4 ) == 4 );
+	close( fd );
+	check( OpenPersistentElementList( &list, kPath, sizeof( Item ), kCapacity, 7 ) );
+	check( CountPersistentElements( &list ) == 0 );
+	check( stat( kPath ".new", &status ) != 0 && errno == ENOENT );
+
+	RunOperations( &list, &random, &nextKey, 20000, 0 );
+	CheckModel( &list );
+	check( ClosePersistentElementList( &list ) );
+
+	check( !OpenPersistentElementList( &list, kPath, sizeof( Item ) + 8, kCapacity, 7 ) && errno == EINVAL );
+
+	//	A crash keeps what was synced, loses only what wasn't, and drops a
+	//	record torn at the log's tail.
+	gSynced = (Model*) mmap( NULL, sizeof( Model ), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+	check( gSynced != MAP_FAILED );
+	*gSynced = gModel;
+	child = fork();
+	check( child >= 0 );
+	if( child == 0 ) {
+		check( OpenPersistentElementList( &list, kPath, sizeof( Item ), kCapacity, 0 ) );
+		CheckModel( &list );
+		RunOperations( &list, &random, &nextKey, 5000, 100 );
+		RunOperations( &list, &random, &nextKey, 50, 0 );
+		check( write( list.logFD, "\100\0\0\0garbage", 11 ) == 11 );
+		_exit( 0 );
+	}
+	check( waitpid( child, &result, 0 ) == child && WIFEXITED( result ) && WEXITSTATUS( result ) == 0 );
+	gModel = *gSynced;
+	nextKey += 100000;
+	check( OpenPersistentElementList( &list, kPath, sizeof( Item ), kCapacity, 7 ) );
+	CheckModel( &list );
+	check( ClosePersistentElementList( &list ) );
+
+	//	Syncing by hand, with no batch, still bounds the log.
+	{
+		bool	shrank = false;
+		off_t	before = 0;
+		size_t	round;
+
+		check( OpenPersistentElementList( &list, kPath, sizeof( Item ), kCapacity, 0 ) );
+		for( round = 0; !shrank || round < 3; round++ ) {
+			RunOperations( &list, &random, &nextKey, 1000, 0 );
+			check( SyncPersistentElementList( &list ) );
+			check( fstat( list.logFD, &status ) == 0 );
+			check( status.st_size <= elementalPersistentLogLimit );
+			shrank |= status.st_size < before;
+			before = status.st_size;
+			check( round < 2000 );
+		}
+		CheckModel( &list );
+		check( ClosePersistentElementList( &list ) );
+	}
+
+	munmap( gSynced, sizeof( Model ) );
+	RemoveFiles();
+	return( 0 );
+}
+
+	static
+	void
+RemoveFiles( void )
+{
+	unlink( kPath );
+	unlink( kPath ".log" );
+	unlink( kPath ".new" );
+}
+
+	static
+	void
+RunOperations(
+	PersistentElementList	*list,
+	uint64_t				*random,
+	uint64_t				*nextKey,
+	size_t					count,
+	size_t					syncEvery )
+{
+	size_t	operation;
+
+	for( operation = 1; operation <= count; operation++ ) {
+		unsigned	choice = (unsigned) (TestRandom( random ) % 10);
+		size_t		index = gModel.count ? (size_t) (TestRandom( random ) % gModel.count) : 0;
+		Item		item;
+
+		memset( &item, 0, sizeof( item ) );
+		if( choice < 4 && gModel.count < kCapacity ) {
+			PersistentOffset	element;
+			bool				first = choice < 2;
+
+			item.key = (*nextKey)++;
+			if( first )
+				PutFirstPersistentElement( &element, &item, list );
+			else
+				PutLastPersistentElement( &element, &item, list );
+			check( element != 0 );
+			index = first ? 0 : gModel.count;
+			memmove( &gModel.keys[ index + 1 ], &gModel.keys[ index ], (gModel.count - index) * sizeof( uint64_t ) );
+			memmove( &gModel.offsets[ index + 1 ], &gModel.offsets[ index ], (gModel.count - index) * sizeof( PersistentOffset ) );
+			gModel.keys[ index ] = item.key;
+			gModel.offsets[ index ] = element;
+			gModel.count++;
+		} else if( choice < 6 && gModel.count ) {
+			item.key = (*nextKey)++;
+			check( UpdatePersistentElement( gModel.offsets[ index ], &item, list ) );
+			gModel.keys[ index ] = item.key;
+		} else if( gModel.count ) {
+			if( choice < 8 ) {
+				check( GrabFirstPersistentElement( &item, list ) );
+				check( item.key == gModel.keys[ 0 ] );
+				index = 0;
+			} else
+				check( RemovePersistentElement( gModel.offsets[ index ], list ) );
+			gModel.count--;
+			memmove( &gModel.keys[ index ], &gModel.keys[ index + 1 ], (gModel.count - index) * sizeof( uint64_t ) );
+			memmove( &gModel.offsets[ index ], &gModel.offsets[ index + 1 ], (gModel.count - index) * sizeof( PersistentOffset ) );
+		}
+		check( CountPersistentElements( list ) == gModel.count );
+
+		if( syncEvery && operation % syncEvery == 0 ) {
+			check( SyncPersistentElementList( list ) );
+			*gSynced = gModel;
+		}
+	}
+}
+
+	static
+	void
+CheckModel(
+	PersistentElementList	*list )
+{
+	PersistentOffset	element;
+	PersistentOffset	prev = 0;
+	size_t				index = 0;
+
+	check( CountPersistentElements( list ) == gModel.count );
+	for( FirstPersistentElement( &element, list ); element; NextPersistentElement( element, &element, list ) ) {
+		PersistentOffset	back;
+
+		check( index < gModel.count );
+		check( element == gModel.offsets[ index ] );
+		check( ((const Item*) GetPersistentElementData( element, list ))->key == gModel.keys[ index ] );
+		PrevPersistentElement( element, &back, list );
+		check( back == prev );
+		prev = element;
+		index++;
+	}
+	check( index == gModel.count );
+	LastPersistentElement( &element, list );
+	check( element == prev );
+}
@@ -0,0 +1,142 @@
+/****************************************************************************************
+	elementalrcutest.c
+
+	Tests of read-mostly lists: readers walking while a writer churns.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Reclaimed nodes are poisoned before they are freed, so a reader that
+	reaches one before its grace period is over fails the test (and, under
+	AddressSanitizer, a reader that reaches one after is caught too).
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "elementalrcu.h"
+#include "elementaltest.h"
+
+#define	kReaders		4
+#define	kOperations		200000
+#define	kPoison			-1
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	int		value;
+	Element	element;
+};
+
+static	ElementList		gList;
+static	ElementEpoch	gEpoch;
+static	ElementReader	gReaders[ kReaders ];
+static	int				gStop;
+static	long			gReclaimed;
+
+	static
+	void
+ReclaimNode(
+	void	*element,
+	void	*refCon );
+
+	static
+	void*
+Reader(
+	void	*refCon );
+
+	int
+main( void )
+{
+	pthread_t	threads[ kReaders ];
+	Node		*node;
+	long		removed = 0;
+	int			index;
+
+	NewElementList( &gList );
+	NewElementEpoch( &gEpoch, ReclaimNode, NULL, offsetof( Node, element ) );
+
+	//	Order, single-threaded.
+	for( index = 0; index < 4; index++ ) {
+		node = (Node*) calloc( 1, sizeof( Node ) );
+		node->value = index;
+		PutLastElementRCU( &node->element, &gList );
+	}
+	FirstElementRCUType( &node, &gList, Node, element );
+	for( index = 0; node; index++, NextElementRCUType( node, &node, Node, element ) )
+		check( node->value == index );
+	check( index == 4 );
+
+	for( index = 0; index < kReaders; index++ )
+		RegisterElementReader( &gReaders[ index ], &gEpoch );
+	for( index = 0; index < kReaders; index++ )
+		check( pthread_create( &threads[ index ], NULL, Reader, &gReaders[ index ] ) == 0 );
+
+	for( index = 0; index < kOperations; index++ ) {
+		node = (Node*) calloc( 1, sizeof( Node ) );
+		node->value = index;
+		switch( index % 4 ) {
+			case 0:	PutFirstElementRCU( &node->element, &gList );	break;
+			case 1:	PutLastElementRCU( &node->element, &gList );	break;
+			case 2:	PutAfterElementRCU( &node->element, gList.first, &gList );	break;
+			case 3:	PutBeforeElementRCU( &node->element, gList.last, &gList );	break;
+		}
+		if( index > 64 ) {
+			RemoveElementRCU( (index & 1) ? gList.first : gList.last, &gList, &gEpoch );
+			removed++;
+		}
+	}
+
+	__atomic_store_n( &gStop, 1, __ATOMIC_RELEASE );
+	for( index = 0; index < kReaders; index++ )
+		pthread_join( threads[ index ], NULL );
+
+	SynchronizeElementEpoch( &gEpoch );
+	check( gReclaimed == removed );
+
+	while( gList.first ) {
+		RemoveElementRCU( gList.first, &gList, &gEpoch );
+		removed++;
+	}
+	for( index = 0; index < kReaders; index++ )
+		UnregisterElementReader( &gReaders[ index ] );
+	DeleteElementEpoch( &gEpoch );
+	check( gReclaimed == removed );
+	check( gList.last == NULL );
+
+	DeleteElementList( &gList );
+	return( 0 );
+}
+
+	static
+	void
+ReclaimNode(
+	void	*element,
+	void	*refCon )
+{
+	Node	*node = (Node*) element;
+
+	(void) refCon;
+	node->value = kPoison;
+	free( node );
+	gReclaimed++;
+}
+
+	static
+	void*
+Reader(
+	void	*refCon )
+{
+	ElementReader	*reader = (ElementReader*) refCon;
+	Node			*node;
+
+	while( !__atomic_load_n( &gStop, __ATOMIC_ACQUIRE ) ) {
+		EnterElementEpoch( reader );
+		for( FirstElementRCUType( &node, &gList, Node, element ); node;
+			 NextElementRCUType( node, &node, Node, element ) )
+			check( node->value != kPoison );
+		ExitElementEpoch( reader );
+	}
+	return( NULL );
+}
@@ -0,0 +1,222 @@
+/****************************************************************************************
+	elementalreactortest.c
+
+	Tests of ElementReactors over socketpairs.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	An echo connection with a tiny send buffer must return every byte, in
+	order, through blocked writes; output pended many times in a pass must be
+	flushed once; a proc may remove another ready connection; idle and
+	hung-up connections must be reported.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "elementalreactor.h"
+#include "elementaltest.h"
+
+#define	kEchoBytes	200000
+
+typedef	struct	Echo	Echo;
+
+struct	Echo	{
+	ElementConnection	connection;
+	char				*out;
+	size_t				outLength;
+	size_t				outOffset;
+	int					reads;
+	int					flushes;
+	int					idles;
+	int					hangups;
+	bool				closed;
+	Echo				*victim;		//	Removed by this one's next read.
+};
+
+static	ElementReactor	gReactor;
+
+	static
+	void
+EchoProc(
+	ElementConnection	*connection,
+	unsigned			events,
+	void				*refCon );
+
+	static
+	void
+OpenPair(
+	int	pair[ 2 ] );
+
+	static
+	void
+CloseEcho(
+	Echo	*echo );
+
+	int
+main( void )
+{
+	Echo	echo;
+	Echo	other;
+	int		pair[ 2 ];
+	int		otherPair[ 2 ];
+	char	buffer[ 8192 ];
+	size_t	sent = 0;
+	size_t	got = 0;
+	int		size = 4096;
+	int		passes;
+
+	check( NewElementReactor( &gReactor, 200 ) );
+
+	//	Echo through a small send buffer, so the reactor has to wait for it to drain.
+	memset( &echo, 0, sizeof( echo ) );
+	echo.out = (char*) malloc( kEchoBytes );
+	OpenPair( pair );
+	check( setsockopt( pair[ 0 ], SOL_SOCKET, SO_SNDBUF, &size, sizeof( size ) ) == 0 );
+	check( AddReactorConnection( &echo.connection, &gReactor, pair[ 0 ], EchoProc, NULL ) );
+	while( got < kEchoBytes ) {
+		ssize_t	count;
+		size_t	index;
+
+		if( sent < kEchoBytes ) {
+			size_t	chunk = kEchoBytes - sent < sizeof( buffer ) ? kEchoBytes - sent : sizeof( buffer );
+
+			for( index = 0; index < chunk; index++ )
+				buffer[ index ] = (char) (sent + index);
+			count = write( pair[ 1 ], buffer, chunk );
+			if( count > 0 )
+				sent += (size_t) count;
+		}
+		check( RunReactorOnce( &gReactor, 10 ) );
+		while( (count = read( pair[ 1 ], buffer, sizeof( buffer ) )) > 0 ) {
+			for( index = 0; index < (size_t) count; index++ )
+				check( buffer[ index ] == (char) (got + index) );
+			got += (size_t) count;
+		}
+	}
+	check( echo.outOffset == echo.outLength );
+
+	//	Pended many times in one pass, flushed once.
+	echo.flushes = 0;
+	PendReactorWrite( &echo.connection, &gReactor );
+	PendReactorWrite( &echo.connection, &gReactor );
+	PendReactorWrite( &echo.connection, &gReactor );
+	check( RunReactorOnce( &gReactor, 0 ) );
+	check( echo.flushes == 1 );
+
+	//	A proc may remove a connection that is waiting its turn on the ready list.
+	memset( &other, 0, sizeof( other ) );
+	other.out = (char*) malloc( kEchoBytes );
+	OpenPair( otherPair );
+	check( AddReactorConnection( &other.connection, &gReactor, otherPair[ 0 ], EchoProc, NULL ) );
+	echo.victim = &other;
+	other.victim = &echo;
+	check( write( pair[ 1 ], "a", 1 ) == 1 );
+	check( write( otherPair[ 1 ], "b", 1 ) == 1 );
+	check( RunReactorOnce( &gReactor, 100 ) );
+	check( echo.closed != other.closed );
+	{
+		Echo	*survivor = echo.closed ? &other : &echo;
+		int		peer = echo.closed ? otherPair[ 1 ] : pair[ 1 ];
+
+		check( survivor->reads > 0 && survivor->victim == NULL );
+		check( read( peer, buffer, sizeof( buffer ) ) == 1 );
+
+		//	Idle: nothing happens for 200ms, then the proc hears of it.
+		for( passes = 0; passes < 40 && !survivor->closed; passes++ )
+			check( RunReactorOnce( &gReactor, -1 ) );
+		check( survivor->idles == 1 && survivor->closed );
+	}
+	close( pair[ 1 ] );
+	close( otherPair[ 1 ] );
+
+	//	Hangup: the peer goes away.
+	memset( &other, 0, sizeof( other ) );
+	other.out = (char*) malloc( kEchoBytes );
+	OpenPair( otherPair );
+	check( AddReactorConnection( &other.connection, &gReactor, otherPair[ 0 ], EchoProc, NULL ) );
+	close( otherPair[ 1 ] );
+	check( RunReactorOnce( &gReactor, 100 ) );
+	check( other.closed && other.hangups == 1 );
+	check( IsListEmpty( &gReactor.idle ) && IsListEmpty( &gReactor.ready ) );
+
+	free( echo.out );
+	DeleteElementReactor( &gReactor );
+	return( 0 );
+}
+
+	static
+	void
+EchoProc(
+	ElementConnection	*connection,
+	unsigned			events,
+	void				*refCon )
+{
+	Echo	*echo = (Echo*) connection;
+	ssize_t	count = 1;
+
+	(void) refCon;
+	if( events & elementalIdle ) {
+		echo->idles++;
+		CloseEcho( echo );
+		return;
+	}
+	if( events & (elementalReadable | elementalHangup) ) {
+		echo->reads++;
+		if( echo->victim ) {
+			CloseEcho( echo->victim );
+			echo->victim->victim = NULL;
+			echo->victim = NULL;
+		}
+		while( echo->outLength < kEchoBytes
+				&& (count = read( connection->fd, echo->out + echo->outLength, kEchoBytes - echo->outLength )) > 0 )
+			echo->outLength += (size_t) count;
+		if( count == 0 || (count < 0 && errno != EAGAIN) ) {
+			echo->hangups++;
+			CloseEcho( echo );
+			return;
+		}
+		if( echo->outLength > echo->outOffset )
+			PendReactorWrite( connection, &gReactor );
+	}
+	if( events & elementalWritable ) {
+		echo->flushes++;
+		while( echo->outOffset < echo->outLength ) {
+			count = write( connection->fd, echo->out + echo->outOffset, echo->outLength - echo->outOffset );
+			if( count < 0 ) {
+				check( errno == EAGAIN );
+				PendReactorWrite( connection, &gReactor );
+				return;
+			}
+			echo->outOffset += (size_t) count;
+		}
+		echo->outOffset = echo->outLength = 0;
+	}
+}
+
+	static
+	void
+OpenPair(
+	int	pair[ 2 ] )
+{
+	check( socketpair( AF_UNIX, SOCK_STREAM, 0, pair ) == 0 );
+	check( fcntl( pair[ 0 ], F_SETFL, O_NONBLOCK ) == 0 );
+	check( fcntl( pair[ 1 ], F_SETFL, O_NONBLOCK ) == 0 );
+}
+
+	static
+	void
+CloseEcho(
+	Echo	*echo )
+{
+	RemoveReactorConnection( &echo->connection, &gReactor );
+	close( echo->connection.fd );
+	echo->closed = true;
+	free( echo->out );
+	echo->out = NULL;
+}
@@ -0,0 +1,67 @@
+/****************************************************************************************
+	elementalregistryplugins.cpp
+
+	The C++ half of elementalregistrytest.c.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Registers handlers and plugins from C++, and links a list at compile
+	time, all constinit, which refuses anything that would run code. A
+	constructor that runs before main walks the plugins registry.
+
+	************************************************************************************/
+
+#include <cstddef>
+
+#include "elemental.h"
+
+struct	Plugin	{
+	Element	element;
+	int		id;
+};
+
+DeclareElementRegistry( Plugins );
+
+extern "C" {
+	extern	size_t		gPluginsBeforeMain;
+	ElementList			*GetPluginTable( void );
+}
+
+size_t	gPluginsBeforeMain;
+
+static	constinit	Plugin	gHandlers[ 3 ] = { { Element(), 100 }, { Element(), 101 }, { Element(), 102 } };
+static	constinit	Plugin	gPlugins[ 2 ] = { { Element(), 0 }, { Element(), 1 } };
+
+RegisterElement( Handlers, &gHandlers[ 0 ].element );
+RegisterElement( Handlers, &gHandlers[ 1 ].element ); RegisterElement( Handlers, &gHandlers[ 2 ].element );
+RegisterElement( Plugins, &gPlugins[ 0 ].element );
+RegisterElement( Plugins, &gPlugins[ 1 ].element );
+
+//	Linked at compile time.
+extern	ElementList			gPluginTable;
+static	constinit	Plugin	gPluginTableEntries[ 4 ] = {
+	{ ElementInitializer( &gPluginTableEntries[ 1 ].element, NULL, &gPluginTable ), 200 },
+	{ ElementInitializer( &gPluginTableEntries[ 2 ].element, &gPluginTableEntries[ 0 ].element, &gPluginTable ), 201 },
+	{ ElementInitializer( &gPluginTableEntries[ 3 ].element, &gPluginTableEntries[ 1 ].element, &gPluginTable ), 202 },
+	{ ElementInitializer( NULL, &gPluginTableEntries[ 2 ].element, &gPluginTable ), 203 } };
+constinit	ElementList		gPluginTable = ElementListInitializer( &gPluginTableEntries[ 0 ].element,
+								&gPluginTableEntries[ 3 ].element );
+
+//	Runs before main, in no particular order with anything else.
+struct	CountPlugins	{
+	CountPlugins() {
+		void	*element;
+
+		for( FirstElement( &element, GetPluginsRegistry() ); element; NextElement( element, &element ) )
+			gPluginsBeforeMain++;
+	}
+};
+
+static	CountPlugins	gCountPlugins;
+
+	ElementList*
+GetPluginTable( void )
+{
+	return( &gPluginTable );
+}
@@ -0,0 +1,186 @@
+/****************************************************************************************
+	elementalregistrytest.c
+
+	Tests of registries and of lists linked at compile time, from C and C++.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Handlers are registered here and in elementalregistryplugins.cpp, some
+	several to a line. Threads racing to stitch the registry on first use
+	must all find every handler in it exactly once, with intact links. A
+	registry nothing was filed in is empty. A C++ constructor that runs
+	before main, in whatever order, must find the plugins registry already
+	complete, and lists linked at compile time in either language must walk
+	both ways and take puts and removals like any other.
+
+	************************************************************************************/
+
+#include <pthread.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kThreads		4
+#define	kHandlers		6		//	Registered here.
+#define	kCppHandlers	3		//	Registered in elementalregistryplugins.cpp.
+#define	kPlugins		2		//	Likewise.
+
+typedef	struct	Handler	Handler;
+
+struct	Handler	{
+	Element	element;
+	int		id;
+};
+
+DefineElementRegistry( Handlers );
+DefineElementRegistry( Plugins );
+DefineElementRegistry( Unused );
+DeclareElementRegistry( Handlers );
+DeclareElementRegistry( Unused );
+
+static	Handler	gHandlers[ kHandlers ] = {
+	{ ElementInitializer( NULL, NULL, NULL ), 0 },
+	{ ElementInitializer( NULL, NULL, NULL ), 1 },
+	{ ElementInitializer( NULL, NULL, NULL ), 2 },
+	{ ElementInitializer( NULL, NULL, NULL ), 3 },
+	{ ElementInitializer( NULL, NULL, NULL ), 4 },
+	{ ElementInitializer( NULL, NULL, NULL ), 5 } };
+
+RegisterElement( Handlers, &gHandlers[ 0 ].element );
+RegisterElement( Handlers, &gHandlers[ 1 ].element );
+RegisterElement( Handlers, &gHandlers[ 2 ].element ); RegisterElement( Handlers, &gHandlers[ 3 ].element );
+
+#define	RegisterTwo( A, B )	\
+	RegisterElement( Handlers, &gHandlers[ A ].element );	\
+	RegisterElement( Handlers, &gHandlers[ B ].element )
+
+RegisterTwo( 4, 5 );
+
+//	A list linked at compile time.
+extern	ElementList	gTable;
+static	Handler		gTableHandlers[ 3 ] = {
+	{ ElementInitializer( &gTableHandlers[ 1 ].element, NULL, &gTable ), 10 },
+	{ ElementInitializer( &gTableHandlers[ 2 ].element, &gTableHandlers[ 0 ].element, &gTable ), 11 },
+	{ ElementInitializer( NULL, &gTableHandlers[ 1 ].element, &gTable ), 12 } };
+ElementList		gTable = ElementListInitializer( &gTableHandlers[ 0 ].element, &gTableHandlers[ 2 ].element );
+
+//	From elementalregistryplugins.cpp.
+extern	size_t		gPluginsBeforeMain;
+extern	ElementList	*GetPluginTable( void );
+
+	static
+	void*
+Stitch(
+	void	*refCon );
+
+	static
+	int
+HandlerID(
+	void	*element );
+
+	static
+	void
+CheckIDs(
+	ElementList	*list,
+	const int	*ids,
+	size_t		count );
+
+	int
+main( void )
+{
+	pthread_t	threads[ kThreads ];
+	ElementList	*lists[ kThreads ];
+	int			index;
+
+	//	Raced stitching.
+	check( HandlersRegistryState == 0 && IsListEmpty( &HandlersRegistry ) );
+	for( index = 0; index < kThreads; index++ )
+		check( pthread_create( &threads[ index ], NULL, Stitch, &lists[ index ] ) == 0 );
+	for( index = 0; index < kThreads; index++ ) {
+		check( pthread_join( threads[ index ], NULL ) == 0 );
+		check( lists[ index ] == &HandlersRegistry );
+	}
+	{
+		int		seen[ kHandlers + kCppHandlers ] = { 0 };
+		void	*element;
+		void	*prev = NULL;
+		size_t	count = 0;
+
+		for( FirstElement( &element, GetHandlersRegistry() ); element; NextElement( element, &element ) ) {
+			int	id = HandlerID( element );
+
+			check( (id >= 0 && id < kHandlers) || (id >= 100 && id < 100 + kCppHandlers) );
+			seen[ id < 100 ? id : id - 100 + kHandlers ]++;
+			check( GetElementList( element ) == &HandlersRegistry );
+			check( ((Element*) element)->prev == prev );
+			prev = element;
+			count++;
+		}
+		check( count == kHandlers + kCppHandlers && HandlersRegistry.last == prev );
+		for( index = 0; index < kHandlers + kCppHandlers; index++ )
+			check( seen[ index ] == 1 );
+	}
+	check( GetHandlersRegistry() == &HandlersRegistry && HandlersRegistryState == 2 );
+
+	//	Nothing registered.
+	check( IsListEmpty( GetUnusedRegistry() ) );
+
+	//	Stitched before main by a C++ constructor.
+	check( gPluginsBeforeMain == kPlugins && PluginsRegistryState == 2 );
+
+	//	Linked at compile time, in C and in C++.
+	{
+		const int	ids[] = { 10, 11, 12 };
+		const int	plugins[] = { 200, 201, 202, 203 };
+		const int	edited[] = { 10, 12, 4 };
+
+		CheckIDs( &gTable, ids, 3 );
+		CheckIDs( GetPluginTable(), plugins, 4 );
+		RemoveElement( &gTableHandlers[ 1 ], &gTable );
+		RemoveElement( &gHandlers[ 4 ], &HandlersRegistry );
+		PutLastElement( &gHandlers[ 4 ], &gTable );
+		CheckIDs( &gTable, edited, 3 );
+	}
+
+	return( 0 );
+}
+
+	static
+	void*
+Stitch(
+	void	*refCon )
+{
+	*(ElementList**) refCon = GetHandlersRegistry();
+	return( NULL );
+}
+
+//	Handlers and the C++ file's plugins share a layout.
+	static
+	int
+HandlerID(
+	void	*element )
+{
+	return( ((Handler*) element)->id );
+}
+
+	static
+	void
+CheckIDs(
+	ElementList	*list,
+	const int	*ids,
+	size_t		count )
+{
+	void	*element;
+	size_t	index = 0;
+
+	for( FirstElement( &element, list ); element; NextElement( element, &element ) ) {
+		check( index < count && HandlerID( element ) == ids[ index ] );
+		check( GetElementList( element ) == list );
+		index++;
+	}
+	check( index == count );
+	for( LastElement( &element, list ); element; PrevElement( element, &element ) )
+		check( HandlerID( element ) == ids[ --index ] );
+	check( index == 0 );
+}
@@ -0,0 +1,192 @@
+/****************************************************************************************
+	elementalrelocatetest.c
+
+	Tests of RelocateElement() and RelocateElementArena().
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Elements copied away from the front, middle and back of a list, and from a
+	list of one, must take their originals' places. An array of nodes moved
+	to a bigger one each time it fills, as realloc() would move it, and
+	threaded on two lists that also hold nodes outside it, must keep both
+	lists' orders through every move.
+
+	************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kOutside	8
+#define	kGrowths	12
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	long	value;
+	Element	element;
+};
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const long	*values,
+	size_t		count );
+
+	int
+main( void )
+{
+	ElementList	list;
+	Node		nodes[ 3 ];
+	Node		copies[ 3 ];
+	long		values[ 3 ] = { 0, 1, 2 };
+	int			index;
+
+	//	One element, first and last at once.
+	NewElementList( &list );
+	memset( nodes, 0, sizeof( nodes ) );
+	PutLastElementType( &nodes[ 0 ], &list, Node, element );
+	memcpy( &copies[ 0 ], &nodes[ 0 ], sizeof( Node ) );
+	memset( &nodes[ 0 ], 0xA5, sizeof( Node ) );
+	RelocateElementType( &nodes[ 0 ], &copies[ 0 ], Node, element );
+	check( list.first == &copies[ 0 ].element && list.last == &copies[ 0 ].element );
+	check( GetElementList( &copies[ 0 ].element ) == &list );
+	RemoveElementType( &copies[ 0 ], &list, Node, element );
+	check( IsListEmpty( &list ) );
+
+	//	Front, middle and back, each to its own new home. The originals are
+	//	scribbled over first: relocation must not read them.
+	memset( nodes, 0, sizeof( nodes ) );
+	for( index = 0; index < 3; index++ ) {
+		nodes[ index ].value = index;
+		PutLastElementType( &nodes[ index ], &list, Node, element );
+	}
+	for( index = 0; index < 3; index++ ) {
+		memcpy( &copies[ index ], &nodes[ index ], sizeof( Node ) );
+		memset( &nodes[ index ], 0xA5, sizeof( Node ) );
+		RelocateElement( &nodes[ index ].element, &copies[ index ].element );
+		CheckOrder( &list, values, 3 );
+	}
+	check( list.first == &copies[ 0 ].element && list.last == &copies[ 2 ].element );
+
+	//	A copy of an element in no list is left alone.
+	memset( &nodes[ 0 ], 0, sizeof( Node ) );
+	memcpy( &nodes[ 1 ], &nodes[ 0 ], sizeof( Node ) );
+	RelocateElementType( &nodes[ 0 ], &nodes[ 1 ], Node, element );
+	check( GetElementList( &nodes[ 1 ].element ) == NULL );
+	CheckOrder( &list, values, 3 );
+	for( index = 0; index < 3; index++ )
+		RemoveElementType( &copies[ index ], &list, Node, element );
+
+	//	An array grown as by realloc(), its nodes interleaved with outside ones on
+	//	two lists. Every third slot stays in no list.
+	{
+		ElementList	lists[ 2 ];
+		Node		outside[ kOutside ];
+		Node		*arena = NULL;
+		long		*orders[ 2 ];
+		size_t		counts[ 2 ] = { 0, 0 };
+		size_t		size = 0;
+		int			growth;
+
+		NewElementList( &lists[ 0 ] );
+		NewElementList( &lists[ 1 ] );
+		memset( outside, 0, sizeof( outside ) );
+		orders[ 0 ] = (long*) malloc( (kOutside + (4 << kGrowths)) * sizeof( long ) );
+		orders[ 1 ] = (long*) malloc( (kOutside + (4 << kGrowths)) * sizeof( long ) );
+
+		for( growth = 0; growth <= kGrowths; growth++ ) {
+			size_t	newSize = (size_t) 4 << growth;
+			Node	*grown = (Node*) malloc( newSize * sizeof( Node ) );
+			size_t	slot;
+
+			//	As realloc() would when it can't grow in place, but keeping the
+			//	old arena until it's been relocated from.
+			check( grown != NULL );
+			if( size )
+				memcpy( grown, arena, size * sizeof( Node ) );
+			RelocateElementArenaType( arena, grown, size * sizeof( Node ), Node, element );
+			free( arena );
+			arena = grown;
+			CheckOrder( &lists[ 0 ], orders[ 0 ], counts[ 0 ] );
+			CheckOrder( &lists[ 1 ], orders[ 1 ], counts[ 1 ] );
+
+			memset( &arena[ size ], 0, (newSize - size) * sizeof( Node ) );
+			for( slot = size; slot < newSize; slot++ ) {
+				int	which = (int) (slot % 3);
+
+				arena[ slot ].value = (long) slot;
+				if( which == 2 )
+					continue;
+				//	Half at the front, half at the back.
+				if( slot & 4 ) {
+					PutFirstElementType( &arena[ slot ], &lists[ which ], Node, element );
+					memmove( &orders[ which ][ 1 ], &orders[ which ][ 0 ], counts[ which ] * sizeof( long ) );
+					orders[ which ][ 0 ] = (long) slot;
+				} else {
+					PutLastElementType( &arena[ slot ], &lists[ which ], Node, element );
+					orders[ which ][ counts[ which ] ] = (long) slot;
+				}
+				counts[ which ]++;
+			}
+			if( growth < kOutside ) {
+				outside[ growth ].value = -1 - growth;
+				PutFirstElementType( &outside[ growth ], &lists[ growth & 1 ], Node, element );
+				memmove( &orders[ growth & 1 ][ 1 ], &orders[ growth & 1 ][ 0 ], counts[ growth & 1 ] * sizeof( long ) );
+				orders[ growth & 1 ][ 0 ] = -1 - growth;
+				counts[ growth & 1 ]++;
+			}
+			size = newSize;
+		}
+		CheckOrder( &lists[ 0 ], orders[ 0 ], counts[ 0 ] );
+		CheckOrder( &lists[ 1 ], orders[ 1 ], counts[ 1 ] );
+
+		//	An arena that grew in place needs nothing done.
+		RelocateElementArenaType( arena, arena, size * sizeof( Node ), Node, element );
+		CheckOrder( &lists[ 0 ], orders[ 0 ], counts[ 0 ] );
+		CheckOrder( &lists[ 1 ], orders[ 1 ], counts[ 1 ] );
+
+		for( index = 0; index < 2; index++ ) {
+			void	*grabbed;
+
+			for( GrabFirstElement( &grabbed, &lists[ index ] ); grabbed; GrabFirstElement( &grabbed, &lists[ index ] ) )
+				;
+			DeleteElementList( &lists[ index ] );
+			free( orders[ index ] );
+		}
+		free( arena );
+	}
+
+	DeleteElementList( &list );
+	return( 0 );
+}
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const long	*values,
+	size_t		count )
+{
+	Node	*node;
+	Node	*prev = NULL;
+	size_t	index = 0;
+
+	for( FirstElementType( &node, list, Node, element ); node; NextElementType( node, (void**) &node, Node, element ) ) {
+		Node	*back;
+
+		check( index < count && node->value == values[ index ] );
+		check( GetElementList( &node->element ) == list );
+		PrevElementType( node, (void**) &back, Node, element );
+		check( back == prev );
+		prev = node;
+		index++;
+	}
+	check( index == count );
+	LastElementType( (void**) &node, list, Node, element );
+	check( node == prev );
+}
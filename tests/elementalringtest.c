@@ -0,0 +1,131 @@
+/****************************************************************************************
+	elementalringtest.c
+
+	Tests of the sentinel ring: putters, accessors, grabbers and reordering.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elementalring.h"
+#include "elementaltest.h"
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	int		value;
+	Element	element;
+};
+
+	static
+	void
+CheckOrder(
+	ElementRing	*ring,
+	const int	*expected,
+	int			count );
+
+	int
+main( void )
+{
+	ElementRing	ring;
+	Item		items[ 8 ];
+	Item		*item;
+	void		*element;
+	int			index;
+
+	memset( items, 0, sizeof( items ) );
+	for( index = 0; index < 8; index++ )
+		items[ index ].value = index;
+	NewElementRing( &ring );
+	check( IsRingEmpty( &ring ) );
+	FirstRingElement( &element, &ring );
+	check( element == NULL );
+
+	//	Reordering an empty or one-element ring changes nothing.
+	RotateElementRing( &ring );
+	SwapElementRingEnds( &ring );
+	check( IsRingEmpty( &ring ) );
+	PutLastRingElementType( &items[ 1 ], &ring, Item, element );
+	RotateElementRing( &ring );
+	RotateElementRingBack( &ring );
+	SwapElementRingEnds( &ring );
+	{
+		const int	expected[] = { 1 };
+		CheckOrder( &ring, expected, 1 );
+	}
+
+	//	Putters, through the Type macros.
+	PutFirstRingElementType( &items[ 0 ], &ring, Item, element );
+	PutLastRingElementType( &items[ 3 ], &ring, Item, element );
+	PutBeforeRingElementType( &items[ 2 ], &items[ 3 ], &ring, Item, element );
+	PutAfterRingElementType( &items[ 4 ], &items[ 3 ], &ring, Item, element );
+	PutBeforeRingElementType( &items[ 5 ], NULL, &ring, Item, element );
+	PutAfterRingElementType( &items[ 6 ], NULL, &ring, Item, element );
+	{
+		const int	expected[] = { 6, 0, 1, 2, 3, 4, 5 };
+		CheckOrder( &ring, expected, 7 );
+	}
+
+	//	Reordering.
+	RotateElementRing( &ring );
+	{
+		const int	expected[] = { 0, 1, 2, 3, 4, 5, 6 };
+		CheckOrder( &ring, expected, 7 );
+	}
+	RotateElementRingBack( &ring );
+	RotateElementRingBack( &ring );
+	{
+		const int	expected[] = { 5, 6, 0, 1, 2, 3, 4 };
+		CheckOrder( &ring, expected, 7 );
+	}
+	SwapElementRingEnds( &ring );
+	{
+		const int	expected[] = { 4, 6, 0, 1, 2, 3, 5 };
+		CheckOrder( &ring, expected, 7 );
+	}
+
+	//	Grabbers.
+	RemoveRingElementType( &items[ 0 ], Item, element );
+	GrabFirstRingElementType( &item, &ring, Item, element );
+	check( item == &items[ 4 ] );
+	GrabLastRingElementType( &item, &ring, Item, element );
+	check( item == &items[ 5 ] );
+	{
+		const int	expected[] = { 6, 1, 2, 3 };
+		CheckOrder( &ring, expected, 4 );
+	}
+
+	while( GrabLastRingElementType( &item, &ring, Item, element ), item )
+		;
+	check( IsRingEmpty( &ring ) );
+	LastRingElement( &element, &ring );
+	check( element == NULL );
+
+	DeleteElementRing( &ring );
+	return( 0 );
+}
+
+	static
+	void
+CheckOrder(
+	ElementRing	*ring,
+	const int	*expected,
+	int			count )
+{
+	Item	*item;
+	int		index = 0;
+
+	for( FirstRingElementType( &item, ring, Item, element ); item; NextRingElementType( item, &item, ring, Item, element ) ) {
+		check( index < count && item->value == expected[ index ] );
+		index++;
+	}
+	check( index == count );
+
+	//	And backwards.
+	for( LastRingElementType( &item, ring, Item, element ); item; PrevRingElementType( item, &item, ring, Item, element ) )
+		check( item->value == expected[ --index ] );
+	check( index == 0 );
+}
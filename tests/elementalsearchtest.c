@@ -0,0 +1,254 @@
+/****************************************************************************************
+	elementalsearchtest.c
+
+	Tests of FindElementByKey() and its reordering policies.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Skewed lookups, some for keys not in the list, are mixed with puts and
+	removals, for each policy in turn. After each the list must be in the
+	order a model predicts: untouched, hit first, hit swapped back one, or,
+	built with elementalSearchCounts, sorted by hits with ties oldest first
+	and puts starting over at none. Built without it, the count policy must
+	transpose, and an Element must be no more than its three pointers.
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+#define	kNodes		64
+#define	kKeys		(kNodes + 8)	//	The rest are never put.
+#define	kOperations	40000
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	Element	element;
+	int		key;
+};
+
+static	Node		gNodes[ kNodes ];
+static	int			gOrder[ kNodes ];	//	Keys, first to last.
+static	unsigned	gHits[ kNodes ];
+static	int			gCount;
+
+	static
+	int
+CompareKey(
+	void		*element,
+	const void	*key );
+
+	static
+	int
+ModelFind(
+	int	key );
+
+	static
+	void
+ModelInsert(
+	int	at,
+	int	key );
+
+	static
+	void
+ModelRemove(
+	int	key );
+
+	static
+	void
+ModelSearch(
+	int	key,
+	int	policy );
+
+	static
+	void
+CheckList(
+	ElementList	*list );
+
+	int
+main( void )
+{
+	uint64_t	random = 29;
+	int			policy;
+
+#if	!elementalSearchCounts && !elementalGenerations
+	check( sizeof( Element ) == 3 * sizeof( void* ) );
+	check( sizeof( ElementList ) == 2 * sizeof( void* ) );
+#endif
+
+	for( policy = elementSearchStatic; policy <= elementSearchCount; policy++ ) {
+		ElementList	list;
+		long		operation;
+		int			key;
+
+		memset( gNodes, 0, sizeof( gNodes ) );
+		memset( gHits, 0, sizeof( gHits ) );
+		gCount = 0;
+		NewElementList( &list );
+		for( key = 0; key < kNodes; key++ ) {
+			gNodes[ key ].key = key;
+			PutLastElement( &gNodes[ key ], &list );
+			ModelInsert( gCount, key );
+		}
+
+		for( operation = 0; operation < kOperations; operation++ ) {
+			unsigned	choice = (unsigned) (TestRandom( &random ) % 100);
+
+			//	Low keys are looked up far more often than high ones.
+			key = (int) (TestRandom( &random ) % kKeys);
+			if( TestRandom( &random ) % 2 )
+				key /= 8;
+
+			if( choice < 90 ) {
+				void	*found;
+
+				FindElementByKey( &found, &list, &key, CompareKey, policy );
+				if( key < kNodes && ModelFind( key ) >= 0 ) {
+					check( found == &gNodes[ key ] );
+					ModelSearch( key, policy );
+				} else
+					check( found == NULL );
+			} else if( choice < 95 ) {
+				if( key >= kNodes || ModelFind( key ) < 0 )
+					continue;
+				RemoveElement( &gNodes[ key ], &list );
+				ModelRemove( key );
+			} else {
+				if( key >= kNodes || ModelFind( key ) >= 0 )
+					continue;
+				if( choice % 2 ) {
+					PutFirstElement( &gNodes[ key ], &list );
+					ModelInsert( 0, key );
+				} else {
+					PutLastElement( &gNodes[ key ], &list );
+					ModelInsert( gCount, key );
+				}
+			}
+			CheckList( &list );
+		}
+
+		//	A hit moved first lands behind a cursor opened at the front, so the
+		//	cursor yields it next.
+		{
+			ElementCursor	cursor;
+			void			*found;
+
+			key = gOrder[ gCount - 1 ];
+			OpenElementCursor( &cursor, &list );
+			FindElementByKey( &found, &list, &key, CompareKey, elementSearchMoveToFront );
+			check( found == &gNodes[ key ] );
+			ModelSearch( key, elementSearchMoveToFront );
+			CheckList( &list );
+			NextCursorElement( &found, &cursor );
+			check( found == &gNodes[ key ] );
+			CloseElementCursor( &cursor );
+		}
+
+		for( key = 0; key < kNodes; key++ )
+			if( ModelFind( key ) >= 0 )
+				RemoveElement( &gNodes[ key ], &list );
+		check( IsListEmpty( &list ) );
+		DeleteElementList( &list );
+	}
+
+	return( 0 );
+}
+
+	static
+	int
+CompareKey(
+	void		*element,
+	const void	*key )
+{
+	return( ((Node*) element)->key != *(const int*) key );
+}
+
+	static
+	int
+ModelFind(
+	int	key )
+{
+	int	index;
+
+	for( index = 0; index < gCount; index++ )
+		if( gOrder[ index ] == key )
+			return( index );
+	return( -1 );
+}
+
+	static
+	void
+ModelInsert(
+	int	at,
+	int	key )
+{
+	memmove( &gOrder[ at + 1 ], &gOrder[ at ], (size_t) (gCount - at) * sizeof( int ) );
+	gOrder[ at ] = key;
+	gHits[ key ] = 0;
+	gCount++;
+}
+
+	static
+	void
+ModelRemove(
+	int	key )
+{
+	int	at = ModelFind( key );
+
+	check( at >= 0 );
+	memmove( &gOrder[ at ], &gOrder[ at + 1 ], (size_t) (gCount - at - 1) * sizeof( int ) );
+	gCount--;
+}
+
+//	Reorders the model as policy says a hit on key should.
+	static
+	void
+ModelSearch(
+	int	key,
+	int	policy )
+{
+	int	at = ModelFind( key );
+	int	to = at;
+
+	switch( policy ) {
+		case elementSearchMoveToFront:
+			to = 0;
+			break;
+		case elementSearchTranspose:
+#if	!elementalSearchCounts
+		case elementSearchCount:
+#endif
+			if( at > 0 )
+				to = at - 1;
+			break;
+#if	elementalSearchCounts
+		case elementSearchCount:
+			gHits[ key ]++;
+			while( to > 0 && gHits[ gOrder[ to - 1 ] ] < gHits[ key ] )
+				to--;
+			break;
+#endif
+	}
+	memmove( &gOrder[ to + 1 ], &gOrder[ to ], (size_t) (at - to) * sizeof( int ) );
+	gOrder[ to ] = key;
+}
+
+	static
+	void
+CheckList(
+	ElementList	*list )
+{
+	void	*element;
+	int		index = 0;
+
+	for( FirstElement( &element, list ); element; NextElement( element, &element ) ) {
+		check( index < gCount );
+		check( element == &gNodes[ gOrder[ index ] ] );
+		index++;
+	}
+	check( index == gCount );
+}
@@ -0,0 +1,178 @@
+/****************************************************************************************
+	elementalshardedtest.c
+
+	Tests of ShardedElementList: spills, refills, steals, hunger, dead
+	elements and conservation under concurrent pushes and pops.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+
+#include "elementalsharded.h"
+#include "elementaltest.h"
+
+#define	kShards		8
+#define	kThreads	kShards		//	A shard each.
+#define	kPerThread	1000
+#define	kRounds		100000
+
+typedef	struct	Node	Node;
+
+struct	Node	{
+	Element		element;
+	unsigned	seen;
+};
+
+static	ElementShard		gShards[ kShards ];
+static	ShardedElementList	gSharded;
+static	Node				gNodes[ kThreads * kPerThread ];
+static	unsigned			gStarted;
+
+	static
+	void*
+Churn(
+	void	*refCon );
+
+	static
+	size_t
+PopAll(
+	ShardedElementList	*sharded,
+	unsigned			shard );
+
+	int
+main( void )
+{
+	pthread_t	threads[ kThreads ];
+	ElementList	sink;
+	Node		*node;
+	size_t		count;
+	int			index;
+
+	memset( gNodes, 0, sizeof( gNodes ) );
+
+	//	A batch spills to overflow past twice the batch size, and another
+	//	shard steals it.
+	NewShardedElementList( &gSharded, gShards, kShards, 4 );
+	for( index = 0; index < 9; index++ )
+		PushShardElementType( &gNodes[ index ], &gSharded, 0, Node, element );
+	check( gShards[ 0 ].localCount == 5 && gShards[ 0 ].overflowCount == 4 );
+	check( StealShardElements( &gSharded, 1 ) == 4 );
+	check( gShards[ 0 ].overflowCount == 0 && gShards[ 1 ].localCount == 4 );
+	check( CountShardedElements( &gSharded ) == 9 );
+
+	//	With every overflow empty, a thief comes back empty but leaves the
+	//	owners hungry, and each publishes up to half its local list at its
+	//	next push or pop.
+	PopShardElementType( &node, &gSharded, 2, Node, element );
+	check( node == NULL && gShards[ 0 ].hungry && gShards[ 1 ].hungry );
+	PopShardElementType( &node, &gSharded, 0, Node, element );
+	check( node != NULL && !gShards[ 0 ].hungry );
+	check( gShards[ 0 ].localCount == 2 && gShards[ 0 ].overflowCount == 2 );
+	PushShardElementType( node, &gSharded, 1, Node, element );
+	check( gShards[ 1 ].localCount == 3 && gShards[ 1 ].overflowCount == 2 );
+	check( PopAll( &gSharded, 2 ) == 4 );
+	check( CountShardedElements( &gSharded ) == 5 );
+	check( PopAll( &gSharded, 0 ) == 2 && gShards[ 1 ].hungry );
+	check( PopAll( &gSharded, 1 ) == 3 );
+	check( CountShardedElements( &gSharded ) == 0 );
+	PopShardElementType( &node, &gSharded, 3, Node, element );
+	check( node == NULL );
+	DeleteShardedElementList( &gSharded );
+
+	//	Dead elements are neither popped nor moved, and don't wedge the count.
+	NewShardedElementList( &gSharded, gShards, kShards, 2 );
+	for( index = 0; index < 6; index++ )
+		PushShardElementType( &gNodes[ index ], &gSharded, 0, Node, element );
+	MarkElementDead( &gNodes[ 0 ].element );
+	MarkElementDead( &gNodes[ 3 ].element );
+	MarkElementDead( &gNodes[ 5 ].element );
+	check( PopAll( &gSharded, 0 ) == 3 );
+	check( CountShardedElements( &gSharded ) == 0 );
+	check( GetElementList( &gNodes[ 3 ].element ) == NULL );
+	PushShardElementType( &gNodes[ 0 ], &gSharded, 1, Node, element );
+	MarkElementDead( &gNodes[ 0 ].element );
+	check( PopAll( &gSharded, 2 ) == 0 && !gShards[ 1 ].hungry );
+	check( PopAll( &gSharded, 1 ) == 0 );
+	check( CountShardedElements( &gSharded ) == 0 );
+	DeleteShardedElementList( &gSharded );
+
+	//	Conservation: every node ends up in exactly one place. Only even
+	//	threads start with nodes, so odd ones live by stealing.
+	NewShardedElementList( &gSharded, gShards, kShards, 16 );
+	for( index = 0; index < kThreads; index++ )
+		check( pthread_create( &threads[ index ], NULL, Churn, NULL ) == 0 );
+	for( index = 0; index < kThreads; index++ )
+		pthread_join( threads[ index ], NULL );
+
+	count = CountShardedElements( &gSharded );
+	check( count == kThreads * kPerThread );
+	FirstShardedElementType( &node, &gSharded, Node, element );
+	for( ; node; NextShardedElementType( node, &node, &gSharded, Node, element ) ) {
+		check( node->seen == 0 );
+		node->seen = 1;
+		count--;
+	}
+	check( count == 0 );
+
+	NewElementList( &sink );
+	DrainShardedElementList( &gSharded, &sink );
+	check( CountShardedElements( &gSharded ) == 0 );
+	for( FirstElementType( &node, &sink, Node, element ); node; NextElementType( node, (void**) &node, Node, element ) )
+		count++;
+	check( count == kThreads * kPerThread );
+
+	DeleteElementList( &sink );
+	DeleteShardedElementList( &gSharded );
+	return( 0 );
+}
+
+	static
+	void*
+Churn(
+	void	*refCon )
+{
+	unsigned	shard = AcquireElementShard( &gSharded );
+	unsigned	self = __atomic_fetch_add( &gStarted, 1, __ATOMIC_RELAXED );
+	uint64_t	state = 0x9e3779b97f4a7c15ull + self;
+	Node		*held[ 32 ];
+	int			index;
+
+	(void) refCon;
+	for( index = 0; self % 2 == 0 && index < 2 * kPerThread; index++ ) {
+		Node	*node = &gNodes[ self * kPerThread + index ];
+
+		PushShardElementType( node, &gSharded, shard, Node, element );
+	}
+	for( index = 0; index < kRounds; index++ ) {
+		int	want = (int) (TestRandom( &state ) % 32);
+		int	got = 0;
+
+		while( got < want ) {
+			PopShardElementType( &held[ got ], &gSharded, shard, Node, element );
+			if( held[ got ] == NULL )
+				break;
+			got++;
+		}
+		while( got )
+			PushShardElementType( held[ --got ], &gSharded, shard, Node, element );
+	}
+	return( NULL );
+}
+
+	static
+	size_t
+PopAll(
+	ShardedElementList	*sharded,
+	unsigned			shard )
+{
+	Node	*node;
+	size_t	popped = 0;
+
+	while( PopShardElementType( &node, sharded, shard, Node, element ), node )
+		popped++;
+	return( popped );
+}
@@ -0,0 +1,261 @@
+/****************************************************************************************
+	elementalspilltest.c
+
+	Tests of SpillQueues.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Random runs of puts and grabs, in bursts well past the budget, must come
+	out in the order they went in, each item's bytes intact, with no more
+	than budget items in memory after any put that succeeds. Some encodings
+	are larger than the scratch buffer and than a read-back chunk. An encoder
+	that fails leaves its item queued, in order, and the put reporting why.
+	A queue deleted with items spilled discards them, and every item decoded
+	or released is accounted for.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "elementalspill.h"
+#include "elementaltest.h"
+
+#define	kBudget		256
+#define	kBatch		32
+#define	kOperations	200000
+#define	kHugeSize	(300 * 1024)	//	More than a read-back chunk.
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	Element		element;
+	uint32_t	sequence;
+	uint32_t	size;
+	char		bytes[];
+};
+
+static	long		gLive;			//	Items allocated and not yet freed.
+static	bool		gFailEncode;
+
+	static
+	Item*
+NewItem(
+	uint32_t	sequence,
+	uint32_t	size );
+
+	static
+	size_t
+EncodeItem(
+	void	*element,
+	void	*buffer,
+	size_t	capacity,
+	void	*refCon );
+
+	static
+	void*
+DecodeItem(
+	const void	*buffer,
+	size_t		length,
+	void		*refCon );
+
+	static
+	void
+ReleaseItem(
+	void	*element,
+	void	*refCon );
+
+	static
+	void
+CheckItem(
+	Item		*item,
+	uint32_t	sequence );
+
+	static
+	uint32_t
+ItemSize(
+	uint32_t	sequence );
+
+	int
+main( void )
+{
+	SpillQueue	queue;
+	uint64_t	random = 41;
+	uint32_t	put = 0;
+	uint32_t	grabbed = 0;
+	long		operation;
+	void		*element;
+
+	NewSpillQueue( &queue, ".", kBudget, kBatch, EncodeItem, DecodeItem, ReleaseItem, NULL );
+
+	//	Empty.
+	check( GrabSpillElement( &element, &queue ) && element == NULL );
+	check( CountSpillElements( &queue ) == 0 );
+
+	//	Bursts of puts and of grabs, each up to forty times the budget.
+	for( operation = 0; operation < kOperations; ) {
+		bool	putting = TestRandom( &random ) % 2;
+		long	run = (long) (TestRandom( &random ) % (kBudget * 40));
+
+		for( ; run && operation < kOperations; run--, operation++ ) {
+			if( putting ) {
+				check( PutSpillElement( NewItem( put, ItemSize( put ) ), &queue ) );
+				put++;
+				check( queue.headCount + queue.tailCount <= kBudget );
+			} else {
+				check( GrabSpillElement( &element, &queue ) );
+				if( grabbed == put ) {
+					check( element == NULL );
+					break;
+				}
+				CheckItem( (Item*) element, grabbed++ );
+			}
+			check( CountSpillElements( &queue ) == put - grabbed );
+		}
+	}
+	while( grabbed < put ) {
+		check( GrabSpillElement( &element, &queue ) );
+		CheckItem( (Item*) element, grabbed++ );
+	}
+	check( GrabSpillElement( &element, &queue ) && element == NULL );
+	check( gLive == 0 );
+
+	//	A failing encoder: the put says why, and nothing is lost or reordered.
+	for( ; put < grabbed + kBudget; put++ )
+		check( PutSpillElement( NewItem( put, ItemSize( put ) ), &queue ) );
+	gFailEncode = true;
+	errno = 0;
+	check( !PutSpillElement( NewItem( put, ItemSize( put ) ), &queue ) && errno == EFBIG );
+	put++;
+	check( CountSpillElements( &queue ) == put - grabbed && queue.spilledCount == 0 );
+	gFailEncode = false;
+	check( PutSpillElement( NewItem( put, ItemSize( put ) ), &queue ) );
+	put++;
+	check( queue.spilledCount > 0 && queue.headCount + queue.tailCount <= kBudget );
+	while( grabbed < put ) {
+		check( GrabSpillElement( &element, &queue ) );
+		CheckItem( (Item*) element, grabbed++ );
+	}
+	check( gLive == 0 );
+
+	//	Deleted with items spilled and none in memory.
+	for( ; put < grabbed + kBudget * 4; put++ )
+		check( PutSpillElement( NewItem( put, ItemSize( put ) ), &queue ) );
+	check( queue.spilledCount > 0 );
+	while( queue.headCount ) {
+		check( GrabSpillElement( &element, &queue ) );
+		CheckItem( (Item*) element, grabbed++ );
+	}
+	while( queue.tailCount ) {
+		GrabLastElement( &element, &queue.tail );
+		queue.tailCount--;
+		free( element );
+		gLive--;
+	}
+	DeleteSpillQueue( &queue );
+	check( gLive == 0 && CountSpillElements( &queue ) == 0 );
+
+	return( 0 );
+}
+
+	static
+	Item*
+NewItem(
+	uint32_t	sequence,
+	uint32_t	size )
+{
+	Item	*item = (Item*) malloc( sizeof( Item ) + size );
+
+	check( item != NULL );
+	memset( &item->element, 0, sizeof( Element ) );
+	item->sequence = sequence;
+	item->size = size;
+	memset( item->bytes, 'a' + sequence % 26, size );
+	gLive++;
+	return( item );
+}
+
+	static
+	size_t
+EncodeItem(
+	void	*element,
+	void	*buffer,
+	size_t	capacity,
+	void	*refCon )
+{
+	Item	*item = (Item*) element;
+	size_t	length = 2 * sizeof( uint32_t ) + item->size;
+
+	(void) refCon;
+	if( gFailEncode )
+		return( (size_t) UINT32_MAX + 1 );
+	if( length <= capacity ) {
+		memcpy( buffer, &item->sequence, sizeof( uint32_t ) );
+		memcpy( (char*) buffer + sizeof( uint32_t ), &item->size, sizeof( uint32_t ) );
+		memcpy( (char*) buffer + 2 * sizeof( uint32_t ), item->bytes, item->size );
+	}
+	return( length );
+}
+
+	static
+	void*
+DecodeItem(
+	const void	*buffer,
+	size_t		length,
+	void		*refCon )
+{
+	uint32_t	sequence;
+	uint32_t	size;
+	Item		*item;
+
+	(void) refCon;
+	memcpy( &sequence, buffer, sizeof( uint32_t ) );
+	memcpy( &size, (const char*) buffer + sizeof( uint32_t ), sizeof( uint32_t ) );
+	check( length == 2 * sizeof( uint32_t ) + size );
+	item = NewItem( sequence, size );
+	memcpy( item->bytes, (const char*) buffer + 2 * sizeof( uint32_t ), size );
+	return( item );
+}
+
+	static
+	void
+ReleaseItem(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	check( GetElementList( element ) == NULL );
+	free( element );
+	gLive--;
+}
+
+	static
+	void
+CheckItem(
+	Item		*item,
+	uint32_t	sequence )
+{
+	uint32_t	index;
+
+	check( item != NULL );
+	check( item->sequence == sequence && item->size == ItemSize( sequence ) );
+	for( index = 0; index < item->size; index++ )
+		check( item->bytes[ index ] == (char) ('a' + sequence % 26) );
+	free( item );
+	gLive--;
+}
+
+//	Mostly small, now and then past the scratch buffer, rarely huge.
+	static
+	uint32_t
+ItemSize(
+	uint32_t	sequence )
+{
+	if( sequence % 5003 == 17 )
+		return( kHugeSize );
+	if( sequence % 97 == 3 )
+		return( 9000 );
+	return( sequence % 61 );
+}
@@ -0,0 +1,177 @@
+/****************************************************************************************
+	elementalsweeptest.c
+
+	Tests of RemoveElementsIf() and lazy removal with MarkElementDead().
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	int		value;
+	Element	element;
+};
+
+	static
+	bool
+IsOdd(
+	void	*element,
+	void	*refCon );
+
+	static
+	bool
+IsAtLeast(
+	void	*element,
+	void	*refCon );
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*expected,
+	int			count );
+
+	int
+main( void )
+{
+	ElementList	list;
+	ElementList	sink;
+	Item		items[ 10 ];
+	void		*element;
+	int			limit = 0;
+	int			index;
+
+	memset( items, 0, sizeof( items ) );
+	NewElementList( &list );
+	NewElementList( &sink );
+	for( index = 0; index < 10; index++ ) {
+		items[ index ].value = index;
+		PutLastElementType( &items[ index ], &list, Item, element );
+	}
+
+	//	Packing the tags into the list field costs no space.
+	check( sizeof( ElementList ) <= 3 * sizeof( void* ) );
+
+	//	A predicate pass, onto a sink.
+	check( RemoveElementsIfType( &list, IsOdd, NULL, &sink, Item, element ) == 5 );
+	{
+		const int	kept[] = { 0, 2, 4, 6, 8 };
+		const int	removed[] = { 1, 3, 5, 7, 9 };
+		CheckOrder( &list, kept, 5 );
+		CheckOrder( &sink, removed, 5 );
+	}
+	check( GetElementListType( &items[ 3 ], Item, element ) == &sink );
+
+	//	Marking dead hides an element at once, and twice is once.
+	MarkElementDeadType( &items[ 0 ], Item, element );
+	MarkElementDeadType( &items[ 4 ], Item, element );
+	MarkElementDeadType( &items[ 8 ], Item, element );
+	MarkElementDeadType( &items[ 8 ], Item, element );
+	check( IsElementDeadType( &items[ 4 ], Item, element ) );
+	check( !IsElementDeadType( &items[ 2 ], Item, element ) );
+	check( GetElementListType( &items[ 4 ], Item, element ) == &list );
+	check( !FindElementType( &items[ 4 ], &list, Item, element ) );
+	{
+		const int	expected[] = { 2, 6 };
+		CheckOrder( &list, expected, 2 );
+	}
+
+	//	Sweeping moves them to the sink; a second sweep finds nothing.
+	check( SweepElementList( &list, &sink ) == 3 );
+	check( SweepElementList( &list, &sink ) == 0 );
+	check( !IsElementDeadType( &items[ 4 ], Item, element ) );
+	{
+		const int	kept[] = { 2, 6 };
+		const int	removed[] = { 1, 3, 5, 7, 9, 0, 4, 8 };
+		CheckOrder( &list, kept, 2 );
+		CheckOrder( &sink, removed, 8 );
+	}
+
+	//	Removing everything, with no sink, detaches.
+	check( RemoveElementsIfType( &list, IsAtLeast, &limit, NULL, Item, element ) == 2 );
+	check( IsListEmpty( &list ) );
+	check( GetElementListType( &items[ 2 ], Item, element ) == NULL );
+
+	//	A dead element can still be removed, or grabbed past; the ends skip it.
+	MarkElementDeadType( &items[ 1 ], Item, element );
+	MarkElementDeadType( &items[ 8 ], Item, element );
+	RemoveElementType( &items[ 8 ], &sink, Item, element );
+	check( GetElementListType( &items[ 8 ], Item, element ) == NULL );
+	check( !IsElementDeadType( &items[ 8 ], Item, element ) );
+	GrabFirstElement( &element, &sink );
+	check( element == &items[ 3 ].element );
+	{
+		const int	expected[] = { 5, 7, 9, 0, 4 };
+		CheckOrder( &sink, expected, 5 );
+	}
+
+	//	An element in no list can't be marked.
+	MarkElementDeadType( &items[ 8 ], Item, element );
+	check( !IsElementDeadType( &items[ 8 ], Item, element ) );
+	check( items[ 8 ].element.list == NULL );
+
+	//	A list of nothing but dead elements is empty to the accessors.
+	while( GrabFirstElement( &element, &sink ), element ) {
+		PutLastElement( element, &list );
+		MarkElementDead( element );
+	}
+	check( IsListEmpty( &list ) && IsListEmpty( &sink ) );
+	LastElement( &element, &list );
+	check( element == NULL );
+	check( SweepElementList( &list, NULL ) == 5 );
+	check( list.first == NULL && list.last == NULL );
+	check( SweepElementList( &sink, NULL ) == 1 );
+	check( sink.first == NULL );
+
+	DeleteElementList( &sink );
+	DeleteElementList( &list );
+	return( 0 );
+}
+
+	static
+	bool
+IsOdd(
+	void	*element,
+	void	*refCon )
+{
+	(void) refCon;
+	return( ((Item*) element)->value % 2 != 0 );
+}
+
+	static
+	bool
+IsAtLeast(
+	void	*element,
+	void	*refCon )
+{
+	return( ((Item*) element)->value >= *(int*) refCon );
+}
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*expected,
+	int			count )
+{
+	Item	*item;
+	int		index = 0;
+
+	for( FirstElementType( &item, list, Item, element ); item; NextElementType( item, (void**) &item, Item, element ) ) {
+		check( index < count && item->value == expected[ index ] );
+		index++;
+	}
+	check( index == count );
+
+	for( LastElementType( (void**) &item, list, Item, element ); item; PrevElementType( item, (void**) &item, Item, element ) )
+		check( item->value == expected[ --index ] );
+	check( index == 0 );
+}
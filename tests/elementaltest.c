@@ -0,0 +1,186 @@
+/****************************************************************************************
+	elementaltest.c
+
+	Tests of the classic ElementList functions.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+typedef	struct	Item	Item;
+
+struct	Item	{
+	int		value;
+	Element	element;
+};
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*expected,
+	int			count );
+
+	int
+main( void )
+{
+	ElementList	list;
+	Item		items[ 8 ];
+	Item		*item;
+	void		*element;
+	int			index;
+
+	memset( items, 0, sizeof( items ) );
+	for( index = 0; index < 8; index++ )
+		items[ index ].value = index;
+	NewElementList( &list );
+	check( IsListEmpty( &list ) );
+	FirstElement( &element, &list );
+	check( element == NULL );
+
+	//	Putters, through the Type macros.
+	PutLastElementType( &items[ 1 ], &list, Item, element );
+	PutFirstElementType( &items[ 0 ], &list, Item, element );
+	PutLastElementType( &items[ 3 ], &list, Item, element );
+	PutBeforeElementType( &items[ 2 ], &items[ 3 ], &list, Item, element );
+	PutAfterElementType( &items[ 4 ], &items[ 3 ], &list, Item, element );
+	PutBeforeElementType( &items[ 5 ], NULL, &list, Item, element );
+	PutAfterElementType( &items[ 6 ], NULL, &list, Item, element );
+	{
+		const int	expected[] = { 6, 0, 1, 2, 3, 4, 5 };
+		CheckOrder( &list, expected, 7 );
+	}
+
+	//	Putting before the first, or after the last, stays at that end.
+	{
+		ElementList	ends;
+		Item		extra[ 4 ];
+
+		memset( extra, 0, sizeof( extra ) );
+		for( index = 0; index < 4; index++ )
+			extra[ index ].value = 10 + index;
+		NewElementList( &ends );
+		PutLastElementType( &extra[ 0 ], &ends, Item, element );
+		PutBeforeElementType( &extra[ 1 ], &extra[ 0 ], &ends, Item, element );
+		PutAfterElementType( &extra[ 2 ], &extra[ 0 ], &ends, Item, element );
+		PutBeforeElementType( &extra[ 3 ], &extra[ 1 ], &ends, Item, element );
+		{
+			const int	expected[] = { 13, 11, 10, 12 };
+			CheckOrder( &ends, expected, 4 );
+		}
+		while( GrabFirstElement( &element, &ends ), element )
+			;
+		DeleteElementList( &ends );
+	}
+
+	//	Splicing a run with a dead element and a cursor's marker in it.
+	{
+		ElementList		from;
+		ElementList		to;
+		ElementCursor	cursor;
+		Item			run[ 6 ];
+
+		memset( run, 0, sizeof( run ) );
+		for( index = 0; index < 6; index++ )
+			run[ index ].value = 20 + index;
+		NewElementList( &from );
+		NewElementList( &to );
+		for( index = 0; index < 4; index++ )
+			PutLastElementType( &run[ index ], &from, Item, element );
+		PutLastElementType( &run[ 4 ], &to, Item, element );
+		PutLastElementType( &run[ 5 ], &to, Item, element );
+		OpenElementCursor( &cursor, &from );
+		check( AdvanceElementCursor( &cursor, 2 ) == 2 );
+		MarkElementDeadType( &run[ 2 ], Item, element );
+
+		SpliceElementsType( &run[ 1 ], &run[ 3 ], &from, &to, false, Item, element );
+		{
+			const int	expectedFrom[] = { 20 };
+			const int	expectedTo[] = { 24, 25, 21, 23 };
+			CheckOrder( &from, expectedFrom, 1 );
+			CheckOrder( &to, expectedTo, 4 );
+		}
+		check( GetElementListType( &run[ 2 ], Item, element ) == &to && IsElementDeadType( &run[ 2 ], Item, element ) );
+		NextCursorElement( &element, &cursor );
+		check( element == NULL && cursor.marker.prev == &run[ 0 ].element && from.last == &cursor.marker );
+
+		check( SweepElementList( &to, NULL ) == 1 );
+		SpliceElements( &run[ 1 ].element, &run[ 3 ].element, &to, &from, true );
+		{
+			const int	expectedFrom[] = { 21, 23, 20 };
+			const int	expectedTo[] = { 24, 25 };
+			CheckOrder( &from, expectedFrom, 3 );
+			CheckOrder( &to, expectedTo, 2 );
+		}
+		CloseElementCursor( &cursor );
+		while( GrabFirstElement( &element, &from ), element )
+			;
+		while( GrabFirstElement( &element, &to ), element )
+			;
+		DeleteElementList( &from );
+		DeleteElementList( &to );
+	}
+
+	//	Accessors.
+	check( FindElementType( &items[ 3 ], &list, Item, element ) );
+	check( GetElementListType( &items[ 3 ], Item, element ) == &list );
+	LastElementType( (void**) &item, &list, Item, element );
+	check( item == &items[ 5 ] );
+	PrevElementType( item, (void**) &item, Item, element );
+	check( item == &items[ 4 ] );
+
+	//	Grabbers.
+	GrabFirstElementType( (void**) &item, &list, Item, element );
+	check( item == &items[ 6 ] && GetElementListType( item, Item, element ) == NULL );
+	GrabLastElementType( (void**) &item, &list, Item, element );
+	check( item == &items[ 5 ] );
+	GrabNextElementType( &items[ 2 ], (void**) &item, &list, Item, element );
+	check( item == &items[ 3 ] );
+	GrabPrevElementType( &items[ 4 ], (void**) &item, &list, Item, element );
+	check( item == &items[ 3 ] );
+	{
+		const int	expected[] = { 0, 1, 3 };
+		CheckOrder( &list, expected, 3 );
+	}
+
+	//	Removing an element in no list is allowed.
+	RemoveElementType( &items[ 7 ], &list, Item, element );
+	check( !FindElementType( &items[ 7 ], &list, Item, element ) );
+
+	while( GrabFirstElement( &element, &list ), element )
+		;
+	check( IsListEmpty( &list ) );
+	LastElement( &element, &list );
+	check( element == NULL );
+
+	DeleteElementList( &list );
+	return( 0 );
+}
+
+	static
+	void
+CheckOrder(
+	ElementList	*list,
+	const int	*expected,
+	int			count )
+{
+	Item	*item;
+	int		index = 0;
+
+	for( FirstElementType( &item, list, Item, element ); item; NextElementType( item, (void**) &item, Item, element ) ) {
+		check( index < count && item->value == expected[ index ] );
+		index++;
+	}
+	check( index == count );
+
+	//	And backwards.
+	for( LastElementType( (void**) &item, list, Item, element ); item; PrevElementType( item, (void**) &item, Item, element ) )
+		check( item->value == expected[ --index ] );
+	check( index == 0 );
+}
@@ -0,0 +1,52 @@
+/****************************************************************************************
+	elementaltest.h
+
+	What the tests share: a check that reports and exits, and a cheap,
+	reproducible random number generator.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Each test is a program that returns 0 when every check passes. Tests are
+	built with DEBUG, so the library's own assertions run too.
+
+	************************************************************************************/
+
+#ifndef		_elementaltest_
+#define		_elementaltest_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//	Unlike assert(), never compiled out.
+#define	check( CONDITION )	\
+			((CONDITION) ? (void) 0 : CheckFailed( #CONDITION, __FILE__, __LINE__ ))
+
+	static inline
+	void
+CheckFailed(
+	const char	*condition,
+	const char	*file,
+	int			line )
+{
+	fprintf( stderr, "%s:%d: check failed: %s\n", file, line, condition );
+	exit( 1 );
+}
+
+//	xorshift64*: seeded the same way every run, so failures reproduce.
+	static inline
+	uint64_t
+TestRandom(
+	uint64_t	*state )
+{
+	uint64_t	x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return( x * UINT64_C( 0x2545F4914F6CDD1D ) );
+}
+
+#endif	//	_elementaltest_
@@ -0,0 +1,235 @@
+/****************************************************************************************
+	elementaltracetest.c
+
+	Tests of the trace recorder and ReplayElementTrace().
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	Threads trace their own lists into a pipe drained slowly, so writes block
+	and recorders run out of buffers. Every record must arrive, and in an
+	order that replays without a single impossible step. A trace whose
+	writes fail must say so when stopped, only one trace runs at a time, and
+	stopping none fails. A buffer pool's trace replays as cleanly.
+
+	************************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "elementalbuffer.h"
+#include "elementaltest.h"
+#include "elementaltrace.h"
+
+#define	kThreads	4
+#define	kItems		64
+#define	kOperations	20000
+#define	kTracePath	"elementaltracetest.trace"
+
+typedef	struct	Drain	Drain;
+
+struct	Drain	{
+	int		fd;
+	char	*bytes;
+	size_t	length;
+	size_t	capacity;
+};
+
+static	int		gBadSteps;
+
+	static
+	void*
+Record(
+	void	*refCon );
+
+	static
+	void*
+DrainSlowly(
+	void	*refCon );
+
+	static
+	void
+CheckingProc(
+	int		op,
+	void	*list,
+	void	*element,
+	void	*anchor,
+	void	*refCon );
+
+	int
+main( void )
+{
+	pthread_t			threads[ kThreads ];
+	pthread_t			drainer;
+	Drain				drain;
+	ElementTraceStats	stats;
+	ElementList			list;
+	Element				elements[ 3000 ];
+	int					pipeFDs[ 2 ];
+	int					fd;
+	int					output;
+	int					index;
+
+	//	Many threads, a slow reader.
+	check( pipe( pipeFDs ) == 0 );
+	memset( &drain, 0, sizeof( drain ) );
+	drain.fd = pipeFDs[ 0 ];
+	drain.capacity = kThreads * kOperations * sizeof( ElementTraceRecord ) + 1;
+	drain.bytes = (char*) malloc( drain.capacity );
+	check( pthread_create( &drainer, NULL, DrainSlowly, &drain ) == 0 );
+	check( StartElementTrace( pipeFDs[ 1 ] ) );
+	check( !StartElementTrace( pipeFDs[ 1 ] ) && errno == EBUSY );
+	for( index = 0; index < kThreads; index++ )
+		check( pthread_create( &threads[ index ], NULL, Record, NULL ) == 0 );
+	for( index = 0; index < kThreads; index++ )
+		check( pthread_join( threads[ index ], NULL ) == 0 );
+	check( StopElementTrace() );
+	close( pipeFDs[ 1 ] );
+	check( pthread_join( drainer, NULL ) == 0 );
+	close( pipeFDs[ 0 ] );
+	check( drain.length == kThreads * kOperations * sizeof( ElementTraceRecord ) );
+
+	fd = open( kTracePath, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	check( fd >= 0 && write( fd, drain.bytes, drain.length ) == (ssize_t) drain.length );
+	check( lseek( fd, 0, SEEK_SET ) == 0 );
+	check( ReplayElementTrace( fd, CheckingProc, sizeof( ElementList ), sizeof( Element ), NULL, &stats ) );
+	check( gBadSteps == 0 );
+	check( stats.lists == kThreads && stats.elements == kThreads * kItems );
+	check( stats.operations == kThreads * kOperations + kThreads );
+	check( lseek( fd, 0, SEEK_SET ) == 0 );
+	check( ReplayElementTrace( fd, ElementTraceCoreProc, sizeof( ElementList ), sizeof( Element ), NULL, &stats ) );
+	close( fd );
+	unlink( kTracePath );
+	free( drain.bytes );
+
+	//	A failed write stops the trace, and stopping reports it.
+	fd = open( "/dev/null", O_RDONLY );
+	memset( elements, 0, sizeof( elements ) );
+	NewElementList( &list );
+	check( StartElementTrace( fd ) );
+	for( index = 0; index < 3000; index++ )
+		PutLastElement( &elements[ index ], &list );
+	check( !StopElementTrace() );
+	close( fd );
+
+	//	And the next trace starts afresh.
+	fd = open( "/dev/null", O_WRONLY );
+	check( StartElementTrace( fd ) );
+	for( index = 0; index < 3000; index++ )
+		RemoveElement( &elements[ index ], &list );
+	check( StopElementTrace() );
+	close( fd );
+	DeleteElementList( &list );
+
+	//	A buffer pool's spliced runs replay as removes and puts.
+	{
+		BufferChain		chain;
+		BufferPool		pool;
+		static char		bytes[ 64 ];
+		ElementBuffer	*buffer;
+		int				round;
+
+		NewBufferPool( &pool, NULL, NULL );
+		NewBufferChain( &chain );
+		fd = open( kTracePath, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+		output = open( "/dev/null", O_WRONLY );
+		check( fd >= 0 && output >= 0 );
+		check( StartElementTrace( fd ) );
+		for( round = 0; round < 20; round++ ) {
+			for( index = 0; index < 1 + round % 7; index++ ) {
+				GrabPoolBuffer( &buffer, &pool );
+				check( buffer != NULL );
+				AppendChainBuffer( buffer, &chain, bytes, sizeof( bytes ) );
+			}
+			check( FlushBufferChain( &chain, output, &pool ) && IsListEmpty( &chain.buffers ) );
+		}
+		check( StopElementTrace() );
+		close( output );
+		check( lseek( fd, 0, SEEK_SET ) == 0 );
+		gBadSteps = 0;
+		check( ReplayElementTrace( fd, CheckingProc, sizeof( ElementList ), sizeof( Element ), NULL, &stats ) );
+		check( gBadSteps == 0 && stats.lists == 2 );
+		close( fd );
+		unlink( kTracePath );
+		DeleteBufferChain( &chain );
+		DeleteBufferPool( &pool );
+	}
+
+	//	Stopping with no trace running stops nothing.
+	errno = 0;
+	check( !StopElementTrace() && errno == EINVAL );
+
+	return( 0 );
+}
+
+	static
+	void*
+Record(
+	void	*refCon )
+{
+	ElementList	list;
+	Element		items[ kItems ];
+	uint64_t	random = (uint64_t) (uintptr_t) &list;
+	int			index;
+
+	(void) refCon;
+	memset( items, 0, sizeof( items ) );
+	NewElementList( &list );
+	for( index = 0; index < kItems; index++ )
+		PutLastElement( &items[ index ], &list );
+	for( index = kItems; index < kOperations; index++ ) {
+		uint64_t	draw = TestRandom( &random );
+		Element		*item = &items[ draw % kItems ];
+
+		if( GetElementList( item ) )
+			RemoveElement( item, &list );
+		else if( draw & 64 )
+			PutFirstElement( item, &list );
+		else
+			PutLastElement( item, &list );
+	}
+
+	return( NULL );
+}
+
+	static
+	void*
+DrainSlowly(
+	void	*refCon )
+{
+	Drain			*drain = (Drain*) refCon;
+	struct timespec	pause = { 0, 200000 };
+	ssize_t			got;
+
+	while( drain->length < drain->capacity
+			&& (got = read( drain->fd, drain->bytes + drain->length,
+				drain->capacity - drain->length < 4096 ? drain->capacity - drain->length : 4096 )) > 0 ) {
+		drain->length += (size_t) got;
+		nanosleep( &pause, NULL );
+	}
+	return( NULL );
+}
+
+	static
+	void
+CheckingProc(
+	int		op,
+	void	*list,
+	void	*element,
+	void	*anchor,
+	void	*refCon )
+{
+	if( op != elementTraceNewList ) {
+		ElementList	*current = GetElementList( element );
+
+		//	Replayed in order, puts find the element loose and removes find it
+		//	where it was put.
+		if( op <= elementTracePutAfter ? current != NULL : current != list )
+			gBadSteps++;
+	}
+	ElementTraceCoreProc( op, list, element, anchor, refCon );
+}
@@ -0,0 +1,148 @@
+/****************************************************************************************
+	elementaltypedtest.c
+
+	Tests of DeclareElementList(): one structure on two typed lists at once.
+
+	Copyright (c) 2026 agent <agent@local>
+	Some rights reserved: http://opensource.org/licenses/mit
+
+	************************************************************************************/
+
+#include <string.h>
+
+#include "elemental.h"
+#include "elementaltest.h"
+
+typedef	struct	Job	Job;
+
+struct	Job	{
+	int		id;
+	Element	byAge;
+	Element	byName;
+};
+
+DeclareElementList( Job, Job, byName );
+DeclareElementList( AgedJob, Job, byAge );
+
+	static
+	int
+CompareID(
+	void		*element,
+	const void	*key );
+
+	static
+	void
+CheckJobs(
+	JobList		*list,
+	const int	*expected,
+	int			count );
+
+	int
+main( void )
+{
+	JobList			jobs;
+	AgedJobList		aged;
+	ElementCursor	cursor;
+	Job				job[ 5 ];
+	Job				*found;
+	int				key;
+	int				index;
+
+	memset( job, 0, sizeof( job ) );
+	NewJobList( &jobs );
+	NewAgedJobList( &aged );
+	check( IsJobListEmpty( &jobs ) );
+	for( index = 0; index < 4; index++ ) {
+		job[ index ].id = index;
+		PutLastJob( &job[ index ], &jobs );
+		PutFirstAgedJob( &job[ index ], &aged );
+	}
+
+	//	The two lists are independent.
+	RemoveJob( &job[ 3 ], &jobs );
+	PutBeforeJob( &job[ 3 ], &job[ 1 ], &jobs );
+	job[ 4 ].id = 4;
+	PutAfterJob( &job[ 4 ], &job[ 1 ], &jobs );
+	{
+		const int	expected[] = { 0, 3, 1, 4, 2 };
+		CheckJobs( &jobs, expected, 5 );
+	}
+	FirstAgedJob( &found, &aged );
+	for( index = 3; found; index--, NextAgedJob( found, &found ) )
+		check( found->id == index );
+	check( index == -1 );
+	check( GetJobList( &job[ 0 ] ) == &jobs && GetAgedJobList( &job[ 0 ] ) == &aged );
+	check( FindJob( &job[ 4 ], &jobs ) && !FindAgedJob( &job[ 4 ], &aged ) );
+
+	//	Accessors and grabbers hand back the structure, not its Element.
+	LastJob( &found, &jobs );
+	check( found == &job[ 2 ] );
+	PrevJob( found, &found );
+	check( found == &job[ 4 ] );
+	GrabNextJob( &job[ 1 ], &found, &jobs );
+	check( found == &job[ 4 ] && GetJobList( &job[ 1 ] ) == NULL );
+	GrabPrevJob( &job[ 4 ], &found, &jobs );
+	check( found == &job[ 3 ] );
+	{
+		const int	expected[] = { 0, 3, 2 };
+		CheckJobs( &jobs, expected, 3 );
+	}
+
+	//	Searching and cursors.
+	key = 2;
+	FindJobByKey( &found, &jobs, &key, CompareID, elementSearchMoveToFront );
+	check( found == &job[ 2 ] );
+	{
+		const int	expected[] = { 2, 0, 3 };
+		CheckJobs( &jobs, expected, 3 );
+	}
+	OpenJobCursor( &cursor, &jobs );
+	NextCursorJob( &found, &cursor );
+	check( found == &job[ 2 ] );
+	NextCursorJob( &found, &cursor );
+	check( found == &job[ 0 ] );
+	CloseElementCursor( &cursor );
+
+	GrabFirstJob( &found, &jobs );
+	check( found == &job[ 2 ] );
+	GrabLastAgedJob( &found, &aged );
+	check( found == &job[ 0 ] );
+
+	ClearJobList( &jobs );
+	check( IsJobListEmpty( &jobs ) );
+	GrabFirstJob( &found, &jobs );
+	check( found == NULL );
+
+	DeleteAgedJobList( &aged );
+	DeleteJobList( &jobs );
+	return( 0 );
+}
+
+	static
+	int
+CompareID(
+	void		*element,
+	const void	*key )
+{
+	return( ((Job*) element)->id != *(const int*) key );
+}
+
+	static
+	void
+CheckJobs(
+	JobList		*list,
+	const int	*expected,
+	int			count )
+{
+	Job	*job;
+	int	index = 0;
+
+	for( FirstJob( &job, list ); job; NextJob( job, &job ) ) {
+		check( index < count && job->id == expected[ index ] );
+		index++;
+	}
+	check( index == count );
+	for( LastJob( &job, list ); job; PrevJob( job, &job ) )
+		check( job->id == expected[ --index ] );
+	check( index == 0 );
+}